@@ -0,0 +1,51 @@
+# Copyright (c) 2015-2019 DNEG
+#
+# All rights reserved. This software is distributed under the
+# Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+#
+# Redistributions of source code must retain the above copyright
+# and license notice and the following restrictions and disclaimer.
+#
+# *     Neither the name of DNEG nor the names
+# of its contributors may be used to endorse or promote products derived
+# from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+# IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+# LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+#
+
+
+# -*- cmake -*-
+# - Embed a binary file into a C++ source file
+#
+# Invoked in script mode with:
+#
+# INPUT                 the file to embed
+# OUTPUT                the C++ source file to generate
+# SYMBOL                the name of the generated array. A <SYMBOL>_size variable
+#                       holding the size of the array in bytes is also generated.
+
+FILE ( READ ${INPUT} _contents HEX )
+STRING ( LENGTH "${_contents}" _length )
+MATH ( EXPR _size "${_length} / 2" )
+
+STRING ( REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," _bytes "${_contents}" )
+STRING ( REGEX REPLACE "(0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,)" "\\1\n    " _bytes "${_bytes}" )
+
+FILE ( WRITE ${OUTPUT}
+  "// Generated from ${INPUT}. Do not edit.\n\n"
+  "#include <stddef.h>\n\n"
+  "extern \"C\" const unsigned char ${SYMBOL}[] = {\n    ${_bytes}\n};\n\n"
+  "extern \"C\" const size_t ${SYMBOL}_size = ${_size};\n"
+  )
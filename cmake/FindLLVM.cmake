@@ -33,6 +33,7 @@
 # LLVM_FOUND            set if LLVM is found.
 # LLVM_INCLUDE_DIR      LLVM's include directory
 # LLVM_LIBRARYDIR       LLVM's library directory
+# LLVM_BINARYDIR        LLVM's binary directory
 # LLVM_LIBRARIES        all LLVM libraries
 
 FIND_PACKAGE ( PackageHandleStandardArgs )
@@ -60,6 +61,10 @@ IF ( LLVM_FOUND )
     OUTPUT_VARIABLE LLVM_LIBRARYDIR
     OUTPUT_STRIP_TRAILING_WHITESPACE)
 
+  execute_process (COMMAND ${LLVM_CONFIG} --bindir
+    OUTPUT_VARIABLE LLVM_BINARYDIR
+    OUTPUT_STRIP_TRAILING_WHITESPACE)
+
   execute_process (COMMAND ${LLVM_CONFIG} --libs all
     OUTPUT_VARIABLE LLVM_LIBRARIES
     OUTPUT_STRIP_TRAILING_WHITESPACE)
@@ -34,6 +34,10 @@
 
 #include <tbb/mutex.h>
 
+#include <cstring>
+#include <string>
+#include <vector>
+
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
 namespace OPENVDB_VERSION_NAME {
@@ -90,6 +94,26 @@ void ConditionalStatement::accept(Visitor& visitor) const
     mElseBranch->accept(visitor);
 }
 
+void FunctionDefinition::accept(Visitor& visitor) const
+{
+    if (visitor.init(*this)) {
+        mBody->accept(visitor);
+    }
+    visitor.visit(*this);
+}
+
+void Loop::accept(Visitor& visitor) const
+{
+    visitor.init(*this);
+    if (mInitial) mInitial->accept(visitor);
+    visitor.visitLoopCondition(*this);
+    if (mCondition) mCondition->accept(visitor);
+    visitor.visitLoopBody(*this);
+    mBody->accept(visitor);
+    if (mIteration) mIteration->accept(visitor);
+    visitor.visit(*this);
+}
+
 void AssignExpression::accept(Visitor& visitor) const
 {
     mExpression->accept(visitor);
@@ -113,6 +137,9 @@ void UnaryOperator::accept(Visitor& visitor) const
 void BinaryOperator::accept(Visitor& visitor) const
 {
     mLeft->accept(visitor);
+    if (mOperation == tokens::AND || mOperation == tokens::OR) {
+        visitor.visitShortCircuit(*this);
+    }
     mRight->accept(visitor);
     visitor.visit(*this);
 }
@@ -130,6 +157,17 @@ void FunctionCall::accept(Visitor& visitor) const
 }
 
 void Return::accept(Visitor& visitor) const
+{
+    if (mExpression) mExpression->accept(visitor);
+    visitor.visit(*this);
+}
+
+void Break::accept(Visitor& visitor) const
+{
+    visitor.visit(*this);
+}
+
+void Continue::accept(Visitor& visitor) const
 {
     visitor.visit(*this);
 }
@@ -265,6 +303,47 @@ Statement* ConditionalStatement::accept(Modifier& visitor)
     return nullptr;
 }
 
+Statement* FunctionDefinition::accept(Modifier& visitor)
+{
+    if (Statement* node = visitor.visit(*this)) {
+        return node;
+    }
+
+    if (Node* node = mBody->accept(visitor)) {
+        mBody.reset(static_cast<Block*>(node));
+    }
+
+    return nullptr;
+}
+
+Statement* Loop::accept(Modifier& visitor)
+{
+    if (Statement* node = visitor.visit(*this)) {
+        return node;
+    }
+
+    if (mInitial) {
+        if (Node* node = mInitial->accept(visitor)) {
+            mInitial.reset(static_cast<Statement*>(node));
+        }
+    }
+    if (mCondition) {
+        if (Node* node = mCondition->accept(visitor)) {
+            mCondition.reset(static_cast<Expression*>(node));
+        }
+    }
+    if (mIteration) {
+        if (Node* node = mIteration->accept(visitor)) {
+            mIteration.reset(static_cast<Expression*>(node));
+        }
+    }
+    if (Node* node = mBody->accept(visitor)) {
+        mBody.reset(static_cast<Block*>(node));
+    }
+
+    return nullptr;
+}
+
 Expression* AssignExpression::accept(Modifier& visitor)
 {
     if (Expression* node = visitor.visit(*this)) {
@@ -346,6 +425,27 @@ Expression* FunctionCall::accept(Modifier& visitor)
 }
 
 Expression* Return::accept(Modifier& visitor)
+{
+    if (Expression* node = visitor.visit(*this)) {
+        return node;
+    }
+    if (mExpression) {
+        if (Node* node = mExpression->accept(visitor)) {
+            mExpression.reset(static_cast<Expression*>(node));
+        }
+    }
+    return nullptr;
+}
+
+Expression* Break::accept(Modifier& visitor)
+{
+    if (Expression* node = visitor.visit(*this)) {
+        return node;
+    }
+    return nullptr;
+}
+
+Expression* Continue::accept(Modifier& visitor)
 {
     if (Expression* node = visitor.visit(*this)) {
         return node;
@@ -491,6 +591,43 @@ namespace {
 // Declare this at file scope to ensure thread-safe initialization.
 tbb::mutex sInitMutex;
 std::string sLastParsingError;
+
+/// @brief  Remove any lines beginning with "#pragma" from the code, storing the remainder
+///         of each line in pragmas. The grammar has no knowledge of pragmas, so removed
+///         lines are replaced with whitespace to preserve the line numbers of any errors.
+void
+extractPragmas(std::string& code, std::vector<std::string>& pragmas)
+{
+    static const std::string token("#pragma");
+    static const char* whitespace = " \t\r";
+
+    size_t lineStart = 0;
+    while (lineStart < code.size()) {
+        size_t lineEnd = code.find('\n', lineStart);
+        if (lineEnd == std::string::npos) lineEnd = code.size();
+
+        const size_t start = code.find_first_not_of(whitespace, lineStart);
+        if (start != std::string::npos && start < lineEnd &&
+            code.compare(start, token.size(), token) == 0) {
+
+            const size_t end = start + token.size();
+            if (end == lineEnd || std::strchr(whitespace, code[end])) {
+                const size_t first = code.find_first_not_of(whitespace, end);
+                const size_t last = code.find_last_not_of(whitespace, lineEnd - 1);
+                if (first < lineEnd && last >= first) {
+                    pragmas.emplace_back(code.substr(first, last - first + 1));
+                }
+                else {
+                    pragmas.emplace_back();
+                }
+                code.replace(start, lineEnd - start, lineEnd - start, ' ');
+            }
+        }
+
+        lineStart = lineEnd + 1;
+    }
+}
+
 }
 
 using yyscan_t = void*;
@@ -511,9 +648,13 @@ extern void yyerror (openvdb::ax::ast::Tree**, char const *s) {
 openvdb::ax::ast::Tree::Ptr
 openvdb::ax::ast::parse(const char* code)
 {
+    std::string source(code);
+    std::vector<std::string> pragmas;
+    extractPragmas(source, pragmas);
+
     tbb::mutex::scoped_lock lock(sInitMutex);
 
-    YY_BUFFER_STATE buffer = yy_scan_string(code);
+    YY_BUFFER_STATE buffer = yy_scan_string(source.c_str());
 
     openvdb::ax::ast::Tree* tree(nullptr);
     const int result = yyparse(&tree);
@@ -527,6 +668,7 @@ openvdb::ax::ast::parse(const char* code)
     }
 
     assert(ptr);
+    ptr->mPragmas = std::move(pragmas);
     return ptr;
 }
 
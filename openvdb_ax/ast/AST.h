@@ -68,6 +68,8 @@ struct Block;
 struct Expression;
 struct ExpressionList;
 struct ConditionalStatement;
+struct FunctionDefinition;
+struct Loop;
 struct AssignExpression;
 struct Crement;
 struct UnaryOperator;
@@ -151,9 +153,11 @@ struct Tree : public Node
     using ConstPtr = std::shared_ptr<const Tree>;
     using UniquePtr = std::unique_ptr<Tree>;
 
-    Tree(Block* block) : mBlock(block) {}
-    Tree() : mBlock(new Block()) {}
-    Tree(const Tree& other) : mBlock(new Block(*other.mBlock)) {}
+    Tree(Block* block) : mBlock(block), mPragmas() {}
+    Tree() : mBlock(new Block()), mPragmas() {}
+    Tree(const Tree& other)
+        : mBlock(new Block(*other.mBlock))
+        , mPragmas(other.mPragmas) {}
     ~Tree() override = default;
 
     void accept(Visitor& visitor) const override final;
@@ -161,6 +165,9 @@ struct Tree : public Node
     Tree* copy() const override final { return new Tree(*this); }
 
     Block::Ptr mBlock;
+    /// @brief  The contents of any "#pragma" lines in the parsed code, in order of
+    ///         appearance and without the leading "#pragma" token
+    std::vector<std::string> mPragmas;
 };
 
 struct ExpressionList : public Statement
@@ -210,6 +217,48 @@ struct ConditionalStatement : public Statement
     Block::Ptr mElseBranch;
 };
 
+// A for, while or do while loop. Only for loops have an initial statement and an
+// iteration expression. A loop without a condition runs until it is exited
+struct Loop : public Statement
+{
+    using Ptr = std::shared_ptr<Loop>;
+    using UniquePtr = std::unique_ptr<Loop>;
+
+    enum LoopType {
+        For,
+        While,
+        DoWhile
+    };
+
+    Loop(const LoopType type,
+         Statement* initial,
+         Expression* condition,
+         Expression* iteration,
+         Block* body)
+        : mLoopType(type)
+        , mInitial(initial)
+        , mCondition(condition)
+        , mIteration(iteration)
+        , mBody(body) {}
+    Loop(const Loop& other)
+        : mLoopType(other.mLoopType)
+        , mInitial(other.mInitial ? other.mInitial->copy() : nullptr)
+        , mCondition(other.mCondition ? other.mCondition->copy() : nullptr)
+        , mIteration(other.mIteration ? other.mIteration->copy() : nullptr)
+        , mBody(new Block(*other.mBody)) {}
+    ~Loop() override = default;
+
+    void accept(Visitor& visitor) const override final;
+    Statement* accept(Modifier& visitor) override final;
+    Loop* copy() const override final { return new Loop(*this); }
+
+    const LoopType mLoopType;
+    Statement::Ptr mInitial;
+    Expression::Ptr mCondition;
+    Expression::Ptr mIteration;
+    Block::Ptr mBody;
+};
+
 struct Variable : public Expression
 {
     using Ptr = std::shared_ptr<Variable>;
@@ -385,10 +434,39 @@ struct Return : public Expression
     using Ptr = std::shared_ptr<Return>;
     using UniquePtr = std::unique_ptr<Return>;
 
+    // @note  A returned expression is only valid from within a user function
+    Return(Expression* expression = nullptr)
+        : mExpression(expression) {}
+    Return(const Return& other)
+        : mExpression(other.mExpression ? other.mExpression->copy() : nullptr) {}
     ~Return() override = default;
     void accept(Visitor& visitor) const override final;
     Expression* accept(Modifier& visitor) override final;
     Return* copy() const override final { return new Return(*this); }
+
+    Expression::Ptr mExpression;
+};
+
+struct Break : public Expression
+{
+    using Ptr = std::shared_ptr<Break>;
+    using UniquePtr = std::unique_ptr<Break>;
+
+    ~Break() override = default;
+    void accept(Visitor& visitor) const override final;
+    Expression* accept(Modifier& visitor) override final;
+    Break* copy() const override final { return new Break(*this); }
+};
+
+struct Continue : public Expression
+{
+    using Ptr = std::shared_ptr<Continue>;
+    using UniquePtr = std::unique_ptr<Continue>;
+
+    ~Continue() override = default;
+    void accept(Visitor& visitor) const override final;
+    Expression* accept(Modifier& visitor) override final;
+    Continue* copy() const override final { return new Continue(*this); }
 };
 
 struct Attribute : public Variable
@@ -474,6 +552,43 @@ struct DeclareLocal : public Variable
     const Name mType;
 };
 
+// A user function defined at the top level of a program, for example:
+//    float lerp(float a, float b, float t) { return a + (b - a) * t; }
+// The return type is the type name of a scalar or vector or "void"
+struct FunctionDefinition : public Statement
+{
+    using Ptr = std::shared_ptr<FunctionDefinition>;
+    using UniquePtr = std::unique_ptr<FunctionDefinition>;
+
+    FunctionDefinition(const std::string& name,
+                       const std::string& type,
+                       const std::vector<DeclareLocal::Ptr>& parameters,
+                       Block* body)
+        : mName(name)
+        , mType(type)
+        , mParameters(parameters)
+        , mBody(body) {}
+    FunctionDefinition(const FunctionDefinition& other)
+        : mName(other.mName)
+        , mType(other.mType)
+        , mParameters()
+        , mBody(new Block(*other.mBody)) {
+        for (const DeclareLocal::Ptr& parameter : other.mParameters) {
+            mParameters.emplace_back(parameter->copy());
+        }
+    }
+    ~FunctionDefinition() override = default;
+
+    void accept(Visitor& visitor) const override final;
+    Statement* accept(Modifier& visitor) override final;
+    FunctionDefinition* copy() const override final { return new FunctionDefinition(*this); }
+
+    const std::string mName;
+    const Name mType;
+    std::vector<DeclareLocal::Ptr> mParameters;
+    Block::Ptr mBody;
+};
+
 struct Local : public Variable
 {
     using Ptr = std::shared_ptr<Local>;
@@ -653,6 +768,8 @@ struct Visitor
     inline virtual void visit(const Block& node) {};
     inline virtual void visit(const ExpressionList& node) {};
     inline virtual void visit(const ConditionalStatement& node) {};
+    inline virtual void visit(const FunctionDefinition& node) {};
+    inline virtual void visit(const Loop& node) {};
     inline virtual void visit(const AssignExpression& node) {};
     inline virtual void visit(const Crement& node) {};
     inline virtual void visit(const UnaryOperator& node) {};
@@ -660,6 +777,8 @@ struct Visitor
     inline virtual void visit(const Cast& node) {};
     inline virtual void visit(const FunctionCall& node) {};
     inline virtual void visit(const Return& node) {};
+    inline virtual void visit(const Break& node) {};
+    inline virtual void visit(const Continue& node) {};
     inline virtual void visit(const Attribute& node) {};
     inline virtual void visit(const AttributeValue& node) {};
     inline virtual void visit(const ExternalVariable& node) {};
@@ -676,6 +795,24 @@ struct Visitor
     inline virtual void visit(const Value<float>& node) {};
     inline virtual void visit(const Value<double>& node) {};
     inline virtual void visit(const Value<std::string>& node) {};
+
+    // Called for the logical binary operators && and || after the left hand side has
+    // been visited and before the right hand side is visited, allowing visitors to
+    // only evaluate the right hand side when required
+
+    inline virtual void visitShortCircuit(const BinaryOperator& node) {};
+
+    // Called for user function definitions before the body is visited. The body is
+    // skipped if this returns false
+
+    inline virtual bool init(const FunctionDefinition& node) { return true; };
+
+    // Called for loops before the initial statement, before the condition and before
+    // the body respectively. The iteration expression is visited after the body
+
+    inline virtual void init(const Loop& node) {};
+    inline virtual void visitLoopCondition(const Loop& node) {};
+    inline virtual void visitLoopBody(const Loop& node) {};
 };
 
 
@@ -688,6 +825,8 @@ struct Modifier
     inline virtual Block* visit(Block& node) { return nullptr; };
     inline virtual ExpressionList* visit(ExpressionList& node) { return nullptr; };
     inline virtual Statement*  visit(ConditionalStatement& node) { return nullptr; };
+    inline virtual Statement*  visit(FunctionDefinition& node) { return nullptr; };
+    inline virtual Statement*  visit(Loop& node) { return nullptr; };
     inline virtual Expression* visit(AssignExpression& node) { return nullptr; };
     inline virtual Expression* visit(Crement& node) { return nullptr; };
     inline virtual Expression* visit(UnaryOperator& node) { return nullptr; };
@@ -695,6 +834,8 @@ struct Modifier
     inline virtual Expression* visit(Cast& node) { return nullptr; };
     inline virtual Expression* visit(FunctionCall& node) { return nullptr; };
     inline virtual Expression* visit(Return& node) { return nullptr; };
+    inline virtual Expression* visit(Break& node) { return nullptr; };
+    inline virtual Expression* visit(Continue& node) { return nullptr; };
     inline virtual Variable*   visit(Attribute& node) { return nullptr; };
     inline virtual Expression* visit(AttributeValue& node) { return nullptr; };
     inline virtual Variable*   visit(ExternalVariable& node) { return nullptr; };
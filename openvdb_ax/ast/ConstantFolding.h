@@ -0,0 +1,437 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENVDB_AX_COMPILER_AST_CONSTANT_FOLDING_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_COMPILER_AST_CONSTANT_FOLDING_HAS_BEEN_INCLUDED
+
+#include "AST.h"
+#include "Tokens.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+namespace ast {
+
+/// @brief  Folds operations on scalar literals and removes the branches of conditional
+///         statements with literal conditions which are never executed. Operations are
+///         evaluated with the same semantics as the generated code and are left as is if
+///         they would overflow or generate warnings.
+///
+/// @note   $ external variables are read from CustomData at execution time and so are
+///         never folded. This should run before volume blocks are split and accesses are
+///         registered, so that attributes which are only accessed in dead code are neither
+///         bound nor created.
+///
+/// @param tree  The AST to modify
+///
+inline void foldConstants(ast::Tree& tree);
+
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+
+namespace constant_folding_internal
+{
+
+/// @brief A scalar literal extracted from the AST. Types are ordered by their precedence.
+struct Literal
+{
+    enum Type { BOOL = 0, INT32, INT64, FLOAT, DOUBLE };
+
+    Type mType;
+    int64_t mInt;   // the value of BOOL, INT32 and INT64 literals
+    double mFloat;  // the value of FLOAT and DOUBLE literals
+
+    static Literal create(const Type type, const int64_t value) { return {type, value, 0.0}; }
+    static Literal create(const Type type, const double value) { return {type, 0, value}; }
+
+    bool isFloat() const { return mType >= FLOAT; }
+
+    /// @brief Returns the value converted to T, as performed by the generated code
+    template <typename T>
+    T get() const { return isFloat() ? static_cast<T>(mFloat) : static_cast<T>(mInt); }
+
+    /// @brief Returns the value as a bool, matching codegen::boolComparison
+    bool truth() const { return isFloat() ? (mFloat < 0.0 || mFloat > 0.0) : mInt != 0; }
+};
+
+/// Returns true and populates the literal if the expression is a scalar literal, or the
+/// negation of one. Literals which generate warnings due to overflows are ignored.
+inline bool getLiteral(const ast::Expression& node, Literal& literal)
+{
+    if (const auto value = dynamic_cast<const ast::Value<bool>*>(&node)) {
+        literal = Literal::create(Literal::BOOL, static_cast<int64_t>(value->mValue != 0));
+        return true;
+    }
+    if (const auto value = dynamic_cast<const ast::Value<int32_t>*>(&node)) {
+        if (value->mText || value->mValue > uint64_t(std::numeric_limits<int32_t>::max())) return false;
+        literal = Literal::create(Literal::INT32, static_cast<int64_t>(value->mValue));
+        return true;
+    }
+    if (const auto value = dynamic_cast<const ast::Value<int64_t>*>(&node)) {
+        if (value->mText || value->mValue > uint64_t(std::numeric_limits<int64_t>::max())) return false;
+        literal = Literal::create(Literal::INT64, static_cast<int64_t>(value->mValue));
+        return true;
+    }
+    if (const auto value = dynamic_cast<const ast::Value<float>*>(&node)) {
+        if (value->mText || value->mValue > double(std::numeric_limits<float>::max())) return false;
+        literal = Literal::create(Literal::FLOAT, static_cast<double>(static_cast<float>(value->mValue)));
+        return true;
+    }
+    if (const auto value = dynamic_cast<const ast::Value<double>*>(&node)) {
+        if (value->mText) return false;
+        literal = Literal::create(Literal::DOUBLE, value->mValue);
+        return true;
+    }
+    if (const auto unary = dynamic_cast<const ast::UnaryOperator*>(&node)) {
+        if (unary->mOperation != ast::tokens::MINUS) return false;
+        if (!dynamic_cast<const ast::ValueBase*>(unary->mExpression.get())) return false;
+        if (!getLiteral(*unary->mExpression, literal) || literal.mType == Literal::BOOL) return false;
+        if (literal.isFloat()) literal.mFloat = -literal.mFloat;
+        else                   literal.mInt = -literal.mInt;
+        return true;
+    }
+    return false;
+}
+
+template <typename ValueT>
+inline typename std::enable_if<std::is_integral<ValueT>::value, ast::Expression*>::type
+createLiteral(const ValueT value)
+{
+    if (value == std::numeric_limits<ValueT>::min()) return nullptr;
+    if (value >= 0) return new ast::Value<ValueT>(static_cast<uint64_t>(value));
+    return new ast::UnaryOperator(ast::tokens::MINUS,
+        new ast::Value<ValueT>(static_cast<uint64_t>(-value)));
+}
+
+template <typename ValueT>
+inline typename std::enable_if<std::is_floating_point<ValueT>::value, ast::Expression*>::type
+createLiteral(const ValueT value)
+{
+    if (!std::isfinite(value)) return nullptr;
+    if (!std::signbit(value)) return new ast::Value<ValueT>(static_cast<double>(value));
+    return new ast::UnaryOperator(ast::tokens::MINUS,
+        new ast::Value<ValueT>(static_cast<double>(-value)));
+}
+
+/// Returns a new AST expression representing the literal, or a null pointer if the literal
+/// can not be represented without changing the warnings or values of the generated code.
+/// Negative values are represented as the negation of a positive literal.
+inline ast::Expression* createLiteral(const Literal& literal)
+{
+    switch (literal.mType) {
+        case Literal::BOOL   : return new ast::Value<bool>(static_cast<uint64_t>(literal.mInt != 0));
+        case Literal::INT32  : return createLiteral(static_cast<int32_t>(literal.mInt));
+        case Literal::INT64  : return createLiteral(literal.mInt);
+        case Literal::FLOAT  : return createLiteral(static_cast<float>(literal.mFloat));
+        case Literal::DOUBLE : return createLiteral(literal.mFloat);
+    }
+    return nullptr;
+}
+
+/// Evaluates a binary operation on two literals of type T, matching the behaviour of the
+/// generated code. Returns false if the operation should not be folded.
+template <typename T>
+inline bool foldBinaryOperation(const ast::tokens::OperatorToken op,
+                                const T lhs, const T rhs,
+                                const Literal::Type type,
+                                Literal& result)
+{
+    auto setBool = [&result](const bool value) {
+        result = Literal::create(Literal::BOOL, static_cast<int64_t>(value));
+        return true;
+    };
+
+    auto set = [&result, type](const T value) {
+        if (std::is_floating_point<T>::value) result = Literal::create(type, static_cast<double>(value));
+        else                                  result = Literal::create(type, static_cast<int64_t>(value));
+        return true;
+    };
+
+    switch (op) {
+        case ast::tokens::EQUALSEQUALS    : return setBool(lhs == rhs);
+        // unordered floating point comparisons are false (FCmpONE)
+        case ast::tokens::NOTEQUALS       : return setBool(lhs < rhs || lhs > rhs);
+        case ast::tokens::MORETHAN        : return setBool(lhs > rhs);
+        case ast::tokens::LESSTHAN        : return setBool(lhs < rhs);
+        case ast::tokens::MORETHANOREQUAL : return setBool(lhs >= rhs);
+        case ast::tokens::LESSTHANOREQUAL : return setBool(lhs <= rhs);
+        default : break;
+    }
+
+    // arithmetic and bitwise operations on bools are left to the generated code
+
+    if (type == Literal::BOOL) return false;
+
+    if (std::is_floating_point<T>::value) {
+        switch (op) {
+            case ast::tokens::PLUS     : return set(lhs + rhs);
+            case ast::tokens::MINUS    : return set(lhs - rhs);
+            case ast::tokens::MULTIPLY : return set(lhs * rhs);
+            case ast::tokens::DIVIDE   : return set(lhs / rhs);
+            case ast::tokens::MODULO   : return set(static_cast<T>(std::fmod(lhs, rhs)));
+            default : return false;
+        }
+    }
+
+    // integer arithmetic wraps. division by zero and division overflow are left to the
+    // generated code
+
+    using UnsignedT = typename std::make_unsigned<T>::type;
+    const UnsignedT ulhs = static_cast<UnsignedT>(lhs);
+    const UnsignedT urhs = static_cast<UnsignedT>(rhs);
+
+    switch (op) {
+        case ast::tokens::PLUS     : return set(static_cast<T>(ulhs + urhs));
+        case ast::tokens::MINUS    : return set(static_cast<T>(ulhs - urhs));
+        case ast::tokens::MULTIPLY : return set(static_cast<T>(ulhs * urhs));
+        case ast::tokens::BITAND   : return set(static_cast<T>(ulhs & urhs));
+        case ast::tokens::BITOR    : return set(static_cast<T>(ulhs | urhs));
+        case ast::tokens::BITXOR   : return set(static_cast<T>(ulhs ^ urhs));
+        case ast::tokens::DIVIDE   : {
+            if (rhs == 0 || rhs == T(-1)) return false;
+            return set(lhs / rhs);
+        }
+        case ast::tokens::MODULO   : {
+            if (rhs == 0 || rhs == T(-1)) return false;
+            return set(lhs % rhs);
+        }
+        default : return false;
+    }
+}
+
+/// @brief Modifier class which folds operations on scalar literals and removes the branches
+///        of conditional statements with literal conditions which are never executed.
+class ConstantFoldModifier : public ast::Modifier
+{
+public:
+
+    ConstantFoldModifier() : mChanged(false) {}
+    virtual ~ConstantFoldModifier() = default;
+
+    /// @brief Folds the tree until no further changes can be made. As the Modifier visits
+    ///        nodes before their children, nested expressions are folded over multiple
+    ///        passes.
+    void fold(ast::Tree& tree)
+    {
+        do {
+            mChanged = false;
+            tree.accept(*this);
+        } while (mChanged);
+    }
+
+    ast::Block* visit(ast::Block& node) override
+    {
+        std::vector<ast::Statement::Ptr> statements;
+        statements.reserve(node.mList.size());
+
+        for (ast::Statement::Ptr& statement : node.mList) {
+            const ast::ConditionalStatement::Ptr conditional =
+                std::dynamic_pointer_cast<ast::ConditionalStatement>(statement);
+
+            Literal condition;
+            if (!conditional || !getLiteral(*conditional->mConditional, condition)) {
+                statements.emplace_back(statement);
+                continue;
+            }
+
+            const ast::Block::Ptr& branch = condition.truth() ?
+                conditional->mThenBranch : conditional->mElseBranch;
+
+            // the executed branch can only be moved into this block if it does not declare
+            // any locals which would otherwise change scope. If it does, the dead branch is
+            // still removed
+
+            if (!declaresLocals(*branch)) {
+                for (ast::Statement::Ptr& inner : branch->mList) {
+                    statements.emplace_back(inner);
+                }
+                mChanged = true;
+                continue;
+            }
+
+            const bool folded = conditional->mElseBranch->mList.empty() &&
+                dynamic_cast<const ast::Value<bool>*>(conditional->mConditional.get());
+
+            if (!folded) {
+                statements.emplace_back(new ast::ConditionalStatement(
+                    new ast::Value<bool>(uint64_t(1)), branch->copy(), new ast::Block()));
+                mChanged = true;
+            }
+            else {
+                statements.emplace_back(statement);
+            }
+        }
+
+        node.mList.swap(statements);
+        return nullptr;
+    }
+
+    ast::Expression* visit(ast::UnaryOperator& node) override
+    {
+        // negated literals are the folded representation of negative values
+
+        if (dynamic_cast<const ast::ValueBase*>(node.mExpression.get()) &&
+            node.mOperation == ast::tokens::MINUS) return nullptr;
+
+        Literal value;
+        if (!getLiteral(*node.mExpression, value)) return nullptr;
+
+        Literal result = value;
+        switch (node.mOperation) {
+            case ast::tokens::PLUS : break;
+            case ast::tokens::NOT : {
+                result = Literal::create(Literal::BOOL, static_cast<int64_t>(!value.truth()));
+                break;
+            }
+            case ast::tokens::MINUS : {
+                if (value.mType == Literal::BOOL) return nullptr;
+                if (value.isFloat()) result.mFloat = -value.mFloat;
+                else                 result.mInt = -value.mInt;
+                break;
+            }
+            case ast::tokens::BITNOT : {
+                if (value.isFloat() || value.mType == Literal::BOOL) return nullptr;
+                result.mInt = ~value.mInt;
+                break;
+            }
+            default : return nullptr;
+        }
+
+        return this->replace(createLiteral(result));
+    }
+
+    ast::Expression* visit(ast::BinaryOperator& node) override
+    {
+        const ast::tokens::OperatorToken op = node.mOperation;
+
+        Literal lhs, rhs;
+        const bool lhsLiteral = getLiteral(*node.mLeft, lhs);
+
+        // the right hand side of && and || is not evaluated if the left hand side
+        // determines the result
+
+        if (lhsLiteral && (op == ast::tokens::AND || op == ast::tokens::OR)) {
+            if ((op == ast::tokens::AND) != lhs.truth()) {
+                return this->replace(new ast::Value<bool>(static_cast<uint64_t>(lhs.truth())));
+            }
+        }
+
+        if (!lhsLiteral || !getLiteral(*node.mRight, rhs)) return nullptr;
+
+        Literal result;
+
+        if (op == ast::tokens::AND || op == ast::tokens::OR) {
+            const bool value = op == ast::tokens::AND ?
+                (lhs.truth() && rhs.truth()) : (lhs.truth() || rhs.truth());
+            result = Literal::create(Literal::BOOL, static_cast<int64_t>(value));
+            return this->replace(createLiteral(result));
+        }
+
+        const Literal::Type type = std::max(lhs.mType, rhs.mType);
+        bool folded = false;
+
+        switch (type) {
+            case Literal::DOUBLE : {
+                folded = foldBinaryOperation(op, lhs.get<double>(), rhs.get<double>(), type, result);
+                break;
+            }
+            case Literal::FLOAT : {
+                folded = foldBinaryOperation(op, lhs.get<float>(), rhs.get<float>(), type, result);
+                break;
+            }
+            case Literal::INT64 : {
+                folded = foldBinaryOperation(op, lhs.get<int64_t>(), rhs.get<int64_t>(), type, result);
+                break;
+            }
+            case Literal::INT32 :
+            case Literal::BOOL : {
+                folded = foldBinaryOperation(op, lhs.get<int32_t>(), rhs.get<int32_t>(), type, result);
+                break;
+            }
+        }
+
+        if (!folded) return nullptr;
+        return this->replace(createLiteral(result));
+    }
+
+private:
+
+    ast::Expression* replace(ast::Expression* replacement)
+    {
+        if (replacement) mChanged = true;
+        return replacement;
+    }
+
+    static bool declaresLocals(const ast::Block& block)
+    {
+        struct DeclarationScanner : public ast::Visitor
+        {
+            void visit(const ast::DeclareLocal&) override { mFound = true; }
+            bool mFound = false;
+        };
+
+        DeclarationScanner scanner;
+        block.accept(scanner);
+        return scanner.mFound;
+    }
+
+    bool mChanged;
+};
+
+}
+
+inline void foldConstants(ast::Tree& tree)
+{
+    constant_folding_internal::ConstantFoldModifier folder;
+    folder.fold(tree);
+}
+
+}
+}
+}
+}
+
+#endif // OPENVDB_AX_COMPILER_AST_CONSTANT_FOLDING_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+
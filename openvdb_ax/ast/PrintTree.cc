@@ -53,6 +53,8 @@ struct PrintVisitor : public ast::Visitor
     void init(const ast::Tree& node) override;
     void visit(const ast::Block& node) override;
     void visit(const ast::ConditionalStatement& node) override;
+    void visit(const ast::FunctionDefinition& node) override;
+    void visit(const ast::Loop& node) override;
     void visit(const ast::AssignExpression& node) override;
     void visit(const ast::Crement& node) override;
     void visit(const ast::ExpressionList& node) override;
@@ -131,6 +133,24 @@ void PrintVisitor::visit(const ast::ConditionalStatement& node)
     mOs << "Conditional Statement: " << ((node.mElseBranch) ? "two branches " : "one branch") << std::endl;
 }
 
+void PrintVisitor::visit(const ast::FunctionDefinition& node)
+{
+    printIndent();
+    mOs << "FunctionDefinition: " << node.mType << " " << node.mName << "(";
+    for (size_t i = 0; i < node.mParameters.size(); ++i) {
+        if (i != 0) mOs << ", ";
+        mOs << node.mParameters[i]->mType << " " << node.mParameters[i]->mName;
+    }
+    mOs << ")" << std::endl;
+}
+
+
+void PrintVisitor::visit(const ast::Loop& node)
+{
+    printIndent();
+    mOs << "Loop: " << (node.mLoopType == ast::Loop::For ? "for" :
+        (node.mLoopType == ast::Loop::While ? "while" : "do while")) << std::endl;
+}
 
 void PrintVisitor::visit(const ast::AssignExpression& node)
 {
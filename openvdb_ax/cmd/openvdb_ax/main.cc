@@ -33,6 +33,7 @@
 #include <openvdb_ax/ast/PrintTree.h>
 #include <openvdb_ax/codegen/FunctionRegistry.h>
 #include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/Plugin.h>
 #include <openvdb_ax/compiler/PointExecutable.h>
 #include <openvdb_ax/compiler/VolumeExecutable.h>
 
@@ -57,8 +58,10 @@ struct ProgOptions
     std::string mInputCode = "";
     std::string mInputVDBFile = "";
     std::string mOutputVDBFile = "";
+    std::vector<std::string> mPlugins;
     bool mVerbose = false;
     bool mPrintAST = false;
+    bool mListFunctions = false;
 };
 
 void
@@ -71,6 +74,7 @@ usage [[noreturn]] (int exitStatus = EXIT_FAILURE)
 "    -s snippet        execute code snippet on the input.vdb file\n" <<
 "    -f file.txt       execute text file containing a code snippet on the input.vdb file\n" <<
 "    -v                verbose (print timing and diagnostics)\n" <<
+"    --plugin lib.so   load the functions of a native function plugin (may be repeated)\n" <<
 "    --list-functions  list all available functions, their signatures and their documentation\n" <<
 "    --print-ast       print the abstract syntax tree generated for point and volume execution\n" <<
 "Warning:\n" <<
@@ -132,15 +136,21 @@ struct ScopedInitialize
     inline void initializeCompiler() const { openvdb::ax::initialize(); }
 };
 
-void printFunctions(std::ostream& os)
+void printFunctions(std::ostream& os, const std::vector<std::string>& plugins)
 {
     openvdb::ax::FunctionOptions opts;
     opts.mLazyFunctions = false;
 
     static const size_t maxHelpTextWidth = 100;
 
-    const openvdb::ax::codegen::FunctionRegistry::UniquePtr reg =
-        openvdb::ax::codegen::createStandardRegistry(opts);
+    const openvdb::ax::codegen::FunctionRegistry::UniquePtr reg(
+        new openvdb::ax::codegen::FunctionRegistry(openvdb::ax::codegen::standardDefinitions()));
+
+    for (const std::string& path : plugins) {
+        openvdb::ax::Plugin::load(path)->registerFunctions(*reg, opts);
+    }
+
+    reg->createAll(opts);
 
     llvm::LLVMContext C;
 
@@ -204,10 +214,11 @@ main(int argc, char *argv[])
                 loadSnippetFile(argv[i], options.mInputCode);
             } else if (parser.check(i, "-v", 0)) {
                 options.mVerbose = true;
+            } else if (parser.check(i, "--plugin")) {
+                ++i;
+                options.mPlugins.emplace_back(argv[i]);
             } else if (parser.check(i, "--list-functions", 0)) {
-                initializer.initializeCompiler();
-                printFunctions(std::cout);
-                return EXIT_SUCCESS;
+                options.mListFunctions = true;
             } else if (parser.check(i, "--print-ast", 0)) {
                 options.mPrintAST = true;
             } else if (arg == "-h" || arg == "-help" || arg == "--help") {
@@ -232,6 +243,19 @@ main(int argc, char *argv[])
         }
     }
 
+    // functions are listed once all arguments are parsed so that plugins are included
+
+    if (options.mListFunctions) {
+        initializer.initializeCompiler();
+        try {
+            printFunctions(std::cout, options.mPlugins);
+        } catch (std::exception& e) {
+            OPENVDB_LOG_FATAL(e.what());
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     if (options.mInputVDBFile.empty() || options.mInputCode.empty()) {
         OPENVDB_LOG_FATAL("expected at least one OpenVDB file and one code snippet");
         usage();
@@ -264,6 +288,18 @@ main(int argc, char *argv[])
     initializer.initializeCompiler();
     openvdb::ax::Compiler::Ptr compiler = openvdb::ax::Compiler::create();
 
+    for (const std::string& plugin : options.mPlugins) {
+        if (options.mVerbose) std::cout << "Loading plugin \"" + plugin + "\"...";
+        try {
+            compiler->loadPlugin(plugin);
+        } catch (std::exception& e) {
+            OPENVDB_LOG_FATAL("Plugin error!");
+            OPENVDB_LOG_FATAL(e.what());
+            return EXIT_FAILURE;
+        }
+        if (options.mVerbose) std::cout << "done." << std::endl;
+    }
+
     // parse
 
     const openvdb::ax::ast::Tree::ConstPtr syntaxTree =
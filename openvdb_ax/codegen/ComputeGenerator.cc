@@ -45,6 +45,7 @@
 #include <openvdb_ax/Exceptions.h>
 
 #include <llvm/ADT/SmallVector.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/IR/CallingConv.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
@@ -52,9 +53,15 @@
 #include <llvm/IR/InlineAsm.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/Operator.h>
 #include <llvm/Pass.h>
 #include <llvm/Support/MathExtras.h>
 #include <llvm/Transforms/Utils/BuildLibCalls.h>
+#include <llvm/Transforms/Utils/Local.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
 
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
@@ -76,6 +83,165 @@ ComputeKernel::getArgumentKeys()
 
 std::string ComputeKernel::getDefaultName() { return "compute"; }
 
+namespace {
+
+/// @brief  The kernel arguments held in a symbol table, ordered by their position in
+///         the function signature.
+inline void
+orderedArguments(const SymbolTable& table,
+                 std::vector<std::pair<std::string, llvm::Argument*>>& arguments)
+{
+    for (const auto& iter : table.map()) {
+        arguments.emplace_back(iter.first, llvm::cast<llvm::Argument>(iter.second));
+    }
+
+    std::sort(arguments.begin(), arguments.end(),
+        [](const std::pair<std::string, llvm::Argument*>& a,
+           const std::pair<std::string, llvm::Argument*>& b) {
+            return a.second->getArgNo() < b.second->getArgNo();
+        });
+}
+
+/// @brief  Load and implicitly convert a pointer to a scalar or vector value to the
+///         scalar or array type of a user function parameter or return value.
+///         Scalars are converted to vectors by assigning every element.
+inline llvm::Value*
+userFunctionConversion(llvm::Value* ptrToValue,
+                       llvm::Type* targetType,
+                       llvm::IRBuilder<>& builder)
+{
+    assert(ptrToValue && ptrToValue->getType()->isPointerTy());
+
+    llvm::Type* sourceType = ptrToValue->getType()->getContainedType(0);
+
+    if (isCharType(sourceType, builder.getContext())) {
+        OPENVDB_THROW(LLVMCastError, "Unable to pass or return strings from user functions.");
+    }
+
+    if (!targetType->isArrayTy()) {
+        if (isArrayType(sourceType)) {
+            OPENVDB_THROW(LLVMCastError, "Unable to implicitly convert a vector to a scalar.");
+        }
+        return arithmeticConversion(builder.CreateLoad(ptrToValue), targetType, builder);
+    }
+
+    llvm::Type* elementType = targetType->getArrayElementType();
+    const size_t size = targetType->getArrayNumElements();
+
+    if (!isArrayType(sourceType)) {
+        llvm::Value* value = builder.CreateLoad(ptrToValue);
+        value = arithmeticConversion(value, elementType, builder);
+        return builder.CreateLoad(arrayPack(std::vector<llvm::Value*>(size, value), builder));
+    }
+
+    if (sourceType->getArrayNumElements() != size) {
+        OPENVDB_THROW(LLVMArrayError, "Unable to implicitly convert vectors with "
+            "mismatching sizes.");
+    }
+
+    return builder.CreateLoad(arrayCast(ptrToValue, elementType, builder));
+}
+
+/// @brief  Visitor which finds attribute accesses
+struct AttributeScanner : public ast::Visitor
+{
+    void visit(const ast::Attribute&) override { mFound = true; }
+    void visit(const ast::AttributeValue&) override { mFound = true; }
+    bool mFound = false;
+};
+
+/// @brief  Load a pointer to an operand of a logical binary operator and convert it
+///         to a bool. Vector and string operands are not supported.
+inline llvm::Value*
+logicalOperand(llvm::Value* ptrToValue,
+               const ast::tokens::OperatorToken op,
+               llvm::IRBuilder<>& builder)
+{
+    assert(ptrToValue && ptrToValue->getType()->isPointerTy() &&
+        "Input to logical BinaryOperator is not a pointer type.");
+
+    llvm::Type* type = ptrToValue->getType()->getContainedType(0);
+
+    if (isCharType(type, builder.getContext())) {
+        OPENVDB_THROW(LLVMBinaryOperationError, "Unsupported string operation \""
+            + ast::tokens::operatorNameFromToken(op) + "\"");
+    }
+    if (isArrayType(type)) {
+        OPENVDB_THROW(LLVMBinaryOperationError, "Call to unsupported operator \""
+            + ast::tokens::operatorNameFromToken(op) + "\" with a vector argument");
+    }
+
+    return boolComparison(builder.CreateLoad(ptrToValue), builder);
+}
+
+/// @brief  Returns true if the expression is an untyped double precision literal, or the
+///         negation of one, setting the value of the literal.
+inline bool
+doubleLiteral(const ast::Expression* node, double& value)
+{
+    if (const auto literal = dynamic_cast<const ast::Value<double>*>(node)) {
+        value = literal->mValue;
+        return true;
+    }
+
+    const auto unary = dynamic_cast<const ast::UnaryOperator*>(node);
+    if (unary && unary->mOperation == ast::tokens::MINUS &&
+        doubleLiteral(unary->mExpression.get(), value)) {
+        value = -value;
+        return true;
+    }
+
+    return false;
+}
+
+/// @brief  Returns true if the function call is a lookupf or lookupvec3f call with a literal
+///         name which can be resolved at compile time, setting the name and custom data type.
+inline bool
+literalLookup(const ast::FunctionCall& node, std::string& name, std::string& type)
+{
+    if (node.mFunction == "lookupf")       type = openvdb::typeNameAsString<float>();
+    else if (node.mFunction == "lookupvec3f") type = openvdb::typeNameAsString<math::Vec3<float>>();
+    else return false;
+
+    if (node.mArguments->mList.size() != 1) return false;
+    const ast::Value<std::string>* const literal =
+        dynamic_cast<const ast::Value<std::string>*>(node.mArguments->mList.front().get());
+    if (!literal) return false;
+
+    // names which can not be represented as a global token use the runtime lookup
+    if (literal->mValue.find_first_of("@$#") != std::string::npos) return false;
+
+    name = literal->mValue;
+    return true;
+}
+
+/// @brief  Convert the fast-math options to the llvm flags set on the IR builder. The
+///         builder applies these to every floating point instruction it creates.
+llvm::FastMathFlags
+toLLVMFastMathFlags(const FunctionOptions::FastMathFlags& options)
+{
+    llvm::FastMathFlags flags;
+    if (options.mNoNaNs)           flags.setNoNaNs();
+    if (options.mNoInfs)           flags.setNoInfs();
+    if (options.mNoSignedZeros)    flags.setNoSignedZeros();
+    if (options.mAllowReciprocal)  flags.setAllowReciprocal();
+    if (options.mAllowContract)    flags.setAllowContract(true);
+#if LLVM_VERSION_MAJOR >= 6
+    if (options.mAllowReassociation) flags.setAllowReassoc();
+#else
+    // prior to LLVM 6, reassociation is only available as part of unsafe algebra,
+    // which implies all other flags
+
+    if (options.mAllowReassociation && options.mNoNaNs && options.mNoInfs &&
+        options.mNoSignedZeros && options.mAllowReciprocal) {
+        flags.setUnsafeAlgebra();
+    }
+#endif
+    return flags;
+}
+
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -89,17 +255,24 @@ ComputeGenerator::ComputeGenerator(llvm::Module& module,
     , mContext(module.getContext())
     , mBuilder(llvm::IRBuilder<>(module.getContext()))
     , mBlocks()
-    , mReturnBlocks()
     , mContinueBlocks()
     , mCurrentBlock(1)
+    , mLoops()
+    , mShortCircuitBlocks()
     , mValues()
     , mSymbolTables()
     , mWarnings(warnings)
     , mFunction(nullptr)
     , mLLVMArguments()
     , mOptions(options)
+    , mFunctionRegistry(functionRegistry)
+    , mUserFunctions()
+    , mStringSizes()
     , mTargetLibInfoImpl(new llvm::TargetLibraryInfoImpl(llvm::Triple(mModule.getTargetTriple())))
-    , mFunctionRegistry(functionRegistry) {}
+    , mKernelState()
+{
+    mBuilder.setFastMathFlags(toLLVMFastMathFlags(mOptions.mFastMathFlags));
+}
 
 void ComputeGenerator::init(const ast::Tree&)
 {
@@ -174,8 +347,149 @@ void ComputeGenerator::visit(const ast::ConditionalStatement& node)
     mCurrentBlock = mBlocks.size();
 }
 
+void ComputeGenerator::init(const ast::Loop& node)
+{
+    LoopBlocks blocks;
+    blocks.mCondition = llvm::BasicBlock::Create(mContext, "loop_condition", mFunction);
+    blocks.mBody = llvm::BasicBlock::Create(mContext, "loop_body", mFunction);
+    blocks.mIteration = llvm::BasicBlock::Create(mContext, "loop_iteration", mFunction);
+    blocks.mExit = llvm::BasicBlock::Create(mContext, "loop_exit", mFunction);
+    mLoops.push(blocks);
+
+    // the exit block is pushed to create a scope for declarations in the initial
+    // statement, which are visible to the condition, body and iteration
+
+    mBlocks.push(blocks.mExit);
+    mCurrentBlock = mBlocks.size();
+}
+
+void ComputeGenerator::visitLoopCondition(const ast::Loop& node)
+{
+    const LoopBlocks& blocks = mLoops.top();
+
+    // do while loops execute the body before testing the condition
+
+    mBuilder.CreateBr(node.mLoopType == ast::Loop::DoWhile ? blocks.mBody : blocks.mCondition);
+    mBuilder.SetInsertPoint(blocks.mCondition);
+}
+
+void ComputeGenerator::visitLoopBody(const ast::Loop& node)
+{
+    const LoopBlocks& blocks = mLoops.top();
+
+    if (node.mCondition) {
+        llvm::Value* condition = mValues.top(); mValues.pop();
+        condition = mBuilder.CreateLoad(condition);
+        condition = boolComparison(condition, mBuilder);
+        mBuilder.CreateCondBr(condition, blocks.mBody, blocks.mExit);
+    }
+    else {
+        mBuilder.CreateBr(blocks.mBody);
+    }
+
+    // the body block branches to the iteration block once visited
+
+    mBlocks.push(blocks.mIteration);
+    mContinueBlocks.push(blocks.mIteration);
+
+    mBuilder.SetInsertPoint(blocks.mBody);
+    mCurrentBlock = mBlocks.size();
+}
+
+void ComputeGenerator::visit(const ast::Loop& node)
+{
+    const LoopBlocks blocks = mLoops.top();
+    mLoops.pop();
+
+    mBuilder.CreateBr(blocks.mCondition);
+
+    assert(mBlocks.top() == blocks.mExit);
+    mBlocks.pop();
+
+    mBuilder.SetInsertPoint(blocks.mExit);
+
+    // remove the symbol table of the initial statement
+    mSymbolTables.erase(mCurrentBlock);
+    mCurrentBlock = mBlocks.size();
+}
+
+void ComputeGenerator::visit(const ast::Break& node)
+{
+    if (mLoops.empty()) {
+        OPENVDB_THROW(LLVMSyntaxError, "Break statement is not within a loop.");
+    }
+
+    mBuilder.CreateBr(mLoops.top().mExit);
+    // any following statements are generated into an unreachable block
+    mBuilder.SetInsertPoint(llvm::BasicBlock::Create(mContext, "break", mFunction));
+}
+
+void ComputeGenerator::visit(const ast::Continue& node)
+{
+    if (mLoops.empty()) {
+        OPENVDB_THROW(LLVMSyntaxError, "Continue statement is not within a loop.");
+    }
+
+    mBuilder.CreateBr(mLoops.top().mIteration);
+    // any following statements are generated into an unreachable block
+    mBuilder.SetInsertPoint(llvm::BasicBlock::Create(mContext, "continue", mFunction));
+}
+
+void ComputeGenerator::visitShortCircuit(const ast::BinaryOperator& node)
+{
+    // Branch on the left hand side, only evaluating the right hand side in its own
+    // block if it can change the result
+
+    const ast::tokens::OperatorToken op = node.mOperation;
+    assert(op == ast::tokens::AND || op == ast::tokens::OR);
+
+    llvm::Value* ptrToLhsValue = mValues.top(); mValues.pop();
+    llvm::Value* lhs = logicalOperand(ptrToLhsValue, op, mBuilder);
+
+    llvm::BasicBlock* rhsBlock = llvm::BasicBlock::Create(mContext, "logical_rhs", mFunction);
+    llvm::BasicBlock* endBlock = llvm::BasicBlock::Create(mContext, "logical_end");
+
+    if (op == ast::tokens::AND) mBuilder.CreateCondBr(lhs, rhsBlock, endBlock);
+    else                        mBuilder.CreateCondBr(lhs, endBlock, rhsBlock);
+
+    mShortCircuitBlocks.emplace(mBuilder.GetInsertBlock(), endBlock);
+    mBuilder.SetInsertPoint(rhsBlock);
+}
+
 void ComputeGenerator::visit(const ast::BinaryOperator& node)
 {
+    // Logical operators have already branched on their left hand side
+
+    if (node.mOperation == ast::tokens::AND || node.mOperation == ast::tokens::OR) {
+
+        llvm::Value* ptrToRhsValue = mValues.top(); mValues.pop();
+        llvm::Value* rhs = logicalOperand(ptrToRhsValue, node.mOperation, mBuilder);
+
+        assert(!mShortCircuitBlocks.empty());
+        llvm::BasicBlock* lhsBlock = mShortCircuitBlocks.top().first;
+        llvm::BasicBlock* endBlock = mShortCircuitBlocks.top().second;
+        mShortCircuitBlocks.pop();
+
+        // the right hand side may have created further blocks
+
+        llvm::BasicBlock* rhsBlock = mBuilder.GetInsertBlock();
+        mBuilder.CreateBr(endBlock);
+
+        endBlock->insertInto(mFunction);
+        mBuilder.SetInsertPoint(endBlock);
+
+        // if the right hand side was skipped, the result is false for && and true for ||
+
+        llvm::PHINode* result = mBuilder.CreatePHI(rhs->getType(), 2);
+        result->addIncoming(mBuilder.getInt1(node.mOperation == ast::tokens::OR), lhsBlock);
+        result->addIncoming(rhs, rhsBlock);
+
+        llvm::Value* resultPtr = insertStaticAlloca(mBuilder, result->getType());
+        mBuilder.CreateStore(result, resultPtr);
+        mValues.push(resultPtr);
+        return;
+    }
+
     // Enum of supported operations
 
     enum OperandTypes
@@ -196,6 +510,13 @@ void ComputeGenerator::visit(const ast::BinaryOperator& node)
     assert(ptrToLhsValue && ptrToLhsValue->getType()->isPointerTy() &&
         "Left Hand Size input to BinaryOperator is not a pointer type.");
 
+    {
+        std::vector<llvm::Value*> operands { ptrToLhsValue, ptrToRhsValue };
+        this->demoteLiterals({ node.mLeft.get(), node.mRight.get() }, operands);
+        ptrToLhsValue = operands[0];
+        ptrToRhsValue = operands[1];
+    }
+
     llvm::Type* lhsType = ptrToLhsValue->getType()->getContainedType(0);
     llvm::Type* rhsType = ptrToRhsValue->getType()->getContainedType(0);
 
@@ -216,6 +537,30 @@ void ComputeGenerator::visit(const ast::BinaryOperator& node)
     }
 
     const ast::tokens::OperatorToken op = node.mOperation;
+
+    // Matrix operands only support component-wise addition and subtraction with other
+    // matrices. Products are performed with the matrix built-in functions
+
+    if (operandTypes == ARRAY_OP_ARRAY &&
+        (isMatrixType(lhsType) || isMatrixType(rhsType)) &&
+        op != ast::tokens::PLUS && op != ast::tokens::MINUS &&
+        ast::tokens::operatorType(op) == ast::tokens::ARITHMETIC) {
+        OPENVDB_THROW(LLVMBinaryOperationError, "Call to unsupported operator \""
+            + ast::tokens::operatorNameFromToken(op) + "\" with two matrix arguments");
+    }
+
+    // Vector arithmetic may be performed on llvm vector types, in which case each array
+    // operand is loaded and the result is stored once, rather than per element
+
+    if (mOptions.mNativeVectors &&
+        ast::tokens::operatorType(op) == ast::tokens::ARITHMETIC &&
+        (operandTypes == ARRAY_OP_ARRAY ||
+         operandTypes == SCALAR_OP_ARRAY ||
+         operandTypes == ARRAY_OP_SCALAR)) {
+        mValues.push(vectorBinaryOperator(ptrToLhsValue, ptrToRhsValue, op, mBuilder));
+        return;
+    }
+
     std::vector<llvm::Value*> lhsElements, rhsElements;
 
     // Initialise array elements
@@ -288,7 +633,7 @@ void ComputeGenerator::visit(const ast::BinaryOperator& node)
 
             if (opType == ast::tokens::ARITHMETIC) {
 
-                resultPtr = mBuilder.CreateAlloca(llvm::ArrayType::get(lhsElements.front()->getType(), results));
+                resultPtr = insertStaticAlloca(mBuilder, llvm::ArrayType::get(lhsElements.front()->getType(), results));
                 std::vector<llvm::Value*> arrayElements;
                 arrayUnpack(resultPtr, arrayElements, mBuilder, /*load elements*/false);
 
@@ -330,7 +675,7 @@ void ComputeGenerator::visit(const ast::BinaryOperator& node)
                 }
 
                 llvm::Type* returnType = elementResult->getType();
-                resultPtr = mBuilder.CreateAlloca(returnType);
+                resultPtr = insertStaticAlloca(mBuilder, returnType);
                 mBuilder.CreateStore(elementResult, resultPtr);
             }
             else if (opType == ast::tokens::LOGICAL || opType == ast::tokens::BITWISE) {
@@ -352,13 +697,8 @@ void ComputeGenerator::visit(const ast::BinaryOperator& node)
                     + ast::tokens::operatorNameFromToken(op) + "\"");
             }
 
-            llvm::AllocaInst* lhsAllocInstance = llvm::cast<llvm::AllocaInst>(ptrToLhsValue);
-            llvm::AllocaInst* rhsAllocInstance = llvm::cast<llvm::AllocaInst>(ptrToRhsValue);
-            llvm::Value* lhsCharArraySize = lhsAllocInstance->getArraySize();
-            llvm::Value* rhsCharArraySize = rhsAllocInstance->getArraySize();
-
-            assert(llvm::isa<llvm::ConstantInt>(lhsCharArraySize));
-            assert(llvm::isa<llvm::ConstantInt>(rhsCharArraySize));
+            llvm::Value* lhsCharArraySize = this->stringSize(ptrToLhsValue);
+            llvm::Value* rhsCharArraySize = this->stringSize(ptrToRhsValue);
 
             // subtract null terminator from lhs size
 
@@ -369,7 +709,7 @@ void ComputeGenerator::visit(const ast::BinaryOperator& node)
 
             llvm::Value* totalSize =
                 binaryOperator(lhsCharArraySize, rhsCharArraySize, ast::tokens::PLUS, mBuilder);
-            resultPtr = mBuilder.CreateAlloca(lhsType, totalSize);
+            resultPtr = this->allocateString(totalSize);
 
             llvm::Value* rhsStringStartPtr = mBuilder.CreateGEP(resultPtr, lhsCharArraySize);
 
@@ -399,7 +739,7 @@ void ComputeGenerator::visit(const ast::BinaryOperator& node)
             llvm::Value* result = binaryOperator(lhs, rhs, op, mBuilder);
 
             // create a store for the result
-            resultPtr = mBuilder.CreateAlloca(result->getType());
+            resultPtr = insertStaticAlloca(mBuilder, result->getType());
             mBuilder.CreateStore(result, resultPtr);
             break;
         }
@@ -445,7 +785,7 @@ void ComputeGenerator::visit(const ast::UnaryOperator& node)
         }
 
         // create a store for the result
-        resultPtr = mBuilder.CreateAlloca(type);
+        resultPtr = insertStaticAlloca(mBuilder, type);
         mBuilder.CreateStore(result, resultPtr);
 
     }
@@ -467,7 +807,7 @@ void ComputeGenerator::visit(const ast::UnaryOperator& node)
         }
 
         // create a store for the result
-        resultPtr = mBuilder.CreateAlloca(type);
+        resultPtr = insertStaticAlloca(mBuilder, type);
         mBuilder.CreateStore(result, resultPtr);
     }
     else if (type->isArrayTy()) {
@@ -570,10 +910,8 @@ void ComputeGenerator::visit(const ast::AssignExpression& node)
             }
 
             // re-allocate the lhs
-            llvm::AllocaInst* allocInstance = llvm::cast<llvm::AllocaInst>(ptrToRhsValue);
-            llvm::Value* size = allocInstance->getArraySize();
-            assert(llvm::isa<llvm::ConstantInt>(size));
-            ptrToLhsValue = mBuilder.CreateAlloca(lhsType, size);
+            llvm::Value* size = this->stringSize(ptrToRhsValue);
+            ptrToLhsValue = this->allocateString(size);
 
             // simple wrapper around the tli impl.
             const llvm::TargetLibraryInfo info(*mTargetLibInfoImpl);
@@ -672,7 +1010,7 @@ void ComputeGenerator::visit(const ast::Crement& node)
 
     llvm::Value* temp = nullptr;
     if (node.mPost) {
-        temp = mBuilder.CreateAlloca(type);
+        temp = insertStaticAlloca(mBuilder, type);
         mBuilder.CreateStore(rhs, temp);
     }
 
@@ -707,7 +1045,7 @@ void ComputeGenerator::visit(const ast::Crement& node)
     }
     else {
         // pre-increment: put the incremented value on the expression stack
-        lhs = mBuilder.CreateAlloca(type);
+        lhs = insertStaticAlloca(mBuilder, type);
         mBuilder.CreateStore(rhs, lhs);
         mValues.push(lhs);
     }
@@ -718,6 +1056,12 @@ void ComputeGenerator::visit(const ast::FunctionCall& node)
     assert(node.mArguments.get() && ("Uninitialized expression list for " +
         node.mFunction).c_str());
 
+    const auto userFunction = mUserFunctions.find(node.mFunction);
+    if (userFunction != mUserFunctions.end()) {
+        this->callUserFunction(node, userFunction->second);
+        return;
+    }
+
     const FunctionBase::Ptr function = this->getFunction(node.mFunction, mOptions);
 
     if (!(function->context() & FunctionBase::Base)) {
@@ -729,16 +1073,26 @@ void ComputeGenerator::visit(const ast::FunctionCall& node)
 
     std::vector<llvm::Value*> arguments;
     argumentsFromStack(mValues, args, arguments);
+    this->demoteLiterals(node, arguments);
     parseDefaultArgumentState(arguments, mBuilder);
 
     std::vector<llvm::Value*> results;
-    llvm::Value* result = function->execute(arguments, mLLVMArguments.map(), mBuilder, mModule, &results);
+    llvm::Value* result = nullptr;
+
+    std::string name, type;
+    if (literalLookup(node, name, type)) {
+        result = this->generateLookup(name, type, function, arguments);
+    }
+    else {
+        result = function->execute(arguments, mLLVMArguments.map(), mBuilder, mModule, &results);
+    }
+
     llvm::Type* resultType = result->getType();
 
     if (resultType != LLVMType<void>::get(mContext)) {
         // only required to allocate new data for the result type if its NOT a pointer
         if (!resultType->isPointerTy()) {
-            llvm::Value* resultStore = mBuilder.CreateAlloca(resultType);
+            llvm::Value* resultStore = insertStaticAlloca(mBuilder, resultType);
             mBuilder.CreateStore(result, resultStore);
             result = resultStore;
         }
@@ -748,6 +1102,169 @@ void ComputeGenerator::visit(const ast::FunctionCall& node)
     for (auto& v : results) mValues.push(v);
 }
 
+void ComputeGenerator::callUserFunction(const ast::FunctionCall& node,
+                                        llvm::Function* function)
+{
+    const size_t args = node.mArguments->mList.size();
+
+    std::vector<std::pair<std::string, llvm::Argument*>> kernelArguments;
+    orderedArguments(mLLVMArguments, kernelArguments);
+
+    const size_t parameters = function->arg_size() - kernelArguments.size();
+    if (args != parameters) {
+        OPENVDB_THROW(LLVMFunctionError, "Function \"" + node.mFunction + "\" expects " +
+            std::to_string(parameters) + " argument(s) but " + std::to_string(args) +
+            " were provided.");
+    }
+
+    std::vector<llvm::Value*> arguments;
+    argumentsFromStack(mValues, args, arguments);
+
+    // forward the arguments of the current function, followed by the converted
+    // call arguments
+
+    std::vector<llvm::Value*> values;
+    values.reserve(function->arg_size());
+    for (const auto& argument : kernelArguments) {
+        values.emplace_back(argument.second);
+    }
+
+    llvm::Function::arg_iterator parameter = function->arg_begin();
+    std::advance(parameter, kernelArguments.size());
+
+    for (llvm::Value* argument : arguments) {
+        llvm::Type* type = parameter->getType();
+        if (type->isPointerTy()) {
+            type = type->getContainedType(0);
+            llvm::Value* store = insertStaticAlloca(mBuilder, type);
+            mBuilder.CreateStore(userFunctionConversion(argument, type, mBuilder), store);
+            values.emplace_back(store);
+        }
+        else {
+            values.emplace_back(userFunctionConversion(argument, type, mBuilder));
+        }
+        ++parameter;
+    }
+
+    llvm::Value* result = mBuilder.CreateCall(function, values);
+
+    if (!result->getType()->isVoidTy()) {
+        llvm::Value* resultStore = insertStaticAlloca(mBuilder, result->getType());
+        mBuilder.CreateStore(result, resultStore);
+        mValues.push(resultStore);
+    }
+}
+
+void ComputeGenerator::demoteLiterals(const std::vector<const ast::Expression*>& nodes,
+                                      std::vector<llvm::Value*>& operands)
+{
+    assert(nodes.size() == operands.size());
+
+    if (mOptions.mPrecisionPolicy != FunctionOptions::PrecisionPolicy::DEMOTE_LITERALS) return;
+
+    std::vector<std::pair<size_t, double>> literals;
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        double value;
+        if (doubleLiteral(nodes[i], value)) {
+            // literals beyond the finite range of a float, which would overflow to infinity
+            // or flush to zero, keep all operands in double precision
+
+            const float demoted = static_cast<float>(value);
+            if (std::isinf(demoted) && !std::isinf(value)) return;
+            if (demoted == 0.0f && value != 0.0) return;
+
+            literals.emplace_back(i, value);
+            continue;
+        }
+
+        // explicitly typed double precision operands keep all operands in double precision
+
+        llvm::Type* type = operands[i]->getType();
+        if (type->isPointerTy()) type = type->getContainedType(0);
+        if (isArrayType(type)) type = type->getArrayElementType();
+        if (type->isDoubleTy()) return;
+    }
+
+    for (const auto& literal : literals) {
+        const float demoted = static_cast<float>(literal.second);
+
+        if (mWarnings && static_cast<double>(demoted) != literal.second) {
+            std::ostringstream os;
+            os << "Double precision literal " << literal.second << " demoted to float "
+                << demoted << ". Use an explicit double to retain precision.";
+            mWarnings->emplace_back(os.str());
+        }
+
+        llvm::Constant* value = LLVMType<float>::get(mContext, demoted);
+        llvm::Value* store = insertStaticAlloca(mBuilder, value->getType());
+        mBuilder.CreateStore(value, store);
+        operands[literal.first] = store;
+    }
+}
+
+void ComputeGenerator::demoteLiterals(const ast::FunctionCall& node,
+                                      std::vector<llvm::Value*>& arguments)
+{
+    std::vector<const ast::Expression*> nodes;
+    nodes.reserve(node.mArguments->mList.size());
+    for (const ast::Expression::Ptr& argument : node.mArguments->mList) {
+        nodes.emplace_back(argument.get());
+    }
+    this->demoteLiterals(nodes, arguments);
+}
+
+llvm::Value* ComputeGenerator::generateLookup(const std::string& name,
+                                              const std::string& type,
+                                              const FunctionBase::Ptr& function,
+                                              const std::vector<llvm::Value*>& arguments)
+{
+    // The global holds the address of the custom data, or zero if no data of this name
+    // and type existed at compile time. See registerLookupGlobals in Compiler.cc
+
+    const std::string globalName = getGlobalLookupAccess(name, type);
+    llvm::Value* ptrToAddress = this->globals().get(globalName);
+
+    if (!ptrToAddress) {
+        ptrToAddress = llvm::cast<llvm::GlobalVariable>
+            (mModule.getOrInsertGlobal(globalName, LLVMType<uintptr_t>::get(mContext)));
+        this->globals().insert(globalName, ptrToAddress);
+    }
+
+    llvm::Type* valueType = llvmTypeFromName(type, mContext);
+    llvm::Value* address = mBuilder.CreateLoad(ptrToAddress);
+    llvm::Value* bound = mBuilder.CreateICmpNE(address,
+        llvm::ConstantInt::get(address->getType(), 0));
+
+    llvm::BasicBlock* boundBlock = llvm::BasicBlock::Create(mContext, "lookup_bound", mFunction);
+    llvm::BasicBlock* unboundBlock = llvm::BasicBlock::Create(mContext, "lookup_unbound", mFunction);
+    llvm::BasicBlock* endBlock = llvm::BasicBlock::Create(mContext, "lookup_end", mFunction);
+
+    mBuilder.CreateCondBr(bound, boundBlock, unboundBlock);
+
+    // direct access to the bound data. vectors are returned by pointer
+
+    mBuilder.SetInsertPoint(boundBlock);
+    llvm::Value* boundValue = mBuilder.CreateIntToPtr(address, valueType->getPointerTo(0));
+    if (!isArrayType(valueType)) boundValue = mBuilder.CreateLoad(boundValue);
+    mBuilder.CreateBr(endBlock);
+
+    // fall back to searching the custom data at runtime
+
+    mBuilder.SetInsertPoint(unboundBlock);
+    llvm::Value* unboundValue = function->execute(arguments, mLLVMArguments.map(), mBuilder, mModule);
+    unboundBlock = mBuilder.GetInsertBlock();
+    mBuilder.CreateBr(endBlock);
+
+    mBuilder.SetInsertPoint(endBlock);
+    assert(boundValue->getType() == unboundValue->getType());
+
+    llvm::PHINode* result = mBuilder.CreatePHI(boundValue->getType(), 2, "lookup");
+    result->addIncoming(boundValue, boundBlock);
+    result->addIncoming(unboundValue, unboundBlock);
+    return result;
+}
+
 void ComputeGenerator::visit(const ast::Cast& node)
 {
     llvm::Value* value = mValues.top();
@@ -761,7 +1278,7 @@ void ComputeGenerator::visit(const ast::Cast& node)
     value = mBuilder.CreateLoad(value);
     value = arithmeticConversion(value, type, mBuilder);
 
-    llvm::Value* store = mBuilder.CreateAlloca(value->getType());
+    llvm::Value* store = insertStaticAlloca(mBuilder, value->getType());
     mBuilder.CreateStore(value, store);
 
     mValues.push(store);
@@ -769,15 +1286,177 @@ void ComputeGenerator::visit(const ast::Cast& node)
 
 void ComputeGenerator::visit(const ast::Return& node)
 {
-    mBuilder.CreateRetVoid();
-    mReturnBlocks.push_back(llvm::BasicBlock::Create(mContext, "return", mFunction));
-    mBuilder.SetInsertPoint(mReturnBlocks.back());
+    llvm::Type* returnType = mFunction->getReturnType();
+
+    if (node.mExpression) {
+        if (!this->inUserFunction()) {
+            OPENVDB_THROW(LLVMFunctionError, "Values can only be returned from user functions.");
+        }
+        if (returnType->isVoidTy()) {
+            OPENVDB_THROW(LLVMFunctionError, "Unable to return a value from a void function.");
+        }
+
+        llvm::Value* value = mValues.top(); mValues.pop();
+        mBuilder.CreateRet(userFunctionConversion(value, returnType, mBuilder));
+    }
+    else {
+        if (!returnType->isVoidTy()) {
+            OPENVDB_THROW(LLVMFunctionError, "A value must be returned from a non void function.");
+        }
+        mBuilder.CreateRetVoid();
+    }
+
+    // any following statements are generated into an unreachable block
+    mBuilder.SetInsertPoint(llvm::BasicBlock::Create(mContext, "return", mFunction));
+}
+
+bool ComputeGenerator::init(const ast::FunctionDefinition& node)
+{
+    if (this->inUserFunction()) {
+        OPENVDB_THROW(LLVMFunctionError, "Function \"" + node.mName +
+            "\" cannot be defined within another function.");
+    }
+    if (this->isUserFunction(node.mName)) {
+        OPENVDB_THROW(LLVMFunctionError, "Function \"" + node.mName +
+            "\" has already been defined.");
+    }
+    if (mFunctionRegistry.definition(node.mName)) {
+        OPENVDB_THROW(LLVMFunctionError, "Function \"" + node.mName +
+            "\" conflicts with a built-in function of the same name.");
+    }
+
+    AttributeScanner scanner;
+    node.mBody->accept(scanner);
+    if (scanner.mFound) {
+        OPENVDB_THROW(LLVMContextError, "Attributes cannot be accessed within the body of "
+            "function \"" + node.mName + "\".");
+    }
+
+    // the arguments of the kernel function are forwarded so that built-in functions
+    // which depend on them can be called from the function body
+
+    std::vector<std::pair<std::string, llvm::Argument*>> kernelArguments;
+    orderedArguments(mLLVMArguments, kernelArguments);
+
+    std::vector<llvm::Type*> types;
+    for (const auto& argument : kernelArguments) {
+        types.emplace_back(argument.second->getType());
+    }
+
+    for (const ast::DeclareLocal::Ptr& parameter : node.mParameters) {
+        if (parameter->mType == openvdb::typeNameAsString<std::string>()) {
+            OPENVDB_THROW(LLVMTypeError, "String parameter \"" + parameter->mName +
+                "\" of function \"" + node.mName + "\" is not supported.");
+        }
+        llvm::Type* type = llvmTypeFromName(parameter->mType, mContext);
+        if (type->isArrayTy()) type = type->getPointerTo(0);
+        types.emplace_back(type);
+    }
+
+    llvm::Type* returnType = (node.mType == "void") ?
+        LLVMType<void>::get(mContext) : llvmTypeFromName(node.mType, mContext);
+
+    // the code of separate volume blocks is generated into the same module, in which
+    // case the function body only needs to be generated once
+
+    const std::string symbol = "ax.user." + node.mName;
+    llvm::Function* function = mModule.getFunction(symbol);
+    if (function) {
+        mUserFunctions[node.mName] = function;
+        return false;
+    }
+
+    function = llvm::Function::Create(llvm::FunctionType::get(returnType, types, false),
+        llvm::Function::InternalLinkage, symbol, &mModule);
+
+    // register the function before its body is generated to allow recursive calls
+
+    mUserFunctions[node.mName] = function;
+
+    // save the state of the kernel function and begin the user function with only
+    // the global variables in scope
+
+    mKernelState.reset(new KernelState);
+    mKernelState->mFunction = mFunction;
+    mKernelState->mCurrentBlock = mCurrentBlock;
+    mKernelState->mInsertPoint = mBuilder.saveIP();
+    std::swap(mKernelState->mBlocks, mBlocks);
+    std::swap(mKernelState->mContinueBlocks, mContinueBlocks);
+    std::swap(mKernelState->mValues, mValues);
+    std::swap(mKernelState->mSymbolTables, mSymbolTables);
+    std::swap(mKernelState->mLLVMArguments, mLLVMArguments);
+
+    mSymbolTables.globals() = mKernelState->mSymbolTables.globals();
+    mFunction = function;
+    mCurrentBlock = 1;
+
+    mBlocks.push(llvm::BasicBlock::Create(mContext, "entry_" + node.mName, mFunction));
+    mBuilder.SetInsertPoint(mBlocks.top());
+
+    llvm::Function::arg_iterator argIter = mFunction->arg_begin();
+    for (const auto& argument : kernelArguments) {
+        mLLVMArguments.insert(argument.first, llvm::cast<llvm::Value>(argIter));
+        ++argIter;
+    }
+
+    // parameters are copied into locals so that they can be modified
+
+    SymbolTable* current = mSymbolTables.getOrInsert(mCurrentBlock);
+    for (const ast::DeclareLocal::Ptr& parameter : node.mParameters) {
+        llvm::Value* value = llvm::cast<llvm::Value>(argIter);
+        if (value->getType()->isPointerTy()) value = mBuilder.CreateLoad(value);
+        ++argIter;
+
+        llvm::Value* local = insertStaticAlloca(mBuilder, value->getType());
+        mBuilder.CreateStore(value, local);
+
+        if (!current->insert(parameter->mName, local)) {
+            OPENVDB_THROW(LLVMDeclarationError, "Parameter \"" + parameter->mName +
+                "\" of function \"" + node.mName + "\" has already been declared!");
+        }
+    }
+
+    return true;
+}
+
+void ComputeGenerator::visit(const ast::FunctionDefinition& node)
+{
+    // nothing to do if the body was not generated
+    if (!this->inUserFunction()) return;
+
+    assert(mBlocks.size() == 1);
+
+    // a function which does not end in a return statement returns zero
+
+    llvm::Type* returnType = mFunction->getReturnType();
+    if (returnType->isVoidTy()) mBuilder.CreateRetVoid();
+    else mBuilder.CreateRet(llvm::Constant::getNullValue(returnType));
+
+    // remove the blocks following return, break and continue statements and any other
+    // blocks only reachable from them. These may still be used by the phi nodes of
+    // other unreachable blocks, so are not erased individually
+    llvm::removeUnreachableBlocks(*mFunction);
+
+    // restore the kernel function, keeping any new global variables
+
+    mKernelState->mSymbolTables.globals() = mSymbolTables.globals();
+
+    mFunction = mKernelState->mFunction;
+    mCurrentBlock = mKernelState->mCurrentBlock;
+    std::swap(mKernelState->mBlocks, mBlocks);
+    std::swap(mKernelState->mContinueBlocks, mContinueBlocks);
+    std::swap(mKernelState->mValues, mValues);
+    std::swap(mKernelState->mSymbolTables, mSymbolTables);
+    std::swap(mKernelState->mLLVMArguments, mLLVMArguments);
+    mBuilder.restoreIP(mKernelState->mInsertPoint);
+
+    mKernelState.reset();
 }
 
 void ComputeGenerator::visit(const ast::DeclareLocal& node)
 {
     // create storage for the local value.
-    llvm::Value* value = mBuilder.CreateAlloca(llvmTypeFromName(node.mType, mContext));
+    llvm::Value* value = insertStaticAlloca(mBuilder, llvmTypeFromName(node.mType, mContext));
     mValues.push(value);
 
     SymbolTable* current = mSymbolTables.getOrInsert(mCurrentBlock);
@@ -864,11 +1543,16 @@ void ComputeGenerator::visit(const ast::ArrayPack& node)
     // or another array
     if (num == 1) return;
 
-    std::vector<llvm::Value*> values;
-    values.reserve(num);
-    for (size_t i = 0; i < num; ++i) {
-        values.push_back(mBuilder.CreateLoad(mValues.top()));
-        mValues.pop();
+    // arguments are visited in order, so the last element is at the top of the stack
+
+    std::vector<llvm::Value*> values(num);
+    for (auto iter = values.rbegin(); iter != values.rend(); ++iter) {
+        llvm::Value* value = mValues.top(); mValues.pop();
+        llvm::Type* type = value->getType()->getContainedType(0);
+        if (!isScalarType(type) || isCharType(type, mContext)) {
+            OPENVDB_THROW(LLVMArrayError, "Array elements must be scalar values.");
+        }
+        *iter = mBuilder.CreateLoad(value);
     }
 
     llvm::Value* array = arrayPackCast(values, mBuilder);
@@ -878,7 +1562,7 @@ void ComputeGenerator::visit(const ast::ArrayPack& node)
 void ComputeGenerator::visit(const ast::Value<bool>& node)
 {
     llvm::Constant* value = LLVMType<bool>::get(mContext, node.mValue);
-    llvm::Value* store = mBuilder.CreateAlloca(value->getType());
+    llvm::Value* store = insertStaticAlloca(mBuilder, value->getType());
     mBuilder.CreateStore(value, store);
     mValues.push(store);
 }
@@ -917,10 +1601,35 @@ void ComputeGenerator::visit(const ast::Value<std::string>& node)
     /// In this case a strcpy is required and negates the optimization effects of llvm arrays.
     /// Thus all strings are allocated as such to provide consistency.
 
+    // literals larger than the stack budget for strings are never copied, and instead
+    // refer to a constant global. Strings are not modified in place, so this is safe
+
+    const size_t size = node.mValue.size() + 1;
+    if (size > MaxStackStringSize) {
+        llvm::Value* store = mBuilder.CreateGlobalStringPtr(node.mValue);
+        mStringSizes[store] = LLVMType<int64_t>::get(mContext, static_cast<int64_t>(size));
+        mValues.push(store);
+        return;
+    }
+
     llvm::Value* store = llvmStringToValue(node.mValue, mBuilder);
     mValues.push(store);
 }
 
+llvm::Value* ComputeGenerator::allocateString(llvm::Value* size)
+{
+    llvm::Value* string = insertStaticAlloca(mBuilder, LLVMType<char>::get(mContext), size);
+    mStringSizes[string] = size;
+    return string;
+}
+
+llvm::Value* ComputeGenerator::stringSize(llvm::Value* string) const
+{
+    const auto iter = mStringSizes.find(string);
+    if (iter != mStringSizes.end()) return iter->second;
+    return llvm::cast<llvm::AllocaInst>(string)->getArraySize();
+}
+
 FunctionBase::Ptr ComputeGenerator::getFunction(const std::string &identifier,
                                                 const FunctionOptions &op,
                                                 const bool allowInternal)
@@ -953,7 +1662,7 @@ ComputeGenerator::visit(const ast::Value<ValueType>& node)
     }
 
     llvm::Constant* value = LLVMType<ValueType>::get(mContext, literal);
-    llvm::Value* store = mBuilder.CreateAlloca(value->getType());
+    llvm::Value* store = insertStaticAlloca(mBuilder, value->getType());
     mBuilder.CreateStore(value, store);
     mValues.push(store);
 }
@@ -982,7 +1691,7 @@ ComputeGenerator::visit(const ast::Value<ValueType>& node)
     }
 
     llvm::Constant* value = LLVMType<ValueType>::get(mContext, literal);
-    llvm::Value* store = mBuilder.CreateAlloca(value->getType());
+    llvm::Value* store = insertStaticAlloca(mBuilder, value->getType());
     mBuilder.CreateStore(value, store);
     mValues.push(store);
 }
@@ -1009,7 +1718,7 @@ void ComputeGenerator::visit(const ast::Tree& node)
 {
     assert(mBlocks.size() == 1);
     mBuilder.CreateRetVoid();
-    for (auto& block : mReturnBlocks) block->eraseFromParent();
+    llvm::removeUnreachableBlocks(*mFunction);
 }
 
 void ComputeGenerator::visit(const ast::Attribute& node)
@@ -54,7 +54,10 @@
 #include <llvm/IR/Module.h>
 
 #include <map>
+#include <memory>
 #include <stack>
+#include <unordered_map>
+#include <utility>
 
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
@@ -122,8 +125,29 @@ protected:
     void visit(const ast::Block& node) override;
     void visit(const ast::ConditionalStatement& node) override;
     void visit(const ast::Return& node) override;
+
+    /// @brief  User functions are generated as internal llvm functions which take
+    ///         the arguments of the kernel function followed by their declared
+    ///         parameters. Vector parameters are passed as pointers to arrays.
+    ///         Returns false if the function body should not be visited as the
+    ///         function already exists in the module.
+    ///
+    bool init(const ast::FunctionDefinition& node) override;
+    void visit(const ast::FunctionDefinition& node) override;
+
+    /// @brief  Loops are generated as a condition block which branches to the body
+    ///         or the exit, and an iteration block which the body and continue
+    ///         statements branch to before returning to the condition
+    ///
+    void init(const ast::Loop& node) override;
+    void visitLoopCondition(const ast::Loop& node) override;
+    void visitLoopBody(const ast::Loop& node) override;
+    void visit(const ast::Loop& node) override;
+    void visit(const ast::Break& node) override;
+    void visit(const ast::Continue& node) override;
     void visit(const ast::UnaryOperator& node) override;
     void visit(const ast::BinaryOperator& node) override;
+    void visitShortCircuit(const ast::BinaryOperator& node) override;
     void visit(const ast::Cast& node) override;
     void visit(const ast::DeclareLocal& node) override;
     void visit(const ast::Local& node) override;
@@ -155,13 +179,49 @@ protected:
 
     FunctionBase::Ptr getFunction(const std::string& identifier, const FunctionOptions& op, const bool allowInternal = false);
 
+    /// @brief  Returns true if the identifier is a user function defined in the code
+    ///         being generated. Calls to user functions are handled by this class.
+    inline bool isUserFunction(const std::string& identifier) const {
+        return mUserFunctions.find(identifier) != mUserFunctions.end();
+    }
+
+    /// @brief  Returns true if code is currently being generated for the body of a
+    ///         user function rather than for the kernel function
+    inline bool inUserFunction() const { return static_cast<bool>(mKernelState); }
+
+    /// @brief  Demote untyped double precision literal operands to float, as permitted by
+    ///         the precision policy, if none of the other operands are double precision
+    ///         and every literal is within the finite range of a float.
+    ///         Each operand is a pointer to its value, as generated from the given node.
+    void demoteLiterals(const std::vector<const ast::Expression*>& nodes,
+        std::vector<llvm::Value*>& operands);
+    void demoteLiterals(const ast::FunctionCall& node, std::vector<llvm::Value*>& arguments);
+
+    /// @brief  String temporaries of up to this many bytes, including the null terminator,
+    ///         may be allocated on the stack
+    static const size_t MaxStackStringSize = 1024;
+
+    /// @brief  Allocate a string temporary of the given number of bytes, including the null
+    ///         terminator, returning a pointer to its first character. By default strings
+    ///         are allocated on the stack.
+    virtual llvm::Value* allocateString(llvm::Value* size);
+
+    /// @brief  Returns the number of bytes, including the null terminator, of a string
+    ///         created by allocateString() or a string literal
+    llvm::Value* stringSize(llvm::Value* string) const;
+
+    /// @brief  Generate a lookup of custom data with a literal name. The lookup loads from
+    ///         the address of the custom data bound at compile time, only calling the
+    ///         provided lookup function if no matching data existed when compiling.
+    llvm::Value* generateLookup(const std::string& name, const std::string& type,
+        const FunctionBase::Ptr& function, const std::vector<llvm::Value*>& arguments);
+
     llvm::Module& mModule;
     llvm::LLVMContext& mContext;
     llvm::IRBuilder<> mBuilder;
 
     // Holds all scoped blocks, including the initial insert point
     std::stack<llvm::BasicBlock*> mBlocks;
-    std::vector<llvm::BasicBlock*> mReturnBlocks;
 
     // Used to hold break points (post conditional statement) for exiting blocks
     // @TODO add support for break keyword
@@ -170,6 +230,20 @@ protected:
     // The current block number used to track scoped declarations
     size_t mCurrentBlock;
 
+    // The blocks of each loop being generated
+    struct LoopBlocks
+    {
+        llvm::BasicBlock* mCondition;
+        llvm::BasicBlock* mBody;
+        llvm::BasicBlock* mIteration;
+        llvm::BasicBlock* mExit;
+    };
+    std::stack<LoopBlocks> mLoops;
+
+    // For each logical binary operator being visited, the block which branches on its
+    // left hand side and the block which is branched to once its result is known
+    std::stack<std::pair<llvm::BasicBlock*, llvm::BasicBlock*>> mShortCircuitBlocks;
+
     // The stack of accessed values
     std::stack<llvm::Value*> mValues;
 
@@ -187,8 +261,33 @@ protected:
 
     const FunctionOptions mOptions;
 
+    // The registry of functions available to this generator
+    FunctionRegistry& mFunctionRegistry;
+
+    // The user functions defined in the code, keyed by their name
+    std::map<std::string, llvm::Function*> mUserFunctions;
+
+    // The sizes of strings which are not stack allocations of a constant size
+    std::unordered_map<const llvm::Value*, llvm::Value*> mStringSizes;
+
 private:
 
+    // The generation state of the kernel function, saved while the body of a
+    // user function is being generated
+    struct KernelState
+    {
+        llvm::Function* mFunction = nullptr;
+        std::stack<llvm::BasicBlock*> mBlocks;
+        std::stack<llvm::BasicBlock*> mContinueBlocks;
+        size_t mCurrentBlock = 0;
+        std::stack<llvm::Value*> mValues;
+        SymbolTableBlocks mSymbolTables;
+        SymbolTable mLLVMArguments;
+        llvm::IRBuilderBase::InsertPoint mInsertPoint;
+    };
+
+    void callUserFunction(const ast::FunctionCall& node, llvm::Function* function);
+
     template <typename ValueType>
     typename std::enable_if<std::is_integral<ValueType>::value>::type
     visit(const ast::Value<ValueType>& node);
@@ -198,7 +297,8 @@ private:
     visit(const ast::Value<ValueType>& node);
 
     const std::unique_ptr<const llvm::TargetLibraryInfoImpl> mTargetLibInfoImpl;
-    FunctionRegistry& mFunctionRegistry;
+
+    std::unique_ptr<KernelState> mKernelState;
 };
 
 }
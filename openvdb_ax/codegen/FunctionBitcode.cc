@@ -0,0 +1,266 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file codegen/FunctionBitcode.cc
+///
+
+#include "FunctionBitcode.h"
+
+#include <openvdb_ax/Exceptions.h>
+
+#include <llvm/ADT/StringSet.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Transforms/IPO/Internalize.h>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+#include <map>
+#include <set>
+
+#ifdef OPENVDB_AX_FUNCTION_BITCODE
+// Generated at build time from the linked bitcode of the function library sources
+extern "C" const unsigned char openvdb_ax_function_bitcode[];
+extern "C" const size_t openvdb_ax_function_bitcode_size;
+#endif
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+namespace codegen {
+
+namespace {
+
+/// @brief  Returns the symbol which a host function pointer is exported as, or an empty
+///         string if the address is not exported by the process. Template and member
+///         functions are exported with their mangled names, which match the names of the
+///         definitions produced by clang in the bitcode library.
+inline std::string
+hostSymbol(void* function)
+{
+#ifndef _WIN32
+    Dl_info info;
+    if (dladdr(function, &info) && info.dli_sname && info.dli_saddr == function) {
+        return std::string(info.dli_sname);
+    }
+#endif
+    return std::string();
+}
+
+inline bool
+resolvesInHost(const llvm::GlobalValue& value)
+{
+    return llvm::sys::DynamicLibrary::SearchForAddressOfSymbol(value.getName().str()) != nullptr;
+}
+
+/// @brief  Returns true if a function from the bitcode library, and every function it
+///         calls, can be executed by the JIT with the same behaviour as the host function.
+///         Thread local storage can not be relocated by the JIT and mutable state which is
+///         local to the library would not be shared with the host. Any declarations must
+///         be resolvable from the host process.
+bool
+isLinkable(const llvm::Function& function, std::set<const llvm::Function*>& visited)
+{
+    if (!visited.insert(&function).second) return true;
+
+    if (function.isDeclaration()) {
+        return function.isIntrinsic() || resolvesInHost(function);
+    }
+
+    for (const llvm::BasicBlock& block : function) {
+        for (const llvm::Instruction& inst : block) {
+            for (const llvm::Value* operand : inst.operand_values()) {
+                const llvm::Value* value = operand->stripPointerCasts();
+                if (const auto* global = llvm::dyn_cast<llvm::GlobalVariable>(value)) {
+                    if (global->isThreadLocal()) return false;
+                    if (global->isDeclaration() && !resolvesInHost(*global)) return false;
+                    if (!global->isConstant() && global->hasLocalLinkage()) return false;
+                }
+                else if (const auto* callee = llvm::dyn_cast<llvm::Function>(value)) {
+                    if (!isLinkable(*callee, visited)) return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+
+bool hasFunctionBitcode()
+{
+#ifdef OPENVDB_AX_FUNCTION_BITCODE
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t linkFunctionBitcode(const FunctionRegistry& registry, llvm::Module& module)
+{
+#ifndef OPENVDB_AX_FUNCTION_BITCODE
+    (void)registry;
+    (void)module;
+    return 0;
+#else
+    return linkFunctionBitcode(registry, module,
+        reinterpret_cast<const char*>(openvdb_ax_function_bitcode),
+        openvdb_ax_function_bitcode_size, "openvdb_ax_function_bitcode");
+#endif
+}
+
+size_t linkFunctionBitcode(const FunctionRegistry& registry,
+                           llvm::Module& module,
+                           const char* bitcode,
+                           const size_t size,
+                           const std::string& name)
+{
+    if (!bitcode || size == 0) return 0;
+
+    // map the host symbols of the external functions declared in the module to the
+    // symbol names they have been declared with
+
+    std::map<std::string, std::string> symbols;
+
+    for (const auto& iter : registry.map()) {
+        const FunctionBase::Ptr function = iter.second.function();
+        if (!function) continue;
+
+        for (const FunctionSignatureBase::Ptr& signature : function->list()) {
+            void* functionPtr = signature->functionPointer();
+            if (!functionPtr) continue;
+
+            const llvm::Function* declaration = module.getFunction(signature->symbolName());
+            if (!declaration || !declaration->isDeclaration()) continue;
+
+            const std::string symbol = hostSymbol(functionPtr);
+            if (!symbol.empty()) symbols[symbol] = signature->symbolName();
+        }
+    }
+
+    if (symbols.empty()) return 0;
+
+    const llvm::StringRef data(bitcode, size);
+    const llvm::MemoryBufferRef buffer(data, name);
+
+    llvm::Expected<std::unique_ptr<llvm::Module>> parsed =
+        llvm::parseBitcodeFile(buffer, module.getContext());
+
+    // if the bitcode was produced by an incompatible version of clang, fall back to
+    // calling the host functions
+
+    if (!parsed) {
+        llvm::consumeError(parsed.takeError());
+        return 0;
+    }
+
+    std::unique_ptr<llvm::Module> library = std::move(*parsed);
+    library->setTargetTriple(module.getTargetTriple());
+    library->setDataLayout(module.getDataLayout());
+
+    // static constructors are never run by the JIT
+
+    if (llvm::GlobalVariable* ctors = library->getNamedGlobal("llvm.global_ctors")) {
+        ctors->eraseFromParent();
+    }
+    if (llvm::GlobalVariable* dtors = library->getNamedGlobal("llvm.global_dtors")) {
+        dtors->eraseFromParent();
+    }
+
+    // mutable globals which are visible outside of the library, such as the static
+    // variables of inline functions, are resolved from the host so that state is shared
+
+    for (llvm::GlobalVariable& global : library->globals()) {
+        if (global.isDeclaration() || global.isConstant()) continue;
+        if (global.hasLocalLinkage() || global.hasAppendingLinkage()) continue;
+        global.setInitializer(nullptr);
+        global.setLinkage(llvm::GlobalValue::ExternalLinkage);
+        global.setComdat(nullptr);
+    }
+
+    // the process symbols are searched to validate declarations in the library
+
+    llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+
+    size_t count = 0;
+
+    for (const auto& symbol : symbols) {
+        llvm::Function* definition = library->getFunction(symbol.first);
+        if (!definition || definition->isDeclaration()) continue;
+
+        const llvm::Function* declaration = module.getFunction(symbol.second);
+        if (definition->getFunctionType() != declaration->getFunctionType()) continue;
+
+        std::set<const llvm::Function*> visited;
+        if (!isLinkable(*definition, visited)) continue;
+
+        definition->setName(symbol.second);
+        ++count;
+    }
+
+    if (count == 0) return 0;
+
+    // only the definitions which are required by the module are linked. These are given
+    // internal linkage so that they are removed once they have been inlined
+
+    const bool failed = llvm::Linker::linkModules(module, std::move(library),
+        llvm::Linker::Flags::LinkOnlyNeeded,
+        [](llvm::Module& M, const llvm::StringSet<>& linked) {
+            llvm::internalizeModule(M, [&linked](const llvm::GlobalValue& value) {
+                return !llvm::isa<llvm::Function>(value) || !value.hasName() ||
+                    linked.count(value.getName()) == 0;
+            });
+        });
+
+    if (failed) {
+        OPENVDB_THROW(LLVMFunctionError, "Failed to link the function bitcode \"" + name + "\".");
+    }
+
+    return count;
+}
+
+}
+}
+}
+}
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file codegen/FunctionBitcode.h
+///
+/// @brief  Linking of the LLVM bitcode of the built-in functions into generated
+///         modules. When the library is built with OPENVDB_AX_BUILD_BITCODE, the
+///         function library is compiled to bitcode by clang and embedded into the
+///         openvdb_ax library. Built-ins which are implemented in C++ can then be
+///         inlined into the compute kernels rather than being called through an
+///         opaque function pointer.
+///
+
+#ifndef OPENVDB_AX_CODEGEN_FUNCTION_BITCODE_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_CODEGEN_FUNCTION_BITCODE_HAS_BEEN_INCLUDED
+
+#include "FunctionRegistry.h"
+
+#include <openvdb_ax/version.h>
+
+#include <llvm/IR/Module.h>
+
+#include <string>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+namespace codegen {
+
+/// @brief  Returns true if the library was built with an embedded bitcode copy of the
+///         built-in functions
+bool hasFunctionBitcode();
+
+/// @brief  Link the bitcode definitions of any externally linked built-in functions
+///         which are called by a module. Linked functions are given internal linkage so
+///         that they can be inlined and removed by the optimizer. Functions which can
+///         not be linked, for example as they access thread local storage, remain
+///         declarations and are mapped to their host function pointers as before.
+///
+/// @param  registry  The function registry which was used to generate the module
+/// @param  module    The module to link into
+///
+/// @return The number of built-in functions which were linked
+///
+size_t linkFunctionBitcode(const FunctionRegistry& registry, llvm::Module& module);
+
+/// @brief  Link the definitions of any externally linked functions which are called by a
+///         module from the given buffer of LLVM bitcode, such as the bitcode provided by a
+///         function plugin. Definitions are matched to the host functions of the registry
+///         and are linked under the same conditions as the built-in function bitcode.
+///
+/// @param  registry  The function registry which was used to generate the module
+/// @param  module    The module to link into
+/// @param  bitcode   The bitcode buffer
+/// @param  size      The size of the bitcode buffer in bytes
+/// @param  name      A name for the bitcode used in error messages
+///
+/// @return The number of functions which were linked
+///
+size_t linkFunctionBitcode(const FunctionRegistry& registry,
+                           llvm::Module& module,
+                           const char* bitcode,
+                           const size_t size,
+                           const std::string& name);
+
+}
+}
+}
+}
+
+#endif // OPENVDB_AX_CODEGEN_FUNCTION_BITCODE_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
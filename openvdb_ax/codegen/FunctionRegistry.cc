@@ -54,7 +54,8 @@ namespace codegen {
 void FunctionRegistry::insert(const std::string& identifier,
        const FunctionRegistry::ConstructorT creator, const bool internal)
 {
-    if (!mMap.emplace(std::piecewise_construct,
+    if ((mDefinitions && mDefinitions->definition(identifier)) ||
+        !mMap.emplace(std::piecewise_construct,
               std::forward_as_tuple(identifier),
               std::forward_as_tuple(creator, internal)).second) {
         OPENVDB_THROW(LLVMFunctionError, "A function already exists"
@@ -67,6 +68,11 @@ void FunctionRegistry::insertAndCreate(const std::string& identifier,
                 const FunctionOptions& op,
                 const bool internal)
 {
+    if (mDefinitions && mDefinitions->definition(identifier)) {
+        OPENVDB_THROW(LLVMFunctionError, "A function already exists"
+            " with the provided token: \"" + identifier + "\"");
+    }
+
     auto inserted = mMap.emplace(std::piecewise_construct,
               std::forward_as_tuple(identifier),
               std::forward_as_tuple(creator, internal));
@@ -82,7 +88,19 @@ FunctionBase::Ptr FunctionRegistry::getOrInsert(const std::string& identifier,
                                                 const bool allowInternalAccess)
 {
     auto iter = mMap.find(identifier);
-    if (iter == mMap.end()) return FunctionBase::Ptr();
+    if (iter == mMap.end()) {
+        // instantiate shared definitions into this registry so that they are never modified
+
+        const RegisteredFunction* shared =
+            mDefinitions ? mDefinitions->definition(identifier) : nullptr;
+        if (!shared) return FunctionBase::Ptr();
+        if (!allowInternalAccess && shared->isInternal()) return FunctionBase::Ptr();
+
+        iter = mMap.emplace(std::piecewise_construct,
+              std::forward_as_tuple(identifier),
+              std::forward_as_tuple(shared->constructor(), shared->isInternal())).first;
+    }
+
     FunctionRegistry::RegisteredFunction& reg = iter->second;
     if (!allowInternalAccess && reg.isInternal()) return FunctionBase::Ptr();
 
@@ -115,8 +133,28 @@ FunctionBase::Ptr FunctionRegistry::get(const std::string& identifier, const boo
     return iter->second.function();
 }
 
+const FunctionRegistry::RegisteredFunction*
+FunctionRegistry::definition(const std::string& identifier) const
+{
+    auto iter = mMap.find(identifier);
+    if (iter != mMap.end()) return &(iter->second);
+    if (mDefinitions) return mDefinitions->definition(identifier);
+    return nullptr;
+}
+
 void FunctionRegistry::createAll(const FunctionOptions& op)
 {
+    // definitions in this registry take precedence over any shared definitions
+
+    for (const FunctionRegistry* registry = mDefinitions.get(); registry;
+        registry = registry->mDefinitions.get()) {
+        for (const auto& it : registry->mMap) {
+            mMap.emplace(std::piecewise_construct,
+                std::forward_as_tuple(it.first),
+                std::forward_as_tuple(it.second.constructor(), it.second.isInternal()));
+        }
+    }
+
     for (auto& it : mMap) it.second.create(op);
 }
 
@@ -151,19 +189,27 @@ void insertStandardFunctions(FunctionRegistry& registry)
     registry.insert("clamp", Clamp::create);
     registry.insert("cosh", Cosh::create);
     registry.insert("cross", CrossProd::create);
+    registry.insert("curlnoise", CurlNoise::create);
+    registry.insert("determinant", Determinant::create);
     registry.insert("dot", DotProd::create);
+    registry.insert("fbm", Fbm::create);
     registry.insert("fit", Fit::create);
+    registry.insert("inverse", Inverse::create);
     registry.insert("length", Length::create);
     registry.insert("lengthsq", LengthSq::create);
     registry.insert("max", Max::create);
     registry.insert("min", Min::create);
+    registry.insert("noise", Noise::create);
     registry.insert("normalize", Normalize::create);
     registry.insert("print", Print::create);
     registry.insert("rand", Rand::create);
     registry.insert("signbit", Signbit::create);
     registry.insert("sinh", Sinh::create);
+    registry.insert("snoise", SNoise::create);
     registry.insert("tan", Tan::create);
     registry.insert("tanh", Tanh::create);
+    registry.insert("transform", Transform::create);
+    registry.insert("transpose", Transpose::create);
 
     registry.insert("lookupf", LookupFloat::create);
     registry.insert("lookupvec3f", LookupVec3f::create);
@@ -182,6 +228,7 @@ void insertStandardFunctions(FunctionRegistry& registry)
     // registry.insert("strattribsize", StringAttribSize::create, true);
     registry.insert("getpointpws", GetPointPWS::create, true);
     registry.insert("setpointpws", SetPointPWS::create, true);
+    registry.insert("allocatescratch", AllocateScratch::create, true);
 
     // indirect internals
 
@@ -197,21 +244,41 @@ void insertStandardFunctions(FunctionRegistry& registry)
 
     registry.insert("getvoxel", GetVoxel::create, true);
     registry.insert("setvoxel", SetVoxel::create, true);
+    registry.insert("getvoxelbuffered", GetVoxelBuffered::create, true);
+    registry.insert("setvoxelbuffered", SetVoxelBuffered::create, true);
     registry.insert("getcoordx", GetCoordX::create);
     registry.insert("getcoordy", GetCoordY::create);
     registry.insert("getcoordz", GetCoordZ::create);
     registry.insert("getvoxelpws", GetVoxelPWS::create);
+
+    // volume stencil functions
+
+    registry.insert("curvature", Curvature::create);
+    registry.insert("gradient", Gradient::create);
+    registry.insert("laplacian", Laplacian::create);
+    registry.insert("sample_offset", SampleOffset::create);
 }
 
 } // anonymous namespace
 
-FunctionRegistry::UniquePtr createStandardRegistry(const FunctionOptions& op)
+FunctionRegistry::ConstPtr standardDefinitions()
 {
-    FunctionRegistry::UniquePtr registry(new FunctionRegistry);
+    // initialized once on first use, which is thread safe as of C++11
 
-    insertStandardFunctions(*registry);
-    if (!op.mLazyFunctions) registry->createAll(op);
+    static const FunctionRegistry::ConstPtr definitions =
+        []() -> FunctionRegistry::ConstPtr {
+            FunctionRegistry::Ptr registry(new FunctionRegistry);
+            insertStandardFunctions(*registry);
+            return registry;
+        }();
+
+    return definitions;
+}
 
+FunctionRegistry::UniquePtr createStandardRegistry(const FunctionOptions& op)
+{
+    FunctionRegistry::UniquePtr registry(new FunctionRegistry(standardDefinitions()));
+    if (!op.mLazyFunctions) registry->createAll(op);
     return registry;
 }
 
@@ -61,12 +61,19 @@ namespace codegen {
 ///         Functions can be inserted into the registry using insert() with a given
 ///         identifier and pointer to a function base.
 ///
+///         A registry may be constructed from a shared, immutable set of definitions,
+///         such as the process wide standard definitions. Functions are then only
+///         instantiated in the derived registry, which makes it cheap to create a
+///         registry for each compilation and allows the definitions to be used by
+///         multiple threads at once.
+///
 class FunctionRegistry
 {
 public:
 
     using ConstructorT = FunctionBase::Ptr(*)(const FunctionOptions&);
     using Ptr = std::shared_ptr<FunctionRegistry>;
+    using ConstPtr = std::shared_ptr<const FunctionRegistry>;
     using UniquePtr = std::unique_ptr<FunctionRegistry>;
 
     /// @brief An object to represent a registered function, storing its constructor,
@@ -96,6 +103,10 @@ public:
         ///
         inline bool isInternal() const { return mInternal; }
 
+        /// @brief Return the constructor of this function definition
+        ///
+        inline ConstructorT constructor() const { return mConstructor; }
+
     private:
         const ConstructorT mConstructor;
         FunctionBase::Ptr mFunction;
@@ -104,6 +115,19 @@ public:
 
     using RegistryMap = std::map<std::string, RegisteredFunction>;
 
+    /// @brief  Construct an empty registry
+    ///
+    FunctionRegistry() : mMap(), mDefinitions() {}
+
+    /// @brief  Construct a registry which is able to instantiate any function defined in
+    ///         another registry. The other registry is never modified and its definitions
+    ///         are not copied. Functions which it has already created are not shared.
+    ///
+    /// @param  definitions  The registry holding the function definitions
+    ///
+    explicit FunctionRegistry(const ConstPtr& definitions)
+        : mMap(), mDefinitions(definitions) {}
+
     /// @brief  Insert and register a function base object to a function identifier.
     /// @note   Throws if the identifier is already registered
     ///
@@ -149,29 +173,53 @@ public:
     FunctionBase::Ptr get(const std::string& identifier,
                           const bool allowInternalAccess) const;
 
-    /// @brief  Force creations of all function objects for all registered functions
+    /// @brief  Return the definition of a function identifier from this registry or, if it
+    ///         has not been inserted or instantiated, from the registry of definitions this
+    ///         registry was constructed from. Returns a nullptr if no such function exists.
+    ///
+    /// @param  identifier  The function identifier
+    ///
+    const RegisteredFunction* definition(const std::string& identifier) const;
+
+    /// @brief  Force creations of all function objects for all registered functions,
+    ///         including all shared definitions
     /// @param  op The current function options
     ///
     void createAll(const FunctionOptions& op);
 
-    /// @brief  Return a const reference to the current registry map
+    /// @brief  Return a const reference to the current registry map. This holds all
+    ///         functions inserted into this registry and any shared definitions which
+    ///         have been instantiated
     ///
     inline const RegistryMap& map() const { return mMap; }
 
+    /// @brief  Return the registry of shared definitions this registry was constructed
+    ///         from, or a nullptr if it holds all of its own definitions
+    ///
+    inline const ConstPtr& definitions() const { return mDefinitions; }
+
     /// @brief  Return whether or not the registry is empty
     ///
-    inline bool empty() const { return mMap.empty(); }
+    inline bool empty() const { return mMap.empty() && (!mDefinitions || mDefinitions->empty()); }
 
-    /// @brief  Clear the underlying function registry
+    /// @brief  Clear the underlying function registry. Shared definitions are released.
     ///
-    inline void clear() { mMap.clear(); }
+    inline void clear() { mMap.clear(); mDefinitions.reset(); }
 
 private:
     RegistryMap mMap;
+    ConstPtr mDefinitions;
 };
 
+/// @brief  Returns the process wide definitions of the standard set of registered functions,
+///         including math functions, point functions and volume functions. The definitions
+///         are created once and are never modified, so they can be shared between threads.
+///
+FunctionRegistry::ConstPtr standardDefinitions();
+
 /// @brief Creates a registry with the standard set of registered functions including math functions,
-///        point functions and volume functions
+///        point functions and volume functions. The returned registry is constructed from the
+///        shared standardDefinitions() so is cheap to create.
 /// @param The current function options
 ///
 FunctionRegistry::UniquePtr createStandardRegistry(const FunctionOptions& op);
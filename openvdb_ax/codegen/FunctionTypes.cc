@@ -121,7 +121,23 @@ FunctionSignatureBase::FunctionSignatureBase(void* const function,
                       const size_t outArgs)
     : mFunction(function)
     , mSymbolName(symbol)
-    , mOutputArguments(outArgs) {}
+    , mOutputArguments(outArgs)
+    , mTypesContext(nullptr)
+    , mReturnType(nullptr)
+    , mTypes() {}
+
+const std::vector<llvm::Type*>&
+FunctionSignatureBase::llvmTypes(llvm::LLVMContext& C, llvm::Type** returnType) const
+{
+    if (mTypesContext != &C) {
+        mTypes.clear();
+        mReturnType = this->toLLVMTypes(C, &mTypes);
+        mTypesContext = &C;
+    }
+
+    if (returnType) *returnType = mReturnType;
+    return mTypes;
+}
 
 FunctionSignatureBase::SignatureMatch
 FunctionSignatureBase::match(const std::vector<llvm::Type*>& types,
@@ -129,8 +145,7 @@ FunctionSignatureBase::match(const std::vector<llvm::Type*>& types,
 {
     if (!this->sizeMatch(types.size())) return SignatureMatch::None;
 
-    std::vector<llvm::Type*> current;
-    this->toLLVMTypes(C, &current);
+    const std::vector<llvm::Type*>& current = this->llvmTypes(C);
 
     if (this->explicitMatch(types, current)) {
         return SignatureMatch::Explicit;
@@ -153,9 +168,7 @@ FunctionSignatureBase::explicitMatch(const std::vector<llvm::Type*>& input, llvm
 {
     if (!this->sizeMatch(input.size())) return false;
 
-    std::vector<llvm::Type*> current;
-    this->toLLVMTypes(C, &current);
-    return explicitMatch(input, current);
+    return explicitMatch(input, this->llvmTypes(C));
 }
 
 bool
@@ -163,15 +176,15 @@ FunctionSignatureBase::implicitMatch(std::vector<llvm::Type*>& input, llvm::LLVM
 {
     if (!this->sizeMatch(input.size())) return false;
 
-    std::vector<llvm::Type*> current;
-    this->toLLVMTypes(C, &current);
-    return implicitMatch(input, current);
+    return implicitMatch(input, this->llvmTypes(C));
 }
 
 bool
 FunctionSignatureBase::hasReturnValue(llvm::LLVMContext& C) const
 {
-    return this->toLLVMTypes(C) != LLVMType<void>::get(C);
+    llvm::Type* returnType = nullptr;
+    this->llvmTypes(C, &returnType);
+    return returnType != LLVMType<void>::get(C);
 }
 
 void
@@ -180,8 +193,7 @@ FunctionSignatureBase::appendOutputArguments(std::vector<llvm::Value*>& values,
 {
     if (mOutputArguments == 0) return;
 
-    std::vector<llvm::Type*> current;
-    this->toLLVMTypes(builder.getContext(), &current);
+    const std::vector<llvm::Type*>& current = this->llvmTypes(builder.getContext());
 
     const size_t inputSize = current.size() - mOutputArguments;
     for (size_t i = inputSize; i < current.size(); ++i) {
@@ -197,7 +209,7 @@ FunctionSignatureBase::appendOutputArguments(std::vector<llvm::Value*>& values,
         }
 
         type = type->getContainedType(0);
-        values.emplace_back(builder.CreateAlloca(type));
+        values.emplace_back(insertStaticAlloca(builder, type));
     }
 }
 
@@ -207,8 +219,7 @@ FunctionSignatureBase::appendOutputTypes(std::vector<llvm::Type*>& types,
 {
     if (mOutputArguments == 0) return;
 
-    std::vector<llvm::Type*> current;
-    this->toLLVMTypes(C, &current);
+    const std::vector<llvm::Type*>& current = this->llvmTypes(C);
 
     const size_t inputSize = current.size() - mOutputArguments;
     for (size_t i = inputSize; i < current.size(); ++i) {
@@ -219,8 +230,8 @@ FunctionSignatureBase::appendOutputTypes(std::vector<llvm::Type*>& types,
 llvm::Function*
 FunctionSignatureBase::toLLVMFunction(llvm::Module& M) const
 {
-    std::vector<llvm::Type*> current;
-    llvm::Type* returnT = this->toLLVMTypes(M.getContext(), &current);
+    llvm::Type* returnT = nullptr;
+    const std::vector<llvm::Type*>& current = this->llvmTypes(M.getContext(), &returnT);
 
     llvm::FunctionType* functionType =
         llvm::FunctionType::get(/*Result=*/returnT,
@@ -331,6 +342,28 @@ FunctionBase::FunctionMatch
 FunctionBase::match(const std::vector<llvm::Type*>& types,
       llvm::LLVMContext& C,
       const bool addOutputArguments) const
+{
+    // cached matches are only valid for a single context
+
+    if (mMatchContext != &C) {
+        mMatches.clear();
+        mMatchContext = &C;
+    }
+
+    auto key = std::make_pair(addOutputArguments, types);
+    auto iter = mMatches.find(key);
+    if (iter != mMatches.end()) return iter->second;
+
+    const FunctionBase::FunctionMatch result =
+        this->findMatch(types, C, addOutputArguments);
+    mMatches.emplace(std::move(key), result);
+    return result;
+}
+
+FunctionBase::FunctionMatch
+FunctionBase::findMatch(const std::vector<llvm::Type*>& types,
+      llvm::LLVMContext& C,
+      const bool addOutputArguments) const
 {
     FunctionSignatureBase::SignatureMatch match =
         FunctionSignatureBase::SignatureMatch::None;
@@ -418,8 +451,7 @@ FunctionBase::execute(const std::vector<llvm::Value*>& args,
 
     if (match == FunctionSignatureBase::SignatureMatch::Implicit) {
 
-        std::vector<llvm::Type*> targetTypes;
-        targetFunction->toLLVMTypes(C, &targetTypes);
+        const std::vector<llvm::Type*>& targetTypes = targetFunction->llvmTypes(C);
 
         for (size_t i = 0; i < input.size(); ++i) {
             if (isScalarType(input[i]->getType())) {
@@ -442,7 +474,12 @@ FunctionBase::execute(const std::vector<llvm::Value*>& args,
 
         llvm::Value* result = nullptr;
         if (targetFunction->functionPointer()) {
-            result = builder.CreateCall(targetFunction->toLLVMFunction(M), input);
+            llvm::Function* function = targetFunction->toLLVMFunction(M);
+            if (this->readNone()) {
+                function->setDoesNotAccessMemory();
+                function->setDoesNotThrow();
+            }
+            result = builder.CreateCall(function, input);
         }
         else {
             result = this->generate(input, globals, builder, M);
@@ -460,10 +497,12 @@ FunctionBase::execute(const std::vector<llvm::Value*>& args,
         }
 
         // @todo  To implicit cast wrong return types?
-        if (result->getType() != targetFunction->toLLVMTypes(C)) {
+        llvm::Type* returnType = nullptr;
+        targetFunction->llvmTypes(C, &returnType);
+        if (result->getType() != returnType) {
             std::string type, expected;
             llvmTypeToString(result->getType(), type);
-            llvmTypeToString(targetFunction->toLLVMTypes(C), expected);
+            llvmTypeToString(returnType, expected);
 
             OPENVDB_THROW(LLVMFunctionError, "Function \"" + this->identifier() +
                 "\" has been invoked with a mismatching return type. Expected: \"" +
@@ -47,10 +47,12 @@
 #include <llvm/IR/Module.h>
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <stack>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace openvdb {
@@ -109,6 +111,10 @@ using StringPtrType = const uint8_t* const;
 using V3D = ArgType<double, 3>;
 using V3F = ArgType<float, 3>;
 using V3I = ArgType<int, 3>;
+using M3D = ArgType<double, 9>;
+using M3F = ArgType<float, 9>;
+using M4D = ArgType<double, 16>;
+using M4F = ArgType<float, 16>;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -229,6 +235,16 @@ struct FunctionSignatureBase
     virtual llvm::Type*
     toLLVMTypes(llvm::LLVMContext& C, std::vector<llvm::Type*>* types = nullptr) const = 0;
 
+    /// @brief  Returns the llvm types of the function arguments and optionally the function
+    ///         return type. Unlike toLLVMTypes, these are only built once for each llvm
+    ///         context and are then cached on the signature.
+    ///
+    /// @param  C           The llvm context
+    /// @param  returnType  An optional llvm type to set to the function return type
+    ///
+    const std::vector<llvm::Type*>&
+    llvmTypes(llvm::LLVMContext& C, llvm::Type** returnType = nullptr) const;
+
     /// @brief  Returns the pointer to the globally accessible function. Note that
     ///         This can be null if the function is entirely IR based
     ///
@@ -377,6 +393,14 @@ protected:
     void* const mFunction;
     const std::string mSymbolName;
     const size_t mOutputArguments;
+
+private:
+    // cached results of toLLVMTypes for the last context used. Functions are created by
+    // the registry of a single compilation, so are destroyed before its context is and
+    // the address of a context is not reused while its types are cached
+    mutable llvm::LLVMContext* mTypesContext;
+    mutable llvm::Type* mReturnType;
+    mutable std::vector<llvm::Type*> mTypes;
 };
 
 /// @brief  The base definition for a single function type.
@@ -424,10 +448,20 @@ struct FunctionBase
     ///
     inline virtual void getDocumentation(std::string& doc) const {}
 
+    /// @brief  Returns true if the external implementations of this function neither read
+    ///         nor write memory and do not throw. Calls to them are marked as such, which
+    ///         allows llvm to hoist, remove and vectorize them like intrinsics.
+    ///
+    inline virtual bool readNone() const { return false; }
+
     /// @brief  Given a vector of llvm types, automatically returns the best possible
     ///         function signature pointer and match type.
     /// @note   The vector of provided llvm types does not need to contain the possible
     ///         output arguments if addOutputArguments is false.
+    /// @note   Results are cached for each set of argument types in the given llvm context.
+    ///         Function objects are instantiated for each compilation by the function
+    ///         registry, so this cache only lives as long as a single compilation and must
+    ///         not be accessed by multiple threads at once.
     ///
     /// @param types  A vector of llvm types representing the function argument types
     /// @param C      The llvm context
@@ -490,8 +524,22 @@ protected:
     /// @param  A vector of function signatures corresponding to this function type
     ///
     FunctionBase(const FunctionList& list)
-        : mFunctionList(list) {}
+        : mFunctionList(list), mMatchContext(nullptr), mMatches() {}
     const FunctionList mFunctionList;
+
+private:
+
+    /// @brief  Performs the signature matching for match() without using the cache
+    ///
+    FunctionMatch
+    findMatch(const std::vector<llvm::Type*>& types,
+          llvm::LLVMContext& C,
+          const bool addOutputArguments) const;
+
+    // cached results of match for the last context used, keyed on whether output
+    // arguments were added and the argument types. See FunctionSignatureBase::mTypes
+    mutable llvm::LLVMContext* mMatchContext;
+    mutable std::map<std::pair<bool, std::vector<llvm::Type*>>, FunctionMatch> mMatches;
 };
 
 
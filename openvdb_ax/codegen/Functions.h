@@ -68,21 +68,14 @@ namespace codegen {
     inline const std::string identifier() const override final { return std::string(Identifier); } \
     inline void getDocumentation(std::string& doc) const override final { doc = Documentation; }
 
-// LLVM Intrinsics which work on FP types
+// LLVM Intrinsics which work on FP types. These are always generated as intrinsics rather
+// than external calls so that llvm is free to constant fold, hoist and vectorize them
 
-#define DEFINE_LLVM_FP_INTRINSIC(ClassName, Identifier, ASTToken, LLVMToken, STDFunc, Doc) \
+#define DEFINE_LLVM_FP_INTRINSIC(ClassName, Identifier, ASTToken, LLVMToken, Doc) \
     struct ClassName : public FunctionBase { \
         DEFINE_IDENTIFIER_CONTEXT_DOC(Identifier, FunctionBase::All, Doc) \
-        inline static Ptr create(const FunctionOptions& op) { \
-            return Ptr(op.mPrioritiseFunctionIR ? new ClassName(PrioritiseIRGeneration()) : new ClassName()); \
-        }\
+        inline static Ptr create(const FunctionOptions&) { return Ptr(new ClassName()); } \
         ClassName() : FunctionBase({ \
-                FunctionSignature<double(double)>::create\
-                    ((double(*)(double))(STDFunc), std::string(#STDFunc"d"), 0), \
-                FunctionSignature<float(float)>::create\
-                    ((float(*)(float))(STDFunc), std::string(#STDFunc"f"), 0) \
-            }) {} \
-        ClassName(const PrioritiseIRGeneration&) : FunctionBase({ \
                 FunctionSignature<double(double)>::create\
                     (nullptr, std::string(#Identifier"d"), 0), \
                 FunctionSignature<float(float)>::create\
@@ -97,29 +90,29 @@ namespace codegen {
             return builder.CreateCall(function, args); \
         } \
     };
-DEFINE_LLVM_FP_INTRINSIC(Sqrt, "sqrt", ast::tokens::SQRT, llvm::Intrinsic::sqrt, std::sqrt,
+DEFINE_LLVM_FP_INTRINSIC(Sqrt, "sqrt", ast::tokens::SQRT, llvm::Intrinsic::sqrt,
     "Computes the square root of arg.");
-DEFINE_LLVM_FP_INTRINSIC(Sin, "sin", ast::tokens::SIN, llvm::Intrinsic::sin, std::sin,
+DEFINE_LLVM_FP_INTRINSIC(Sin, "sin", ast::tokens::SIN, llvm::Intrinsic::sin,
     "Computes the sine of arg (measured in radians).");
-DEFINE_LLVM_FP_INTRINSIC(Cos, "cos", ast::tokens::COS, llvm::Intrinsic::cos, std::cos,
+DEFINE_LLVM_FP_INTRINSIC(Cos, "cos", ast::tokens::COS, llvm::Intrinsic::cos,
     "Computes the cosine of arg (measured in radians).");
-DEFINE_LLVM_FP_INTRINSIC(Log, "log", ast::tokens::LOG, llvm::Intrinsic::log, std::log,
+DEFINE_LLVM_FP_INTRINSIC(Log, "log", ast::tokens::LOG, llvm::Intrinsic::log,
     "Computes the natural (base e) logarithm of arg.");
-DEFINE_LLVM_FP_INTRINSIC(Log10, "log10", ast::tokens::LOG10, llvm::Intrinsic::log10, std::log10,
+DEFINE_LLVM_FP_INTRINSIC(Log10, "log10", ast::tokens::LOG10, llvm::Intrinsic::log10,
     "Computes the common (base-10) logarithm of arg.");
-DEFINE_LLVM_FP_INTRINSIC(Log2, "log2", ast::tokens::LOG2, llvm::Intrinsic::log2, std::log2,
+DEFINE_LLVM_FP_INTRINSIC(Log2, "log2", ast::tokens::LOG2, llvm::Intrinsic::log2,
     "Computes the binary (base-2) logarithm of arg.");
-DEFINE_LLVM_FP_INTRINSIC(Exp, "exp", ast::tokens::EXP, llvm::Intrinsic::exp, std::exp,
+DEFINE_LLVM_FP_INTRINSIC(Exp, "exp", ast::tokens::EXP, llvm::Intrinsic::exp,
     "Computes e (Euler's number, 2.7182818...) raised to the given power arg.");
-DEFINE_LLVM_FP_INTRINSIC(Exp2, "exp2", ast::tokens::EXP2, llvm::Intrinsic::exp2, std::exp2,
+DEFINE_LLVM_FP_INTRINSIC(Exp2, "exp2", ast::tokens::EXP2, llvm::Intrinsic::exp2,
     "Computes 2 raised to the given power arg.");
-DEFINE_LLVM_FP_INTRINSIC(Fabs, "fabs", ast::tokens::FABS, llvm::Intrinsic::fabs, std::fabs,
+DEFINE_LLVM_FP_INTRINSIC(Fabs, "fabs", ast::tokens::FABS, llvm::Intrinsic::fabs,
     "Computes the absolute value of a floating point value arg.");
-DEFINE_LLVM_FP_INTRINSIC(Floor, "floor", ast::tokens::FLOOR, llvm::Intrinsic::floor, std::floor,
+DEFINE_LLVM_FP_INTRINSIC(Floor, "floor", ast::tokens::FLOOR, llvm::Intrinsic::floor,
     "Computes the largest integer value not greater than arg.");
-DEFINE_LLVM_FP_INTRINSIC(Ceil, "ceil", ast::tokens::CEIL, llvm::Intrinsic::ceil, std::ceil,
+DEFINE_LLVM_FP_INTRINSIC(Ceil, "ceil", ast::tokens::CEIL, llvm::Intrinsic::ceil,
     "Computes the smallest integer value not less than arg.");
-DEFINE_LLVM_FP_INTRINSIC(Round, "round", ast::tokens::ROUND, llvm::Intrinsic::round, std::round,
+DEFINE_LLVM_FP_INTRINSIC(Round, "round", ast::tokens::ROUND, llvm::Intrinsic::round,
     "Computes the nearest integer value to arg (in floating-point format), rounding halfway cases away "
     "from zero.");
 
@@ -173,10 +166,11 @@ struct Acos : public FunctionBase
         "Computes the principal value of the arc cosine of the input.")
 
     inline static Ptr create(const FunctionOptions&) { return Ptr(new Acos()); }
+    inline bool readNone() const override { return true; }
 
     Acos() : FunctionBase({
         FunctionSignature<double(double)>::create
-            ((double(*)(double))(std::acos), std::string("acosd")),
+            ((double(*)(double))(std::acos), std::string("acos")),
         FunctionSignature<float(float)>::create
             ((float(*)(float))(std::acos), std::string("acosf"))
     }) {}
@@ -188,10 +182,11 @@ struct Asin : public FunctionBase
         "Computes the principal value of the arc sine of the input.")
 
     inline static Ptr create(const FunctionOptions&) { return Ptr(new Asin()); }
+    inline bool readNone() const override { return true; }
 
     Asin() : FunctionBase({
         FunctionSignature<double(double)>::create
-            ((double(*)(double))(std::asin), std::string("asind")),
+            ((double(*)(double))(std::asin), std::string("asin")),
         FunctionSignature<float(float)>::create
             ((float(*)(float))(std::asin), std::string("asinf"))
     }) {}
@@ -203,10 +198,11 @@ struct Atan : public FunctionBase
         "Computes the principal value of the arc tangent of the input.")
 
     inline static Ptr create(const FunctionOptions&) { return Ptr(new Atan()); }
+    inline bool readNone() const override { return true; }
 
     Atan() : FunctionBase({
         FunctionSignature<double(double)>::create
-            ((double(*)(double))(std::atan), std::string("atand")),
+            ((double(*)(double))(std::atan), std::string("atan")),
         FunctionSignature<float(float)>::create
             ((float(*)(float))(std::atan), std::string("atanf"))
     }) {}
@@ -219,10 +215,11 @@ struct Atan2 : public FunctionBase
         "the correct quadrant.")
 
     inline static Ptr create(const FunctionOptions&) { return Ptr(new Atan2()); }
+    inline bool readNone() const override { return true; }
 
     Atan2() : FunctionBase({
         FunctionSignature<double(double,double)>::create
-            ((double(*)(double,double))(std::atan2), std::string("atan2d")),
+            ((double(*)(double,double))(std::atan2), std::string("atan2")),
         FunctionSignature<float(float,float)>::create
             ((float(*)(float,float))(std::atan2), std::string("atan2f"))
     }) {}
@@ -234,10 +231,11 @@ struct Cbrt : public FunctionBase
         "Computes the cubic root of the input.")
 
     inline static Ptr create(const FunctionOptions&) { return Ptr(new Cbrt()); }
+    inline bool readNone() const override { return true; }
 
     Cbrt() : FunctionBase({
         FunctionSignature<double(double)>::create
-            ((double(*)(double))(std::cbrt), std::string("cbrtd")),
+            ((double(*)(double))(std::cbrt), std::string("cbrt")),
         FunctionSignature<float(float)>::create
             ((float(*)(float))(std::cbrt), std::string("cbrtf"))
     }) {}
@@ -249,10 +247,11 @@ struct Sinh : public FunctionBase
         "Computes the hyperbolic sine of the input")
 
     inline static Ptr create(const FunctionOptions&) { return Ptr(new Sinh()); }
+    inline bool readNone() const override { return true; }
 
     Sinh() : FunctionBase({
         FunctionSignature<double(double)>::create
-            ((double(*)(double))(std::sinh), std::string("sinhd")),
+            ((double(*)(double))(std::sinh), std::string("sinh")),
         FunctionSignature<float(float)>::create
             ((float(*)(float))(std::sinh), std::string("sinhf"))
     }) {}
@@ -264,10 +263,11 @@ struct Cosh : public FunctionBase
         "Computes the hyperbolic cosine of the input")
 
     inline static Ptr create(const FunctionOptions&) { return Ptr(new Cosh()); }
+    inline bool readNone() const override { return true; }
 
     Cosh() : FunctionBase({
         FunctionSignature<double(double)>::create
-            ((double(*)(double))(std::cosh), std::string("coshd")),
+            ((double(*)(double))(std::cosh), std::string("cosh")),
         FunctionSignature<float(float)>::create
             ((float(*)(float))(std::cosh), std::string("coshf"))
     }) {}
@@ -279,10 +279,11 @@ struct Tanh : public FunctionBase
         "Computes the hyperbolic tangent of the input")
 
     inline static Ptr create(const FunctionOptions&) { return Ptr(new Tanh()); }
+    inline bool readNone() const override { return true; }
 
     Tanh() : FunctionBase({
         FunctionSignature<double(double)>::create
-            ((double(*)(double))(std::tanh), std::string("tanhd")),
+            ((double(*)(double))(std::tanh), std::string("tanh")),
         FunctionSignature<float(float)>::create
             ((float(*)(float))(std::tanh), std::string("tanhf"))
     }) {}
@@ -294,13 +295,54 @@ struct Rand : public FunctionBase
         "Creates a random number based on the provided seed. The number will be "
         "in the range of 0 to 1. The same number is produced for the same seed.")
 
-    inline static Ptr create(const FunctionOptions&) { return Ptr(new Rand()); }
+    inline static Ptr create(const FunctionOptions& op) {
+        return Ptr(op.mLegacyRand ? new Rand() : new Rand(PrioritiseIRGeneration()));
+    }
 
     Rand() : FunctionBase({
             DECLARE_FUNCTION_SIGNATURE(rand_double),
             DECLARE_FUNCTION_SIGNATURE(rand_int)
     }) {}
 
+    Rand(const PrioritiseIRGeneration&) : FunctionBase({
+            FunctionSignature<double(double)>::create
+                (nullptr, std::string("randd")),
+            FunctionSignature<double(int32_t)>::create
+                (nullptr, std::string("randi"))
+    }) {}
+
+    /// @brief  Generates a stateless counter based random number from the seed using the
+    ///         SplitMix64 finalizer. Integer seeds are hashed as their double equivalent so
+    ///         that rand(1) == rand(1.0).
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final
+    {
+        llvm::Type* doubleT = LLVMType<double>::get(builder.getContext());
+        llvm::Type* longT = LLVMType<int64_t>::get(builder.getContext());
+
+        llvm::Value* seed = arithmeticConversion(args[0], doubleT, builder);
+
+        // adding positive zero converts -0.0 to 0.0, so that both produce the same number
+
+        seed = builder.CreateFAdd(seed, llvm::ConstantFP::get(doubleT, 0.0));
+
+        llvm::Value* z = builder.CreateBitCast(seed, longT);
+        z = builder.CreateAdd(z, builder.getInt64(0x9E3779B97F4A7C15ULL));
+        z = builder.CreateXor(z, builder.CreateLShr(z, 30));
+        z = builder.CreateMul(z, builder.getInt64(0xBF58476D1CE4E5B9ULL));
+        z = builder.CreateXor(z, builder.CreateLShr(z, 27));
+        z = builder.CreateMul(z, builder.getInt64(0x94D049BB133111EBULL));
+        z = builder.CreateXor(z, builder.CreateLShr(z, 31));
+
+        // the top 53 bits are scaled into a double in the range [0,1)
+
+        llvm::Value* result = builder.CreateUIToFP(builder.CreateLShr(z, 11), doubleT);
+        return builder.CreateFMul(result, llvm::ConstantFP::get(doubleT, 1.0 / 9007199254740992.0));
+    }
+
 private:
 
     static double rand_double(double seed);
@@ -626,9 +668,11 @@ struct Tan : public FunctionBase
         return Ptr(op.mPrioritiseFunctionIR ? new Tan(PrioritiseIRGeneration()) : new Tan());
     }
 
+    inline bool readNone() const override { return true; }
+
     Tan() : FunctionBase({
         FunctionSignature<double(double)>::create
-            ((double(*)(double))(std::tan), std::string("tand")),
+            ((double(*)(double))(std::tan), std::string("tan")),
         FunctionSignature<float(float)>::create
             ((float(*)(float))(std::tan), std::string("tanf")),
         FunctionSignature<double(int32_t)>::create
@@ -666,23 +710,36 @@ struct LengthSq : public FunctionBase
         "Returns the squared length of the given vector")
 
     inline static Ptr create(const FunctionOptions& op) {
-        return Ptr(op.mPrioritiseFunctionIR ? new LengthSq(PrioritiseIRGeneration()) : new LengthSq());
+        return Ptr((op.mPrioritiseFunctionIR || op.mNativeVectors) ?
+            new LengthSq(PrioritiseIRGeneration(), op.mNativeVectors) : new LengthSq());
     }
 
     LengthSq() : FunctionBase({
         DECLARE_FUNCTION_SIGNATURE(LengthSq::lensq<double>),
         DECLARE_FUNCTION_SIGNATURE(LengthSq::lensq<float>),
         DECLARE_FUNCTION_SIGNATURE(LengthSq::lensq<int32_t>)
-    }) {}
+    }), mNativeVectors(false) {}
 
-    LengthSq(const PrioritiseIRGeneration&) : FunctionBase({
+    LengthSq(const PrioritiseIRGeneration&, const bool nativeVectors = false) : FunctionBase({
             FunctionSignature<double(double (*)[3])>::create
                 (nullptr, std::string("lensqd")),
             FunctionSignature<float(float (*)[3])>::create
                 (nullptr, std::string("lensqf")),
             FunctionSignature<int32_t(int32_t (*)[3])>::create
                 (nullptr, std::string("lensqi"))
-        }) {}
+        }), mNativeVectors(nativeVectors) {}
+
+    /// @brief  Vectorized version of doGenerate. The input array is loaded as a single
+    ///         llvm vector which is returned through vector.
+    inline static llvm::Value*
+    doGenerateVector(llvm::Value* ptrToVector,
+                     llvm::Value*& vector,
+                     llvm::IRBuilder<>& builder)
+    {
+        vector = arrayToVector(ptrToVector, builder);
+        llvm::Value* squared = binaryOperator(vector, vector, ast::tokens::MULTIPLY, builder);
+        return vectorSum(squared, builder);
+    }
 
     inline static llvm::Value*
     doGenerate(llvm::Value* ptrToVector,
@@ -705,11 +762,18 @@ struct LengthSq : public FunctionBase
          llvm::IRBuilder<>& builder,
          llvm::Module& M) const override final
     {
+        if (mNativeVectors) {
+            llvm::Value* vector = nullptr;
+            return doGenerateVector(args[0], vector, builder);
+        }
+
         std::vector<llvm::Value*> elements;
         return doGenerate(args[0], elements, builder);
     }
 
 private:
+    const bool mNativeVectors;
+
     template <typename T>
     inline static T lensq(T (*in)[3]) {
         return openvdb::math::Vec3<T>(in[0]).lengthSqr();
@@ -722,23 +786,24 @@ struct Length : public FunctionBase
         "Returns the length of the given vector")
 
     inline static Ptr create(const FunctionOptions& op) {
-        return Ptr(op.mPrioritiseFunctionIR ? new Length(PrioritiseIRGeneration()) : new Length());
+        return Ptr((op.mPrioritiseFunctionIR || op.mNativeVectors) ?
+            new Length(PrioritiseIRGeneration(), op.mNativeVectors) : new Length());
     }
 
     Length() : FunctionBase({
         DECLARE_FUNCTION_SIGNATURE(Length::length<double>),
         DECLARE_FUNCTION_SIGNATURE(Length::length<float>)
-    }) {}
+    }), mNativeVectors(false) {}
 
     // @note  allow explicit int signature for initial length computing optimization
-    Length(const PrioritiseIRGeneration&) : FunctionBase({
+    Length(const PrioritiseIRGeneration&, const bool nativeVectors = false) : FunctionBase({
             FunctionSignature<double(double (*)[3])>::create
                 (nullptr, std::string("lengthd")),
             FunctionSignature<float(float (*)[3])>::create
                 (nullptr, std::string("lengthf")),
             FunctionSignature<float(int32_t (*)[3])>::create
                 (nullptr, std::string("lengthi"))
-        }) {}
+        }), mNativeVectors(nativeVectors) {}
 
     inline static llvm::Value*
     doGenerate(llvm::Value* ptrToVector,
@@ -747,15 +812,19 @@ struct Length : public FunctionBase
            llvm::Module& M)
     {
         llvm::Value* result = LengthSq::doGenerate(ptrToVector, elements, builder);
+        return doGenerateSqrt(result, builder, M);
+    }
 
-        llvm::Type* floatT = LLVMType<float>::get(builder.getContext());
-        if (result->getType()->isIntegerTy()) {
-           result = arithmeticConversion(result, floatT, builder);
-        }
-
-        llvm::Function* sqrt =
-            llvm::Intrinsic::getDeclaration(&M, llvm::Intrinsic::sqrt, result->getType());
-        return builder.CreateCall(sqrt, result, "lengthsqrt");
+    /// @brief  Vectorized version of doGenerate. The input array is loaded as a single
+    ///         llvm vector which is returned through vector.
+    inline static llvm::Value*
+    doGenerateVector(llvm::Value* ptrToVector,
+           llvm::Value*& vector,
+           llvm::IRBuilder<>& builder,
+           llvm::Module& M)
+    {
+        llvm::Value* result = LengthSq::doGenerateVector(ptrToVector, vector, builder);
+        return doGenerateSqrt(result, builder, M);
     }
 
     llvm::Value*
@@ -764,11 +833,33 @@ struct Length : public FunctionBase
          llvm::IRBuilder<>& builder,
          llvm::Module& M) const override final
     {
+        if (mNativeVectors) {
+            llvm::Value* vector = nullptr;
+            return doGenerateVector(args[0], vector, builder, M);
+        }
+
         std::vector<llvm::Value*> elements;
         return doGenerate(args[0], elements, builder, M);
     }
 
 private:
+    inline static llvm::Value*
+    doGenerateSqrt(llvm::Value* result,
+           llvm::IRBuilder<>& builder,
+           llvm::Module& M)
+    {
+        llvm::Type* floatT = LLVMType<float>::get(builder.getContext());
+        if (result->getType()->isIntegerTy()) {
+           result = arithmeticConversion(result, floatT, builder);
+        }
+
+        llvm::Function* sqrt =
+            llvm::Intrinsic::getDeclaration(&M, llvm::Intrinsic::sqrt, result->getType());
+        return builder.CreateCall(sqrt, result, "lengthsqrt");
+    }
+
+    const bool mNativeVectors;
+
     template <typename T>
     inline static T length(T (*in)[3]) {
         return openvdb::math::Vec3<T>(in[0]).length();
@@ -799,7 +890,8 @@ struct Normalize : public FunctionBase
         "Returns the normalized result of the given vector.")
 
     inline static Ptr create(const FunctionOptions& op) {
-        return Ptr(op.mPrioritiseFunctionIR ? new Normalize(PrioritiseIRGeneration()) : new Normalize());
+        return Ptr((op.mPrioritiseFunctionIR || op.mNativeVectors) ?
+            new Normalize(PrioritiseIRGeneration(), op.mNativeVectors) : new Normalize());
     }
 
     Normalize() : FunctionBase({
@@ -807,17 +899,17 @@ struct Normalize : public FunctionBase
             (nullptr, std::string("normalized"), 0),
         FunctionSignature<V3F*(V3F*)>::create
             (nullptr, std::string("normalizef"), 0)
-    }), mExternalCall(true) {}
+    }), mExternalCall(true), mNativeVectors(false) {}
 
     // @note  allow explicit int signature for initial length computing optimization
-    Normalize(const PrioritiseIRGeneration&) : FunctionBase({
+    Normalize(const PrioritiseIRGeneration&, const bool nativeVectors = false) : FunctionBase({
         FunctionSignature<V3D*(V3D*)>::create
             (nullptr, std::string("normalized"), 0),
         FunctionSignature<V3F*(V3F*)>::create
             (nullptr, std::string("normalizef"), 0),
         FunctionSignature<V3I*(V3I*)>::create
             (nullptr, std::string("normalizei"), 0)
-    }), mExternalCall(false) {}
+    }), mExternalCall(false), mNativeVectors(nativeVectors) {}
 
     inline void getDependencies(std::vector<std::string>& identifiers) const override {
         if (mExternalCall) identifiers.emplace_back("internal_normalize");
@@ -838,6 +930,21 @@ struct Normalize : public FunctionBase
             assert(!results.empty());
             result = results.front();
         }
+        else if (mNativeVectors) {
+            llvm::Value* vector = nullptr;
+            llvm::Value* lSq = Length::doGenerateVector(args.front(), vector, builder, M);
+
+            // the following is always done at fp precision
+
+            vector = vectorConversion(vector, lSq->getType(), builder);
+
+            llvm::Value* one = llvm::ConstantFP::get(lSq->getType(), 1.0);
+            llvm::Value* oneDividedByLength = builder.CreateFDiv(one, lSq);
+            oneDividedByLength = builder.CreateVectorSplat(
+                vector->getType()->getVectorNumElements(), oneDividedByLength);
+
+            result = vectorToArray(builder.CreateFMul(vector, oneDividedByLength), builder);
+        }
         else {
             std::vector<llvm::Value*> elements;
             llvm::Value* lSq = Length::doGenerate(args.front(), elements, builder, M);
@@ -867,6 +974,7 @@ struct Normalize : public FunctionBase
 
 private:
     const bool mExternalCall;
+    const bool mNativeVectors;
 };
 
 struct DotProd : public FunctionBase
@@ -875,23 +983,24 @@ struct DotProd : public FunctionBase
         "Computes the dot product of two vectors")
 
     inline static Ptr create(const FunctionOptions& op) {
-        return Ptr(op.mPrioritiseFunctionIR ? new DotProd(PrioritiseIRGeneration()) : new DotProd());
+        return Ptr((op.mPrioritiseFunctionIR || op.mNativeVectors) ?
+            new DotProd(PrioritiseIRGeneration(), op.mNativeVectors) : new DotProd());
     }
 
     DotProd() : FunctionBase({
         DECLARE_FUNCTION_SIGNATURE(dot<double>),
         DECLARE_FUNCTION_SIGNATURE(dot<float>),
         DECLARE_FUNCTION_SIGNATURE(dot<int32_t>)
-    }) {}
+    }), mNativeVectors(false) {}
 
-    DotProd(const PrioritiseIRGeneration&) : FunctionBase({
+    DotProd(const PrioritiseIRGeneration&, const bool nativeVectors = false) : FunctionBase({
         FunctionSignature<double(double (*)[3], double (*)[3])>::create
             (nullptr, std::string("dotprodd")),
         FunctionSignature<float(float (*)[3], float (*)[3])>::create
             (nullptr, std::string("dotprodf")),
         FunctionSignature<int32_t(int32_t (*)[3], int32_t (*)[3])>::create
             (nullptr, std::string("dotprodi"))
-    }) {}
+    }), mNativeVectors(nativeVectors) {}
 
     llvm::Value*
     generate(const std::vector<llvm::Value*>& args,
@@ -899,6 +1008,12 @@ struct DotProd : public FunctionBase
          llvm::IRBuilder<>& builder,
          llvm::Module& M) const override final
     {
+        if (mNativeVectors) {
+            llvm::Value* v1 = arrayToVector(args[0], builder);
+            llvm::Value* v2 = arrayToVector(args[1], builder);
+            return vectorSum(binaryOperator(v1, v2, ast::tokens::MULTIPLY, builder), builder);
+        }
+
         std::vector<llvm::Value*> v1, v2;
         arrayUnpack(args[0], v1, builder, /*load*/true);
         arrayUnpack(args[1], v2, builder, /*load*/true);
@@ -913,6 +1028,8 @@ struct DotProd : public FunctionBase
         return result;
     }
 private:
+    const bool mNativeVectors;
+
     template <typename T>
     inline static T dot(T (*in1)[3], T (*in2)[3]) {
         const openvdb::math::Vec3<T> inv1(*in1);
@@ -947,19 +1064,43 @@ struct CrossProd : public FunctionBase
     DEFINE_IDENTIFIER_CONTEXT_DOC("cross", FunctionBase::All,
         "Computes the cross product of two vectors")
 
-    inline static Ptr create(const FunctionOptions&) { return Ptr(new CrossProd()); }
+    inline static Ptr create(const FunctionOptions& op) {
+        return Ptr(new CrossProd(op.mNativeVectors));
+    }
 
-    CrossProd() : FunctionBase({
+    CrossProd(const bool nativeVectors = false) : FunctionBase({
         FunctionSignature<V3D*(V3D*,V3D*)>::create
             (nullptr, std::string("crossprodd"), 0),
         FunctionSignature<V3F*(V3F*,V3F*)>::create
             (nullptr, std::string("crossprodf"), 0),
         FunctionSignature<V3I*(V3I*,V3I*)>::create
             (nullptr, std::string("crossprodi"), 0)
-    }) {}
+    }), mNativeVectors(nativeVectors) {}
 
     inline void getDependencies(std::vector<std::string>& identifiers) const override {
-        identifiers.emplace_back("internal_cross");
+        if (!mNativeVectors) identifiers.emplace_back("internal_cross");
+    }
+
+    /// @brief  Computes the cross product of two loaded llvm vectors of 3 elements,
+    ///         returning the result as a llvm vector
+    inline static llvm::Value*
+    doGenerateVector(llvm::Value* a,
+                     llvm::Value* b,
+                     llvm::IRBuilder<>& builder)
+    {
+        // a x b = a.yzx * b.zxy - a.zxy * b.yzx
+
+        const std::vector<uint32_t> yzx { 1, 2, 0 };
+        const std::vector<uint32_t> zxy { 2, 0, 1 };
+
+        llvm::Value* ayzx = builder.CreateShuffleVector(a, a, yzx);
+        llvm::Value* azxy = builder.CreateShuffleVector(a, a, zxy);
+        llvm::Value* byzx = builder.CreateShuffleVector(b, b, yzx);
+        llvm::Value* bzxy = builder.CreateShuffleVector(b, b, zxy);
+
+        llvm::Value* lhs = binaryOperator(ayzx, bzxy, ast::tokens::MULTIPLY, builder);
+        llvm::Value* rhs = binaryOperator(azxy, byzx, ast::tokens::MULTIPLY, builder);
+        return binaryOperator(lhs, rhs, ast::tokens::MINUS, builder);
     }
 
     llvm::Value*
@@ -968,6 +1109,12 @@ struct CrossProd : public FunctionBase
          llvm::IRBuilder<>& builder,
          llvm::Module& M) const override final {
 
+        if (mNativeVectors) {
+            llvm::Value* a = arrayToVector(args[0], builder);
+            llvm::Value* b = arrayToVector(args[1], builder);
+            return vectorToArray(doGenerateVector(a, b, builder), builder);
+        }
+
         std::vector<llvm::Value*> results;
         Internal func;
         func.execute(args, globals, builder, M, &results);
@@ -975,6 +1122,788 @@ struct CrossProd : public FunctionBase
 
         return results.front();
     }
+
+private:
+    const bool mNativeVectors;
+};
+
+// Matrix functions. Matrices are stored as row major arrays of 9 or 16 elements and are
+// always loaded as a single llvm vector so that their rows can be processed with
+// shuffles and vector arithmetic
+
+/// @brief  Returns a llvm vector of the given type with the element values provided
+inline llvm::Value*
+llvmConstantVector(const std::vector<double>& values,
+                   llvm::Type* elementType)
+{
+    std::vector<llvm::Constant*> constants;
+    constants.reserve(values.size());
+    for (const double value : values) {
+        constants.emplace_back(llvm::ConstantFP::get(elementType, value));
+    }
+    return llvm::ConstantVector::get(constants);
+}
+
+struct Transform : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("transform", FunctionBase::All,
+        "Transforms a vector by a 3x3 or 4x4 matrix, treating the vector as a row vector. "
+        "The translation of a 4x4 matrix is applied without a perspective divide.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Transform()); }
+
+    Transform() : FunctionBase({
+        FunctionSignature<V3D*(V3D*,M4D*)>::create
+            (nullptr, std::string("transformm4d"), 0),
+        FunctionSignature<V3F*(V3F*,M4F*)>::create
+            (nullptr, std::string("transformm4f"), 0),
+        FunctionSignature<V3D*(V3D*,M3D*)>::create
+            (nullptr, std::string("transformm3d"), 0),
+        FunctionSignature<V3F*(V3F*,M3F*)>::create
+            (nullptr, std::string("transformm3f"), 0)
+    }) {}
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final
+    {
+        llvm::Value* vector = arrayToVector(args[0], builder);
+        llvm::Value* matrix = arrayToVector(args[1], builder);
+
+        const uint32_t dim = (matrix->getType()->getVectorNumElements() == 16) ? 4 : 3;
+
+        // v * M = v.x * M[0] + v.y * M[1] + v.z * M[2] (+ M[3])
+
+        llvm::Value* result = nullptr;
+        for (uint32_t row = 0; row < 3; ++row) {
+            const std::vector<uint32_t> mask { row*dim, row*dim + 1, row*dim + 2 };
+            llvm::Value* rowVector = builder.CreateShuffleVector(matrix, matrix, mask);
+            llvm::Value* element = builder.CreateExtractElement(vector, builder.getInt32(row));
+            element = builder.CreateVectorSplat(3, element);
+            element = binaryOperator(element, rowVector, ast::tokens::MULTIPLY, builder);
+            result = result ? binaryOperator(result, element, ast::tokens::PLUS, builder) : element;
+        }
+
+        if (dim == 4) {
+            const std::vector<uint32_t> translation { 12, 13, 14 };
+            llvm::Value* rowVector = builder.CreateShuffleVector(matrix, matrix, translation);
+            result = binaryOperator(result, rowVector, ast::tokens::PLUS, builder);
+        }
+
+        return vectorToArray(result, builder);
+    }
+};
+
+struct Transpose : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("transpose", FunctionBase::All,
+        "Returns the transpose of a 3x3 or 4x4 matrix.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Transpose()); }
+
+    Transpose() : FunctionBase({
+        FunctionSignature<M4D*(M4D*)>::create
+            (nullptr, std::string("transposem4d"), 0),
+        FunctionSignature<M4F*(M4F*)>::create
+            (nullptr, std::string("transposem4f"), 0),
+        FunctionSignature<M3D*(M3D*)>::create
+            (nullptr, std::string("transposem3d"), 0),
+        FunctionSignature<M3F*(M3F*)>::create
+            (nullptr, std::string("transposem3f"), 0)
+    }) {}
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final
+    {
+        llvm::Value* matrix = arrayToVector(args[0], builder);
+        const uint32_t dim = (matrix->getType()->getVectorNumElements() == 16) ? 4 : 3;
+
+        std::vector<uint32_t> mask;
+        mask.reserve(dim * dim);
+        for (uint32_t i = 0; i < dim; ++i) {
+            for (uint32_t j = 0; j < dim; ++j) {
+                mask.emplace_back(j * dim + i);
+            }
+        }
+
+        return vectorToArray(builder.CreateShuffleVector(matrix, matrix, mask), builder);
+    }
+};
+
+struct Determinant : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("determinant", FunctionBase::All,
+        "Returns the determinant of a 3x3 or 4x4 matrix.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Determinant()); }
+
+    Determinant() : FunctionBase({
+        FunctionSignature<double(M4D*)>::create
+            (nullptr, std::string("determinantm4d")),
+        FunctionSignature<float(M4F*)>::create
+            (nullptr, std::string("determinantm4f")),
+        FunctionSignature<double(M3D*)>::create
+            (nullptr, std::string("determinantm3d")),
+        FunctionSignature<float(M3F*)>::create
+            (nullptr, std::string("determinantm3f"))
+    }) {}
+
+    /// @brief  Computes the determinant of a loaded llvm vector representing a 3x3 or
+    ///         4x4 matrix. The adjugate of the matrix is returned through adjugate as a
+    ///         llvm vector of the same type.
+    inline static llvm::Value*
+    doGenerateVector(llvm::Value* matrix,
+                     llvm::Value*& adjugate,
+                     llvm::IRBuilder<>& builder)
+    {
+        if (matrix->getType()->getVectorNumElements() == 16) {
+            return doGenerateMat4(matrix, adjugate, builder);
+        }
+        return doGenerateMat3(matrix, adjugate, builder);
+    }
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final
+    {
+        llvm::Value* adjugate = nullptr;
+        return doGenerateVector(arrayToVector(args[0], builder), adjugate, builder);
+    }
+
+private:
+    inline static llvm::Value*
+    doGenerateMat3(llvm::Value* matrix,
+                   llvm::Value*& adjugate,
+                   llvm::IRBuilder<>& builder)
+    {
+        const std::vector<uint32_t> row0 { 0, 1, 2 }, row1 { 3, 4, 5 }, row2 { 6, 7, 8 };
+        llvm::Value* r0 = builder.CreateShuffleVector(matrix, matrix, row0);
+        llvm::Value* r1 = builder.CreateShuffleVector(matrix, matrix, row1);
+        llvm::Value* r2 = builder.CreateShuffleVector(matrix, matrix, row2);
+
+        // the columns of the adjugate are the cross products of the rows
+
+        llvm::Value* c0 = CrossProd::doGenerateVector(r1, r2, builder);
+        llvm::Value* c1 = CrossProd::doGenerateVector(r2, r0, builder);
+        llvm::Value* c2 = CrossProd::doGenerateVector(r0, r1, builder);
+
+        const std::vector<uint32_t> concat { 0, 1, 2, 3, 4, 5 };
+        const std::vector<uint32_t> columns { 0, 3, 6, 1, 4, 7, 2, 5, 8 };
+        llvm::Value* c01 = builder.CreateShuffleVector(c0, c1, concat);
+        llvm::Value* c22 = builder.CreateShuffleVector(c2, c2, concat);
+        adjugate = builder.CreateShuffleVector(c01, c22, columns);
+
+        return vectorSum(binaryOperator(r0, c0, ast::tokens::MULTIPLY, builder), builder);
+    }
+
+    inline static llvm::Value*
+    doGenerateMat4(llvm::Value* matrix,
+                   llvm::Value*& adjugate,
+                   llvm::IRBuilder<>& builder)
+    {
+        // Laplace expansion using the 2x2 determinants of the upper two rows (s0-s5)
+        // and lower two rows (c0-c5), computed together as a single vector
+
+        const std::vector<uint32_t> a { 0, 0, 0, 1, 1, 2,  8,  8,  8,  9,  9, 10 };
+        const std::vector<uint32_t> b { 5, 6, 7, 6, 7, 7, 13, 14, 15, 14, 15, 15 };
+        const std::vector<uint32_t> c { 4, 4, 4, 5, 5, 6, 12, 12, 12, 13, 13, 14 };
+        const std::vector<uint32_t> d { 1, 2, 3, 2, 3, 3,  9, 10, 11, 10, 11, 11 };
+
+        llvm::Value* sc = binaryOperator(
+            binaryOperator(builder.CreateShuffleVector(matrix, matrix, a),
+                builder.CreateShuffleVector(matrix, matrix, b), ast::tokens::MULTIPLY, builder),
+            binaryOperator(builder.CreateShuffleVector(matrix, matrix, c),
+                builder.CreateShuffleVector(matrix, matrix, d), ast::tokens::MULTIPLY, builder),
+            ast::tokens::MINUS, builder);
+
+        // each element of the adjugate is x1*y1 - x2*y2 + x3*y3 where x are elements of
+        // the matrix and y are the 2x2 determinants, with alternating signs
+
+        const std::vector<uint32_t> x1 { 5, 1, 13,  9, 4, 0, 12,  8, 4, 0, 12,  8, 4, 0, 12,  8 };
+        const std::vector<uint32_t> y1 { 11, 11, 5, 5, 11, 11, 5, 5, 10, 10, 4, 4, 9, 9, 3, 3 };
+        const std::vector<uint32_t> x2 { 6, 2, 14, 10, 6, 2, 14, 10, 5, 1, 13,  9, 5, 1, 13,  9 };
+        const std::vector<uint32_t> y2 { 10, 10, 4, 4, 8, 8, 2, 2, 8, 8, 2, 2, 7, 7, 1, 1 };
+        const std::vector<uint32_t> x3 { 7, 3, 15, 11, 7, 3, 15, 11, 7, 3, 15, 11, 6, 2, 14, 10 };
+        const std::vector<uint32_t> y3 { 9, 9, 3, 3, 7, 7, 1, 1, 6, 6, 0, 0, 6, 6, 0, 0 };
+
+        llvm::Value* result = binaryOperator(builder.CreateShuffleVector(matrix, matrix, x1),
+            builder.CreateShuffleVector(sc, sc, y1), ast::tokens::MULTIPLY, builder);
+        result = binaryOperator(result,
+            binaryOperator(builder.CreateShuffleVector(matrix, matrix, x2),
+                builder.CreateShuffleVector(sc, sc, y2), ast::tokens::MULTIPLY, builder),
+            ast::tokens::MINUS, builder);
+        result = binaryOperator(result,
+            binaryOperator(builder.CreateShuffleVector(matrix, matrix, x3),
+                builder.CreateShuffleVector(sc, sc, y3), ast::tokens::MULTIPLY, builder),
+            ast::tokens::PLUS, builder);
+
+        llvm::Type* elementType = matrix->getType()->getVectorElementType();
+        llvm::Value* signs = llvmConstantVector({ 1, -1, 1, -1, -1, 1, -1, 1,
+            1, -1, 1, -1, -1, 1, -1, 1 }, elementType);
+        adjugate = binaryOperator(result, signs, ast::tokens::MULTIPLY, builder);
+
+        // det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0
+
+        const std::vector<uint32_t> s { 0, 1, 2, 3, 4, 5 };
+        const std::vector<uint32_t> cr { 11, 10, 9, 8, 7, 6 };
+        llvm::Value* determinantSigns = llvmConstantVector({ 1, -1, 1, 1, -1, 1 }, elementType);
+
+        llvm::Value* products = binaryOperator(builder.CreateShuffleVector(sc, sc, s),
+            builder.CreateShuffleVector(sc, sc, cr), ast::tokens::MULTIPLY, builder);
+        products = binaryOperator(products, determinantSigns, ast::tokens::MULTIPLY, builder);
+        return vectorSum(products, builder);
+    }
+};
+
+struct Inverse : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("inverse", FunctionBase::All,
+        "Returns the inverse of a 3x3 or 4x4 matrix. If the matrix is singular, a matrix "
+        "of zeros is returned.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Inverse()); }
+
+    Inverse() : FunctionBase({
+        FunctionSignature<M4D*(M4D*)>::create
+            (nullptr, std::string("inversem4d"), 0),
+        FunctionSignature<M4F*(M4F*)>::create
+            (nullptr, std::string("inversem4f"), 0),
+        FunctionSignature<M3D*(M3D*)>::create
+            (nullptr, std::string("inversem3d"), 0),
+        FunctionSignature<M3F*(M3F*)>::create
+            (nullptr, std::string("inversem3f"), 0)
+    }) {}
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final
+    {
+        llvm::Value* matrix = arrayToVector(args[0], builder);
+
+        llvm::Value* adjugate = nullptr;
+        llvm::Value* det = Determinant::doGenerateVector(matrix, adjugate, builder);
+
+        llvm::Type* vectorType = matrix->getType();
+        llvm::Value* zero = llvm::ConstantFP::get(det->getType(), 0.0);
+        llvm::Value* one = llvm::ConstantFP::get(det->getType(), 1.0);
+
+        llvm::Value* inverseDet = builder.CreateFDiv(one, det);
+        inverseDet = builder.CreateVectorSplat(vectorType->getVectorNumElements(), inverseDet);
+        llvm::Value* result = binaryOperator(adjugate, inverseDet, ast::tokens::MULTIPLY, builder);
+
+        llvm::Value* isSingular = builder.CreateFCmpOEQ(det, zero);
+        result = builder.CreateSelect(isSingular, llvm::Constant::getNullValue(vectorType), result);
+
+        return vectorToArray(result, builder);
+    }
+};
+
+// Noise functions. Noise is generated from a stateless hash of the integer lattice
+// coordinates so that the result only depends on the position and seed, and never on
+// the order of evaluation or the number of threads. The lattice corners which
+// contribute to a position are evaluated together as llvm vectors
+
+/// @brief  Hashes llvm vectors of 32 bit integer lattice coordinates, returning a llvm
+///         vector of 32 bit hashes. The scalar integer seed selects an independent field.
+inline llvm::Value*
+noiseHash(llvm::Value* x,
+          llvm::Value* y,
+          llvm::Value* z,
+          llvm::Value* seed,
+          llvm::IRBuilder<>& builder)
+{
+    llvm::Type* type = x->getType();
+    auto constant = [type](const uint32_t value) -> llvm::Value* {
+        return llvm::ConstantInt::get(type, value);
+    };
+
+    seed = builder.CreateVectorSplat(type->getVectorNumElements(), seed);
+
+    llvm::Value* h = builder.CreateMul(x, constant(0x8da6b343));
+    h = builder.CreateAdd(h, builder.CreateMul(y, constant(0xd8163841)));
+    h = builder.CreateAdd(h, builder.CreateMul(z, constant(0xcb1ab31f)));
+    h = builder.CreateAdd(h, builder.CreateMul(seed, constant(0x165667b1)));
+
+    h = builder.CreateXor(h, builder.CreateLShr(h, 16));
+    h = builder.CreateMul(h, constant(0x7feb352d));
+    h = builder.CreateXor(h, builder.CreateLShr(h, 15));
+    h = builder.CreateMul(h, constant(0x846ca68b));
+    return builder.CreateXor(h, builder.CreateLShr(h, 16));
+}
+
+/// @brief  Selects a gradient for each hash from the lowest four bits, using the twelve
+///         cube edge directions of improved Perlin noise padded to sixteen. The gradient
+///         components are returned as llvm vectors of the given floating point type.
+inline void
+noiseGradient(llvm::Value* hash,
+              llvm::Type* elementType,
+              llvm::Value*& gx,
+              llvm::Value*& gy,
+              llvm::Value*& gz,
+              llvm::IRBuilder<>& builder)
+{
+    llvm::Type* hashType = hash->getType();
+    const unsigned size = hashType->getVectorNumElements();
+
+    llvm::Value* zero = llvm::Constant::getNullValue(hashType);
+    llvm::Value* h = builder.CreateAnd(hash, 15);
+
+    // g = (+/-u) + (+/-v) where u is x for h < 8, otherwise y and v is y for h < 4, x for
+    // h == 12 or h == 14, otherwise z
+
+    llvm::Value* uIsX = builder.CreateICmpULT(h, llvm::ConstantInt::get(hashType, 8));
+    llvm::Value* vIsY = builder.CreateICmpULT(h, llvm::ConstantInt::get(hashType, 4));
+    llvm::Value* vIsX = builder.CreateICmpEQ(builder.CreateAnd(h, 13),
+        llvm::ConstantInt::get(hashType, 12));
+
+    llvm::Value* positive =
+        llvm::ConstantVector::getSplat(size, llvm::ConstantFP::get(elementType, 1.0));
+    llvm::Value* negative =
+        llvm::ConstantVector::getSplat(size, llvm::ConstantFP::get(elementType, -1.0));
+    llvm::Value* none = llvm::Constant::getNullValue(positive->getType());
+
+    llvm::Value* u = builder.CreateSelect(builder.CreateICmpNE(builder.CreateAnd(h, 1), zero),
+        negative, positive);
+    llvm::Value* v = builder.CreateSelect(builder.CreateICmpNE(builder.CreateAnd(h, 2), zero),
+        negative, positive);
+
+    gx = binaryOperator(builder.CreateSelect(uIsX, u, none),
+        builder.CreateSelect(vIsX, v, none), ast::tokens::PLUS, builder);
+    gy = binaryOperator(builder.CreateSelect(uIsX, none, u),
+        builder.CreateSelect(vIsY, v, none), ast::tokens::PLUS, builder);
+    gz = builder.CreateSelect(builder.CreateOr(vIsY, vIsX), none, v);
+}
+
+/// @brief  Returns the dot product of llvm vectors of gradient and offset components
+inline llvm::Value*
+noiseDot(llvm::Value* gx, llvm::Value* gy, llvm::Value* gz,
+         llvm::Value* x, llvm::Value* y, llvm::Value* z,
+         llvm::IRBuilder<>& builder)
+{
+    llvm::Value* result = binaryOperator(gx, x, ast::tokens::MULTIPLY, builder);
+    result = binaryOperator(result,
+        binaryOperator(gy, y, ast::tokens::MULTIPLY, builder), ast::tokens::PLUS, builder);
+    return binaryOperator(result,
+        binaryOperator(gz, z, ast::tokens::MULTIPLY, builder), ast::tokens::PLUS, builder);
+}
+
+struct Noise : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("noise", FunctionBase::All,
+        "Computes improved Perlin gradient noise at the given position. The result is in "
+        "the range 0 to 1 and is 0.5 at every integer lattice point.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Noise()); }
+
+    Noise() : FunctionBase({
+        FunctionSignature<double(V3D*)>::create
+            (nullptr, std::string("noised")),
+        FunctionSignature<float(V3F*)>::create
+            (nullptr, std::string("noisef"))
+    }) {}
+
+    /// @brief  Computes signed Perlin noise in the range -1 to 1 from a loaded llvm vector
+    ///         of 3 elements
+    inline static llvm::Value*
+    doGenerateVector(llvm::Value* position,
+                     llvm::Value* seed,
+                     llvm::IRBuilder<>& builder,
+                     llvm::Module& M)
+    {
+        llvm::Type* elementType = position->getType()->getVectorElementType();
+        llvm::Type* intType = LLVMType<int32_t>::get(builder.getContext());
+
+        llvm::Function* floor = llvm::Intrinsic::getDeclaration(&M,
+            llvm::Intrinsic::floor, position->getType());
+        llvm::Value* lattice = builder.CreateCall(floor, position);
+        llvm::Value* offset = binaryOperator(position, lattice, ast::tokens::MINUS, builder);
+        lattice = builder.CreateFPToSI(lattice, llvm::VectorType::get(intType, 3));
+
+        // the eight corners of the cell are evaluated together, indexed by x + 2y + 4z
+
+        const std::vector<std::vector<uint32_t>> corners {
+            { 0, 1, 0, 1, 0, 1, 0, 1 },
+            { 0, 0, 1, 1, 0, 0, 1, 1 },
+            { 0, 0, 0, 0, 1, 1, 1, 1 }
+        };
+
+        std::vector<llvm::Value*> coords(3), offsets(3);
+        for (uint32_t i = 0; i < 3; ++i) {
+            std::vector<llvm::Constant*> intCorner, fpCorner;
+            for (const uint32_t corner : corners[i]) {
+                intCorner.emplace_back(llvm::ConstantInt::get(intType, corner));
+                fpCorner.emplace_back(llvm::ConstantFP::get(elementType, corner));
+            }
+
+            llvm::Value* coord = builder.CreateExtractElement(lattice, builder.getInt32(i));
+            coords[i] = builder.CreateAdd(builder.CreateVectorSplat(8, coord),
+                llvm::ConstantVector::get(intCorner));
+
+            llvm::Value* value = builder.CreateExtractElement(offset, builder.getInt32(i));
+            offsets[i] = binaryOperator(builder.CreateVectorSplat(8, value),
+                llvm::ConstantVector::get(fpCorner), ast::tokens::MINUS, builder);
+        }
+
+        llvm::Value* hash = noiseHash(coords[0], coords[1], coords[2], seed, builder);
+
+        llvm::Value* gx, *gy, *gz;
+        noiseGradient(hash, elementType, gx, gy, gz, builder);
+        llvm::Value* values = noiseDot(gx, gy, gz, offsets[0], offsets[1], offsets[2], builder);
+
+        // fade = t^3 * (t * (t * 6 - 15) + 10)
+
+        auto splat = [&](const double value) -> llvm::Value* {
+            return llvm::ConstantVector::getSplat(3, llvm::ConstantFP::get(elementType, value));
+        };
+
+        llvm::Value* fade = binaryOperator(offset, splat(6.0), ast::tokens::MULTIPLY, builder);
+        fade = binaryOperator(fade, splat(15.0), ast::tokens::MINUS, builder);
+        fade = binaryOperator(fade, offset, ast::tokens::MULTIPLY, builder);
+        fade = binaryOperator(fade, splat(10.0), ast::tokens::PLUS, builder);
+        llvm::Value* cube = binaryOperator(offset, offset, ast::tokens::MULTIPLY, builder);
+        cube = binaryOperator(cube, offset, ast::tokens::MULTIPLY, builder);
+        fade = binaryOperator(cube, fade, ast::tokens::MULTIPLY, builder);
+
+        // interpolate pairs of corners along x, y and then z
+
+        for (uint32_t i = 0, size = 4; i < 3; ++i, size /= 2) {
+            std::vector<uint32_t> even, odd;
+            for (uint32_t j = 0; j < size; ++j) {
+                even.emplace_back(j * 2);
+                odd.emplace_back(j * 2 + 1);
+            }
+
+            llvm::Value* a = builder.CreateShuffleVector(values, values, even);
+            llvm::Value* b = builder.CreateShuffleVector(values, values, odd);
+            llvm::Value* t = builder.CreateExtractElement(fade, builder.getInt32(i));
+            t = builder.CreateVectorSplat(size, t);
+
+            b = binaryOperator(b, a, ast::tokens::MINUS, builder);
+            b = binaryOperator(t, b, ast::tokens::MULTIPLY, builder);
+            values = binaryOperator(a, b, ast::tokens::PLUS, builder);
+        }
+
+        return builder.CreateExtractElement(values, builder.getInt32(0));
+    }
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final
+    {
+        llvm::Value* result =
+            doGenerateVector(arrayToVector(args[0], builder), builder.getInt32(0), builder, M);
+
+        // remap from -1 to 1 into 0 to 1
+
+        llvm::Value* half = llvm::ConstantFP::get(result->getType(), 0.5);
+        result = binaryOperator(result, half, ast::tokens::MULTIPLY, builder);
+        return binaryOperator(result, half, ast::tokens::PLUS, builder);
+    }
+};
+
+struct SNoise : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("snoise", FunctionBase::All,
+        "Computes simplex noise at the given position. The result is signed and in the "
+        "range -1 to 1.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new SNoise()); }
+
+    SNoise() : FunctionBase({
+        FunctionSignature<double(V3D*)>::create
+            (nullptr, std::string("snoised")),
+        FunctionSignature<float(V3F*)>::create
+            (nullptr, std::string("snoisef"))
+    }) {}
+
+    /// @brief  Computes simplex noise from a loaded llvm vector of 3 elements. If gradient
+    ///         is provided, it is set to the analytical derivative of the noise as a llvm
+    ///         vector of 3 elements.
+    inline static llvm::Value*
+    doGenerateVector(llvm::Value* position,
+                     llvm::Value* seed,
+                     llvm::IRBuilder<>& builder,
+                     llvm::Module& M,
+                     llvm::Value** gradient = nullptr)
+    {
+        llvm::Type* elementType = position->getType()->getVectorElementType();
+        llvm::Type* intType = LLVMType<int32_t>::get(builder.getContext());
+
+        auto scalar = [&](const double value) -> llvm::Constant* {
+            return llvm::ConstantFP::get(elementType, value);
+        };
+        auto splat = [&](const double value, const unsigned size) -> llvm::Constant* {
+            return llvm::ConstantVector::getSplat(size, scalar(value));
+        };
+
+        // skew the position to find the simplex cell and unskew the cell origin
+
+        const double F3 = 1.0 / 3.0, G3 = 1.0 / 6.0;
+
+        llvm::Value* skew = vectorSum(position, builder);
+        skew = binaryOperator(skew, scalar(F3), ast::tokens::MULTIPLY, builder);
+        skew = binaryOperator(position, builder.CreateVectorSplat(3, skew),
+            ast::tokens::PLUS, builder);
+
+        llvm::Function* floor = llvm::Intrinsic::getDeclaration(&M,
+            llvm::Intrinsic::floor, position->getType());
+        llvm::Value* lattice = builder.CreateCall(floor, skew);
+
+        llvm::Value* unskew = vectorSum(lattice, builder);
+        unskew = binaryOperator(unskew, scalar(G3), ast::tokens::MULTIPLY, builder);
+        unskew = binaryOperator(lattice, builder.CreateVectorSplat(3, unskew),
+            ast::tokens::MINUS, builder);
+        llvm::Value* offset = binaryOperator(position, unskew, ast::tokens::MINUS, builder);
+
+        // rank the offset components to find the two middle corners of the simplex,
+        // i1 = min(g, l.zxy) and i2 = max(g, l.zxy) where g = (offset >= offset.yzx)
+
+        const std::vector<uint32_t> yzx { 1, 2, 0 };
+        const std::vector<uint32_t> zxy { 2, 0, 1 };
+
+        llvm::Value* g = builder.CreateFCmpOGE(offset,
+            builder.CreateShuffleVector(offset, offset, yzx));
+        g = builder.CreateSelect(g, splat(1.0, 3), splat(0.0, 3));
+        llvm::Value* l = binaryOperator(splat(1.0, 3), g, ast::tokens::MINUS, builder);
+        l = builder.CreateShuffleVector(l, l, zxy);
+
+        llvm::Value* less = builder.CreateFCmpOLT(g, l);
+        llvm::Value* i1 = builder.CreateSelect(less, g, l);
+        llvm::Value* i2 = builder.CreateSelect(less, l, g);
+
+        // the four corners of the simplex are evaluated together, with each component
+        // stored as a separate llvm vector of 4 elements
+
+        std::vector<llvm::Constant*> unskewed;
+        for (uint32_t i = 0; i < 4; ++i) unskewed.emplace_back(scalar(i * G3));
+
+        std::vector<llvm::Value*> coords(3), offsets(3);
+        for (uint32_t i = 0; i < 3; ++i) {
+            llvm::Value* corners = llvmConstantVector({ 0, 0, 0, 1 }, elementType);
+            corners = builder.CreateInsertElement(corners,
+                builder.CreateExtractElement(i1, builder.getInt32(i)), builder.getInt32(1));
+            corners = builder.CreateInsertElement(corners,
+                builder.CreateExtractElement(i2, builder.getInt32(i)), builder.getInt32(2));
+
+            llvm::Value* coord = builder.CreateExtractElement(lattice, builder.getInt32(i));
+            coord = binaryOperator(builder.CreateVectorSplat(4, coord), corners,
+                ast::tokens::PLUS, builder);
+            coords[i] = builder.CreateFPToSI(coord, llvm::VectorType::get(intType, 4));
+
+            llvm::Value* value = builder.CreateExtractElement(offset, builder.getInt32(i));
+            value = binaryOperator(builder.CreateVectorSplat(4, value), corners,
+                ast::tokens::MINUS, builder);
+            offsets[i] = binaryOperator(value, llvm::ConstantVector::get(unskewed),
+                ast::tokens::PLUS, builder);
+        }
+
+        llvm::Value* hash = noiseHash(coords[0], coords[1], coords[2], seed, builder);
+
+        llvm::Value* gx, *gy, *gz;
+        noiseGradient(hash, elementType, gx, gy, gz, builder);
+        llvm::Value* dot = noiseDot(gx, gy, gz, offsets[0], offsets[1], offsets[2], builder);
+
+        // each corner contributes t^4 * dot where t = max(0.6 - |offset|^2, 0)
+
+        llvm::Value* t = noiseDot(offsets[0], offsets[1], offsets[2],
+            offsets[0], offsets[1], offsets[2], builder);
+        t = binaryOperator(splat(0.6, 4), t, ast::tokens::MINUS, builder);
+        t = builder.CreateSelect(builder.CreateFCmpOGT(t, splat(0.0, 4)), t, splat(0.0, 4));
+
+        llvm::Value* t2 = binaryOperator(t, t, ast::tokens::MULTIPLY, builder);
+        llvm::Value* t4 = binaryOperator(t2, t2, ast::tokens::MULTIPLY, builder);
+
+        llvm::Value* result =
+            vectorSum(binaryOperator(t4, dot, ast::tokens::MULTIPLY, builder), builder);
+        result = binaryOperator(result, scalar(32.0), ast::tokens::MULTIPLY, builder);
+
+        if (gradient) {
+
+            // d/dx (t^4 * dot) = t^4 * g - 8 * t^3 * dot * offset
+
+            llvm::Value* scale = binaryOperator(t2, t, ast::tokens::MULTIPLY, builder);
+            scale = binaryOperator(scale, dot, ast::tokens::MULTIPLY, builder);
+            scale = binaryOperator(scale, splat(8.0, 4), ast::tokens::MULTIPLY, builder);
+
+            const std::vector<llvm::Value*> components { gx, gy, gz };
+            llvm::Value* derivative = splat(0.0, 3);
+
+            for (uint32_t i = 0; i < 3; ++i) {
+                llvm::Value* value = binaryOperator(t4, components[i],
+                    ast::tokens::MULTIPLY, builder);
+                value = binaryOperator(value,
+                    binaryOperator(scale, offsets[i], ast::tokens::MULTIPLY, builder),
+                    ast::tokens::MINUS, builder);
+                value = binaryOperator(vectorSum(value, builder), scalar(32.0),
+                    ast::tokens::MULTIPLY, builder);
+                derivative = builder.CreateInsertElement(derivative, value, builder.getInt32(i));
+            }
+
+            *gradient = derivative;
+        }
+
+        return result;
+    }
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final
+    {
+        return doGenerateVector(arrayToVector(args[0], builder), builder.getInt32(0), builder, M);
+    }
+};
+
+struct CurlNoise : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("curlnoise", FunctionBase::All,
+        "Computes divergence free noise at the given position, as the curl of a vector "
+        "field of three independent simplex noise fields.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new CurlNoise()); }
+
+    CurlNoise() : FunctionBase({
+        FunctionSignature<V3D*(V3D*)>::create
+            (nullptr, std::string("curlnoised"), 0),
+        FunctionSignature<V3F*(V3F*)>::create
+            (nullptr, std::string("curlnoisef"), 0)
+    }) {}
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final
+    {
+        llvm::Value* position = arrayToVector(args[0], builder);
+
+        // the analytical derivatives of the potential (x, y, z) are seeded by their index
+
+        std::vector<llvm::Value*> gradients(3);
+        for (uint32_t i = 0; i < 3; ++i) {
+            SNoise::doGenerateVector(position, builder.getInt32(i), builder, M, &gradients[i]);
+        }
+
+        // curl = (dz/dy - dy/dz, dx/dz - dz/dx, dy/dx - dx/dy)
+
+        const std::vector<uint32_t> lhsMask { 1, 5, 2 };
+        const std::vector<uint32_t> rhsMask { 2, 3, 2 };
+
+        llvm::Value* lhs = builder.CreateShuffleVector(gradients[2], gradients[0], lhsMask);
+        lhs = builder.CreateInsertElement(lhs,
+            builder.CreateExtractElement(gradients[1], builder.getInt32(0)), builder.getInt32(2));
+
+        llvm::Value* rhs = builder.CreateShuffleVector(gradients[1], gradients[2], rhsMask);
+        rhs = builder.CreateInsertElement(rhs,
+            builder.CreateExtractElement(gradients[0], builder.getInt32(1)), builder.getInt32(2));
+
+        return vectorToArray(binaryOperator(lhs, rhs, ast::tokens::MINUS, builder), builder);
+    }
+};
+
+struct Fbm : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("fbm", FunctionBase::All,
+        "Computes fractal Brownian motion at the given position by summing the given "
+        "number of octaves of simplex noise. Each octave multiplies the frequency by the "
+        "lacunarity (default 2) and the amplitude by the gain (default 0.5). The result is "
+        "normalized by the total amplitude and is in the range -1 to 1.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Fbm()); }
+
+    Fbm() : FunctionBase({
+        FunctionSignature<double(V3D*, int32_t)>::create
+            (nullptr, std::string("fbmd")),
+        FunctionSignature<float(V3F*, int32_t)>::create
+            (nullptr, std::string("fbmf")),
+        FunctionSignature<double(V3D*, int32_t, double, double)>::create
+            (nullptr, std::string("fbmscaled")),
+        FunctionSignature<float(V3F*, int32_t, float, float)>::create
+            (nullptr, std::string("fbmscalef"))
+    }) {}
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final
+    {
+        llvm::LLVMContext& C = builder.getContext();
+
+        llvm::Value* position = arrayToVector(args[0], builder);
+        llvm::Value* octaves = args[1];
+
+        llvm::Type* elementType = position->getType()->getVectorElementType();
+        llvm::Value* zero = llvm::ConstantFP::get(elementType, 0.0);
+        llvm::Value* one = llvm::ConstantFP::get(elementType, 1.0);
+
+        llvm::Value* lacunarity = llvm::ConstantFP::get(elementType, 2.0);
+        llvm::Value* gain = llvm::ConstantFP::get(elementType, 0.5);
+        if (args.size() == 4) {
+            lacunarity = args[2];
+            gain = args[3];
+        }
+
+        // each octave is seeded by its index so that the octaves are independent
+
+        llvm::BasicBlock* entry = builder.GetInsertBlock();
+        llvm::Function* function = entry->getParent();
+        llvm::BasicBlock* condition = llvm::BasicBlock::Create(C, "fbm_condition", function);
+        llvm::BasicBlock* body = llvm::BasicBlock::Create(C, "fbm_body", function);
+        llvm::BasicBlock* exit = llvm::BasicBlock::Create(C, "fbm_exit", function);
+
+        builder.CreateBr(condition);
+        builder.SetInsertPoint(condition);
+
+        llvm::PHINode* octave = builder.CreatePHI(octaves->getType(), 2, "octave");
+        llvm::PHINode* sum = builder.CreatePHI(elementType, 2, "sum");
+        llvm::PHINode* total = builder.CreatePHI(elementType, 2, "total");
+        llvm::PHINode* amplitude = builder.CreatePHI(elementType, 2, "amplitude");
+        llvm::PHINode* frequency = builder.CreatePHI(elementType, 2, "frequency");
+
+        octave->addIncoming(builder.getInt32(0), entry);
+        sum->addIncoming(zero, entry);
+        total->addIncoming(zero, entry);
+        amplitude->addIncoming(one, entry);
+        frequency->addIncoming(one, entry);
+
+        builder.CreateCondBr(builder.CreateICmpSLT(octave, octaves), body, exit);
+        builder.SetInsertPoint(body);
+
+        llvm::Value* scaled = binaryOperator(position,
+            builder.CreateVectorSplat(3, frequency), ast::tokens::MULTIPLY, builder);
+        llvm::Value* value = SNoise::doGenerateVector(scaled, octave, builder, M);
+        value = binaryOperator(amplitude, value, ast::tokens::MULTIPLY, builder);
+
+        llvm::BasicBlock* latch = builder.GetInsertBlock();
+        octave->addIncoming(builder.CreateAdd(octave, builder.getInt32(1)), latch);
+        sum->addIncoming(binaryOperator(sum, value, ast::tokens::PLUS, builder), latch);
+        total->addIncoming(binaryOperator(total, amplitude, ast::tokens::PLUS, builder), latch);
+        amplitude->addIncoming(
+            binaryOperator(amplitude, gain, ast::tokens::MULTIPLY, builder), latch);
+        frequency->addIncoming(
+            binaryOperator(frequency, lacunarity, ast::tokens::MULTIPLY, builder), latch);
+
+        builder.CreateBr(condition);
+        builder.SetInsertPoint(exit);
+
+        // no octaves or a total amplitude of zero produces zero
+
+        llvm::Value* result = binaryOperator(sum, total, ast::tokens::DIVIDE, builder);
+        return builder.CreateSelect(builder.CreateFCmpONE(total, zero), result, zero);
+    }
 };
 
 struct Clamp : public FunctionBase
@@ -39,6 +39,7 @@
 #include "Utils.h"
 
 #include <openvdb_ax/Exceptions.h>
+#include <openvdb_ax/ast/Scanners.h>
 
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/BasicBlock.h>
@@ -83,6 +84,27 @@ std::string PointKernel::getDefaultName() { return "compute_point"; }
 std::string PointRangeKernel::getDefaultName() { return "compute_point_range"; }
 
 
+namespace {
+
+/// @brief  Add the parameter attributes of the point kernel arguments. The custom data,
+///         attribute set and handle tables are only read by the kernel and are not
+///         accessible through any other argument. The tables may be null if empty.
+inline void addKernelAttributes(llvm::Function& function)
+{
+    const std::vector<llvm::Attribute::AttrKind> readOnly {
+        llvm::Attribute::NoAlias, llvm::Attribute::ReadOnly };
+
+    addArgumentAttributes(function, 0, readOnly); // custom_data
+    addArgumentAttributes(function, 1, readOnly); // attribute_set
+    addArgumentAttributes(function, 3, readOnly); // attribute_handles
+    addArgumentAttributes(function, 4, readOnly); // group_handles
+    addArgumentAttributes(function, 5,
+        { llvm::Attribute::NoAlias, llvm::Attribute::NonNull }); // leaf_data
+}
+
+}
+
+
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
 
@@ -91,9 +113,11 @@ PointComputeGenerator::PointComputeGenerator(llvm::Module& module,
                                              FunctionRegistry& functionRegistry,
                                              std::vector<std::string>* const warnings)
     : ComputeGenerator(module, options, functionRegistry, warnings)
-    , mAttributeVisitCount(0) {}
+    , mAttributeVisitCount(0)
+    , mScratchSites(0)
+    , mPromotedAttributes() {}
 
-void PointComputeGenerator::init(const ast::Tree&)
+void PointComputeGenerator::init(const ast::Tree& tree)
 {
     // Override the ComputeGenerators default init() with the custom
     // functions requires for Point execution
@@ -108,6 +132,7 @@ void PointComputeGenerator::init(const ast::Tree&)
     // Set the base code generator function to the compute voxel function
 
     mFunction = pointKernelSignature->toLLVMFunction(mModule);
+    addKernelAttributes(*mFunction);
 
     // Set up arguments for initial entry
 
@@ -126,6 +151,7 @@ void PointComputeGenerator::init(const ast::Tree&)
         FunctionSignatureT::create(nullptr, PointRangeKernel::getDefaultName());
 
     llvm::Function* rangeFunction = pointRangeKernelSignature->toLLVMFunction(mModule);
+    addKernelAttributes(*rangeFunction);
 
     // Set up arguments for initial entry for the range function
 
@@ -189,6 +215,120 @@ void PointComputeGenerator::init(const ast::Tree&)
     mBlocks.push(llvm::BasicBlock::Create(mContext,
         "entry_" + PointKernel::getDefaultName(), mFunction));
     mBuilder.SetInsertPoint(mBlocks.top());
+
+    if (mOptions.mPromoteAttributes) this->promoteAttributes(tree);
+}
+
+llvm::Value* PointComputeGenerator::allocateString(llvm::Value* size)
+{
+    // user functions have no access to the leaf data and small strings of a known
+    // size are cheaper on the stack
+
+    if (this->inUserFunction()) {
+        return ComputeGenerator::allocateString(size);
+    }
+    if (llvm::ConstantInt* constant = llvm::dyn_cast<llvm::ConstantInt>(size)) {
+        if (constant->getZExtValue() <= MaxStackStringSize) {
+            return ComputeGenerator::allocateString(size);
+        }
+    }
+
+    // each allocation site reuses the same memory every time it is executed, such as
+    // on every iteration of a loop, so that the arena does not grow with the number of
+    // times a site runs
+
+    llvm::Value* site = LLVMType<int64_t>::get(mContext, static_cast<int64_t>(mScratchSites++));
+
+    const FunctionBase::Ptr allocate = this->getFunction("allocatescratch", mOptions, true);
+    llvm::Value* string = allocate->execute({mLLVMArguments.get("leaf_data"), site, size},
+        mLLVMArguments.map(), mBuilder, mModule);
+
+    mStringSizes[string] = size;
+    return string;
+}
+
+void PointComputeGenerator::promoteAttributes(const ast::Tree& tree)
+{
+    // Points can only access their own attributes, so every attribute can be read once
+    // into a local at the start of the kernel and operated on as a local variable
+
+    mPromotedAttributes.clear();
+
+    ast::visitNodeType<ast::Attribute>(tree,
+        [&](const ast::Attribute& node) {
+            if (node.mType == "string") {
+                OPENVDB_THROW(AXCompilerError, "Access to string attributes not yet supported.");
+            }
+            const std::string key = node.mName == "P" ? "P" :
+                getGlobalAttributeAccess(node.mName, node.mType);
+            mPromotedAttributes.insert({key, {node.mName, node.mType, nullptr, nullptr, false}});
+        });
+
+    auto markWritten = [&](const ast::Variable::Ptr& variable) {
+        const ast::Attribute* const attribute =
+            dynamic_cast<const ast::Attribute*>(variable.get());
+        if (!attribute) return;
+        const std::string key = attribute->mName == "P" ? "P" :
+            getGlobalAttributeAccess(attribute->mName, attribute->mType);
+        assert(mPromotedAttributes.count(key));
+        mPromotedAttributes[key].mWritten = true;
+    };
+
+    ast::visitNodeType<ast::AssignExpression>(tree,
+        [&](const ast::AssignExpression& node) { markWritten(node.mVariable); });
+    ast::visitNodeType<ast::Crement>(tree,
+        [&](const ast::Crement& node) { markWritten(node.mVariable); });
+
+    for (auto& iter : mPromotedAttributes) {
+        PromotedAttribute& attribute = iter.second;
+        const bool usingPosition = attribute.mName == "P";
+
+        if (usingPosition) {
+            attribute.mHandle = mLLVMArguments.get("leaf_data");
+        }
+        else {
+            // see visit(ast::Attribute)
+            llvm::Value* index = llvm::cast<llvm::GlobalVariable>
+                (mModule.getOrInsertGlobal(iter.first, LLVMType<int64_t>::get(mContext)));
+            this->globals().insert(iter.first, index);
+
+            index = mBuilder.CreateLoad(index);
+            attribute.mHandle = loadHandle(mBuilder, mLLVMArguments.get("attribute_handles"), index);
+        }
+
+        attribute.mValue = insertStaticAlloca(mBuilder, llvmTypeFromName(attribute.mType, mContext));
+
+        std::vector<llvm::Value*> args {
+            attribute.mHandle, mLLVMArguments.get("point_index"), attribute.mValue
+        };
+
+        const FunctionBase::Ptr function =
+            this->getFunction(usingPosition ? "getpointpws" : "getattribute", mOptions, true);
+        function->execute(args, mLLVMArguments.map(), mBuilder, mModule, nullptr, /*add output args*/false);
+    }
+}
+
+void PointComputeGenerator::storePromotedAttributes()
+{
+    for (const auto& iter : mPromotedAttributes) {
+        const PromotedAttribute& attribute = iter.second;
+        if (!attribute.mWritten) continue;
+
+        // pod types are passed by value, arrays by pointer
+
+        llvm::Value* value = attribute.mValue;
+        if (!isArrayType(value->getType()->getContainedType(0))) {
+            value = mBuilder.CreateLoad(value);
+        }
+
+        std::vector<llvm::Value*> args {
+            attribute.mHandle, mLLVMArguments.get("point_index"), value
+        };
+
+        const FunctionBase::Ptr function = this->getFunction(attribute.mName == "P" ?
+            "setpointpws" : "setattribute", mOptions, true);
+        function->execute(args, mLLVMArguments.map(), mBuilder, mModule);
+    }
 }
 
 void PointComputeGenerator::visit(const ast::AssignExpression& node)
@@ -353,7 +493,7 @@ void PointComputeGenerator::visit(const ast::Crement& node)
 
     llvm::Value* temp = nullptr;
     if (node.mPost) {
-        temp = mBuilder.CreateAlloca(type);
+        temp = insertStaticAlloca(mBuilder, type);
         mBuilder.CreateStore(rhs, temp);
     }
 
@@ -406,7 +546,7 @@ void PointComputeGenerator::visit(const ast::Crement& node)
     }
     else {
         // pre-increment: put the incremented value on the expression stack
-        lhs = mBuilder.CreateAlloca(type);
+        lhs = insertStaticAlloca(mBuilder, type);
         mBuilder.CreateStore(rhs, lhs);
         mValues.push(lhs);
     }
@@ -417,6 +557,11 @@ void PointComputeGenerator::visit(const ast::FunctionCall& node)
     assert(node.mArguments.get() && ("Uninitialized expression list for " +
            node.mFunction).c_str());
 
+    if (this->isUserFunction(node.mFunction)) {
+        ComputeGenerator::visit(node);
+        return;
+    }
+
     const FunctionBase::Ptr function =
         this->getFunction(node.mFunction, mOptions, /*no internal access*/false);
 
@@ -434,6 +579,7 @@ void PointComputeGenerator::visit(const ast::FunctionCall& node)
 
     std::vector<llvm::Value*> arguments;
     argumentsFromStack(mValues, args, arguments);
+    this->demoteLiterals(node, arguments);
     parseDefaultArgumentState(arguments, mBuilder);
 
     std::vector<llvm::Value*> results;
@@ -443,7 +589,7 @@ void PointComputeGenerator::visit(const ast::FunctionCall& node)
     if (resultType != LLVMType<void>::get(mContext)) {
         // only required to allocate new data for the result type if its NOT a pointer
         if (!resultType->isPointerTy()) {
-            llvm::Value* resultStore = mBuilder.CreateAlloca(resultType);
+            llvm::Value* resultStore = insertStaticAlloca(mBuilder, resultType);
             mBuilder.CreateStore(result, resultStore);
             result = resultStore;
         }
@@ -455,6 +601,15 @@ void PointComputeGenerator::visit(const ast::FunctionCall& node)
 
 void PointComputeGenerator::visit(const ast::Attribute& node)
 {
+    if (mOptions.mPromoteAttributes) {
+        // promoted attributes are accessed as locals
+        const std::string key = node.mName == "P" ? "P" :
+            getGlobalAttributeAccess(node.mName, node.mType);
+        assert(mPromotedAttributes.count(key));
+        mValues.push(mPromotedAttributes[key].mValue);
+        return;
+    }
+
     if (node.mType == "string") {
         OPENVDB_THROW(AXCompilerError, "Access to string attributes not yet supported.");
     }
@@ -483,8 +638,7 @@ void PointComputeGenerator::visit(const ast::Attribute& node)
         // The result is a loaded void* value
 
         index = mBuilder.CreateLoad(index);
-        llvm::Value* handlePtr = mBuilder.CreateGEP(mLLVMArguments.get("attribute_handles"), index);
-        handlePtr = mBuilder.CreateLoad(handlePtr);
+        llvm::Value* handlePtr = loadHandle(mBuilder, mLLVMArguments.get("attribute_handles"), index);
 
         // indicate the next value is an attribute
 
@@ -499,6 +653,9 @@ void PointComputeGenerator::visit(const ast::Attribute& node)
 
 void PointComputeGenerator::visit(const ast::AttributeValue& node)
 {
+    // the local holding a promoted attribute is already on the stack
+    if (mOptions.mPromoteAttributes) return;
+
     assert(mAttributeVisitCount != 0 &&
         "Expected attribute is marked as a local");
     assert(node.mAttribute &&
@@ -535,7 +692,7 @@ void PointComputeGenerator::visit(const ast::AttributeValue& node)
         // args.reserve(4);
     }
     else {
-        returnValue = mBuilder.CreateAlloca(returnType);
+        returnValue = insertStaticAlloca(mBuilder, returnType);
         args.reserve(3);
     }
 
@@ -557,6 +714,21 @@ void PointComputeGenerator::visit(const ast::AttributeValue& node)
     mValues.push(returnValue);
 }
 
+void PointComputeGenerator::visit(const ast::Return& node)
+{
+    // promoted attributes are only stored when returning from the kernel
+    if (mOptions.mPromoteAttributes && !this->inUserFunction()) {
+        this->storePromotedAttributes();
+    }
+    ComputeGenerator::visit(node);
+}
+
+void PointComputeGenerator::visit(const ast::Tree& node)
+{
+    if (mOptions.mPromoteAttributes) this->storePromotedAttributes();
+    ComputeGenerator::visit(node);
+}
+
 }
 }
 }
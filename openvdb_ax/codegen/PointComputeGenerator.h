@@ -44,6 +44,9 @@
 #include "Types.h"
 #include "Utils.h"
 
+#include <map>
+#include <string>
+
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
 namespace OPENVDB_VERSION_NAME {
@@ -65,7 +68,8 @@ namespace codegen {
 ///           5) - A void pointer to a vector of void pointers, representing an
 ///                array of group handles
 ///           6) - A void pointer to a LeafLocalData object, used to track newly
-///                initialized attributes and arrays
+///                initialized attributes and arrays and to allocate temporary
+///                strings which are too large for the stack
 ///
 struct PointKernel
 {
@@ -130,12 +134,41 @@ protected:
     void visit(const ast::FunctionCall& node) override;
     void visit(const ast::Attribute& node) override;
     void visit(const ast::AttributeValue& node) override;
+    void visit(const ast::Return& node) override;
+    void visit(const ast::Tree& node) override;
+
+    /// @brief  Allocate strings which are too large for the stack from the scratch
+    ///         arena of the LeafLocalData. Each call allocates from its own slot of the
+    ///         arena, which is reused every time the generated code is executed.
+    llvm::Value* allocateString(llvm::Value* size) override;
 
 private:
 
+    /// @brief  An attribute which is loaded into a local at the start of the kernel
+    ///         and, if written to, stored back at every exit.
+    struct PromotedAttribute
+    {
+        std::string mName;
+        std::string mType;
+        llvm::Value* mHandle;  // the attribute handle, or the leaf data for P
+        llvm::Value* mValue;   // the local holding the current value
+        bool mWritten;
+    };
+
+    /// @brief  Load every attribute accessed in the tree into locals in the entry block
+    void promoteAttributes(const ast::Tree& tree);
+    /// @brief  Store the locals of all written promoted attributes back to the points
+    void storePromotedAttributes();
+
     // Track how many attributes have been visisted so we can choose the correct
     // code path
     size_t mAttributeVisitCount;
+
+    // The number of sites in the kernel which allocate from the scratch arena
+    size_t mScratchSites;
+
+    // Promoted attributes keyed by their global access name (or "P" for position)
+    std::map<std::string, PromotedAttribute> mPromotedAttributes;
 };
 
 }
@@ -220,6 +220,18 @@ void SetPointPWS::set_point_pws(void* leafDataPtr,
 //     strcpy(sarray, data.c_str());
 // }
 
+uint8_t* AllocateScratch::allocate_scratch(void* leafDataPtr,
+                                           const int64_t site,
+                                           const int64_t size)
+{
+    assert(site >= 0);
+    assert(size >= 0);
+    openvdb::ax::compiler::LeafLocalData* leafData =
+        static_cast<openvdb::ax::compiler::LeafLocalData*>(leafDataPtr);
+    return reinterpret_cast<uint8_t*>(leafData->allocateScratch(static_cast<size_t>(site),
+        static_cast<size_t>(size)));
+}
+
 void GetPointPWS::get_point_pws(void* leafDataPtr,
                                 const uint64_t index,
                                 openvdb::Vec3s* value)
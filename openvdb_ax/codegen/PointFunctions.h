@@ -273,6 +273,10 @@ struct SetAttribute : public FunctionBase
         DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Vec3d>),
         DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Vec3f>),
         DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Vec3i>),
+        DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Mat3d>),
+        DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Mat3s>),
+        DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Mat4d>),
+        DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Mat4s>),
         // DECLARE_FUNCTION_SIGNATURE(set_attribute_string),
     }) {}
 
@@ -320,6 +324,24 @@ private:
                               openvdb::Vec3s* value);
 };
 
+struct AllocateScratch : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("allocatescratch", FunctionBase::Point,
+        "Internal function for allocating temporary memory for an allocation site from the "
+        "scratch arena of the current thread. The memory remains valid until the same site "
+        "allocates again.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new AllocateScratch()); }
+
+    AllocateScratch() : FunctionBase({
+        DECLARE_FUNCTION_SIGNATURE(allocate_scratch)
+    }) {}
+
+private:
+
+    static uint8_t* allocate_scratch(void* leafDataPtr, const int64_t site, const int64_t size);
+};
+
 //@todo: Once required improvements made to StringAttributeArray
 //       renable string attributes and functions
 // struct StringAttribSize : public FunctionBase
@@ -358,6 +380,10 @@ struct GetAttribute : public FunctionBase
         DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Vec3d>, 1),
         DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Vec3f>, 1),
         DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Vec3i>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Mat3d>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Mat3s>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Mat4d>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Mat4s>, 1),
         // DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute_string, 1)
     }) {}
 
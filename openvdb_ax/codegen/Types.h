@@ -40,6 +40,7 @@
 
 #include <openvdb_ax/Exceptions.h>
 
+#include <openvdb/math/Mat3.h>
 #include <openvdb/math/Mat4.h>
 #include <openvdb/math/Vec3.h>
 #include <openvdb/Types.h>
@@ -195,6 +196,10 @@ struct LLVMType<void*> {
 template <> struct LLVMType<math::Vec3<int32_t>> : public LLVMType<int32_t[3]> {};
 template <> struct LLVMType<math::Vec3<float>> : public LLVMType<float[3]> {};
 template <> struct LLVMType<math::Vec3<double>> : public LLVMType<double[3]> {};
+template <> struct LLVMType<math::Mat3<float>> : public LLVMType<float[9]> {};
+template <> struct LLVMType<math::Mat3<double>> : public LLVMType<double[9]> {};
+template <> struct LLVMType<math::Mat4<float>> : public LLVMType<float[16]> {};
+template <> struct LLVMType<math::Mat4<double>> : public LLVMType<double[16]> {};
 
 #undef REGISTER_LLVM_TYPE_MAP
 #undef REGISTER_OPENVDB_VECTOR_LLVM_TYPE_MAP
@@ -253,6 +258,10 @@ llvmTypeFromName(const std::string& type,
     if (type == openvdb::typeNameAsString<math::Vec3<int32_t>>())  return LLVMType<math::Vec3<int32_t>>::get(C);
     if (type == openvdb::typeNameAsString<math::Vec3<float>>())    return LLVMType<math::Vec3<float>>::get(C);
     if (type == openvdb::typeNameAsString<math::Vec3<double>>())   return LLVMType<math::Vec3<double>>::get(C);
+    if (type == openvdb::typeNameAsString<math::Mat3<float>>())    return LLVMType<math::Mat3<float>>::get(C);
+    if (type == openvdb::typeNameAsString<math::Mat3<double>>())   return LLVMType<math::Mat3<double>>::get(C);
+    if (type == openvdb::typeNameAsString<math::Mat4<float>>())    return LLVMType<math::Mat4<float>>::get(C);
+    if (type == openvdb::typeNameAsString<math::Mat4<double>>())   return LLVMType<math::Mat4<double>>::get(C);
     if (type == openvdb::typeNameAsString<std::string>())          return LLVMType<char>::get(C);
 
     OPENVDB_THROW(LLVMTypeError, "Attribute Type " + type + " not recognised");
@@ -337,13 +346,23 @@ isArray3Type(llvm::Type* type)
     return isArrayNType(type, 3);
 }
 
+/// @brief Returns whether the supplied Type* is an array type representing a 3x3
+///        or 4x4 matrix, i.e. an array with 9 or 16 elements
+/// @param type The Type* to check
+///
+inline bool
+isMatrixType(llvm::Type* type)
+{
+    return isArrayNType(type, 9) || isArrayNType(type, 16);
+}
+
 
 namespace internal
 {
 
 inline bool isValidGlobalToken(const std::string& token)
 {
-    static const std::vector<char> sKeys { '@', '$' };
+    static const std::vector<char> sKeys { '@', '$', '#' };
     for (const char key : sKeys) {
         size_t pos = token.find(key);
         if (pos == std::string::npos) continue;
@@ -400,6 +419,27 @@ isGlobalExternalAccess(const std::string& global,
     return true;
 }
 
+/// @brief  Parse a global variable name to figure out if it is a lookup of custom data
+///         with a literal name. Returns true if it is a valid lookup and sets name and
+///         type to the corresponding values.
+///
+/// @param  global  The global token name
+/// @param  name    The name to set if the token is a valid lookup
+/// @param  type    The type to set if the token is a valid lookup
+///
+inline bool
+isGlobalLookupAccess(const std::string& global,
+                     std::string& name,
+                     std::string& type)
+{
+    const size_t at = global.find("#");
+    if (at == std::string::npos) return false;
+    assert(internal::isValidGlobalToken(global));
+    type = global.substr(0, at);
+    name = global.substr(at + 1, global.size());
+    return true;
+}
+
 /// @brief  Returns a global token name representing a valid attribute access from
 ///         a given attribute name and type.
 /// @note   The type is not validated but must be one of the supported typenames.
@@ -432,6 +472,21 @@ getGlobalExternalAccess(const std::string& name, const std::string& type)
     return global;
 }
 
+/// @brief  Returns a global token name representing a lookup of custom data with a
+///         literal name, from a given name and type.
+/// @note   The name must not contain any of the global token keys (@, $ or #).
+///
+/// @param  name    The custom data name
+/// @param  type    The custom data type
+///
+inline std::string
+getGlobalLookupAccess(const std::string& name, const std::string& type)
+{
+    const std::string global = type + "#" + name;
+    assert(internal::isValidGlobalToken(global));
+    return global;
+}
+
 
 }
 }
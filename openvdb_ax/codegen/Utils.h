@@ -136,6 +136,68 @@ llvmPointerFromAddress(const ValueT* const& ptr,
     return builder.CreateIntToPtr(address, LLVMType<ValueT*>::get(builder.getContext()));
 }
 
+/// @brief  Insert a stack allocation at the beginning of the entry block of the function
+///         currently being built, so that it is only allocated once per call and may be
+///         promoted to a register by mem2reg/SROA. Allocations of a non constant size are
+///         inserted at the builder's current insert point.
+///
+/// @param  builder  The current llvm IRBuilder
+/// @param  type     The type to allocate
+/// @param  size     The optional number of elements of type to allocate
+///
+inline llvm::AllocaInst*
+insertStaticAlloca(llvm::IRBuilder<>& builder,
+                   llvm::Type* type,
+                   llvm::Value* size = nullptr)
+{
+    if (size && !llvm::isa<llvm::Constant>(size)) {
+        return builder.CreateAlloca(type, size);
+    }
+
+    llvm::BasicBlock* block = builder.GetInsertBlock();
+    assert(block && block->getParent());
+
+    llvm::BasicBlock& entry = block->getParent()->getEntryBlock();
+    llvm::IRBuilder<> entryBuilder(&entry, entry.begin());
+    return entryBuilder.CreateAlloca(type, size);
+}
+
+/// @brief  Load an element of a table of handles passed to a kernel, such as the attribute
+///         handles of a point kernel or the accessors of a volume kernel. The tables are not
+///         modified while a kernel executes and are passed as noalias, so the load is
+///         marked as invariant, allowing it to be hoisted out of loops over the kernel.
+///
+/// @param  builder  The current llvm IRBuilder
+/// @param  table    The pointer to the table of handles
+/// @param  index    The index of the handle to load
+///
+inline llvm::LoadInst*
+loadHandle(llvm::IRBuilder<>& builder,
+           llvm::Value* table,
+           llvm::Value* index)
+{
+    llvm::LLVMContext& C = builder.getContext();
+    llvm::LoadInst* handle = builder.CreateLoad(builder.CreateGEP(table, index));
+    handle->setMetadata(llvm::LLVMContext::MD_invariant_load, llvm::MDNode::get(C, llvm::None));
+    return handle;
+}
+
+/// @brief  Add parameter attributes to the argument of a kernel function
+///
+/// @param  function  The kernel function
+/// @param  index     The index of the argument
+/// @param  kinds     The attributes to add
+///
+inline void
+addArgumentAttributes(llvm::Function& function,
+                      const unsigned index,
+                      const std::vector<llvm::Attribute::AttrKind>& kinds)
+{
+    for (const llvm::Attribute::AttrKind kind : kinds) {
+        function.addParamAttr(index, kind);
+    }
+}
+
 /// @brief  Insert a std::string object into IR and return the pointer to it's allocation
 /// @note   Includes the null terminator
 ///
@@ -153,7 +215,7 @@ llvmStringToValue(const std::string& string, llvm::IRBuilder<>& builder)
     llvm::Type* charType = LLVMType<char>::get(C);
 
     llvm::Value* size = llvm::ConstantInt::get(llvm::Type::getInt64Ty(C), stringSize + 1);
-    llvm::Value* store = builder.CreateAlloca(charType, size);
+    llvm::Value* store = insertStaticAlloca(builder, charType, size);
 
     // loop for <= size to include null terminator
 
@@ -473,7 +535,7 @@ arrayCast(llvm::Value* ptrToArray,
 
     const size_t elementSize = arrayType->getArrayNumElements();
     llvm::Value* targetArray =
-        builder.CreateAlloca(llvm::ArrayType::get(targetElementType, elementSize));
+        insertStaticAlloca(builder, llvm::ArrayType::get(targetElementType, elementSize));
 
     for (size_t i = 0; i < elementSize; ++i) {
         llvm::Value* target = builder.CreateConstGEP2_64(targetArray, 0, i);
@@ -619,7 +681,10 @@ binaryOperator(llvm::Value* lhs, llvm::Value* rhs,
         if (warnings) *warnings = std::string("Implicit cast from float to int.");
     }
 
-    const BinaryFunction llvmBinaryFunction = llvmBinaryConversion(lhsType, token);
+    // arithmetic operations on llvm vectors are selected from their element type
+
+    const BinaryFunction llvmBinaryFunction =
+        llvmBinaryConversion(lhsType->getScalarType(), token);
     return llvmBinaryFunction(builder, lhs, rhs);
 }
 
@@ -714,7 +779,7 @@ array3Pack(llvm::Value* value1,
     value3 = arithmeticConversion(value3, type, builder);
 
     llvm::Type* vectorType = llvm::ArrayType::get(type, 3);
-    llvm::Value* vector = builder.CreateAlloca(vectorType);
+    llvm::Value* vector = insertStaticAlloca(builder, vectorType);
 
     llvm::Value* e1 = builder.CreateConstGEP2_64(vector, 0, 0);
     llvm::Value* e2 = builder.CreateConstGEP2_64(vector, 0, 1);
@@ -746,7 +811,7 @@ arrayPack(llvm::Value* value,
 
     llvm::Type* type = value->getType();
     llvm::Value* array =
-        builder.CreateAlloca(llvm::ArrayType::get(type, size));
+        insertStaticAlloca(builder, llvm::ArrayType::get(type, size));
 
     for (size_t i = 0; i < size; ++i) {
         llvm::Value* element = builder.CreateConstGEP2_64(array, 0, i);
@@ -768,7 +833,7 @@ arrayPack(const std::vector<llvm::Value*>& values,
 {
     llvm::Type* type = values.front()->getType();
     llvm::Value* array =
-        builder.CreateAlloca(llvm::ArrayType::get(type, values.size()));
+        insertStaticAlloca(builder, llvm::ArrayType::get(type, values.size()));
 
     size_t idx = 0;
     for (llvm::Value* const& value : values) {
@@ -808,6 +873,156 @@ arrayPackCast(std::vector<llvm::Value*>& values,
     return arrayPack(values, builder);
 }
 
+/// @brief  Load an array into a single llvm vector of the same element type and size.
+///         The provided llvm Value is expected to be a pointer to an array. The array
+///         is accessed at the alignment of its elements.
+///
+/// @param ptrToArray  A llvm value which is a pointer to a llvm array
+/// @param builder     The current llvm IRBuilder
+///
+inline llvm::Value*
+arrayToVector(llvm::Value* ptrToArray,
+              llvm::IRBuilder<>& builder)
+{
+    assert(ptrToArray && ptrToArray->getType()->isPointerTy() &&
+        "Input to arrayToVector is not a pointer type.");
+
+    llvm::Type* arrayType = ptrToArray->getType()->getContainedType(0);
+    assert(arrayType->isArrayTy());
+
+    llvm::Type* elementType = arrayType->getArrayElementType();
+    llvm::Type* vectorType =
+        llvm::VectorType::get(elementType, arrayType->getArrayNumElements());
+
+    const llvm::DataLayout& layout = builder.GetInsertBlock()->getModule()->getDataLayout();
+    const unsigned alignment = layout.getABITypeAlignment(elementType);
+
+    llvm::Value* ptrToVector = builder.CreateBitCast(ptrToArray, vectorType->getPointerTo(0));
+    return builder.CreateAlignedLoad(ptrToVector, alignment);
+}
+
+/// @brief  Store a llvm vector into a new array of the same element type and size and
+///         return a pointer to the newly allocated array.
+///
+/// @param vector   A loaded llvm vector value
+/// @param builder  The current llvm IRBuilder
+///
+inline llvm::Value*
+vectorToArray(llvm::Value* vector,
+              llvm::IRBuilder<>& builder)
+{
+    llvm::Type* vectorType = vector->getType();
+    assert(vectorType->isVectorTy());
+
+    llvm::Type* elementType = vectorType->getVectorElementType();
+    llvm::Value* array = insertStaticAlloca(builder,
+        llvm::ArrayType::get(elementType, vectorType->getVectorNumElements()));
+
+    const llvm::DataLayout& layout = builder.GetInsertBlock()->getModule()->getDataLayout();
+    const unsigned alignment = layout.getABITypeAlignment(elementType);
+
+    llvm::Value* ptrToVector = builder.CreateBitCast(array, vectorType->getPointerTo(0));
+    builder.CreateAlignedStore(vector, ptrToVector, alignment);
+    return array;
+}
+
+/// @brief  Casts a llvm vector to a vector of equal size with a different scalar element
+///         type. Returns the vector unchanged if it already has the target element type.
+///
+/// @param vector             A loaded llvm vector value
+/// @param targetElementType  The target llvm scalar type to convert each element to
+/// @param builder            The current llvm IRBuilder
+///
+inline llvm::Value*
+vectorConversion(llvm::Value* vector,
+                 llvm::Type* targetElementType,
+                 llvm::IRBuilder<>& builder)
+{
+    llvm::Type* vectorType = vector->getType();
+    assert(vectorType->isVectorTy());
+
+    llvm::Type* elementType = vectorType->getVectorElementType();
+    if (elementType == targetElementType) return vector;
+
+    llvm::Type* targetType =
+        llvm::VectorType::get(targetElementType, vectorType->getVectorNumElements());
+    CastFunction llvmCastFunction = llvmArithmeticConversion(elementType, targetElementType);
+    return llvmCastFunction(builder, vector, targetType);
+}
+
+/// @brief  Returns the sum of all elements of a llvm vector as a loaded scalar value
+///
+/// @param vector   A loaded llvm vector value
+/// @param builder  The current llvm IRBuilder
+///
+inline llvm::Value*
+vectorSum(llvm::Value* vector,
+          llvm::IRBuilder<>& builder)
+{
+    llvm::Type* vectorType = vector->getType();
+    assert(vectorType->isVectorTy());
+
+    const BinaryFunction add =
+        llvmBinaryConversion(vectorType->getVectorElementType(), ast::tokens::PLUS);
+
+    llvm::Value* result = builder.CreateExtractElement(vector, builder.getInt32(0));
+    for (unsigned i = 1; i < vectorType->getVectorNumElements(); ++i) {
+        result = add(builder, result, builder.CreateExtractElement(vector, builder.getInt32(i)));
+    }
+    return result;
+}
+
+/// @brief  Performs an arithmetic binary operation on two pointers to either arrays or
+///         scalars, of which at least one must be an array, using llvm vector types. Array
+///         operands are loaded as a single vector and scalar operands are splatted. Both
+///         are converted to the highest order element type. Returns a pointer to a new
+///         array holding the result.
+///
+/// @param ptrToLhs  A pointer to the left hand side array or scalar
+/// @param ptrToRhs  A pointer to the right hand side array or scalar
+/// @param token     The arithmetic token representing the binary operation to perform
+/// @param builder   The current llvm IRBuilder
+///
+inline llvm::Value*
+vectorBinaryOperator(llvm::Value* ptrToLhs,
+                     llvm::Value* ptrToRhs,
+                     const ast::tokens::OperatorToken& token,
+                     llvm::IRBuilder<>& builder)
+{
+    assert(ast::tokens::operatorType(token) == ast::tokens::ARITHMETIC);
+
+    llvm::Type* lhsType = ptrToLhs->getType()->getContainedType(0);
+    llvm::Type* rhsType = ptrToRhs->getType()->getContainedType(0);
+    assert(lhsType->isArrayTy() || rhsType->isArrayTy());
+
+    if (lhsType->isArrayTy() && rhsType->isArrayTy() &&
+        lhsType->getArrayNumElements() != rhsType->getArrayNumElements()) {
+        OPENVDB_THROW(LLVMBinaryOperationError, "Unable to perform operation \""
+            + ast::tokens::operatorNameFromToken(token) + "\" on arrays of mismatching sizes.");
+    }
+
+    const unsigned size = static_cast<unsigned>(lhsType->isArrayTy() ?
+        lhsType->getArrayNumElements() : rhsType->getArrayNumElements());
+
+    llvm::Type* elementType = typePrecedence(
+        lhsType->isArrayTy() ? lhsType->getArrayElementType() : lhsType,
+        rhsType->isArrayTy() ? rhsType->getArrayElementType() : rhsType);
+
+    auto load = [&](llvm::Value* ptr, llvm::Type* type) -> llvm::Value* {
+        if (type->isArrayTy()) {
+            return vectorConversion(arrayToVector(ptr, builder), elementType, builder);
+        }
+        llvm::Value* scalar = arithmeticConversion(builder.CreateLoad(ptr), elementType, builder);
+        return builder.CreateVectorSplat(size, scalar);
+    };
+
+    llvm::Value* lhs = load(ptrToLhs, lhsType);
+    llvm::Value* rhs = load(ptrToRhs, rhsType);
+
+    const BinaryFunction llvmBinaryFunction = llvmBinaryConversion(elementType, token);
+    return vectorToArray(llvmBinaryFunction(builder, lhs, rhs), builder);
+}
+
 }
 }
 }
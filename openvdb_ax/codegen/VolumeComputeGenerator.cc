@@ -37,7 +37,9 @@
 #include "FunctionTypes.h"
 #include "Types.h"
 #include "Utils.h"
+#include "VolumeFunctions.h"
 
+#include <openvdb_ax/ast/Scanners.h>
 #include <openvdb_ax/Exceptions.h>
 
 namespace openvdb {
@@ -74,18 +76,58 @@ VolumeComputeGenerator::VolumeComputeGenerator(llvm::Module& module,
                                                std::vector<std::string>* const warnings)
     : ComputeGenerator(module, options, functionRegistry, warnings)
     , mVolumeVisitCount(0)
-    , mFunctionName(VolumeKernel::getDefaultName()) {}
+    , mFunctionName(VolumeKernel::getDefaultName())
+    , mStencilVolumes()
+    , mBufferedVolumes() {}
 
 void VolumeComputeGenerator::setFunctionName(const std::string& name)
 {
     mFunctionName = name;
 }
 
-void VolumeComputeGenerator::init(const ast::Tree&)
+const std::set<std::string>& VolumeComputeGenerator::bufferedVolumes() const
+{
+    return mBufferedVolumes;
+}
+
+void VolumeComputeGenerator::init(const ast::Tree& tree)
 {
     // Override the ComputeGenerators default init() with the custom
     // functions requires for Volume execution
 
+    // Find all volume values which are passed directly to stencil functions
+    // so that their accessors can be forwarded instead of their values
+
+    mStencilVolumes.clear();
+    ast::visitNodeType<ast::FunctionCall>(tree,
+        [&](const ast::FunctionCall& call) {
+            if (call.mArguments->mList.empty()) return;
+            if (!isStencilFunction(call.mFunction)) return;
+            const ast::AttributeValue* const volume =
+                dynamic_cast<const ast::AttributeValue*>(call.mArguments->mList.front().get());
+            if (volume) mStencilVolumes.insert(volume);
+        });
+
+    // Any volume which is written to and sampled by a stencil function must have
+    // its writes buffered, otherwise the results depend on the order in which
+    // voxels are processed
+
+    std::set<std::string> sampled;
+    for (const ast::AttributeValue* volume : mStencilVolumes) {
+        sampled.insert(volume->mAttribute->mName);
+    }
+
+    mBufferedVolumes.clear();
+    const auto insertIfSampled = [&](const ast::Variable::Ptr& variable) {
+        if (!std::dynamic_pointer_cast<ast::Attribute>(variable)) return;
+        if (sampled.count(variable->mName)) mBufferedVolumes.insert(variable->mName);
+    };
+
+    ast::visitNodeType<ast::AssignExpression>(tree,
+        [&](const ast::AssignExpression& node) { insertIfSampled(node.mVariable); });
+    ast::visitNodeType<ast::Crement>(tree,
+        [&](const ast::Crement& node) { insertIfSampled(node.mVariable); });
+
     using FunctionSignatureT = FunctionSignature<VolumeKernel::Signature>;
 
     // Use the function signature type to generate the llvm function
@@ -97,6 +139,21 @@ void VolumeComputeGenerator::init(const ast::Tree&)
 
     mFunction = volumeKernelSignature->toLLVMFunction(mModule);
 
+    // The custom data, coordinates and tables of accessors and transforms are only read
+    // by the kernel and are not accessible through any other argument. The tables may be
+    // null if empty.
+
+    const std::vector<llvm::Attribute::AttrKind> readOnly {
+        llvm::Attribute::NoAlias, llvm::Attribute::ReadOnly };
+    const std::vector<llvm::Attribute::AttrKind> readOnlyNonNull {
+        llvm::Attribute::NoAlias, llvm::Attribute::ReadOnly, llvm::Attribute::NonNull };
+
+    addArgumentAttributes(*mFunction, 0, readOnly);        // custom_data
+    addArgumentAttributes(*mFunction, 1, readOnlyNonNull); // coord_is
+    addArgumentAttributes(*mFunction, 2, readOnlyNonNull); // coord_ws
+    addArgumentAttributes(*mFunction, 3, readOnly);        // accessors
+    addArgumentAttributes(*mFunction, 4, readOnly);        // transforms
+
     // Set up arguments for initial entry
 
     llvm::Function::arg_iterator argIter = mFunction->arg_begin();
@@ -233,7 +290,9 @@ void VolumeComputeGenerator::visit(const ast::AssignExpression& node)
         accessorPtr, mLLVMArguments.get("coord_is"), rhs
     };
 
-    const FunctionBase::Ptr function = this->getFunction("setvoxel", mOptions, true);
+    const bool buffered = mBufferedVolumes.count(attribute->mName);
+    const FunctionBase::Ptr function =
+        this->getFunction(buffered ? "setvoxelbuffered" : "setvoxel", mOptions, true);
     function->execute(argumentValues, mLLVMArguments.map(), mBuilder, mModule);
 }
 
@@ -257,7 +316,7 @@ void VolumeComputeGenerator::visit(const ast::Crement& node)
 
     llvm::Value* temp = nullptr;
     if (node.mPost) {
-        temp = mBuilder.CreateAlloca(type);
+        temp = insertStaticAlloca(mBuilder, type);
         mBuilder.CreateStore(rhs, temp);
     }
 
@@ -286,7 +345,9 @@ void VolumeComputeGenerator::visit(const ast::Crement& node)
         lhs, mLLVMArguments.get("coord_is"), rhs
     };
 
-    const FunctionBase::Ptr function = this->getFunction("setvoxel", mOptions, true);
+    const bool buffered = mBufferedVolumes.count(node.mVariable->mName);
+    const FunctionBase::Ptr function =
+        this->getFunction(buffered ? "setvoxelbuffered" : "setvoxel", mOptions, true);
     function->execute(argumentValues, mLLVMArguments.map(), mBuilder, mModule);
 
     // decide what to put on the expression stack
@@ -297,7 +358,7 @@ void VolumeComputeGenerator::visit(const ast::Crement& node)
     }
     else {
         // pre-increment: put the incremented value on the expression stack
-        lhs = mBuilder.CreateAlloca(type);
+        lhs = insertStaticAlloca(mBuilder, type);
         mBuilder.CreateStore(rhs, lhs);
         mValues.push(lhs);
     }
@@ -309,6 +370,11 @@ void VolumeComputeGenerator::visit(const ast::FunctionCall& node)
     assert(node.mArguments.get() && ("Uninitialized expression list for " +
            node.mFunction).c_str());
 
+    if (this->isUserFunction(node.mFunction)) {
+        ComputeGenerator::visit(node);
+        return;
+    }
+
     const FunctionBase::Ptr function = this->getFunction(node.mFunction, mOptions, /*no internal access*/false);
     assert(function);
 
@@ -322,10 +388,16 @@ void VolumeComputeGenerator::visit(const ast::FunctionCall& node)
             "\" called within an invalid context");
     }
 
+    if (dynamic_cast<const StencilFunctionBase*>(function.get())) {
+        this->visitStencil(node, *function);
+        return;
+    }
+
     const size_t args = node.mArguments->mList.size();
 
     std::vector<llvm::Value*> arguments;
     argumentsFromStack(mValues, args, arguments);
+    this->demoteLiterals(node, arguments);
     parseDefaultArgumentState(arguments, mBuilder);
 
     std::vector<llvm::Value*> results;
@@ -335,7 +407,7 @@ void VolumeComputeGenerator::visit(const ast::FunctionCall& node)
     if (resultType != LLVMType<void>::get(mContext)) {
         // only required to allocate new data for the result type if its NOT a pointer
         if (!resultType->isPointerTy()) {
-            llvm::Value* resultStore = mBuilder.CreateAlloca(resultType);
+            llvm::Value* resultStore = insertStaticAlloca(mBuilder, resultType);
             mBuilder.CreateStore(result, resultStore);
             result = resultStore;
         }
@@ -361,8 +433,7 @@ void VolumeComputeGenerator::visit(const ast::Attribute& node)
     // index into the void* array of handles and load the value.
     // The result is a loaded void* value
 
-    llvm::Value* accessorPtr = mBuilder.CreateGEP(mLLVMArguments.get("accessors"), registeredIndex);
-    accessorPtr = mBuilder.CreateLoad(accessorPtr);
+    llvm::Value* accessorPtr = loadHandle(mBuilder, mLLVMArguments.get("accessors"), registeredIndex);
 
     // indicate the next value is an attribute
 
@@ -383,6 +454,11 @@ void VolumeComputeGenerator::visit(const ast::AttributeValue& node)
 
     --mVolumeVisitCount;
 
+    // if this volume is sampled by a stencil function, leave the accessor on
+    // the stack for the function call - see visitStencil()
+
+    if (mStencilVolumes.find(&node) != mStencilVolumes.end()) return;
+
     llvm::Value* accessorValue = mValues.top(); mValues.pop();
 
     // volume should have already been inserted - see visit(ast::Attribute)
@@ -398,22 +474,86 @@ void VolumeComputeGenerator::visit(const ast::AttributeValue& node)
 
     // retrieve volume transform
 
-    llvm::Value* transformPtr = mBuilder.CreateGEP(mLLVMArguments.get("transforms"), registeredIndex);
-    llvm::Value* transform = mBuilder.CreateLoad(transformPtr);
+    llvm::Value* transform = loadHandle(mBuilder, mLLVMArguments.get("transforms"), registeredIndex);
 
     llvm::Type* returnType = llvmTypeFromName(node.mAttribute->mType, mContext);
-    llvm::Value* returnValue = mBuilder.CreateAlloca(returnType);
+    llvm::Value* returnValue = insertStaticAlloca(mBuilder, returnType);
 
     const std::vector<llvm::Value*> args {
         accessorValue, transform, mLLVMArguments.get("coord_ws"), returnValue
     };
 
-    const FunctionBase::Ptr function = this->getFunction("getvoxel", mOptions, true);
+    const bool buffered = mBufferedVolumes.count(node.mAttribute->mName);
+    const FunctionBase::Ptr function =
+        this->getFunction(buffered ? "getvoxelbuffered" : "getvoxel", mOptions, true);
     function->execute(args, mLLVMArguments.map(), mBuilder, mModule, nullptr, /*add output args*/false);
 
     mValues.push(returnValue);
 }
 
+void VolumeComputeGenerator::visitStencil(const ast::FunctionCall& node,
+                                          const FunctionBase& function)
+{
+    const StencilFunctionBase& stencil = static_cast<const StencilFunctionBase&>(function);
+
+    const ast::AttributeValue* const volume = node.mArguments->mList.empty() ? nullptr :
+        dynamic_cast<const ast::AttributeValue*>(node.mArguments->mList.front().get());
+
+    if (!volume) {
+        OPENVDB_THROW(LLVMFunctionError, "\"" + node.mFunction +
+            "\" expects a volume attribute as its first argument.");
+    }
+
+    assert(mStencilVolumes.find(volume) != mStencilVolumes.end());
+
+    const ast::Attribute::Ptr& attribute = volume->mAttribute;
+    llvm::Type* volumeType = llvmTypeFromName(attribute->mType, mContext);
+    llvm::Type* outputType = stencil.outputType(volumeType);
+
+    if (!outputType) {
+        OPENVDB_THROW(LLVMTypeError, "Unable to call \"" + node.mFunction +
+            "\" on volume \"@" + attribute->mName + "\" of type \"" + attribute->mType + "\".");
+    }
+
+    std::vector<llvm::Value*> arguments;
+    argumentsFromStack(mValues, node.mArguments->mList.size(), arguments);
+
+    // the first argument is the volume accessor (see visit(ast::AttributeValue)).
+    // All remaining arguments are integer offsets
+
+    llvm::Value* accessorValue = arguments.front();
+    arguments.erase(arguments.begin());
+    parseDefaultArgumentState(arguments, mBuilder);
+
+    for (llvm::Value*& argument : arguments) {
+        if (!isScalarType(argument->getType())) {
+            OPENVDB_THROW(LLVMFunctionError, "\"" + node.mFunction +
+                "\" expects scalar offsets after the volume argument.");
+        }
+        argument = arithmeticConversion(argument, LLVMType<int32_t>::get(mContext), mBuilder);
+    }
+
+    // retrieve volume transform
+
+    const std::string globalName = getGlobalAttributeAccess(attribute->mName, attribute->mType);
+    assert(this->globals().exists(globalName));
+
+    llvm::Value* registeredIndex = llvm::cast<llvm::GlobalVariable>
+        (mModule.getOrInsertGlobal(globalName, LLVMType<int64_t>::get(mContext)));
+    registeredIndex = mBuilder.CreateLoad(registeredIndex);
+
+    llvm::Value* transform = loadHandle(mBuilder, mLLVMArguments.get("transforms"), registeredIndex);
+
+    llvm::Value* returnValue = insertStaticAlloca(mBuilder, outputType);
+
+    arguments.insert(arguments.begin(), { accessorValue, transform, mLLVMArguments.get("coord_is") });
+    arguments.emplace_back(returnValue);
+
+    stencil.execute(arguments, mLLVMArguments.map(), mBuilder, mModule, nullptr, /*add output args*/false);
+
+    mValues.push(returnValue);
+}
+
 
 }
 }
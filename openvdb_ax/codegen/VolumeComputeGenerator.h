@@ -42,6 +42,9 @@
 #include "ComputeGenerator.h"
 #include "FunctionTypes.h"
 
+#include <set>
+#include <unordered_set>
+
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
 namespace OPENVDB_VERSION_NAME {
@@ -109,6 +112,12 @@ struct VolumeComputeGenerator : public ComputeGenerator
 
     void setFunctionName(const std::string& name);
 
+    /// @brief  Returns the names of the volumes which are written to and also sampled at
+    ///         neighbouring voxels by the generated function. Writes to these volumes are
+    ///         made into shadow leaf buffers which must be swapped into their trees once
+    ///         all voxels have been processed. See LeafWriteBuffers
+    const std::set<std::string>& bufferedVolumes() const;
+
 protected:
 
     /// @brief initializes visitor.  Automatically called when visiting the tree's root node.
@@ -121,8 +130,20 @@ protected:
 
 private:
 
+    /// @brief  Generate a call to a function which samples the neighbourhood of the
+    ///         volume passed as its first argument. See StencilFunctionBase
+    void visitStencil(const ast::FunctionCall& node, const FunctionBase& function);
+
     size_t mVolumeVisitCount;
     std::string mFunctionName;
+
+    // Volume values which are the first argument of a stencil function call.
+    // The accessor of these volumes is passed to the function instead of the
+    // value of the current voxel
+    std::unordered_set<const ast::AttributeValue*> mStencilVolumes;
+
+    // Names of volumes which are written to and sampled by stencil functions
+    std::set<std::string> mBufferedVolumes;
 };
 
 }
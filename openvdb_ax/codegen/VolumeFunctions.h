@@ -54,7 +54,13 @@
 
 #include <openvdb_ax/version.h>
 
+#include <array>
+#include <cmath>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
@@ -230,6 +236,519 @@ private:
 
 };
 
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+
+/// @brief  Returns the calling thread's generation of the LeafNeighbourhood caches.
+///         Any cache filled under a different generation is considered stale.
+///
+inline uint64_t& leafNeighbourhoodGeneration()
+{
+    static thread_local uint64_t generation = 0;
+    return generation;
+}
+
+/// @brief  Invalidate every LeafNeighbourhood cache on the calling thread. Volume
+///         executors should call this before processing a new range of leaf nodes,
+///         as the values of the volumes being sampled may have changed.
+///
+inline void invalidateLeafNeighbourhoods()
+{
+    ++leafNeighbourhoodGeneration();
+}
+
+/// @brief  A per-thread cache of the values of a single leaf node padded by a one voxel
+///         border. Stencil functions sample the neighbours of the current voxel through
+///         this cache rather than through the accessor, so that the tree is only
+///         traversed once per leaf for every voxel in that leaf.
+///
+template <typename TreeT>
+struct LeafNeighbourhood
+{
+    using ValueT = typename TreeT::ValueType;
+    using LeafT = typename TreeT::LeafNodeType;
+    using AccessorT = typename openvdb::Grid<TreeT>::Accessor;
+
+    static const int32_t PAD = 1;
+    static const int32_t DIM = int32_t(LeafT::DIM) + 2 * PAD;
+
+    // The number of trees cached per thread, so that a kernel which samples several
+    // volumes of the same type does not evict the cache of one volume with another
+    static const size_t TREES = 4;
+
+    /// @brief  Returns the calling thread's cache of the tree of the given accessor. If
+    ///         the tree is not cached, the least recently assigned cache is reused.
+    inline static LeafNeighbourhood& local(const AccessorT& accessor)
+    {
+        static thread_local std::array<std::unique_ptr<LeafNeighbourhood>, TREES> caches;
+        static thread_local size_t next = 0;
+
+        const void* const tree = &(accessor.tree());
+        for (const std::unique_ptr<LeafNeighbourhood>& cache : caches) {
+            if (cache && cache->mTree == tree) return *cache;
+        }
+
+        std::unique_ptr<LeafNeighbourhood>& cache = caches[next];
+        next = (next + 1) % TREES;
+        if (!cache) cache.reset(new LeafNeighbourhood);
+        return *cache;
+    }
+
+    /// @brief  Returns the value at ijk, which is expected to be within the padded
+    ///         neighbourhood of the leaf containing centre. The neighbourhood is
+    ///         fetched if it is not already cached. Coordinates outside of the
+    ///         neighbourhood fall back to the accessor.
+    ///
+    /// @param  accessor  The accessor of the volume being sampled
+    /// @param  centre    The coordinate of the voxel currently being processed
+    /// @param  ijk       The coordinate to sample
+    ///
+    inline ValueT getValue(AccessorT& accessor,
+                           const openvdb::Coord& centre,
+                           const openvdb::Coord& ijk)
+    {
+        const openvdb::Coord origin = centre & ~(int32_t(LeafT::DIM) - 1);
+        if (origin != mOrigin || &(accessor.tree()) != mTree ||
+            mGeneration != leafNeighbourhoodGeneration()) {
+            this->fill(accessor, origin);
+        }
+
+        const int32_t i = ijk[0] - mOrigin[0] + PAD;
+        const int32_t j = ijk[1] - mOrigin[1] + PAD;
+        const int32_t k = ijk[2] - mOrigin[2] + PAD;
+
+        if (i < 0 || i >= DIM || j < 0 || j >= DIM || k < 0 || k >= DIM) {
+            return accessor.getValue(ijk);
+        }
+
+        return mData[(i * DIM + j) * DIM + k];
+    }
+
+private:
+    LeafNeighbourhood()
+        : mTree(nullptr)
+        , mOrigin()
+        , mGeneration(0) {}
+
+    inline void fill(AccessorT& accessor, const openvdb::Coord& origin)
+    {
+        static const int32_t LEAF_DIM = int32_t(LeafT::DIM);
+
+        // the interior can be copied directly from the leaf if it exists, otherwise
+        // the values are retrieved from the tile or background through the accessor
+
+        const LeafT* const leaf = accessor.probeConstLeaf(origin);
+
+        ValueT* data = mData;
+        openvdb::Coord ijk;
+        for (int32_t i = -PAD; i < LEAF_DIM + PAD; ++i) {
+            ijk[0] = origin[0] + i;
+            const bool interiorI = (i >= 0 && i < LEAF_DIM);
+            for (int32_t j = -PAD; j < LEAF_DIM + PAD; ++j) {
+                ijk[1] = origin[1] + j;
+                const bool interiorJ = interiorI && (j >= 0 && j < LEAF_DIM);
+                for (int32_t k = -PAD; k < LEAF_DIM + PAD; ++k) {
+                    ijk[2] = origin[2] + k;
+                    const bool interior = leaf && interiorJ && (k >= 0 && k < LEAF_DIM);
+                    *data++ = interior ? ValueT(leaf->getValue(ijk)) : ValueT(accessor.getValue(ijk));
+                }
+            }
+        }
+
+        mTree = &(accessor.tree());
+        mOrigin = origin;
+        mGeneration = leafNeighbourhoodGeneration();
+    }
+
+    const void* mTree;
+    openvdb::Coord mOrigin;
+    uint64_t mGeneration;
+    ValueT mData[DIM * DIM * DIM];
+};
+
+/// @brief  Samples the neighbours of the current voxel of a volume with value type
+///         ValueT through the calling thread's LeafNeighbourhood cache.
+///
+template <typename ValueT>
+struct VoxelStencil
+{
+    using GridT = typename openvdb::BoolGrid::ValueConverter<ValueT>::Type;
+    using NeighbourhoodT = LeafNeighbourhood<typename GridT::TreeType>;
+
+    VoxelStencil(void* accessor, const int32_t (*coord)[3])
+        : mAccessor(*static_cast<typename GridT::Accessor*>(accessor))
+        , mNeighbourhood(NeighbourhoodT::local(mAccessor))
+        , mCentre(coord[0]) {
+            assert(accessor);
+        }
+
+    /// @brief  Returns the value of the voxel at the given offset from the current voxel
+    inline ValueT operator()(const int32_t i, const int32_t j, const int32_t k) const
+    {
+        return mNeighbourhood.getValue(mAccessor, mCentre, mCentre.offsetBy(i, j, k));
+    }
+
+private:
+    typename GridT::Accessor& mAccessor;
+    NeighbourhoodT& mNeighbourhood;
+    const openvdb::Coord mCentre;
+};
+
+/// @brief  Per-thread shadow leaf buffers for a volume which is written to and also sampled
+///         at neighbouring voxels by the same kernel. Writes are redirected into a copy of
+///         the buffer of the leaf being written so that concurrent reads continue to see the
+///         original values. Buffers are only allocated for leaves which are written to and
+///         are swapped into the tree by the executor once every leaf has been processed.
+/// @note   Volume kernels only ever write to the voxel currently being processed, which
+///         means each leaf is written to by a single thread and its writes are contiguous.
+///
+template <typename TreeT>
+struct LeafWriteBuffers
+{
+    using ValueT = typename TreeT::ValueType;
+    using LeafT = typename TreeT::LeafNodeType;
+    using BufferT = typename LeafT::Buffer;
+    using AccessorT = typename openvdb::Grid<TreeT>::Accessor;
+    using BufferedLeaf = std::pair<LeafT*, std::unique_ptr<BufferT>>;
+
+    /// @brief  Returns the write buffers active on the calling thread, or a nullptr if
+    ///         writes should not be buffered. Set by the volume executor
+    inline static LeafWriteBuffers*& active()
+    {
+        static thread_local LeafWriteBuffers* buffers = nullptr;
+        return buffers;
+    }
+
+    LeafWriteBuffers() : mLeaves() {}
+
+    /// @brief  Set the value of a voxel in the shadow buffer of its leaf, allocating
+    ///         the shadow buffer from the current leaf values if necessary
+    inline void setValue(AccessorT& accessor, const openvdb::Coord& ijk, const ValueT& value)
+    {
+        if (mLeaves.empty() ||
+            (ijk & ~(int32_t(LeafT::DIM) - 1)) != mLeaves.back().first->origin()) {
+            LeafT* leaf = accessor.probeLeaf(ijk);
+            assert(leaf && "Buffered volume writes expect the voxel to be within a leaf node");
+            mLeaves.emplace_back(leaf, std::unique_ptr<BufferT>(new BufferT(leaf->buffer())));
+        }
+        mLeaves.back().second->setValue(LeafT::coordToOffset(ijk), value);
+    }
+
+    /// @brief  Returns the value of a voxel from the shadow buffer of its leaf if the
+    ///         leaf is currently being written to, otherwise from the tree
+    inline ValueT getValue(AccessorT& accessor, const openvdb::Coord& ijk) const
+    {
+        if (!mLeaves.empty() &&
+            (ijk & ~(int32_t(LeafT::DIM) - 1)) == mLeaves.back().first->origin()) {
+            return mLeaves.back().second->getValue(LeafT::coordToOffset(ijk));
+        }
+        return accessor.getValue(ijk);
+    }
+
+    /// @brief  Swap all shadow buffers into their leaf nodes, releasing the original
+    ///         leaf values
+    inline void swap()
+    {
+        for (BufferedLeaf& leaf : mLeaves) leaf.first->swap(*(leaf.second));
+        mLeaves.clear();
+    }
+
+private:
+    std::vector<BufferedLeaf> mLeaves;
+};
+
+struct SetVoxelBuffered : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("setvoxelbuffered", FunctionBase::Volume,
+        "Internal function for setting the value of a voxel of a volume which is also "
+        "sampled at neighbouring voxels. The value is written to a shadow leaf buffer.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new SetVoxelBuffered()); }
+
+    SetVoxelBuffered() : FunctionBase({
+        // pod types pass by value
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_buffered<double>),
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_buffered<float>),
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_buffered<int64_t>),
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_buffered<int32_t>),
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_buffered<int16_t>),
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_buffered<bool>),
+        // non-pod types pass by ptr
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_buffered_ptr<openvdb::Vec3d>),
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_buffered_ptr<openvdb::Vec3f>),
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_buffered_ptr<openvdb::Vec3i>)
+    }) {}
+
+private:
+    template <typename ValueT>
+    inline static void set_voxel_buffered_ptr(void* accessor, const int32_t (*coord)[3], const ValueT* value)
+    {
+        using GridType = typename openvdb::BoolGrid::ValueConverter<ValueT>::Type;
+        using AccessorType = typename GridType::Accessor;
+        using BuffersType = LeafWriteBuffers<typename GridType::TreeType>;
+
+        assert(accessor);
+        assert(coord);
+
+        AccessorType* const accessorPtr = static_cast<AccessorType* const>(accessor);
+        BuffersType* const buffers = BuffersType::active();
+
+        if (buffers) buffers->setValue(*accessorPtr, openvdb::Coord(coord[0]), *value);
+        else         accessorPtr->setValueOnly(openvdb::Coord(coord[0]), *value);
+    }
+
+    template <typename ValueT>
+    inline static void set_voxel_buffered(void* accessor, const int32_t (*coord)[3], const ValueT value)
+    {
+        set_voxel_buffered_ptr<ValueT>(accessor, coord, &value);
+    }
+};
+
+struct GetVoxelBuffered : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("getvoxelbuffered", FunctionBase::Volume,
+        "Internal function for getting the value of a voxel of a volume which is written "
+        "to through shadow leaf buffers.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new GetVoxelBuffered()); }
+
+    GetVoxelBuffered() : FunctionBase({
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel_buffered<double>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel_buffered<float>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel_buffered<int64_t>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel_buffered<int32_t>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel_buffered<int16_t>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel_buffered<bool>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel_buffered<openvdb::Vec3d>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel_buffered<openvdb::Vec3f>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel_buffered<openvdb::Vec3i>, 1)
+    }) {}
+
+private:
+    template <typename ValueT>
+    inline static void get_voxel_buffered(void* accessor, void* transform, const float (*coord)[3], ValueT* value)
+    {
+        using GridType = typename openvdb::BoolGrid::ValueConverter<ValueT>::Type;
+        using AccessorType = typename GridType::Accessor;
+        using BuffersType = LeafWriteBuffers<typename GridType::TreeType>;
+
+        assert(accessor);
+        assert(coord);
+        assert(transform);
+
+        AccessorType* const accessorPtr = static_cast<AccessorType* const>(accessor);
+        const openvdb::math::Transform* const transformPtr =
+                static_cast<const openvdb::math::Transform* const>(transform);
+        openvdb::Vec3d coordWS(*coord);
+        openvdb::Coord coordIS = transformPtr->worldToIndexCellCentered(coordWS);
+
+        const BuffersType* const buffers = BuffersType::active();
+        (*value) = buffers ? buffers->getValue(*accessorPtr, coordIS) : accessorPtr->getValue(coordIS);
+    }
+};
+
+/// @brief  Base class for volume functions which sample the neighbourhood of the current
+///         voxel. The first argument of a stencil function in AX must be a volume attribute,
+///         i.e. gradient(@density). The VolumeComputeGenerator replaces this argument with
+///         the volume's accessor, transform and the current index space coordinate. Any
+///         further arguments are integer offsets. The output argument is always last and
+///         is allocated by the generator with the type returned from outputType().
+///
+struct StencilFunctionBase : public FunctionBase
+{
+    /// @brief  Returns the llvm type of the output argument of this function when sampling
+    ///         a volume of the given value type, or a nullptr if the type is unsupported.
+    ///
+    /// @param  volumeType  The llvm value type of the volume being sampled
+    ///
+    virtual llvm::Type* outputType(llvm::Type* volumeType) const = 0;
+
+protected:
+    StencilFunctionBase(const FunctionList& list)
+        : FunctionBase(list) {}
+};
+
+/// @brief  Returns whether the identifier is that of a stencil function. This allows
+///         stencil calls to be found without instantiating the functions being called.
+///
+inline bool isStencilFunction(const std::string& identifier)
+{
+    return identifier == "gradient" ||
+        identifier == "laplacian" ||
+        identifier == "curvature" ||
+        identifier == "sample_offset";
+}
+
+struct Gradient : public StencilFunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("gradient", FunctionBase::Volume,
+        "Returns the world space gradient of a float or double volume at the current voxel, "
+        "computed with second order central differences.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Gradient()); }
+
+    Gradient() : StencilFunctionBase({
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_gradient<double>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_gradient<float>, 1)
+    }) {}
+
+    llvm::Type* outputType(llvm::Type* volumeType) const override final {
+        if (!volumeType->isFloatingPointTy()) return nullptr;
+        return llvm::ArrayType::get(volumeType, 3);
+    }
+
+private:
+    template <typename ValueT>
+    inline static void volume_gradient(void* accessor, void* transform,
+        const int32_t (*coord)[3], openvdb::math::Vec3<ValueT>* out)
+    {
+        assert(transform);
+        const VoxelStencil<ValueT> v(accessor, coord);
+        const openvdb::Vec3d voxelSize =
+            static_cast<const openvdb::math::Transform*>(transform)->voxelSize();
+
+        (*out)[0] = ValueT(double(v(1, 0, 0) - v(-1, 0, 0)) / (2.0 * voxelSize[0]));
+        (*out)[1] = ValueT(double(v(0, 1, 0) - v(0, -1, 0)) / (2.0 * voxelSize[1]));
+        (*out)[2] = ValueT(double(v(0, 0, 1) - v(0, 0, -1)) / (2.0 * voxelSize[2]));
+    }
+};
+
+struct Laplacian : public StencilFunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("laplacian", FunctionBase::Volume,
+        "Returns the world space laplacian of a float or double volume at the current voxel, "
+        "computed with second order central differences.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Laplacian()); }
+
+    Laplacian() : StencilFunctionBase({
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_laplacian<double>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_laplacian<float>, 1)
+    }) {}
+
+    llvm::Type* outputType(llvm::Type* volumeType) const override final {
+        if (!volumeType->isFloatingPointTy()) return nullptr;
+        return volumeType;
+    }
+
+private:
+    template <typename ValueT>
+    inline static void volume_laplacian(void* accessor, void* transform,
+        const int32_t (*coord)[3], ValueT* out)
+    {
+        assert(transform);
+        const VoxelStencil<ValueT> v(accessor, coord);
+        const openvdb::Vec3d voxelSize =
+            static_cast<const openvdb::math::Transform*>(transform)->voxelSize();
+
+        const double centre = 2.0 * double(v(0, 0, 0));
+        const double dxx = (double(v(1, 0, 0)) + double(v(-1, 0, 0)) - centre);
+        const double dyy = (double(v(0, 1, 0)) + double(v(0, -1, 0)) - centre);
+        const double dzz = (double(v(0, 0, 1)) + double(v(0, 0, -1)) - centre);
+
+        (*out) = ValueT(dxx / (voxelSize[0] * voxelSize[0]) +
+                        dyy / (voxelSize[1] * voxelSize[1]) +
+                        dzz / (voxelSize[2] * voxelSize[2]));
+    }
+};
+
+struct Curvature : public StencilFunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("curvature", FunctionBase::Volume,
+        "Returns the world space mean curvature of a float or double volume at the current "
+        "voxel, computed with second order central differences. Assumes a uniform voxel size. "
+        "Returns zero where the gradient vanishes.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Curvature()); }
+
+    Curvature() : StencilFunctionBase({
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_curvature<double>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_curvature<float>, 1)
+    }) {}
+
+    llvm::Type* outputType(llvm::Type* volumeType) const override final {
+        if (!volumeType->isFloatingPointTy()) return nullptr;
+        return volumeType;
+    }
+
+private:
+    template <typename ValueT>
+    inline static void volume_curvature(void* accessor, void* transform,
+        const int32_t (*coord)[3], ValueT* out)
+    {
+        assert(transform);
+        const VoxelStencil<ValueT> v(accessor, coord);
+
+        const double centre = 2.0 * double(v(0, 0, 0));
+
+        const double dx = 0.5 * (double(v(1, 0, 0)) - double(v(-1, 0, 0)));
+        const double dy = 0.5 * (double(v(0, 1, 0)) - double(v(0, -1, 0)));
+        const double dz = 0.5 * (double(v(0, 0, 1)) - double(v(0, 0, -1)));
+
+        const double normGradSqr = dx * dx + dy * dy + dz * dz;
+        if (normGradSqr <= 0.0) {
+            (*out) = ValueT(0);
+            return;
+        }
+
+        const double dxx = double(v(1, 0, 0)) + double(v(-1, 0, 0)) - centre;
+        const double dyy = double(v(0, 1, 0)) + double(v(0, -1, 0)) - centre;
+        const double dzz = double(v(0, 0, 1)) + double(v(0, 0, -1)) - centre;
+
+        const double dxy = 0.25 * (double(v(1, 1, 0)) - double(v(1, -1, 0)) -
+                                   double(v(-1, 1, 0)) + double(v(-1, -1, 0)));
+        const double dxz = 0.25 * (double(v(1, 0, 1)) - double(v(1, 0, -1)) -
+                                   double(v(-1, 0, 1)) + double(v(-1, 0, -1)));
+        const double dyz = 0.25 * (double(v(0, 1, 1)) - double(v(0, 1, -1)) -
+                                   double(v(0, -1, 1)) + double(v(0, -1, -1)));
+
+        const double alpha =
+            dx * dx * (dyy + dzz) + dy * dy * (dxx + dzz) + dz * dz * (dxx + dyy) -
+            2.0 * (dx * dy * dxy + dx * dz * dxz + dy * dz * dyz);
+
+        const double voxelSize =
+            static_cast<const openvdb::math::Transform*>(transform)->voxelSize()[0];
+
+        (*out) = ValueT(alpha / (2.0 * std::pow(normGradSqr, 1.5) * voxelSize));
+    }
+};
+
+struct SampleOffset : public StencilFunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("sample_offset", FunctionBase::Volume,
+        "Returns the value of a volume at the given integer index space offset from the "
+        "current voxel.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new SampleOffset()); }
+
+    SampleOffset() : StencilFunctionBase({
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_sample_offset<double>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_sample_offset<float>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_sample_offset<int64_t>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_sample_offset<int32_t>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_sample_offset<int16_t>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_sample_offset<bool>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_sample_offset<openvdb::Vec3d>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_sample_offset<openvdb::Vec3f>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(volume_sample_offset<openvdb::Vec3i>, 1)
+    }) {}
+
+    llvm::Type* outputType(llvm::Type* volumeType) const override final {
+        return volumeType;
+    }
+
+private:
+    template <typename ValueT>
+    inline static void volume_sample_offset(void* accessor, void* transform,
+        const int32_t (*coord)[3], const int32_t i, const int32_t j, const int32_t k,
+        ValueT* out)
+    {
+        const VoxelStencil<ValueT> v(accessor, coord);
+        (*out) = v(i, j, k);
+    }
+};
+
 }
 }
 }
@@ -30,10 +30,13 @@
 
 #include "Compiler.h"
 
+#include "Plugin.h"
 #include "PointExecutable.h"
 #include "VolumeExecutable.h"
 
+#include <openvdb_ax/ast/ConstantFolding.h>
 #include <openvdb_ax/ast/Scanners.h>
+#include <openvdb_ax/codegen/FunctionBitcode.h>
 #include <openvdb_ax/codegen/FunctionRegistry.h>
 #include <openvdb_ax/codegen/PointComputeGenerator.h>
 #include <openvdb_ax/codegen/VolumeComputeGenerator.h>
@@ -50,18 +53,21 @@
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/ManagedStatic.h> // llvm_shutdown
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/raw_os_ostream.h>
 #include <llvm/Support/SourceMgr.h> // SMDiagnostic
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
 
 // @note  As of adding support for LLVM 5.0 we not longer explicitly
 // perform standrd compiler passes (-std-compile-opts) based on the changes
 // to the opt binary in the llvm codebase (tools/opt.cpp). We also no
 // longer explicitly perform:
 //  - llvm::createStripSymbolsPass()
-// And have never performed any specific target machine analysis passes
+// Target machine analysis passes are performed for the host target
 //
 // @todo  Properly identify the IPO passes that we would benefit from using
 // as well as what user controls would otherwise be appropriate
@@ -75,6 +81,9 @@
 
 #include <tbb/mutex.h>
 
+#include <set>
+#include <sstream>
+
 
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
@@ -224,29 +233,122 @@ void addOptimizationPasses(llvm::legacy::PassManagerBase& passes,
 }
 
 
+/// Registers the vectorized versions of math functions provided by a vector math library,
+/// allowing the vectorizers to replace calls to math functions and intrinsics with them
+///
+void addVectorMathLibrary(llvm::TargetLibraryInfoImpl& tlii,
+                          const CompilerOptions::VectorMathLibrary library)
+{
+    using VectorMathLibrary = CompilerOptions::VectorMathLibrary;
+
+    switch (library) {
+        case VectorMathLibrary::SVML : {
+            tlii.addVectorizableFunctionsFromVecLib(llvm::TargetLibraryInfoImpl::SVML);
+            break;
+        }
+        case VectorMathLibrary::ACCELERATE : {
+            tlii.addVectorizableFunctionsFromVecLib(llvm::TargetLibraryInfoImpl::Accelerate);
+            break;
+        }
+        case VectorMathLibrary::LIBMVEC : {
+            const llvm::Triple triple(llvm::sys::getProcessTriple());
+            if (triple.getArch() != llvm::Triple::x86_64 || !triple.isOSLinux()) {
+                OPENVDB_THROW(LLVMTargetError, "The libmvec vector math library is only "
+                    "supported on x86_64 Linux.");
+            }
+
+            // libmvec is not linked by default, so load it to allow the JIT to resolve
+            // its symbols
+
+            std::string error;
+            if (llvm::sys::DynamicLibrary::LoadLibraryPermanently("libmvec.so.1", &error)) {
+                OPENVDB_THROW(LLVMInitialisationError, "Unable to load the libmvec vector "
+                    "math library: " + error);
+            }
+
+            // libmvec is not one of llvm's known vector libraries. Only its SSE variants
+            // are registered as these are available to all x86_64 targets
+
+            static const llvm::VecDesc libmvecFunctions[] = {
+                {"sin", "_ZGVbN2v_sin", 2},
+                {"llvm.sin.f64", "_ZGVbN2v_sin", 2},
+                {"cos", "_ZGVbN2v_cos", 2},
+                {"llvm.cos.f64", "_ZGVbN2v_cos", 2},
+                {"exp", "_ZGVbN2v_exp", 2},
+                {"llvm.exp.f64", "_ZGVbN2v_exp", 2},
+                {"log", "_ZGVbN2v_log", 2},
+                {"llvm.log.f64", "_ZGVbN2v_log", 2},
+                {"pow", "_ZGVbN2vv_pow", 2},
+                {"llvm.pow.f64", "_ZGVbN2vv_pow", 2},
+                {"sinf", "_ZGVbN4v_sinf", 4},
+                {"llvm.sin.f32", "_ZGVbN4v_sinf", 4},
+                {"cosf", "_ZGVbN4v_cosf", 4},
+                {"llvm.cos.f32", "_ZGVbN4v_cosf", 4},
+                {"expf", "_ZGVbN4v_expf", 4},
+                {"llvm.exp.f32", "_ZGVbN4v_expf", 4},
+                {"logf", "_ZGVbN4v_logf", 4},
+                {"llvm.log.f32", "_ZGVbN4v_logf", 4},
+                {"powf", "_ZGVbN4vv_powf", 4},
+                {"llvm.pow.f32", "_ZGVbN4vv_powf", 4}
+            };
+
+            tlii.addVectorizableFunctions(libmvecFunctions);
+            break;
+        }
+        case VectorMathLibrary::NONE :
+        default : {}
+    }
+}
+
+/// Returns a target machine for the host and initializes the module's target triple and
+/// data layout from it, giving the optimization passes access to the host's cost model.
+/// Returns a null pointer if no target is available, in which case only target independent
+/// optimisations are performed
+///
+std::unique_ptr<llvm::TargetMachine> initializeHostTarget(llvm::Module& module)
+{
+    llvm::EngineBuilder builder;
+    builder.setMCPU(llvm::sys::getHostCPUName());
+
+    std::unique_ptr<llvm::TargetMachine> targetMachine(builder.selectTarget());
+    if (!targetMachine) return nullptr;
+
+    module.setTargetTriple(targetMachine->getTargetTriple().str());
+    module.setDataLayout(targetMachine->createDataLayout());
+    return targetMachine;
+}
+
 void LLVMoptimise(llvm::Module* module,
                   const unsigned optLevel,
                   const unsigned sizeLevel,
+                  llvm::TargetMachine* targetMachine,
+                  const CompilerOptions::VectorMathLibrary vectorLibrary,
                   const bool verify = false)
 {
-    // Pass manager setup and IR optimisations - Do target independent optimisations
-    // only - i.e. the following do not require an llvm TargetMachine analysis pass
+    // Pass manager setup and IR optimisations. If a target machine is provided, its
+    // analysis passes are used to drive target dependent optimizations such as the
+    // vectorizers
 
     llvm::legacy::PassManager passes;
     const llvm::Triple moduleTriple(module->getTargetTriple());
     llvm::TargetLibraryInfoImpl tlii(moduleTriple);
+    addVectorMathLibrary(tlii, vectorLibrary);
     passes.add(new llvm::TargetLibraryInfoWrapperPass(tlii));
 
+    const llvm::TargetIRAnalysis targetAnalysis = targetMachine ?
+        targetMachine->getTargetIRAnalysis() : llvm::TargetIRAnalysis();
+
     // Add internal analysis passes from the target machine.
-    passes.add(llvm::createTargetTransformInfoWrapperPass(llvm::TargetIRAnalysis()));
+    passes.add(llvm::createTargetTransformInfoWrapperPass(targetAnalysis));
 
     llvm::legacy::FunctionPassManager functionPasses(module);
-    functionPasses.add(llvm::createTargetTransformInfoWrapperPass(llvm::TargetIRAnalysis()));
+    functionPasses.add(new llvm::TargetLibraryInfoWrapperPass(tlii));
+    functionPasses.add(llvm::createTargetTransformInfoWrapperPass(targetAnalysis));
 
     if (verify) functionPasses.add(llvm::createVerifierPass());
 
     addStandardLinkPasses(passes);
-    addOptimizationPasses(passes, functionPasses, nullptr, optLevel, sizeLevel);
+    addOptimizationPasses(passes, functionPasses, targetMachine, optLevel, sizeLevel);
 
     functionPasses.doInitialization();
     for (llvm::Function& function : *module) {
@@ -286,9 +388,11 @@ void initializeGlobalFunctions(const codegen::FunctionRegistry& registry,
             void* functionPtr = signature->functionPointer();
             if (!functionPtr) continue;
 
-            // llvmFunction may not exists if compiled without mLazyFunctions
+            // llvmFunction may not exists if compiled without mLazyFunctions. If its
+            // definition has been linked from the function bitcode, no mapping is required
+
             const llvm::Function* llvmFunction = module.getFunction(signature->symbolName());
-            if (!llvmFunction) continue;
+            if (!llvmFunction || !llvmFunction->isDeclaration()) continue;
 
             // error if updateGlobalMapping returned a previously mapped address, as we've
             // overwritten something
@@ -302,7 +406,11 @@ void initializeGlobalFunctions(const codegen::FunctionRegistry& registry,
     }
 }
 
-void optimiseAndVerify(llvm::Module* module, const bool verify, const CompilerOptions::OptLevel optLevel)
+void optimiseAndVerify(llvm::Module* module,
+                       const bool verify,
+                       const CompilerOptions::OptLevel optLevel,
+                       const CompilerOptions::VectorMathLibrary vectorLibrary,
+                       llvm::TargetMachine* targetMachine)
 {
     if (verify) {
         llvm::raw_os_ostream out(std::cout);
@@ -313,27 +421,27 @@ void optimiseAndVerify(llvm::Module* module, const bool verify, const CompilerOp
 
     switch (optLevel) {
         case CompilerOptions::OptLevel::O0 : {
-            LLVMoptimise(module, 0, 0, verify);
+            LLVMoptimise(module, 0, 0, targetMachine, vectorLibrary, verify);
             break;
         }
         case CompilerOptions::OptLevel::O1 : {
-            LLVMoptimise(module, 1, 0, verify);
+            LLVMoptimise(module, 1, 0, targetMachine, vectorLibrary, verify);
             break;
         }
         case CompilerOptions::OptLevel::O2 : {
-            LLVMoptimise(module, 2, 0, verify);
+            LLVMoptimise(module, 2, 0, targetMachine, vectorLibrary, verify);
             break;
         }
         case CompilerOptions::OptLevel::Os : {
-            LLVMoptimise(module, 2, 1, verify);
+            LLVMoptimise(module, 2, 1, targetMachine, vectorLibrary, verify);
             break;
         }
         case CompilerOptions::OptLevel::Oz : {
-            LLVMoptimise(module, 2, 2, verify);
+            LLVMoptimise(module, 2, 2, targetMachine, vectorLibrary, verify);
             break;
         }
         case CompilerOptions::OptLevel::O3 : {
-            LLVMoptimise(module, 3, 0, verify);
+            LLVMoptimise(module, 3, 0, targetMachine, vectorLibrary, verify);
             break;
         }
         case CompilerOptions::OptLevel::NONE :
@@ -389,6 +497,56 @@ void verifyTypedAccesses(const ast::Tree& tree)
     ast::visitNodeType<ast::ExternalVariable>(tree, externalOp);
 }
 
+/// @brief  Apply the "#pragma" directives of a syntax tree to a copy of the function
+///         options. Only "fastmath" is currently supported, which replaces the fast-math
+///         flags with the comma or whitespace separated list of flags that follows it.
+///         "fast" enables all flags and "off" disables them. Unknown pragmas are ignored.
+void applyPragmas(const ast::Tree& tree,
+                  FunctionOptions& options,
+                  std::vector<std::string>* warnings)
+{
+    for (const std::string& pragma : tree.mPragmas) {
+
+        std::string arguments(pragma);
+        std::replace(arguments.begin(), arguments.end(), ',', ' ');
+        std::istringstream stream(arguments);
+
+        std::string name;
+        stream >> name;
+
+        if (name != "fastmath") {
+            if (warnings) warnings->emplace_back("Ignoring unknown pragma \"" + pragma + "\".");
+            continue;
+        }
+
+        FunctionOptions::FastMathFlags flags;
+        std::string flag;
+
+        while (stream >> flag) {
+            if (flag == "nnan")           flags.mNoNaNs = true;
+            else if (flag == "ninf")      flags.mNoInfs = true;
+            else if (flag == "nsz")       flags.mNoSignedZeros = true;
+            else if (flag == "arcp")      flags.mAllowReciprocal = true;
+            else if (flag == "contract")  flags.mAllowContract = true;
+            else if (flag == "reassoc")   flags.mAllowReassociation = true;
+            else if (flag == "fast") {
+                flags.mNoNaNs = flags.mNoInfs = flags.mNoSignedZeros = true;
+                flags.mAllowReciprocal = flags.mAllowContract = true;
+                flags.mAllowReassociation = true;
+            }
+            else if (flag == "off") {
+                flags = FunctionOptions::FastMathFlags();
+            }
+            else {
+                OPENVDB_THROW(AXCompilerError, "Invalid flag \"" + flag + "\" in pragma \"" +
+                    pragma + "\". Expected nnan, ninf, nsz, arcp, contract, reassoc, fast or off.");
+            }
+        }
+
+        options.mFastMathFlags = flags;
+    }
+}
+
 template <typename RegistryT>
 inline typename RegistryT::Ptr
 registerAccesses(const codegen::SymbolTable& globals, const ast::Tree& tree)
@@ -510,6 +668,26 @@ registerExternalGlobals(const codegen::SymbolTable& globals, CustomData::Ptr& da
                 meta = data->getOrInsertData<TypedMetadata<math::Vec3<double>>>(name);
             if (meta) initializer = codegen::LLVMType<uintptr_t>::get(C, meta->value());
         }
+        else if (type == typeNameAsString<math::Mat3<float>>()) {
+            TypedMetadata<math::Mat3<float>>*
+                meta = data->getOrInsertData<TypedMetadata<math::Mat3<float>>>(name);
+            if (meta) initializer = codegen::LLVMType<uintptr_t>::get(C, meta->value());
+        }
+        else if (type == typeNameAsString<math::Mat3<double>>()) {
+            TypedMetadata<math::Mat3<double>>*
+                meta = data->getOrInsertData<TypedMetadata<math::Mat3<double>>>(name);
+            if (meta) initializer = codegen::LLVMType<uintptr_t>::get(C, meta->value());
+        }
+        else if (type == typeNameAsString<math::Mat4<float>>()) {
+            TypedMetadata<math::Mat4<float>>*
+                meta = data->getOrInsertData<TypedMetadata<math::Mat4<float>>>(name);
+            if (meta) initializer = codegen::LLVMType<uintptr_t>::get(C, meta->value());
+        }
+        else if (type == typeNameAsString<math::Mat4<double>>()) {
+            TypedMetadata<math::Mat4<double>>*
+                meta = data->getOrInsertData<TypedMetadata<math::Mat4<double>>>(name);
+            if (meta) initializer = codegen::LLVMType<uintptr_t>::get(C, meta->value());
+        }
         else {
             // grammar guarantees this is unreachable as long as all types are supported
             OPENVDB_THROW(AXCompilerError, "Unsupported $ parameter type \"" + type + "\".");
@@ -525,6 +703,53 @@ registerExternalGlobals(const codegen::SymbolTable& globals, CustomData::Ptr& da
     }
 }
 
+/// @brief Bind lookups of custom data with literal names to the address of the data. Unlike
+///        external variables, lookups never insert data. If no data of the expected type
+///        exists the address is left as zero, and the lookup is performed at runtime.
+/// @note  Custom data entries are never reallocated when their values are set, so the bound
+///        addresses remain valid until the custom data is reset.
+inline void
+registerLookupGlobals(const codegen::SymbolTable& globals, const CustomData::ConstPtr& data,
+    llvm::LLVMContext& C)
+{
+    std::string name, type;
+    for (const auto& global : globals.map()) {
+
+        const std::string& token = global.first;
+        if (!codegen::isGlobalLookupAccess(token, name, type)) continue;
+
+        // should always be a GlobalVariable.
+        assert(llvm::isa<llvm::GlobalVariable>(global.second));
+
+        llvm::GlobalVariable* variable = llvm::cast<llvm::GlobalVariable>(global.second);
+        assert(variable->getValueType() == codegen::LLVMType<uintptr_t>::get(C));
+        llvm::Constant* initializer = nullptr;
+
+        if (data) {
+            if (type == typeNameAsString<float>()) {
+                const TypedMetadata<float>* meta =
+                    data->getData<TypedMetadata<float>>(name);
+                if (meta) initializer = codegen::LLVMType<uintptr_t>::get(C, meta->value());
+            }
+            else if (type == typeNameAsString<math::Vec3<float>>()) {
+                const TypedMetadata<math::Vec3<float>>* meta =
+                    data->getData<TypedMetadata<math::Vec3<float>>>(name);
+                if (meta) initializer = codegen::LLVMType<uintptr_t>::get(C, meta->value());
+            }
+            else {
+                OPENVDB_THROW(AXCompilerError, "Unsupported lookup type \"" + type + "\".");
+            }
+        }
+
+        if (!initializer) {
+            initializer = llvm::ConstantInt::get(codegen::LLVMType<uintptr_t>::get(C), 0);
+        }
+
+        variable->setInitializer(initializer);
+        variable->setConstant(true); // is not written to at runtime
+    }
+}
+
 /// @brief Modifier class that "disables" attribute assignment statements inside of an AST.
 class ModifyVolumeAssignments : public ast::Modifier
 {
@@ -534,7 +759,8 @@ public:
         : mTargetVolAssignmentExpression(0)
         , mCurrentVolAssignmentExpression(0)
         , mVolumesAssigned()
-        , mVolumeAssignmentFound(false) {}
+        , mVolumeAssignmentFound(false)
+        , mReplacements() {}
 
     virtual ~ModifyVolumeAssignments() = default;
 
@@ -562,6 +788,7 @@ public:
             }
             else {
                replacement.reset(new ast::AttributeValue(attribute->copy()));
+               mReplacements.insert(replacement.get());
             }
 
             mCurrentVolAssignmentExpression++;
@@ -575,6 +802,7 @@ public:
     {
         mVolumeAssignmentFound = false;
         mCurrentVolAssignmentExpression = 0;
+        mReplacements.clear();
     }
 
     void incrementTargetVolumeAssignment()
@@ -588,6 +816,12 @@ public:
         return mVolumeAssignmentFound;
     }
 
+    /// Returns true if a node replaced an attribute assignment during the last AST traversal
+    bool isReplacement(const ast::Node& node) const
+    {
+        return mReplacements.count(&node) != 0;
+    }
+
     /// apends the list of names of volumes that have been assigned to during previous
     /// AST traversals
     void appendVolumesAssigned(std::vector<std::string>& volumes) const
@@ -603,6 +837,7 @@ private:
     int mCurrentVolAssignmentExpression;
     std::vector<std::string> mVolumesAssigned;
     bool mVolumeAssignmentFound;
+    std::set<const ast::Node*> mReplacements;
 };
 
 /// @brief class that encapsulates blocks of code generated for volume code.
@@ -613,7 +848,10 @@ public:
     VolumeCodeBlocks()
         : mBlockFunctionNames()
         , mBlockFunctionAddresses()
-        , mVolumesAssigned() {}
+        , mVolumesAssigned()
+        , mBufferedBlocks()
+        , mBlockReads()
+        , mBlockWrites() {}
 
     ~VolumeCodeBlocks() = default;
 
@@ -629,6 +867,41 @@ public:
         }
     }
 
+    /// Returns whether each block writes to a volume which it also samples at neighbouring
+    /// voxels, and so has its writes made into shadow leaf buffers
+    const std::vector<bool>& getBufferedBlocks() const
+    {
+        return mBufferedBlocks;
+    }
+
+    /// Returns, for each block, the indices of the earlier blocks which must have finished
+    /// executing before it can start. A block depends on an earlier block if either writes
+    /// to a volume which the other reads from or writes to.
+    std::vector<std::vector<size_t>> getBlockDependencies() const
+    {
+        auto intersects = [](const std::set<std::string>& a, const std::set<std::string>& b) {
+            for (const auto& name : a) {
+                if (b.count(name)) return true;
+            }
+            return false;
+        };
+
+        const size_t numBlocks = mBlockWrites.size();
+        std::vector<std::vector<size_t>> dependencies(numBlocks);
+
+        for (size_t j = 1; j < numBlocks; ++j) {
+            for (size_t i = 0; i < j; ++i) {
+                if (intersects(mBlockWrites[i], mBlockReads[j]) ||
+                    intersects(mBlockReads[i], mBlockWrites[j]) ||
+                    intersects(mBlockWrites[i], mBlockWrites[j])) {
+                    dependencies[j].emplace_back(i);
+                }
+            }
+        }
+
+        return dependencies;
+    }
+
     void
     compileBlocks(const ast::Tree& syntaxTree,
                   llvm::Module& module,
@@ -668,6 +941,47 @@ public:
             // increment "initial"/"base" volume assignment if we found another assignment
             if (modifier.volumeAssignmentFound()) {
                 modifier.incrementTargetVolumeAssignment();
+                mBufferedBlocks.push_back(!codeGenerator.bufferedVolumes().empty());
+
+                // record the volumes read from and written to by this block
+
+                mBlockReads.emplace_back();
+                mBlockWrites.emplace_back();
+                std::set<std::string>& reads = mBlockReads.back();
+                std::set<std::string>& writes = mBlockWrites.back();
+
+                // the assignments of other blocks have been replaced with attribute values,
+                // which are only read if their value is used rather than being a statement
+
+                std::set<const ast::Node*> statements;
+                ast::visitNodeType<ast::Block>(*tree,
+                    [&](const ast::Block& node) {
+                        for (const ast::Statement::Ptr& statement : node.mList) {
+                            statements.insert(statement.get());
+                        }
+                    });
+                ast::visitNodeType<ast::Loop>(*tree,
+                    [&](const ast::Loop& node) {
+                        statements.insert(node.mInitial.get());
+                        statements.insert(node.mIteration.get());
+                    });
+
+                ast::visitNodeType<ast::AttributeValue>(*tree,
+                    [&](const ast::AttributeValue& node) {
+                        if (modifier.isReplacement(node) && statements.count(&node)) return;
+                        reads.insert(node.mAttribute->mName);
+                    });
+                ast::visitNodeType<ast::AssignExpression>(*tree,
+                    [&](const ast::AssignExpression& node) {
+                        if (!std::dynamic_pointer_cast<ast::Attribute>(node.mVariable)) return;
+                        writes.insert(node.mVariable->mName);
+                    });
+                ast::visitNodeType<ast::Crement>(*tree,
+                    [&](const ast::Crement& node) {
+                        if (!std::dynamic_pointer_cast<ast::Attribute>(node.mVariable)) return;
+                        reads.insert(node.mVariable->mName);
+                        writes.insert(node.mVariable->mName);
+                    });
             }
 
             ++volumeCount;
@@ -717,6 +1031,9 @@ private:
     std::vector<std::vector<std::string> > mBlockFunctionNames;
     std::vector<std::map<std::string, uint64_t> > mBlockFunctionAddresses;
     std::vector<std::string> mVolumesAssigned;
+    std::vector<bool> mBufferedBlocks;
+    std::vector<std::set<std::string>> mBlockReads;
+    std::vector<std::set<std::string>> mBlockWrites;
 };
 
 
@@ -754,9 +1071,13 @@ Compiler::Compiler(const CompilerOptions& options,
     , mCompilerOptions(options)
     , mParser(parser)
     , mFunctionRegistry()
+    , mPlugins()
 {
     mContext.reset(new llvm::LLVMContext);
-    mFunctionRegistry = codegen::createStandardRegistry(options.mFunctionOptions);
+    // functions are only instantiated per compilation, so the compiler's registry only
+    // needs to refer to the shared standard definitions
+
+    mFunctionRegistry.reset(new codegen::FunctionRegistry(codegen::standardDefinitions()));
 }
 
 Compiler::UniquePtr Compiler::create(const CompilerOptions &options,
@@ -771,6 +1092,20 @@ void Compiler::setFunctionRegistry(std::unique_ptr<codegen::FunctionRegistry>&&
     mFunctionRegistry = std::move(functionRegistry);
 }
 
+void Compiler::loadPlugin(const std::string& path)
+{
+    const Plugin::Ptr plugin = Plugin::load(path);
+
+    // the current registry may be shared with other compilers, so the plugin's
+    // functions are inserted into a new registry which refers to it
+
+    codegen::FunctionRegistry::Ptr registry(new codegen::FunctionRegistry(mFunctionRegistry));
+    plugin->registerFunctions(*registry, mCompilerOptions.mFunctionOptions);
+
+    mFunctionRegistry = registry;
+    mPlugins.emplace_back(plugin);
+}
+
 
 template<>
 PointExecutable::Ptr
@@ -784,13 +1119,26 @@ Compiler::compile<PointExecutable>(const ast::Tree& syntaxTree,
 
     verifyTypedAccesses(*tree);
 
+    FunctionOptions options(mCompilerOptions.mFunctionOptions);
+    applyPragmas(*tree, options, warnings);
+
+    // instantiate functions into a registry for this compilation only so that the
+    // compiler's registry is never modified
+
+    codegen::FunctionRegistry functionRegistry(mFunctionRegistry);
+    if (!options.mLazyFunctions) functionRegistry.createAll(options);
+
+    // fold constants and remove dead code prior to accesses being registered
+
+    ast::foldConstants(*tree);
+
     // initialize the module and generate LLVM IR
 
     std::unique_ptr<llvm::Module> module(new llvm::Module("module", *mContext));
+    std::unique_ptr<llvm::TargetMachine> targetMachine = initializeHostTarget(*module);
 
     codegen::PointComputeGenerator
-        codeGenerator(*module, mCompilerOptions.mFunctionOptions,
-            *mFunctionRegistry, warnings);
+        codeGenerator(*module, options, functionRegistry, warnings);
     tree->accept(codeGenerator);
 
     // map accesses (always do this prior to optimising as globals may be removed)
@@ -800,6 +1148,15 @@ Compiler::compile<PointExecutable>(const ast::Tree& syntaxTree,
 
     CustomData::Ptr validCustomData(customData);
     registerExternalGlobals(codeGenerator.globals(), validCustomData, *mContext);
+    registerLookupGlobals(codeGenerator.globals(), validCustomData, *mContext);
+
+    // link the definitions of any C++ built-ins and plugin functions so that they may be inlined
+
+    codegen::linkFunctionBitcode(functionRegistry, *module);
+    for (const Plugin::Ptr& plugin : mPlugins) {
+        codegen::linkFunctionBitcode(functionRegistry, *module,
+            plugin->bitcode(), plugin->bitcodeSize(), plugin->path());
+    }
 
     // as P is accessed specially and not accessed via a global, need to add it to the registry
 
@@ -811,7 +1168,8 @@ Compiler::compile<PointExecutable>(const ast::Tree& syntaxTree,
 
     // get module, verify and create execution engine
     llvm::Module* modulePtr = module.get();
-    optimiseAndVerify(modulePtr, mCompilerOptions.mVerify, mCompilerOptions.mOptLevel);
+    optimiseAndVerify(modulePtr, mCompilerOptions.mVerify, mCompilerOptions.mOptLevel,
+        mCompilerOptions.mVectorMathLibrary, targetMachine.get());
 
     // create the llvm execution engine which will build our function pointers
 
@@ -819,6 +1177,7 @@ Compiler::compile<PointExecutable>(const ast::Tree& syntaxTree,
     std::shared_ptr<llvm::ExecutionEngine>
         executionEngine(llvm::EngineBuilder(std::move(module))
             .setEngineKind(llvm::EngineKind::JIT)
+            .setMCPU(llvm::sys::getHostCPUName())
             .setErrorStr(&error)
             .create());
 
@@ -828,7 +1187,7 @@ Compiler::compile<PointExecutable>(const ast::Tree& syntaxTree,
 
     // map functions
 
-    initializeGlobalFunctions(*mFunctionRegistry, *executionEngine, *modulePtr);
+    initializeGlobalFunctions(functionRegistry, *executionEngine, *modulePtr);
 
     // finalize mapping
 
@@ -865,31 +1224,53 @@ Compiler::compile<VolumeExecutable>(const ast::Tree& syntaxTree,
 {
     verifyTypedAccesses(syntaxTree);
 
+    FunctionOptions options(mCompilerOptions.mFunctionOptions);
+    applyPragmas(syntaxTree, options, warnings);
+
+    codegen::FunctionRegistry functionRegistry(mFunctionRegistry);
+    if (!options.mLazyFunctions) functionRegistry.createAll(options);
+
+    // fold constants and remove dead code prior to the volume blocks being split and
+    // accesses being registered
+
+    openvdb::SharedPtr<ast::Tree> tree(syntaxTree.copy());
+    ast::foldConstants(*tree);
+
     // initialize the module and generate LLVM IR
 
     std::unique_ptr<llvm::Module> module(new llvm::Module("module", *mContext));
+    std::unique_ptr<llvm::TargetMachine> targetMachine = initializeHostTarget(*module);
 
     VolumeCodeBlocks volumeCodeBlocks;
     codegen::SymbolTable globals;
 
-    volumeCodeBlocks.compileBlocks(syntaxTree, *module,
-        mCompilerOptions.mFunctionOptions, globals, *mFunctionRegistry, warnings);
+    volumeCodeBlocks.compileBlocks(*tree, *module,
+        options, globals, functionRegistry, warnings);
 
     // map accesses (always do this prior to optimising as globals may be removed)
 
     const VolumeRegistry::Ptr registry =
-        registerAccesses<VolumeRegistry>(globals, syntaxTree);
+        registerAccesses<VolumeRegistry>(globals, *tree);
 
     CustomData::Ptr validCustomData(customData);
     registerExternalGlobals(globals, validCustomData, *mContext);
+    registerLookupGlobals(globals, validCustomData, *mContext);
+
+    codegen::linkFunctionBitcode(functionRegistry, *module);
+    for (const Plugin::Ptr& plugin : mPlugins) {
+        codegen::linkFunctionBitcode(functionRegistry, *module,
+            plugin->bitcode(), plugin->bitcodeSize(), plugin->path());
+    }
 
     llvm::Module* modulePtr = module.get();
-    optimiseAndVerify(modulePtr, mCompilerOptions.mVerify, mCompilerOptions.mOptLevel);
+    optimiseAndVerify(modulePtr, mCompilerOptions.mVerify, mCompilerOptions.mOptLevel,
+        mCompilerOptions.mVectorMathLibrary, targetMachine.get());
 
     std::string error;
     std::shared_ptr<llvm::ExecutionEngine>
         executionEngine(llvm::EngineBuilder(std::move(module))
             .setEngineKind(llvm::EngineKind::JIT)
+            .setMCPU(llvm::sys::getHostCPUName())
             .setErrorStr(&error)
             .create());
 
@@ -899,7 +1280,7 @@ Compiler::compile<VolumeExecutable>(const ast::Tree& syntaxTree,
 
     // map functions
 
-    initializeGlobalFunctions(*mFunctionRegistry, *executionEngine,
+    initializeGlobalFunctions(functionRegistry, *executionEngine,
         *modulePtr);
 
     // finalize mapping
@@ -913,7 +1294,8 @@ Compiler::compile<VolumeExecutable>(const ast::Tree& syntaxTree,
     // create final executable object
     VolumeExecutable::Ptr
         executable(new VolumeExecutable(executionEngine, mContext, registry, validCustomData,
-            volumeCodeBlocks.functionsForAllBlocks(), volumesAssigned));
+            volumeCodeBlocks.functionsForAllBlocks(), volumesAssigned,
+            volumeCodeBlocks.getBufferedBlocks(), volumeCodeBlocks.getBlockDependencies()));
     return executable;
 }
 
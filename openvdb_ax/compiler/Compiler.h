@@ -44,6 +44,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 // forward
 namespace llvm {
@@ -68,6 +70,7 @@ class FunctionRegistry;
 }
 
 // forward
+class Plugin;
 class VolumeRegistry;
 
 /// @brief  Initializes llvm. Must be called before any AX compilation or execution is performed.
@@ -133,18 +136,31 @@ public:
 
     /// @brief Sets the compiler's function registry object.
     /// @param functionRegistry A unique pointer to a FunctionRegistry object.  The compiler will
-    ///        take ownership of the registry that was passed in.
+    ///        take ownership of the registry that was passed in. The registry is treated as
+    ///        a set of immutable definitions; functions are instantiated in a new registry
+    ///        for each compilation.
     /// @todo  Perhaps allow one to register individual functions into this class rather than the entire
     ///        registry at once, and/or allow one to extract a pointer to the registry and update it
     ///        manually.
     void setFunctionRegistry(std::unique_ptr<codegen::FunctionRegistry>&& functionRegistry);
 
+    /// @brief Load a native function plugin from a shared library and make its functions
+    ///        available to all subsequent compilations. Plugin functions are registered
+    ///        on top of the current function registry, so plugins should be loaded after
+    ///        any call to setFunctionRegistry(). If the plugin provides the bitcode of its
+    ///        functions, it is linked into each module so that they may be inlined.
+    /// @param path The path to the shared library
+    /// @throw AXCompilerError if the plugin can not be loaded, or LLVMFunctionError if it
+    ///        defines a function which already exists
+    void loadPlugin(const std::string& path);
+
 private:
 
     std::shared_ptr<llvm::LLVMContext> mContext;
     const CompilerOptions mCompilerOptions;
     const std::function<ast::Tree::Ptr(const char*)> mParser;
     std::shared_ptr<codegen::FunctionRegistry> mFunctionRegistry;
+    std::vector<std::shared_ptr<const Plugin>> mPlugins;
 };
 
 
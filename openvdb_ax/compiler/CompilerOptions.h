@@ -42,6 +42,28 @@ namespace ax {
 /// @brief Options that control how a function registry behaves
 struct FunctionOptions
 {
+    /// @brief Controls the precision of arithmetic performed with untyped floating point
+    ///        literals such as 0.5, which are double precision by default
+    enum class PrecisionPolicy
+    {
+        DEFAULT, // Literals are doubles, promoting any arithmetic they are used in to double
+        DEMOTE_LITERALS // Literals used in binary operations or function calls are demoted
+                        // to float unless another operand is explicitly double precision
+    };
+
+    /// @brief Individual llvm fast-math flags which are applied to all floating point
+    ///        arithmetic, including the arithmetic of functions generated from IR. These
+    ///        can be overridden per snippet with a "#pragma fastmath" directive.
+    struct FastMathFlags
+    {
+        bool mNoNaNs = false; // nnan - Assume arguments and results are never NaN
+        bool mNoInfs = false; // ninf - Assume arguments and results are never +/-Inf
+        bool mNoSignedZeros = false; // nsz - Treat the sign of a zero as insignificant
+        bool mAllowReciprocal = false; // arcp - Allow the use of a reciprocal over division
+        bool mAllowContract = false; // contract - Allow fusing into fused multiply-adds
+        bool mAllowReassociation = false; // reassoc - Allow reassociation of arithmetic
+    };
+
     // Function options
 
     /// @brief  When enabled, functions which have IR builder instruction definitions will
@@ -51,6 +73,26 @@ struct FunctionOptions
     ///         At the end of code generation, only functions which have been instantiated
     ///         will exist in the function map.
     bool mLazyFunctions = true;
+    /// @brief  When enabled, arithmetic on vectors and the dot, cross, length, lengthsq and
+    ///         normalize functions are generated using llvm vector types. Vectors are still
+    ///         stored as arrays and are only converted when they are loaded or stored.
+    bool mNativeVectors = false;
+    /// @brief  When enabled, rand() reseeds a thread local Mersenne Twister engine on every
+    ///         call, reproducing the random sequences of previous versions. By default, a
+    ///         stateless hash of the seed is generated inline, which is significantly faster
+    ///         but produces different values.
+    bool mLegacyRand = false;
+    /// @brief  When enabled, every point attribute accessed in a snippet is read once into
+    ///         a local at the start of the point kernel and, if written to, stored once at
+    ///         every exit, instead of calling into the attribute handle on every access.
+    bool mPromoteAttributes = false;
+    /// @brief  The precision policy for untyped floating point literals. When literals are
+    ///         demoted, a warning is reported for each literal which can not be exactly
+    ///         represented as a float.
+    PrecisionPolicy mPrecisionPolicy = PrecisionPolicy::DEFAULT;
+    /// @brief  The fast-math flags applied to floating point operations. All flags are
+    ///         disabled by default, retaining strict IEEE semantics.
+    FastMathFlags mFastMathFlags = FastMathFlags();
 };
 
 /// @brief Settings which control how a Compiler class object behaves
@@ -68,7 +110,21 @@ struct CompilerOptions
         O3  // Optimization level 3. Similar to clang -O3
     };
 
+    /// @brief Vector math libraries which calls to math functions may be mapped onto by
+    ///        the loop and SLP vectorizers
+    enum class VectorMathLibrary
+    {
+        NONE, // Do not map math functions to a vector library
+        LIBMVEC, // The GNU C library vector math library. Only supported on x86_64 Linux
+        SVML, // The Intel Short Vector Math Library
+        ACCELERATE // The Apple Accelerate framework
+    };
+
     OptLevel mOptLevel = OptLevel::O3;
+    /// @brief The vector math library to vectorize math functions with. The library must
+    ///        be available to the process at runtime, with the exception of LIBMVEC which
+    ///        is loaded on demand
+    VectorMathLibrary mVectorMathLibrary = VectorMathLibrary::NONE;
 
     /// @brief If this flag is true, the generated llvm module will be verified when compilation
     ///        occurs, resulting in an exception being thrown if it is not valid
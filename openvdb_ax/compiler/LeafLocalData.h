@@ -38,6 +38,10 @@
 #include <openvdb/points/PointDataGrid.h>
 #include <openvdb/points/PointGroup.h>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
 namespace OPENVDB_VERSION_NAME {
@@ -46,6 +50,62 @@ namespace ax {
 namespace compiler {
 
 
+/// @brief  Temporary memory for data created by a kernel, such as strings which are too
+///         large for the stack. Each allocation site of the kernel owns a slot of memory
+///         which is reused every time the site is executed and only grows when a larger
+///         allocation is requested. An arena which is reused by a thread across points,
+///         leaf nodes and loop iterations stops allocating once each site has reached its
+///         peak size.
+///
+class ScratchArena
+{
+public:
+    using UniquePtr = std::unique_ptr<ScratchArena>;
+
+    /// @brief  Construct an empty arena
+    ///
+    ScratchArena() : mSlots() {}
+
+    /// @brief  Return uninitialized memory of at least the given size for an allocation
+    ///         site. The memory remains valid until the same site allocates again or the
+    ///         arena is destroyed.
+    ///
+    /// @param  site  The index of the allocation site within the kernel
+    /// @param  size  The number of bytes to allocate
+    ///
+    inline char* allocate(const size_t site, const size_t size)
+    {
+        if (site >= mSlots.size()) mSlots.resize(site + 1);
+
+        Slot& slot = mSlots[site];
+        if (slot.mSize < size) {
+            // grow geometrically so that a site whose size varies reallocates rarely
+            slot.mSize = std::max(size, slot.mSize * 2);
+            slot.mData.reset(new char[slot.mSize]);
+        }
+        return slot.mData.get();
+    }
+
+    /// @brief  Returns the total number of bytes held by the arena
+    ///
+    inline size_t capacity() const {
+        size_t bytes = 0;
+        for (const Slot& slot : mSlots) bytes += slot.mSize;
+        return bytes;
+    }
+
+private:
+    struct Slot
+    {
+        Slot() : mData(), mSize(0) {}
+        std::unique_ptr<char[]> mData;
+        size_t mSize;
+    };
+
+    std::vector<Slot> mSlots;
+};
+
+
 /// @brief  Various functions can request the use and initialization of point data from within
 ///         the kernel that does not use the standard attribute handle methods. This data can
 ///         then be accessed after execution to perform post-processes such as adding new groups,
@@ -75,16 +135,21 @@ struct LeafLocalData
     /// @brief  Construct a new data object to keep track of various data objects
     ///         created per leaf by the point compute generator.
     ///
-    /// @param  count  The number of points within the current leaf, used to initialize
-    ///                the size of new arrays
+    /// @param  count    The number of points within the current leaf, used to initialize
+    ///                  the size of new arrays
+    /// @param  scratch  The arena used for temporary allocations. This is typically shared
+    ///                  by all leaf nodes processed by a thread. If null, an arena owned by
+    ///                  this object is created when first required.
     ///
-    LeafLocalData(const size_t count)
+    LeafLocalData(const size_t count, ScratchArena* scratch = nullptr)
         : mPointCount(count)
         , mArrays()
         , mOffset(0)
         , mHandles()
         , mStringMap()
-        , mPositions() {}
+        , mPositions()
+        , mScratch(scratch)
+        , mOwnedScratch() {}
 
     ////////////////////////////////////////////////////////////////////////
 
@@ -288,6 +353,25 @@ struct LeafLocalData
     }
 
 
+    ////////////////////////////////////////////////////////////////////////
+
+    /// Scratch methods
+
+    /// @brief  Return temporary memory of the given size for an allocation site from the
+    ///         scratch arena. The memory remains valid until the same site allocates again.
+    ///
+    /// @param  site  The index of the allocation site within the kernel
+    /// @param  size  The number of bytes to allocate
+    ///
+    inline char* allocateScratch(const size_t site, const size_t size) {
+        if (!mScratch) {
+            mOwnedScratch.reset(new ScratchArena);
+            mScratch = mOwnedScratch.get();
+        }
+        return mScratch->allocate(site, size);
+    }
+
+
 private:
 
     const size_t mPointCount;
@@ -296,6 +380,8 @@ private:
     std::map<std::string, std::unique_ptr<GroupHandleT>> mHandles;
     StringArrayMap mStringMap;
     PositionVector mPositions;
+    ScratchArena* mScratch;
+    ScratchArena::UniquePtr mOwnedScratch;
 };
 
 }
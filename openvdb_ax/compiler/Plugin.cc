@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file compiler/Plugin.cc
+///
+
+#include "Plugin.h"
+
+#include <openvdb_ax/Exceptions.h>
+
+#include <llvm/Support/DynamicLibrary.h>
+
+#include <sstream>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+
+Plugin::Ptr Plugin::load(const std::string& path)
+{
+    using VersionT = unsigned int(*)();
+    using BitcodeT = const char*(*)(size_t*);
+
+    // load permanently with global symbol visibility, so that any declarations in the
+    // plugin's bitcode can be resolved by the JIT
+
+    std::string error;
+    llvm::sys::DynamicLibrary library =
+        llvm::sys::DynamicLibrary::getPermanentLibrary(path.c_str(), &error);
+    if (!library.isValid()) {
+        OPENVDB_THROW(AXCompilerError, "Unable to load plugin \"" + path + "\": " + error);
+    }
+
+    const VersionT version =
+        reinterpret_cast<VersionT>(library.getAddressOfSymbol("openvdb_ax_plugin_version"));
+    const RegisterFunctionsT registerFunctions =
+        reinterpret_cast<RegisterFunctionsT>(library.getAddressOfSymbol("openvdb_ax_plugin_register"));
+
+    if (!version || !registerFunctions) {
+        OPENVDB_THROW(AXCompilerError, "\"" + path + "\" is not an AX plugin. "
+            "Plugins must be declared with OPENVDB_AX_PLUGIN.");
+    }
+
+    // plugins share C++ types with the library, so must match its version exactly
+
+    if (version() != OPENVDB_AX_LIBRARY_VERSION_NUMBER) {
+        std::ostringstream os;
+        os << "Plugin \"" << path << "\" was built against a different version of AX ("
+           << std::hex << version() << ", expected "
+           << OPENVDB_AX_LIBRARY_VERSION_NUMBER << ").";
+        OPENVDB_THROW(AXCompilerError, os.str());
+    }
+
+    const char* bitcode = nullptr;
+    size_t bitcodeSize = 0;
+
+    const BitcodeT getBitcode =
+        reinterpret_cast<BitcodeT>(library.getAddressOfSymbol("openvdb_ax_plugin_bitcode"));
+    if (getBitcode) bitcode = getBitcode(&bitcodeSize);
+    if (!bitcode) bitcodeSize = 0;
+
+    return Ptr(new Plugin(path, registerFunctions, bitcode, bitcodeSize));
+}
+
+void Plugin::registerFunctions(codegen::FunctionRegistry& registry,
+                               const FunctionOptions& options) const
+{
+    mRegisterFunctions(&registry, &options);
+}
+
+}
+}
+}
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file compiler/Plugin.h
+///
+/// @brief  Native function plugins. A plugin is a shared library which registers
+///         additional C++ functions with the FunctionRegistry of a Compiler, and which
+///         may optionally provide the LLVM bitcode of those functions so that they can
+///         be inlined into compiled kernels. A plugin exports its entry points with
+///         OPENVDB_AX_PLUGIN:
+///
+/// @code
+/// #include <openvdb_ax/compiler/Plugin.h>
+///
+/// void registerFunctions(openvdb::ax::codegen::FunctionRegistry& registry,
+///                        const openvdb::ax::FunctionOptions&)
+/// {
+///     registry.insert("falloff", Falloff::create);
+/// }
+///
+/// OPENVDB_AX_PLUGIN(registerFunctions)
+/// @endcode
+///
+///         Bitcode is provided by additionally declaring OPENVDB_AX_PLUGIN_BITCODE with
+///         a pointer to, and the size of, a buffer holding the bitcode of the plugin's
+///         function library as compiled by clang with -emit-llvm. Functions must be
+///         exported by the shared library for their bitcode definitions to be matched.
+///
+
+#ifndef OPENVDB_AX_COMPILER_PLUGIN_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_COMPILER_PLUGIN_HAS_BEEN_INCLUDED
+
+#include <openvdb_ax/compiler/CompilerOptions.h>
+#include <openvdb_ax/codegen/FunctionRegistry.h>
+#include <openvdb_ax/version.h>
+
+#include <openvdb/Platform.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/// @brief  Export the entry points of a function plugin. The given function is called
+///         with the registry into which the plugin's functions should be inserted.
+#define OPENVDB_AX_PLUGIN(registerFunctions) \
+    extern "C" OPENVDB_EXPORT unsigned int openvdb_ax_plugin_version() { \
+        return OPENVDB_AX_LIBRARY_VERSION_NUMBER; \
+    } \
+    extern "C" OPENVDB_EXPORT void openvdb_ax_plugin_register( \
+        openvdb::ax::codegen::FunctionRegistry* registry, \
+        const openvdb::ax::FunctionOptions* options) { \
+        registerFunctions(*registry, *options); \
+    }
+
+/// @brief  Export the LLVM bitcode of the functions of a plugin
+#define OPENVDB_AX_PLUGIN_BITCODE(data, size) \
+    extern "C" OPENVDB_EXPORT const char* openvdb_ax_plugin_bitcode(size_t* bitcodeSize) { \
+        *bitcodeSize = static_cast<size_t>(size); \
+        return reinterpret_cast<const char*>(data); \
+    }
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+
+/// @brief  A function plugin loaded from a shared library
+class Plugin
+{
+public:
+
+    using Ptr = std::shared_ptr<const Plugin>;
+
+    /// @brief  Load a plugin from the shared library at the given path. Libraries are
+    ///         never unloaded as compiled code may call into them at any time.
+    /// @throw  AXCompilerError if the library could not be loaded, does not export the
+    ///         plugin entry points or was built against a different version of AX
+    static Ptr load(const std::string& path);
+
+    /// @brief  Insert the functions of this plugin into a function registry
+    void registerFunctions(codegen::FunctionRegistry& registry,
+                           const FunctionOptions& options) const;
+
+    /// @brief  The LLVM bitcode of the plugin's functions, or a null pointer if the
+    ///         plugin does not provide any
+    inline const char* bitcode() const { return mBitcode; }
+    inline size_t bitcodeSize() const { return mBitcodeSize; }
+
+    inline const std::string& path() const { return mPath; }
+
+private:
+
+    using RegisterFunctionsT =
+        void(*)(codegen::FunctionRegistry*, const FunctionOptions*);
+
+    Plugin(const std::string& path, RegisterFunctionsT registerFunctions,
+        const char* bitcode, const size_t bitcodeSize)
+        : mPath(path)
+        , mRegisterFunctions(registerFunctions)
+        , mBitcode(bitcode)
+        , mBitcodeSize(bitcodeSize) {}
+
+    const std::string mPath;
+    const RegisterFunctionsT mRegisterFunctions;
+    const char* const mBitcode;
+    const size_t mBitcodeSize;
+};
+
+}
+}
+}
+
+#endif // OPENVDB_AX_COMPILER_PLUGIN_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
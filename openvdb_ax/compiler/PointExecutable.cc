@@ -47,6 +47,8 @@
 #include <openvdb/points/PointMask.h>
 #include <openvdb/points/PointMove.h>
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include <type_traits> // std::enable_if
 
 namespace openvdb {
@@ -63,6 +65,9 @@ using KernelFunctionPtr = std::add_pointer<codegen::PointKernel::Signature>::typ
 using FunctionTraitsT = codegen::PointKernel::FunctionTraitsT;
 using ReturnT = FunctionTraitsT::ReturnType;
 
+/// @brief  The scratch arenas of each thread, used for temporary string allocations
+using ScratchArenas = tbb::enumerable_thread_specific<compiler::ScratchArena>;
+
 
 /// @brief  The arguments of the generated function
 ///
@@ -115,11 +120,12 @@ struct PointFunctionArguments
 
     PointFunctionArguments(const CustomData::ConstPtr& customData,
                            const points::AttributeSet& attributeSet,
-                           const size_t pointCount)
+                           const size_t pointCount,
+                           compiler::ScratchArena* scratch = nullptr)
         : mCustomData(customData)
         , mAttributeSet(&attributeSet)
         , mIndex(0)
-        , mLeafLocalData(new compiler::LeafLocalData(pointCount))
+        , mLeafLocalData(new compiler::LeafLocalData(pointCount, scratch))
         , mVoidAttributeHandles()
         , mAttributeHandles()
         , mVoidGroupHandles()
@@ -265,6 +271,10 @@ addAttributeHandle(PointFunctionArguments& args,
     else if (valueType == openvdb::typeNameAsString<math::Vec3<int32_t>>()) addAttributeHandleTyped<math::Vec3<int32_t>>(args, leaf, name, write);
     else if (valueType == openvdb::typeNameAsString<math::Vec3<float>>())   addAttributeHandleTyped<math::Vec3<float>>(args, leaf, name, write);
     else if (valueType == openvdb::typeNameAsString<math::Vec3<double>>())  addAttributeHandleTyped<math::Vec3<double>>(args, leaf, name, write);
+    else if (valueType == openvdb::typeNameAsString<math::Mat3<float>>())   addAttributeHandleTyped<math::Mat3<float>>(args, leaf, name, write);
+    else if (valueType == openvdb::typeNameAsString<math::Mat3<double>>())  addAttributeHandleTyped<math::Mat3<double>>(args, leaf, name, write);
+    else if (valueType == openvdb::typeNameAsString<math::Mat4<float>>())   addAttributeHandleTyped<math::Mat4<float>>(args, leaf, name, write);
+    else if (valueType == openvdb::typeNameAsString<math::Mat4<double>>())  addAttributeHandleTyped<math::Mat4<double>>(args, leaf, name, write);
     else if (valueType == openvdb::typeNameAsString<Name>())                addAttributeHandleTyped<Name>(args, leaf, name, write);
     else {
         OPENVDB_THROW(TypeError, "Could not retrieve attribute '" + name + "' as it has an unknown value type '" + valueType + "'");
@@ -287,13 +297,15 @@ struct PointExecuterOp
                KernelFunctionPtr computeFunction,
                const math::Transform& transform,
                const GroupIndex* const groupIndex,
-               std::vector<compiler::LeafLocalData::UniquePtr>& leafLocalData)
+               std::vector<compiler::LeafLocalData::UniquePtr>& leafLocalData,
+               ScratchArenas& scratch)
         : mComputeFunction(computeFunction)
         , mCustomData(customData)
         , mTransform(transform)
         , mGroupIndex(groupIndex)
         , mAttributeRegistry(attributeRegistry)
-        , mLeafLocalData(leafLocalData) {}
+        , mLeafLocalData(leafLocalData)
+        , mScratch(scratch) {}
 
     // UseGroup = true
     template<bool UseG>
@@ -330,7 +342,11 @@ struct PointExecuterOp
 
     void operator()(LeafNode& leaf, size_t idx) const
     {
-        PointFunctionArguments args(mCustomData, leaf.attributeSet(), leaf.getLastValue());
+        // each allocation site reuses its own slot of the arena, so a single arena per
+        // thread is reused across all points and leaf nodes it processes
+
+        PointFunctionArguments args(mCustomData, leaf.attributeSet(), leaf.getLastValue(),
+            &mScratch.local());
 
         // add attributes based on the order and existence in the attribute registry
         // except for position, P, which is handled specially
@@ -404,6 +420,7 @@ private:
     const GroupIndex* const         mGroupIndex;
     const AttributeRegistry&        mAttributeRegistry;
     std::vector<compiler::LeafLocalData::UniquePtr>& mLeafLocalData;
+    ScratchArenas&                  mScratch;
 };
 
 void appendMissingAttributes(openvdb::points::PointDataGrid& grid,
@@ -471,6 +488,9 @@ void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
 
     LeafManagerT leafManager(grid.tree());
 
+    // the scratch arenas must outlive the leaf local data which references them
+
+    ScratchArenas scratch;
     std::vector<compiler::LeafLocalData::UniquePtr> leafLocalData(leafManager.leafCount());
 
     if (!usingGroup) {
@@ -488,13 +508,13 @@ void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
         if (!usingPosition) {
             PointExecuterOp</*UseTransform*/false, /*UseGroup*/false>
                 executerOp(*mAttributeRegistry, mCustomData, compute, transform, &groupIndex,
-                    leafLocalData);
+                    leafLocalData, scratch);
             leafManager.foreach(executerOp);
         }
         else {
             PointExecuterOp</*UseTransform*/true, /*UseGroup*/false>
                 executerOp(*mAttributeRegistry, mCustomData, compute, transform, &groupIndex,
-                    leafLocalData);
+                    leafLocalData, scratch);
             leafManager.foreach(executerOp);
         }
     }
@@ -513,14 +533,14 @@ void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
         if (!usingPosition && usingGroup) {
             PointExecuterOp</*UseTransform*/false, /*UseGroup*/true>
                 executerOp(*mAttributeRegistry, mCustomData, compute, transform, &groupIndex,
-                    leafLocalData);
+                    leafLocalData, scratch);
             leafManager.foreach(executerOp);
         }
         else {
             // usingGroup && usingPosition
             PointExecuterOp</*UseTransform*/true, /*UseGroup*/true>
                 executerOp(*mAttributeRegistry, mCustomData, compute, transform, &groupIndex,
-                    leafLocalData);
+                    leafLocalData, scratch);
             leafManager.foreach(executerOp);
         }
     }
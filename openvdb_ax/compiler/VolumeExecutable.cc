@@ -35,6 +35,7 @@
 // @TODO refactor so we don't have to include VolumeComputeGenerator.h,
 // but still have the functions defined in one place
 #include <openvdb_ax/codegen/VolumeComputeGenerator.h>
+#include <openvdb_ax/codegen/VolumeFunctions.h>
 
 #include <openvdb/Exceptions.h>
 #include <openvdb/tree/LeafManager.h>
@@ -45,8 +46,14 @@
 #include <openvdb/tree/ValueAccessor.h>
 #include <openvdb/tree/LeafManager.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
 
 namespace openvdb {
@@ -184,27 +191,93 @@ retrieveAccessor(VolumeFunctionArguments& args,
     }
 }
 
+/// @brief  An optional restriction of the active voxels a block is executed over.
+///         Voxels must lie within the bounding box and/or be active in the mask.
+///         If activate is true, the voxels of the mask are first activated in the
+///         volume being written to.
+/// @note   The mask is expected to be in the same index space as the volume being
+///         written to.
+struct VoxelRegion
+{
+    VoxelRegion(const math::CoordBBox* bbox = nullptr,
+                const MaskTree* mask = nullptr,
+                const bool activate = false)
+        : mBBox(bbox), mMask(mask), mActivate(activate && mask) {}
+
+    inline bool empty() const { return !mBBox && !mMask; }
+
+    const math::CoordBBox* mBBox;
+    const MaskTree* mMask;
+    bool mActivate;
+};
+
 template <typename TreeT>
 struct VolumeExecuterOp
 {
     using LeafManagerT = typename tree::LeafManager<TreeT>;
+    using LeafT = typename TreeT::LeafNodeType;
+    using LeafVecT = std::vector<LeafT*>;
+    using MaskAccessorT = tree::ValueAccessor<const MaskTree>;
+    using WriteBuffersT = codegen::LeafWriteBuffers<TreeT>;
+    using ThreadWriteBuffersT = tbb::enumerable_thread_specific<WriteBuffersT>;
 
     VolumeExecuterOp(const VolumeRegistry& volumeRegistry,
                      const CustomData::ConstPtr& customData,
                      const math::Transform& assignedVolumeTransform,
                      KernelFunctionPtr computeFunction,
-                     openvdb::GridPtrVec& grids)
+                     const openvdb::GridPtrVec& grids,
+                     ThreadWriteBuffersT* writeBuffers = nullptr,
+                     const VoxelRegion& region = VoxelRegion(),
+                     const LeafVecT* leaves = nullptr)
         : mVolumeRegistry(volumeRegistry)
         , mCustomData(customData)
         , mComputeFunction(computeFunction)
         , mGrids(grids)
-        , mTargetVolumeTransform(assignedVolumeTransform) {
+        , mTargetVolumeTransform(assignedVolumeTransform)
+        , mWriteBuffers(writeBuffers)
+        , mRegion(region)
+        , mLeaves(leaves) {
             assert(!mGrids.empty());
         }
 
+    /// @brief  Execute over every active voxel of a range of leaf nodes
     void operator()(const typename LeafManagerT::LeafRange& range) const
     {
         VolumeFunctionArguments args(mCustomData);
+        this->initialize(args);
+
+        for (auto leaf = range.begin(); leaf; ++leaf) {
+            this->execute(*leaf, args, nullptr);
+        }
+
+        this->finalize();
+    }
+
+    /// @brief  Execute over the active voxels of a range of the leaf nodes which
+    ///         intersect the voxel region
+    void operator()(const tbb::blocked_range<size_t>& range) const
+    {
+        assert(mLeaves);
+
+        VolumeFunctionArguments args(mCustomData);
+        this->initialize(args);
+
+        std::unique_ptr<MaskAccessorT> mask;
+        if (mRegion.mMask) mask.reset(new MaskAccessorT(*mRegion.mMask));
+
+        for (size_t n = range.begin(); n < range.end(); ++n) {
+            this->execute(*((*mLeaves)[n]), args, mask.get());
+        }
+
+        this->finalize();
+    }
+
+private:
+    inline void initialize(VolumeFunctionArguments& args) const
+    {
+        // values cached by stencil functions on this thread may be out of date
+
+        codegen::invalidateLeafNeighbourhoods();
 
         size_t location(0);
         for (const auto& iter : mVolumeRegistry.volumeData()) {
@@ -213,23 +286,227 @@ struct VolumeExecuterOp
             ++location;
         }
 
-        for (auto leaf = range.begin(); leaf; ++leaf) {
-            for (auto voxel = leaf->cbeginValueOn(); voxel; ++voxel) {
-                args.mCoord = voxel.getCoord();
-                args.mCoordWS = mTargetVolumeTransform.indexToWorld(args.mCoord);
-                args.bind(mComputeFunction)();
-            }
+        // redirect buffered writes on this thread into its shadow leaf buffers
+
+        if (mWriteBuffers) WriteBuffersT::active() = &(mWriteBuffers->local());
+    }
+
+    inline void finalize() const
+    {
+        if (mWriteBuffers) WriteBuffersT::active() = nullptr;
+    }
+
+    inline void execute(const LeafT& leaf,
+                        VolumeFunctionArguments& args,
+                        MaskAccessorT* mask) const
+    {
+        const math::CoordBBox* const bbox = mRegion.mBBox;
+
+        for (auto voxel = leaf.cbeginValueOn(); voxel; ++voxel) {
+            args.mCoord = voxel.getCoord();
+            if (bbox && !bbox->isInside(args.mCoord)) continue;
+            if (mask && !mask->isValueOn(args.mCoord)) continue;
+            args.mCoordWS = mTargetVolumeTransform.indexToWorld(args.mCoord);
+            args.bind(mComputeFunction)();
         }
     }
 
-private:
     const VolumeRegistry&       mVolumeRegistry;
     const CustomData::ConstPtr  mCustomData;
     KernelFunctionPtr           mComputeFunction;
     const openvdb::GridPtrVec&  mGrids;
     const math::Transform&      mTargetVolumeTransform;
+    ThreadWriteBuffersT*        mWriteBuffers;
+    const VoxelRegion           mRegion;
+    const LeafVecT*             mLeaves;
 };
 
+/// @brief  Append the leaf nodes of a tree which intersect a bounding box. If the
+///         bounding box covers fewer leaf node positions than the tree has leaf nodes,
+///         each position is probed directly, otherwise every leaf node is tested.
+template <typename TreeT>
+inline void
+collectLeaves(TreeT& tree,
+              const math::CoordBBox& bbox,
+              std::vector<typename TreeT::LeafNodeType*>& leaves)
+{
+    using LeafT = typename TreeT::LeafNodeType;
+    static const int32_t DIM = int32_t(LeafT::DIM);
+
+    if (bbox.empty()) return;
+
+    const math::Coord min = bbox.min() & ~(DIM - 1);
+    const math::Coord max = bbox.max() & ~(DIM - 1);
+    const math::Coord::ValueType nx = (max.x() - min.x()) / DIM + 1;
+    const math::Coord::ValueType ny = (max.y() - min.y()) / DIM + 1;
+    const math::Coord::ValueType nz = (max.z() - min.z()) / DIM + 1;
+    const Index64 positions = Index64(nx) * Index64(ny) * Index64(nz);
+
+    if (positions <= tree.leafCount()) {
+        math::Coord ijk;
+        for (ijk[0] = min.x(); ijk[0] <= max.x(); ijk[0] += DIM) {
+            for (ijk[1] = min.y(); ijk[1] <= max.y(); ijk[1] += DIM) {
+                for (ijk[2] = min.z(); ijk[2] <= max.z(); ijk[2] += DIM) {
+                    LeafT* leaf = tree.probeLeaf(ijk);
+                    if (leaf) leaves.emplace_back(leaf);
+                }
+            }
+        }
+    }
+    else {
+        for (auto leaf = tree.beginLeaf(); leaf; ++leaf) {
+            if (bbox.hasOverlap(leaf->getNodeBoundingBox())) leaves.emplace_back(leaf.getLeaf());
+        }
+    }
+}
+
+/// @brief  Append the leaf nodes of a tree which intersect the active voxels and
+///         tiles of a mask
+template <typename TreeT>
+inline void
+collectLeaves(TreeT& tree,
+              const MaskTree& mask,
+              std::vector<typename TreeT::LeafNodeType*>& leaves)
+{
+    for (auto leaf = mask.cbeginLeaf(); leaf; ++leaf) {
+        if (leaf->isEmpty()) continue;
+        typename TreeT::LeafNodeType* target = tree.probeLeaf(leaf->origin());
+        if (target) leaves.emplace_back(target);
+    }
+
+    // active tiles of the mask, excluding voxels
+
+    auto tile = mask.cbeginValueOn();
+    tile.setMaxDepth(MaskTree::ValueOnCIter::LEAF_DEPTH - 1);
+
+    math::CoordBBox bbox;
+    for (; tile; ++tile) {
+        tile.getBoundingBox(bbox);
+        collectLeaves(tree, bbox, leaves);
+    }
+}
+
+/// @brief  Activate the leaf voxels of a mask in a tree. Leaf nodes which don't exist
+///         are created in parallel from the value and active state of the tree at their
+///         origin and are then added to the tree serially.
+/// @note   The mask must not contain active tiles, which are voxelized on execution
+template <typename TreeT>
+inline void
+activateTopology(TreeT& tree, const MaskTree& topology)
+{
+    using LeafT = typename TreeT::LeafNodeType;
+
+    assert(!topology.hasActiveTiles());
+
+    tree::LeafManager<const MaskTree> manager(topology);
+    const size_t leafCount = manager.leafCount();
+    if (leafCount == 0) return;
+
+    std::vector<LeafT*> newLeaves(leafCount, nullptr);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, leafCount),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t n = range.begin(); n < range.end(); ++n) {
+                const MaskTree::LeafNodeType& maskLeaf = manager.leaf(n);
+                LeafT* leaf = tree.probeLeaf(maskLeaf.origin());
+                if (!leaf) {
+                    typename TreeT::ValueType value;
+                    const bool active = tree.probeValue(maskLeaf.origin(), value);
+                    leaf = new LeafT(maskLeaf.origin(), value, active);
+                    newLeaves[n] = leaf;
+                }
+                typename LeafT::NodeMaskType mask(leaf->getValueMask());
+                mask |= maskLeaf.getValueMask();
+                leaf->setValueMask(mask);
+            }
+        });
+
+    for (LeafT* leaf : newLeaves) {
+        if (leaf) tree.addLeaf(leaf);
+    }
+}
+
+/// @brief  Execute a compiled block over the active voxels of the given tree, optionally
+///         restricted to a region. If an instance of thread local write buffers is
+///         provided, their buffers are swapped into the tree once execution completes.
+template <typename TreeT>
+inline void
+executeVolumeBlock(TreeT& tree,
+                   const VolumeRegistry& volumeRegistry,
+                   const CustomData::ConstPtr& customData,
+                   const math::Transform& transform,
+                   KernelFunctionPtr compute,
+                   const openvdb::GridPtrVec& grids,
+                   const VoxelRegion& region,
+                   typename VolumeExecuterOp<TreeT>::ThreadWriteBuffersT* writeBuffers)
+{
+    if (region.mActivate) activateTopology(tree, *region.mMask);
+
+    if (region.empty()) {
+        tree::LeafManager<TreeT> leafManager(tree);
+        VolumeExecuterOp<TreeT> executerOp(volumeRegistry, customData, transform,
+            compute, grids, writeBuffers);
+        tbb::parallel_for(leafManager.leafRange(), executerOp);
+        return;
+    }
+
+    // only build the range from leaf nodes which intersect the region
+
+    typename VolumeExecuterOp<TreeT>::LeafVecT leaves;
+    if (region.mMask) collectLeaves(tree, *region.mMask, leaves);
+    else              collectLeaves(tree, *region.mBBox, leaves);
+
+    if (leaves.empty()) return;
+
+    VolumeExecuterOp<TreeT> executerOp(volumeRegistry, customData, transform,
+        compute, grids, writeBuffers, region, &leaves);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, leaves.size()), executerOp);
+}
+
+/// @brief  Execute a compiled block over the active voxels of the given tree
+template <typename TreeT>
+inline void
+executeVolumeBlock(TreeT& tree,
+                   const VolumeRegistry& volumeRegistry,
+                   const CustomData::ConstPtr& customData,
+                   const math::Transform& transform,
+                   KernelFunctionPtr compute,
+                   const openvdb::GridPtrVec& grids,
+                   const VoxelRegion& region)
+{
+    executeVolumeBlock(tree, volumeRegistry, customData, transform,
+        compute, grids, region, nullptr);
+}
+
+/// @brief  Execute a compiled block over the active voxels of the given tree. If buffered
+///         is true, the block writes to a volume it also samples at neighbouring voxels.
+///         Writes are then made into per-thread shadow leaf buffers which are only swapped
+///         into the tree once every voxel has been processed, so that all reads see the
+///         values from before the block was executed.
+template <typename TreeT>
+inline void
+executeVolumeBlock(TreeT& tree,
+                   const VolumeRegistry& volumeRegistry,
+                   const CustomData::ConstPtr& customData,
+                   const math::Transform& transform,
+                   KernelFunctionPtr compute,
+                   const openvdb::GridPtrVec& grids,
+                   const VoxelRegion& region,
+                   const bool buffered)
+{
+    if (!buffered) {
+        executeVolumeBlock(tree, volumeRegistry, customData, transform,
+            compute, grids, region, nullptr);
+        return;
+    }
+
+    typename VolumeExecuterOp<TreeT>::ThreadWriteBuffersT writeBuffers;
+    executeVolumeBlock(tree, volumeRegistry, customData, transform,
+        compute, grids, region, &writeBuffers);
+
+    for (auto& buffers : writeBuffers) buffers.swap();
+}
+
 void registerVolumes(const GridPtrVec &grids, GridPtrVec &writeableGrids, GridPtrVec &usableGrids,
                      const VolumeRegistry::VolumeDataVec& volumeData)
 {
@@ -263,17 +540,142 @@ void registerVolumes(const GridPtrVec &grids, GridPtrVec &writeableGrids, GridPt
     }
 }
 
+/// @brief  Apply an operator to the tree of a grid of any of the supported volume types
+template <typename OpT>
+inline void
+applyToTree(const GridBase& grid, OpT& op)
+{
+    if (grid.isType<BoolGrid>())        op(static_cast<const BoolGrid&>(grid).tree());
+    else if (grid.isType<Int32Grid>())  op(static_cast<const Int32Grid&>(grid).tree());
+    else if (grid.isType<Int64Grid>())  op(static_cast<const Int64Grid&>(grid).tree());
+    else if (grid.isType<FloatGrid>())  op(static_cast<const FloatGrid&>(grid).tree());
+    else if (grid.isType<DoubleGrid>()) op(static_cast<const DoubleGrid&>(grid).tree());
+    else if (grid.isType<Vec3IGrid>())  op(static_cast<const Vec3IGrid&>(grid).tree());
+    else if (grid.isType<Vec3fGrid>())  op(static_cast<const Vec3fGrid&>(grid).tree());
+    else if (grid.isType<Vec3dGrid>())  op(static_cast<const Vec3dGrid&>(grid).tree());
+    else if (grid.isType<MaskGrid>())   op(static_cast<const MaskGrid&>(grid).tree());
+    else {
+        OPENVDB_THROW(TypeError, "Could not retrieve volume '" + grid.getName()
+                                 + "' as it has an unknown value type");
+    }
+}
+
+struct TopologyUnionOp
+{
+    TopologyUnionOp(MaskTree& topology) : mTopology(topology) {}
+    template <typename TreeT>
+    inline void operator()(const TreeT& tree) { mTopology.topologyUnion(tree); }
+    MaskTree& mTopology;
+};
+
+struct TopologyIntersectionOp
+{
+    TopologyIntersectionOp(MaskTree& topology) : mTopology(topology) {}
+    template <typename TreeT>
+    inline void operator()(const TreeT& tree) { mTopology.topologyIntersection(tree); }
+    MaskTree& mTopology;
+};
+
+/// @brief  Build the topology which is executed over from the given volumes. Returns
+///         false if the topology of the volume being written to should be used.
+bool buildExecutionTopology(const VolumeExecutable::ExecutionTopology type,
+                            const std::string& name,
+                            const GridPtrVec& grids,
+                            const GridPtrVec& usableGrids,
+                            const VolumeRegistry::VolumeDataVec& volumeData,
+                            MaskTree& topology)
+{
+    using ExecutionTopology = VolumeExecutable::ExecutionTopology;
+
+    if (type == ExecutionTopology::ASSIGNED) return false;
+
+    TopologyUnionOp unionOp(topology);
+
+    if (type == ExecutionTopology::NAMED) {
+        for (const auto& grid : grids) {
+            if (grid->getName() != name) continue;
+            applyToTree(*grid, unionOp);
+            return true;
+        }
+        OPENVDB_THROW(LookupError, "Missing grid \"@" + name + "\" for the execution topology.");
+    }
+
+    // the volumes which are only read from
+
+    GridPtrVec inputs;
+    assert(usableGrids.size() == volumeData.size());
+    for (size_t i = 0; i < volumeData.size(); ++i) {
+        if (!volumeData[i].mWriteable) inputs.push_back(usableGrids[i]);
+    }
+
+    if (inputs.empty()) return false;
+
+    applyToTree(*inputs.front(), unionOp);
+
+    if (type == ExecutionTopology::UNION) {
+        for (size_t i = 1; i < inputs.size(); ++i) {
+            applyToTree(*inputs[i], unionOp);
+        }
+    }
+    else {
+        assert(type == ExecutionTopology::INTERSECTION);
+        TopologyIntersectionOp intersectionOp(topology);
+        for (size_t i = 1; i < inputs.size(); ++i) {
+            applyToTree(*inputs[i], intersectionOp);
+        }
+    }
+
+    return true;
+}
+
 } // anonymous namespace
 
 void VolumeExecutable::execute(const openvdb::GridPtrVec& grids) const
+{
+    this->execute(grids, nullptr, nullptr);
+}
+
+void VolumeExecutable::execute(const openvdb::GridPtrVec& grids,
+                               const math::CoordBBox& bbox) const
+{
+    this->execute(grids, &bbox, nullptr);
+}
+
+void VolumeExecutable::execute(const openvdb::GridPtrVec& grids,
+                               const MaskGrid& mask) const
+{
+    this->execute(grids, nullptr, &(mask.tree()));
+}
+
+void VolumeExecutable::execute(const openvdb::GridPtrVec& grids,
+                               const math::CoordBBox* bbox,
+                               const MaskTree* mask) const
 {
     openvdb::GridPtrVec usableGrids, writeableGrids;
 
     registerVolumes(grids, writeableGrids, usableGrids, mVolumeRegistry->volumeData());
 
-    const int numBlocks = mBlockFunctionAddresses.size();
+    // If a topology other than that of the assigned volumes is executed over, it is
+    // built as a mask and activated in each volume before it is written to. Only leaf
+    // voxels are executed over, so active tiles of the mask are voxelized. As volumes
+    // which are only read from are never modified, the mask is built once, unless it is
+    // the topology of a named volume which is also written to.
 
-    for (int i = 0; i < numBlocks; i++) {
+    auto buildRegion = [&](MaskTree& topology) -> VoxelRegion {
+        if (!buildExecutionTopology(mExecutionTopology, mTopologyName, grids, usableGrids,
+                mVolumeRegistry->volumeData(), topology)) {
+            return VoxelRegion(bbox, mask);
+        }
+        if (bbox) topology.clip(*bbox);
+        if (mask) topology.topologyIntersection(*mask);
+        topology.voxelizeActiveTiles();
+        return VoxelRegion(bbox, &topology, /*activate*/true);
+    };
+
+    MaskTree topology;
+    VoxelRegion region = buildRegion(topology);
+
+    auto executeBlock = [&](const int i) {
 
         const std::map<std::string, uint64_t>& blockFunctions = mBlockFunctionAddresses.at(i);
 
@@ -306,74 +708,123 @@ void VolumeExecutable::execute(const openvdb::GridPtrVec& grids) const
         // We execute over the topology of the grid currently being modified.  To do this, we need
         // a typed tree and leaf manager
 
+        const bool buffered = i < int(mBufferedBlocks.size()) && mBufferedBlocks[i];
+
         if (gridToModify->isType<BoolGrid>()) {
             BoolGrid::Ptr typed = StaticPtrCast<BoolGrid>(gridToModify);
-            tree::LeafManager<BoolTree> leafManager(typed->tree());
-            VolumeExecuterOp<BoolTree> executerOp(*mVolumeRegistry, mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
+            executeVolumeBlock(typed->tree(), *mVolumeRegistry, mCustomData, *writeTransform,
+                compute, usableGrids, region, buffered);
         }
         else if (gridToModify->isType<Int32Grid>()) {
             Int32Grid::Ptr typed = StaticPtrCast<Int32Grid>(gridToModify);
-            tree::LeafManager<Int32Tree> leafManager(typed->tree());
-            VolumeExecuterOp<Int32Tree> executerOp(*mVolumeRegistry, mCustomData, *writeTransform,
-                 compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
+            executeVolumeBlock(typed->tree(), *mVolumeRegistry, mCustomData, *writeTransform,
+                compute, usableGrids, region, buffered);
         }
         else if (gridToModify->isType<Int64Grid>()) {
             Int64Grid::Ptr typed = StaticPtrCast<Int64Grid>(gridToModify);
-            tree::LeafManager<Int64Tree> leafManager(typed->tree());
-            VolumeExecuterOp<Int64Tree> executerOp(*mVolumeRegistry, mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
+            executeVolumeBlock(typed->tree(), *mVolumeRegistry, mCustomData, *writeTransform,
+                compute, usableGrids, region, buffered);
         }
         else if (gridToModify->isType<FloatGrid>()) {
             FloatGrid::Ptr typed = StaticPtrCast<FloatGrid>(gridToModify);
-            tree::LeafManager<FloatTree> leafManager(typed->tree());
-            VolumeExecuterOp<FloatTree> executerOp(*mVolumeRegistry, mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
+            executeVolumeBlock(typed->tree(), *mVolumeRegistry, mCustomData, *writeTransform,
+                compute, usableGrids, region, buffered);
         }
         else if (gridToModify->isType<DoubleGrid>()) {
             DoubleGrid::Ptr typed = StaticPtrCast<DoubleGrid>(gridToModify);
-            tree::LeafManager<DoubleTree> leafManager(typed->tree());
-            VolumeExecuterOp<DoubleTree> executerOp(*mVolumeRegistry, mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
+            executeVolumeBlock(typed->tree(), *mVolumeRegistry, mCustomData, *writeTransform,
+                compute, usableGrids, region, buffered);
         }
         else if (gridToModify->isType<Vec3IGrid>()) {
             Vec3IGrid::Ptr typed = StaticPtrCast<Vec3IGrid>(gridToModify);
-            tree::LeafManager<Vec3ITree> leafManager(typed->tree());
-            VolumeExecuterOp<Vec3ITree> executerOp(*mVolumeRegistry, mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
+            executeVolumeBlock(typed->tree(), *mVolumeRegistry, mCustomData, *writeTransform,
+                compute, usableGrids, region, buffered);
         }
         else if (gridToModify->isType<Vec3fGrid>()) {
             Vec3fGrid::Ptr typed = StaticPtrCast<Vec3fGrid>(gridToModify);
-            tree::LeafManager<Vec3fTree> leafManager(typed->tree());
-            VolumeExecuterOp<Vec3fTree> executerOp(*mVolumeRegistry, mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
+            executeVolumeBlock(typed->tree(), *mVolumeRegistry, mCustomData, *writeTransform,
+                compute, usableGrids, region, buffered);
         }
         else if (gridToModify->isType<Vec3dGrid>()) {
             Vec3dGrid::Ptr typed = StaticPtrCast<Vec3dGrid>(gridToModify);
-            tree::LeafManager<Vec3dTree> leafManager(typed->tree());
-            VolumeExecuterOp<Vec3dTree> executerOp(*mVolumeRegistry, mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
+            executeVolumeBlock(typed->tree(), *mVolumeRegistry, mCustomData, *writeTransform,
+                compute, usableGrids, region, buffered);
         }
         else if (gridToModify->isType<MaskGrid>()) {
+            // mask grids are written through bool accessors, see retrieveAccessor(). As
+            // the shadow leaf buffers of these writes would be those of a bool tree, mask
+            // grids cannot be written to while they are sampled by stencil functions
+            if (buffered) {
+                OPENVDB_THROW(TypeError, "Unable to write to mask grid '" +
+                    gridToModify->getName() + "' as it is also sampled at neighbouring "
+                    "voxels. Buffered writes are not supported for mask grids.");
+            }
             MaskGrid::Ptr typed = StaticPtrCast<MaskGrid>(gridToModify);
-            tree::LeafManager<MaskTree> leafManager(typed->tree());
-            VolumeExecuterOp<MaskTree> executerOp(*mVolumeRegistry, mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
+            executeVolumeBlock(typed->tree(), *mVolumeRegistry, mCustomData, *writeTransform,
+                compute, usableGrids, region);
         }
         else {
             OPENVDB_THROW(TypeError, "Could not retrieve volume '" + gridToModify->getName()
                                      + "' as it has an unknown value type");
         }
+    };
+
+    const int numBlocks = mBlockFunctionAddresses.size();
+
+    // Blocks which follow a write to the named topology volume execute over its new
+    // topology. As this isn't known to the block dependencies, blocks are executed in
+    // order and the topology is rebuilt after each of these writes.
+
+    const bool namedTopologyWritten = region.mActivate &&
+        mExecutionTopology == ExecutionTopology::NAMED &&
+        std::find(mAssignedVolumes.cbegin(), mAssignedVolumes.cend(), mTopologyName) !=
+            mAssignedVolumes.cend();
+
+    if (namedTopologyWritten) {
+        for (int i = 0; i < numBlocks; i++) {
+            executeBlock(i);
+            if (mAssignedVolumes[i] != mTopologyName) continue;
+            topology.clear();
+            region = buildRegion(topology);
+        }
+        return;
+    }
+
+    if (numBlocks <= 1 || mBlockDependencies.size() != size_t(numBlocks)) {
+        for (int i = 0; i < numBlocks; i++) executeBlock(i);
+        return;
     }
+
+    // Execute blocks which don't depend on each other concurrently. Each block is only
+    // spawned once all of the blocks it depends on have completed, so that blocks which
+    // read from or write to the same volumes keep their program order.
+
+    std::vector<std::vector<size_t>> successors(numBlocks);
+    std::vector<std::atomic<size_t>> remaining(numBlocks);
+
+    for (size_t i = 0; i < size_t(numBlocks); ++i) {
+        remaining[i] = mBlockDependencies[i].size();
+        for (const size_t dependency : mBlockDependencies[i]) {
+            assert(dependency < i);
+            successors[dependency].emplace_back(i);
+        }
+    }
+
+    tbb::task_group group;
+    std::function<void(const size_t)> spawn = [&](const size_t i) {
+        group.run([&, i]() {
+            executeBlock(int(i));
+            for (const size_t successor : successors[i]) {
+                if (--remaining[successor] == 0) spawn(successor);
+            }
+        });
+    };
+
+    for (size_t i = 0; i < size_t(numBlocks); ++i) {
+        if (remaining[i] == 0) spawn(i);
+    }
+
+    group.wait();
 }
 
 }
@@ -64,6 +64,15 @@ public:
     using Ptr = std::shared_ptr<VolumeExecutable>;
     using Registry = VolumeRegistry;
 
+    /// @brief The active voxel topology which each block of code is executed over
+    enum class ExecutionTopology
+    {
+        ASSIGNED,     // The active voxels of the volume being written to
+        UNION,        // The union of the active voxels of all volumes which are only read
+        INTERSECTION, // The intersection of the active voxels of all volumes which are only read
+        NAMED         // The active voxels of a named volume
+    };
+
     /// @brief Constructor
     /// @param exeEngine Shared pointer to an llvm::ExecutionEngine object used to build functions.
     ///        context should be the associated llvm context
@@ -74,6 +83,12 @@ public:
     /// @param functionAddresses A Vector of maps of function names to physical memory addresses which were built
     ///        by llvm using exeEngine
     /// @param assignedVolumes Vector of names of volumes which are written to, in order.
+    /// @param bufferedBlocks Whether each block writes to a volume which it also samples at
+    ///        neighbouring voxels. Writes of these blocks are made into shadow leaf buffers
+    ///        which are swapped in once the block has been executed.
+    /// @param blockDependencies For each block, the indices of the earlier blocks which must
+    ///        have finished executing before it can start. Blocks which don't depend on each
+    ///        other are executed concurrently. If empty, blocks are executed in order.
     /// @note  This object is normally be constructed by the Compiler::compile method, rather
     ///        than directly
     VolumeExecutable(const std::shared_ptr<const llvm::ExecutionEngine>& exeEngine,
@@ -81,21 +96,79 @@ public:
                      const Registry::ConstPtr& volumeRegistry,
                      const CustomData::ConstPtr& customData,
                      const std::vector<std::map<std::string, uint64_t>>& functionAddresses,
-                     const std::vector<std::string>& assignedVolumes)
+                     const std::vector<std::string>& assignedVolumes,
+                     const std::vector<bool>& bufferedBlocks = std::vector<bool>(),
+                     const std::vector<std::vector<size_t>>& blockDependencies =
+                        std::vector<std::vector<size_t>>())
         : mContext(context)
         , mExecutionEngine(exeEngine)
         , mVolumeRegistry(volumeRegistry)
         , mCustomData(customData)
         , mBlockFunctionAddresses(functionAddresses)
-        , mAssignedVolumes(assignedVolumes) {}
+        , mAssignedVolumes(assignedVolumes)
+        , mBufferedBlocks(bufferedBlocks)
+        , mBlockDependencies(blockDependencies)
+        , mExecutionTopology(ExecutionTopology::ASSIGNED)
+        , mTopologyName() {}
 
     ~VolumeExecutable() = default;
 
+    /// @brief Set the active voxel topology which is executed over
+    /// @param topology The topology to execute over
+    /// @param name The name of the volume whose topology is used when the topology is
+    ///        ExecutionTopology::NAMED. This volume must be provided on execution but
+    ///        does not need to be accessed by the AX code
+    /// @note  For all topologies other than ExecutionTopology::ASSIGNED, the topology is
+    ///        activated in the volume being written to and each block is executed over
+    ///        exactly those voxels. New leaf nodes are created in parallel, without
+    ///        copying the values of the input volumes. If no volumes are only read from,
+    ///        ExecutionTopology::UNION and ExecutionTopology::INTERSECTION fall back to
+    ///        the assigned topology. Active tiles of the topology are voxelized in the
+    ///        volume being written to, whereas, as with the assigned topology, active tiles
+    ///        of that volume are not executed over. If the named volume is also written to,
+    ///        blocks are executed in order and later blocks use its updated topology.
+    inline void setExecutionTopology(const ExecutionTopology topology,
+                                     const std::string& name = "")
+    {
+        mExecutionTopology = topology;
+        mTopologyName = name;
+    }
+
+    /// @brief Returns the active voxel topology which is executed over
+    inline ExecutionTopology getExecutionTopology() const { return mExecutionTopology; }
+
+    /// @brief Returns, for each block, the indices of the earlier blocks which must have
+    ///        finished executing before it can start
+    inline const std::vector<std::vector<size_t>>& getBlockDependencies() const
+    {
+        return mBlockDependencies;
+    }
+
     /// @brief Execute AX code on target grids
     void execute(const openvdb::GridPtrVec& grids) const;
 
+    /// @brief Execute AX code on target grids, restricted to the active voxels of each
+    ///        volume being written to which lie inside of a bounding box
+    /// @param grids The grids to execute over
+    /// @param bbox  The index space bounding box to execute over
+    /// @note  Only the leaf nodes which intersect the bounding box are visited
+    void execute(const openvdb::GridPtrVec& grids, const openvdb::CoordBBox& bbox) const;
+
+    /// @brief Execute AX code on target grids, restricted to the active voxels of each
+    ///        volume being written to which are also active in a mask
+    /// @param grids The grids to execute over
+    /// @param mask  The mask of voxels to execute over. Its active voxels and tiles are
+    ///        expected to be in the same index space as the volumes being written to.
+    /// @note  Only the leaf nodes which intersect the active topology of the mask are
+    ///        visited
+    void execute(const openvdb::GridPtrVec& grids, const openvdb::MaskGrid& mask) const;
+
 private:
 
+    void execute(const openvdb::GridPtrVec& grids,
+                 const openvdb::CoordBBox* bbox,
+                 const openvdb::MaskTree* mask) const;
+
     // The Context and ExecutionEngine must exist _only_ for object lifetime
     // management. The ExecutionEngine must be destroyed before the Context
     const std::shared_ptr<const llvm::LLVMContext> mContext;
@@ -104,6 +177,10 @@ private:
     const CustomData::ConstPtr mCustomData;
     const std::vector<std::map<std::string, uint64_t> > mBlockFunctionAddresses;
     const std::vector<std::string> mAssignedVolumes;
+    const std::vector<bool> mBufferedBlocks;
+    const std::vector<std::vector<size_t>> mBlockDependencies;
+    ExecutionTopology mExecutionTopology;
+    std::string mTopologyName;
 };
 
 }
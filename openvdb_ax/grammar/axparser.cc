@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.5.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.5"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -61,8 +66,8 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 31 "grammar/axparser.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 31 "grammar/axparser.y"
 
     #include <stdio.h>
     #include <iostream>
@@ -141,197 +146,333 @@
         }
     }
 
-#line 145 "grammar/axparser.cc" /* yacc.c:339  */
+    FunctionDefinition* buildFunctionDefinition(const std::string& type,
+                                                const std::string& name,
+                                                ExpressionList* parameters,
+                                                Block* body)
+    {
+        // parameters are parsed as a list of local declarations
+        const ExpressionList::UniquePtr list(parameters);
+        std::vector<DeclareLocal::Ptr> declarations;
+        declarations.reserve(list->mList.size());
+        for (const Expression::Ptr& parameter : list->mList) {
+            declarations.emplace_back(std::static_pointer_cast<DeclareLocal>(parameter));
+        }
+        return new FunctionDefinition(name, type, declarations, body);
+    }
 
+    /// @brief  Build a matrix literal from its first three elements and the list of
+    ///         remaining elements. Returns a nullptr if the total number of elements
+    ///         does not represent a 3x3 or 4x4 matrix.
+    ArrayPack* buildMatrixLiteral(Expression* first,
+                                  Expression* second,
+                                  Expression* third,
+                                  ExpressionList* remaining)
+    {
+        ExpressionList::UniquePtr elements(remaining);
+        elements->mList.emplace(elements->mList.begin(), third);
+        elements->mList.emplace(elements->mList.begin(), second);
+        elements->mList.emplace(elements->mList.begin(), first);
+
+        const size_t size = elements->mList.size();
+        if (size != 9 && size != 16) return nullptr;
+        return new ArrayPack(elements.release());
+    }
+
+#line 183 "grammar/axparser.cc"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "axparser.h".  */
-#ifndef YY_YY_GRAMMAR_AXPARSER_H_INCLUDED
-# define YY_YY_GRAMMAR_AXPARSER_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    TRUE = 258,
-    FALSE = 259,
-    SEMICOLON = 260,
-    AT = 261,
-    DOLLAR = 262,
-    IF = 263,
-    ELSE = 264,
-    RETURN = 265,
-    EQUALS = 266,
-    PLUSEQUALS = 267,
-    MINUSEQUALS = 268,
-    MULTIPLYEQUALS = 269,
-    DIVIDEEQUALS = 270,
-    PLUSPLUS = 271,
-    MINUSMINUS = 272,
-    LPARENS = 273,
-    RPARENS = 274,
-    LCURLY = 275,
-    RCURLY = 276,
-    PLUS = 277,
-    MINUS = 278,
-    MULTIPLY = 279,
-    DIVIDE = 280,
-    MODULO = 281,
-    BITAND = 282,
-    BITOR = 283,
-    BITXOR = 284,
-    BITNOT = 285,
-    EQUALSEQUALS = 286,
-    NOTEQUALS = 287,
-    MORETHAN = 288,
-    LESSTHAN = 289,
-    MORETHANOREQUAL = 290,
-    LESSTHANOREQUAL = 291,
-    AND = 292,
-    OR = 293,
-    NOT = 294,
-    STRING = 295,
-    DOUBLE = 296,
-    FLOAT = 297,
-    LONG = 298,
-    INT = 299,
-    SHORT = 300,
-    BOOL = 301,
-    VOID = 302,
-    F_AT = 303,
-    I_AT = 304,
-    V_AT = 305,
-    S_AT = 306,
-    F_DOLLAR = 307,
-    I_DOLLAR = 308,
-    V_DOLLAR = 309,
-    S_DOLLAR = 310,
-    COMMA = 311,
-    VEC3I = 312,
-    VEC3F = 313,
-    VEC3D = 314,
-    DOT_X = 315,
-    DOT_Y = 316,
-    DOT_Z = 317,
-    L_SHORT = 318,
-    L_INT = 319,
-    L_LONG = 320,
-    L_FLOAT = 321,
-    L_DOUBLE = 322,
-    L_STRING = 323,
-    IDENTIFIER = 324,
-    LPAREN = 325,
-    RPAREN = 326,
-    LOWER_THAN_ELSE = 327
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
+#include "axparser.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 114 "grammar/axparser.y" /* yacc.c:355  */
-
-    const char* value_string;
-    uint64_t index;
-
-    openvdb::ax::ast::Tree* tree;
-    openvdb::ax::ast::ValueBase* value;
-    openvdb::ax::ast::VectorUnpack* vector_unpack;
-    openvdb::ax::ast::Block* block;
-    openvdb::ax::ast::Statement* statement;
-    openvdb::ax::ast::Expression* expression;
-    openvdb::ax::ast::ExpressionList* expressionlist;
-    openvdb::ax::ast::Variable* variable;
-    openvdb::ax::ast::ExternalVariable* external;
-    openvdb::ax::ast::Attribute* attribute;
-    openvdb::ax::ast::AttributeValue* attributevalue;
-    openvdb::ax::ast::DeclareLocal* declare_local;
-    openvdb::ax::ast::Local* local;
-
-#line 277 "grammar/axparser.cc" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_TRUE = 3,                       /* TRUE  */
+  YYSYMBOL_FALSE = 4,                      /* FALSE  */
+  YYSYMBOL_SEMICOLON = 5,                  /* SEMICOLON  */
+  YYSYMBOL_AT = 6,                         /* AT  */
+  YYSYMBOL_DOLLAR = 7,                     /* DOLLAR  */
+  YYSYMBOL_IF = 8,                         /* IF  */
+  YYSYMBOL_ELSE = 9,                       /* ELSE  */
+  YYSYMBOL_RETURN = 10,                    /* RETURN  */
+  YYSYMBOL_FOR = 11,                       /* FOR  */
+  YYSYMBOL_DO = 12,                        /* DO  */
+  YYSYMBOL_WHILE = 13,                     /* WHILE  */
+  YYSYMBOL_BREAK = 14,                     /* BREAK  */
+  YYSYMBOL_CONTINUE = 15,                  /* CONTINUE  */
+  YYSYMBOL_EQUALS = 16,                    /* EQUALS  */
+  YYSYMBOL_PLUSEQUALS = 17,                /* PLUSEQUALS  */
+  YYSYMBOL_MINUSEQUALS = 18,               /* MINUSEQUALS  */
+  YYSYMBOL_MULTIPLYEQUALS = 19,            /* MULTIPLYEQUALS  */
+  YYSYMBOL_DIVIDEEQUALS = 20,              /* DIVIDEEQUALS  */
+  YYSYMBOL_PLUSPLUS = 21,                  /* PLUSPLUS  */
+  YYSYMBOL_MINUSMINUS = 22,                /* MINUSMINUS  */
+  YYSYMBOL_LPARENS = 23,                   /* LPARENS  */
+  YYSYMBOL_RPARENS = 24,                   /* RPARENS  */
+  YYSYMBOL_LCURLY = 25,                    /* LCURLY  */
+  YYSYMBOL_RCURLY = 26,                    /* RCURLY  */
+  YYSYMBOL_PLUS = 27,                      /* PLUS  */
+  YYSYMBOL_MINUS = 28,                     /* MINUS  */
+  YYSYMBOL_MULTIPLY = 29,                  /* MULTIPLY  */
+  YYSYMBOL_DIVIDE = 30,                    /* DIVIDE  */
+  YYSYMBOL_MODULO = 31,                    /* MODULO  */
+  YYSYMBOL_BITAND = 32,                    /* BITAND  */
+  YYSYMBOL_BITOR = 33,                     /* BITOR  */
+  YYSYMBOL_BITXOR = 34,                    /* BITXOR  */
+  YYSYMBOL_BITNOT = 35,                    /* BITNOT  */
+  YYSYMBOL_EQUALSEQUALS = 36,              /* EQUALSEQUALS  */
+  YYSYMBOL_NOTEQUALS = 37,                 /* NOTEQUALS  */
+  YYSYMBOL_MORETHAN = 38,                  /* MORETHAN  */
+  YYSYMBOL_LESSTHAN = 39,                  /* LESSTHAN  */
+  YYSYMBOL_MORETHANOREQUAL = 40,           /* MORETHANOREQUAL  */
+  YYSYMBOL_LESSTHANOREQUAL = 41,           /* LESSTHANOREQUAL  */
+  YYSYMBOL_AND = 42,                       /* AND  */
+  YYSYMBOL_OR = 43,                        /* OR  */
+  YYSYMBOL_NOT = 44,                       /* NOT  */
+  YYSYMBOL_STRING = 45,                    /* STRING  */
+  YYSYMBOL_DOUBLE = 46,                    /* DOUBLE  */
+  YYSYMBOL_FLOAT = 47,                     /* FLOAT  */
+  YYSYMBOL_LONG = 48,                      /* LONG  */
+  YYSYMBOL_INT = 49,                       /* INT  */
+  YYSYMBOL_SHORT = 50,                     /* SHORT  */
+  YYSYMBOL_BOOL = 51,                      /* BOOL  */
+  YYSYMBOL_VOID = 52,                      /* VOID  */
+  YYSYMBOL_F_AT = 53,                      /* F_AT  */
+  YYSYMBOL_I_AT = 54,                      /* I_AT  */
+  YYSYMBOL_V_AT = 55,                      /* V_AT  */
+  YYSYMBOL_S_AT = 56,                      /* S_AT  */
+  YYSYMBOL_F_DOLLAR = 57,                  /* F_DOLLAR  */
+  YYSYMBOL_I_DOLLAR = 58,                  /* I_DOLLAR  */
+  YYSYMBOL_V_DOLLAR = 59,                  /* V_DOLLAR  */
+  YYSYMBOL_S_DOLLAR = 60,                  /* S_DOLLAR  */
+  YYSYMBOL_COMMA = 61,                     /* COMMA  */
+  YYSYMBOL_VEC3I = 62,                     /* VEC3I  */
+  YYSYMBOL_VEC3F = 63,                     /* VEC3F  */
+  YYSYMBOL_VEC3D = 64,                     /* VEC3D  */
+  YYSYMBOL_MAT3F = 65,                     /* MAT3F  */
+  YYSYMBOL_MAT3D = 66,                     /* MAT3D  */
+  YYSYMBOL_MAT4F = 67,                     /* MAT4F  */
+  YYSYMBOL_MAT4D = 68,                     /* MAT4D  */
+  YYSYMBOL_DOT_X = 69,                     /* DOT_X  */
+  YYSYMBOL_DOT_Y = 70,                     /* DOT_Y  */
+  YYSYMBOL_DOT_Z = 71,                     /* DOT_Z  */
+  YYSYMBOL_L_SHORT = 72,                   /* L_SHORT  */
+  YYSYMBOL_L_INT = 73,                     /* L_INT  */
+  YYSYMBOL_L_LONG = 74,                    /* L_LONG  */
+  YYSYMBOL_L_FLOAT = 75,                   /* L_FLOAT  */
+  YYSYMBOL_L_DOUBLE = 76,                  /* L_DOUBLE  */
+  YYSYMBOL_L_STRING = 77,                  /* L_STRING  */
+  YYSYMBOL_IDENTIFIER = 78,                /* IDENTIFIER  */
+  YYSYMBOL_LPAREN = 79,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 80,                    /* RPAREN  */
+  YYSYMBOL_LOWER_THAN_ELSE = 81,           /* LOWER_THAN_ELSE  */
+  YYSYMBOL_YYACCEPT = 82,                  /* $accept  */
+  YYSYMBOL_statements = 83,                /* statements  */
+  YYSYMBOL_program = 84,                   /* program  */
+  YYSYMBOL_block = 85,                     /* block  */
+  YYSYMBOL_body = 86,                      /* body  */
+  YYSYMBOL_statement = 87,                 /* statement  */
+  YYSYMBOL_simple_statement = 88,          /* simple_statement  */
+  YYSYMBOL_conditional_statement = 89,     /* conditional_statement  */
+  YYSYMBOL_loop_statement = 90,            /* loop_statement  */
+  YYSYMBOL_loop_initial = 91,              /* loop_initial  */
+  YYSYMBOL_loop_condition = 92,            /* loop_condition  */
+  YYSYMBOL_loop_iteration = 93,            /* loop_iteration  */
+  YYSYMBOL_function_definition = 94,       /* function_definition  */
+  YYSYMBOL_function_parameters = 95,       /* function_parameters  */
+  YYSYMBOL_parameters = 96,                /* parameters  */
+  YYSYMBOL_function_scope = 97,            /* function_scope  */
+  YYSYMBOL_function_block = 98,            /* function_block  */
+  YYSYMBOL_function_body = 99,             /* function_body  */
+  YYSYMBOL_function_statement = 100,       /* function_statement  */
+  YYSYMBOL_function_conditional_statement = 101, /* function_conditional_statement  */
+  YYSYMBOL_function_loop_statement = 102,  /* function_loop_statement  */
+  YYSYMBOL_expression = 103,               /* expression  */
+  YYSYMBOL_vector_element = 104,           /* vector_element  */
+  YYSYMBOL_expression_expand = 105,        /* expression_expand  */
+  YYSYMBOL_cast_expression = 106,          /* cast_expression  */
+  YYSYMBOL_function_call_expression = 107, /* function_call_expression  */
+  YYSYMBOL_arguments = 108,                /* arguments  */
+  YYSYMBOL_declare_assignment = 109,       /* declare_assignment  */
+  YYSYMBOL_assign_expression = 110,        /* assign_expression  */
+  YYSYMBOL_assign_component_expression = 111, /* assign_component_expression  */
+  YYSYMBOL_crement = 112,                  /* crement  */
+  YYSYMBOL_unary_expression = 113,         /* unary_expression  */
+  YYSYMBOL_binary_expression = 114,        /* binary_expression  */
+  YYSYMBOL_vector_literal = 115,           /* vector_literal  */
+  YYSYMBOL_matrix_literal = 116,           /* matrix_literal  */
+  YYSYMBOL_attribute = 117,                /* attribute  */
+  YYSYMBOL_external = 118,                 /* external  */
+  YYSYMBOL_declare_local = 119,            /* declare_local  */
+  YYSYMBOL_local = 120,                    /* local  */
+  YYSYMBOL_literal = 121,                  /* literal  */
+  YYSYMBOL_component = 122,                /* component  */
+  YYSYMBOL_scalar_type = 123,              /* scalar_type  */
+  YYSYMBOL_vector_type = 124,              /* vector_type  */
+  YYSYMBOL_matrix_type = 125               /* matrix_type  */
 };
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
 
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-};
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
+/* Second part of user prologue.  */
+#line 257 "grammar/axparser.y"
+
+    #include <cstring>
+    #include <utility>
+
+    /// @brief  Returns the token of a keyword which is not a rule of the lexer, or
+    ///         IDENTIFIER if the text is not one of these keywords
+    int keywordToken(const char* text)
+    {
+        static const std::pair<const char*, int> keywords[] = {
+            { "void", VOID },
+            { "for", FOR },
+            { "do", DO },
+            { "while", WHILE },
+            { "break", BREAK },
+            { "continue", CONTINUE },
+            { "mat3f", MAT3F },
+            { "mat3d", MAT3D },
+            { "mat4f", MAT4F },
+            { "mat4d", MAT4D },
+            { "matrix3", MAT3F }, // VEX support tokens
+            { "matrix", MAT4F }
+        };
+
+        for (const auto& keyword : keywords) {
+            if (std::strcmp(text, keyword.first) == 0) return keyword.second;
+        }
+        return IDENTIFIER;
+    }
 
+    /// @brief  Returns the next token of the lexer. Keywords without lexer rules are
+    ///         scanned as identifiers and are replaced with their tokens here
+    int yylexKeyword(void)
+    {
+        const int token = yylex();
+        if (token != IDENTIFIER) return token;
 
-extern YYSTYPE yylval;
-extern YYLTYPE yylloc;
-int yyparse (openvdb::ax::ast::Tree** tree);
+        const int keyword = keywordToken(yylval.value_string);
+        if (keyword != IDENTIFIER) {
+            free((char*)yylval.value_string);
+            yylval.value_string = nullptr;
+        }
+        return keyword;
+    }
 
-#endif /* !YY_YY_GRAMMAR_AXPARSER_H_INCLUDED  */
+    #define yylex yylexKeyword
 
-/* Copy the second part of user declarations.  */
+#line 389 "grammar/axparser.cc"
 
-#line 308 "grammar/axparser.cc" /* yacc.c:358  */
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -339,15 +480,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -361,47 +515,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -414,8 +564,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -480,8 +644,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -491,18 +654,19 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -515,11 +679,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -531,12 +695,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -546,30 +710,33 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  97
+#define YYFINAL  125
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   729
+#define YYLAST   1636
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  73
+#define YYNTOKENS  82
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  27
+#define YYNNTS  44
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  129
+#define YYNRULES  180
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  219
+#define YYNSTATES  332
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   336
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   327
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -603,36 +770,51 @@ static const yytype_uint8 yytranslate[] =
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
       45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
       55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    68,    69,    70,    71,    72
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    81
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   206,   206,   207,   211,   212,   213,   217,   218,   224,
-     225,   226,   227,   228,   236,   237,   243,   244,   245,   246,
-     247,   248,   249,   250,   251,   252,   253,   254,   255,   256,
-     263,   264,   265,   270,   277,   282,   283,   288,   289,   296,
-     297,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   326,   327,   328,   329,   330,   331,   332,   333,   334,
-     335,   344,   345,   346,   347,   348,   349,   350,   351,   356,
-     357,   358,   359,   365,   366,   367,   368,   369,   370,   371,
-     372,   373,   374,   375,   376,   377,   378,   379,   380,   385,
-     390,   391,   392,   393,   394,   395,   396,   397,   402,   403,
-     404,   405,   406,   407,   408,   409,   414,   415,   416,   423,
-     430,   431,   432,   433,   434,   435,   436,   437,   442,   443,
-     444,   450,   451,   452,   453,   454,   455,   461,   462,   463
+       0,   307,   307,   308,   314,   315,   316,   317,   321,   322,
+     323,   327,   328,   334,   335,   336,   341,   342,   343,   344,
+     345,   346,   353,   354,   360,   361,   362,   368,   369,   370,
+     374,   375,   379,   380,   387,   388,   389,   390,   395,   396,
+     401,   402,   407,   408,   412,   413,   414,   418,   419,   425,
+     426,   427,   428,   433,   434,   439,   440,   441,   447,   448,
+     449,   450,   451,   452,   453,   454,   455,   456,   457,   458,
+     459,   460,   461,   468,   469,   470,   475,   482,   487,   488,
+     493,   494,   501,   502,   511,   512,   513,   514,   515,   516,
+     517,   518,   519,   520,   531,   532,   533,   534,   535,   536,
+     537,   538,   539,   540,   549,   550,   551,   552,   553,   554,
+     555,   556,   561,   562,   563,   564,   570,   571,   572,   573,
+     574,   575,   576,   577,   578,   579,   580,   581,   582,   583,
+     584,   585,   590,   595,   607,   608,   609,   610,   611,   612,
+     613,   614,   615,   620,   621,   622,   623,   624,   625,   626,
+     627,   628,   633,   634,   635,   636,   643,   650,   651,   652,
+     653,   654,   655,   656,   657,   662,   663,   664,   670,   671,
+     672,   673,   674,   675,   681,   682,   683,   689,   690,   691,
+     692
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "TRUE", "FALSE", "SEMICOLON", "AT",
-  "DOLLAR", "IF", "ELSE", "RETURN", "EQUALS", "PLUSEQUALS", "MINUSEQUALS",
+  "\"end of file\"", "error", "\"invalid token\"", "TRUE", "FALSE",
+  "SEMICOLON", "AT", "DOLLAR", "IF", "ELSE", "RETURN", "FOR", "DO",
+  "WHILE", "BREAK", "CONTINUE", "EQUALS", "PLUSEQUALS", "MINUSEQUALS",
   "MULTIPLYEQUALS", "DIVIDEEQUALS", "PLUSPLUS", "MINUSMINUS", "LPARENS",
   "RPARENS", "LCURLY", "RCURLY", "PLUS", "MINUS", "MULTIPLY", "DIVIDE",
   "MODULO", "BITAND", "BITOR", "BITXOR", "BITNOT", "EQUALSEQUALS",
@@ -640,373 +822,603 @@ static const char *const yytname[] =
   "LESSTHANOREQUAL", "AND", "OR", "NOT", "STRING", "DOUBLE", "FLOAT",
   "LONG", "INT", "SHORT", "BOOL", "VOID", "F_AT", "I_AT", "V_AT", "S_AT",
   "F_DOLLAR", "I_DOLLAR", "V_DOLLAR", "S_DOLLAR", "COMMA", "VEC3I",
-  "VEC3F", "VEC3D", "DOT_X", "DOT_Y", "DOT_Z", "L_SHORT", "L_INT",
-  "L_LONG", "L_FLOAT", "L_DOUBLE", "L_STRING", "IDENTIFIER", "LPAREN",
-  "RPAREN", "LOWER_THAN_ELSE", "$accept", "statements", "block", "body",
-  "statement", "conditional_statement", "expression", "vector_element",
+  "VEC3F", "VEC3D", "MAT3F", "MAT3D", "MAT4F", "MAT4D", "DOT_X", "DOT_Y",
+  "DOT_Z", "L_SHORT", "L_INT", "L_LONG", "L_FLOAT", "L_DOUBLE", "L_STRING",
+  "IDENTIFIER", "LPAREN", "RPAREN", "LOWER_THAN_ELSE", "$accept",
+  "statements", "program", "block", "body", "statement",
+  "simple_statement", "conditional_statement", "loop_statement",
+  "loop_initial", "loop_condition", "loop_iteration",
+  "function_definition", "function_parameters", "parameters",
+  "function_scope", "function_block", "function_body",
+  "function_statement", "function_conditional_statement",
+  "function_loop_statement", "expression", "vector_element",
   "expression_expand", "cast_expression", "function_call_expression",
   "arguments", "declare_assignment", "assign_expression",
   "assign_component_expression", "crement", "unary_expression",
-  "binary_expression", "vector_literal", "attribute", "external",
-  "declare_local", "local", "literal", "component", "scalar_type",
-  "vector_type", YY_NULLPTR
+  "binary_expression", "vector_literal", "matrix_literal", "attribute",
+  "external", "declare_local", "local", "literal", "component",
+  "scalar_type", "vector_type", "matrix_type", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
-     325,   326,   327
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -61
+#define YYPACT_NINF (-293)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-61)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-     314,   -61,   -61,   -61,   -60,   -52,     4,    43,   545,   545,
-     515,   515,   515,   515,   515,   515,    14,   -61,   -61,   -61,
-     -61,   -61,   -61,   -43,   -40,   -18,     6,    12,    16,    37,
-      45,   -61,   -61,   -61,   -61,   -61,   -61,   -61,   -61,   -61,
-     100,   138,   314,   -61,   -61,   636,   -61,   -61,   -61,   -61,
-     145,   -61,   -61,   -61,   -61,   -61,   -61,    55,     1,   123,
-     114,   -61,     5,    18,   -61,   -61,   381,   -61,   147,   -61,
-     -61,   -61,   148,   150,   -61,   -61,    82,   656,    21,   106,
-     584,    53,    53,   -61,   620,    88,    89,   -61,   -61,   -61,
-     -61,   -61,   -61,   -61,   -61,   -61,   448,   -61,   -61,   -61,
-     515,   515,   515,   515,   515,   515,   515,   515,   515,   515,
-     515,   515,   515,   515,   515,   515,   -61,   515,   515,   515,
-     515,   515,   -61,   -61,   -61,   -61,   -61,   129,   -61,   515,
-     515,   515,   515,   515,   515,   -61,   -61,   134,    90,    91,
-     -61,   -61,    93,    95,   -61,   180,   142,   -61,   -61,   515,
-     -61,   -61,   -61,   691,    -6,    53,    53,   139,   139,   -61,
-     189,   189,   189,   620,   620,    31,    31,    31,    31,   620,
-     620,   691,   691,   691,   691,   691,   515,   515,   515,   515,
-     515,   691,   691,   691,   691,   691,   691,   515,   515,   515,
-     515,   515,   -61,   -61,   -61,   -61,   -61,   247,     9,   381,
-     601,   -61,   515,   691,   691,   691,   691,   691,   691,   691,
-     691,   691,   691,   -61,   -61,   515,   691,   674,   -61
+     569,  -293,  -293,  -293,   -66,   -34,    31,    65,    59,  1101,
+      31,    84,    90,    94,    94,  1405,  1405,  1405,  1405,  1405,
+    1405,    10,  -293,  -293,  -293,  -293,  -293,  -293,    18,    32,
+      35,    42,    49,    51,    60,    68,    85,  -293,  -293,  -293,
+    -293,  -293,  -293,  -293,  -293,  -293,  -293,  -293,  -293,  -293,
+     102,   166,   569,  -293,  -293,  -293,  -293,  -293,   398,  -293,
+    -293,  -293,  -293,   162,  -293,  -293,  -293,  -293,  -293,  -293,
+    -293,   157,    37,   152,   192,  -293,     1,    19,    34,  -293,
+    -293,  1101,  -293,  1481,   645,   156,  -293,    16,    36,    43,
+    1101,  -293,  -293,   164,  -293,  -293,  -293,   165,   174,   175,
+    -293,  -293,    52,  1576,    13,    57,    69,  1533,    93,    93,
+    -293,   495,   105,   106,  -293,   181,  -293,  -293,  -293,  -293,
+    -293,  -293,  -293,  -293,  1253,  -293,  -293,  -293,  -293,  1405,
+    1405,  1405,  1405,  1405,  1405,  1405,  1405,  1405,  1405,  1405,
+    1405,  1405,  1405,  1405,  1405,  -293,  1405,  1405,  1405,  1405,
+    1405,  -293,  -293,  -293,  -293,  -293,    99,  -293,  1405,  1405,
+    1405,  1405,  1405,  1405,  -293,  -293,   116,   127,   128,   181,
+    -293,   138,   139,   181,   141,   143,   181,   213,   218,  1593,
+    -293,  -293,   721,  -293,   159,    31,  -293,  -293,  -293,  -293,
+    -293,  1405,  -293,  -293,   307,   199,  -293,  1593,     5,    93,
+      93,   194,   194,  -293,   124,   124,   124,   495,   495,   515,
+     515,   515,   515,   495,   495,  1593,  1593,  1593,  1593,  1593,
+    1405,  1405,  1405,  1405,  1405,  1593,  1593,  1593,  1593,  1593,
+    1593,  1405,  1405,  1405,  1405,  1405,  -293,  -293,   199,  -293,
+    -293,   199,  -293,  -293,   199,  1101,  1405,  -293,  -293,   233,
+    1550,  -293,   161,     7,  -293,   168,   176,   177,   797,  -293,
+    -293,  1405,  1593,  1593,  1593,  1593,  1593,  1593,  1593,  1593,
+    1593,  1593,  -293,  -293,  -293,  -293,   235,  1593,  -293,  1405,
+    -293,   185,    31,  1329,   219,  1177,    31,  -293,  -293,   873,
+    -293,  -293,  -293,  1593,  1405,   469,  -293,  1177,   428,  1481,
+     949,   230,  -293,  1177,  -293,  -293,   220,  1593,  -293,  1405,
+     247,  -293,   252,  -293,  1025,    31,  -293,  1101,    -8,  1177,
+    1405,  -293,   254,  -293,  -293,  -293,   255,  -293,  1405,   240,
+    1177,  -293
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-       2,   116,   117,    13,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,   126,   125,   124,
-     123,   122,   121,     0,     0,     0,     0,     0,     0,     0,
-       0,   127,   128,   129,   110,   111,   112,   113,   114,   115,
-     109,     0,     3,     8,    11,     0,    25,    16,    23,    17,
-       0,    20,    21,    22,    19,    18,    24,    29,    27,    40,
-      28,    26,     0,     0,    97,   105,     0,    12,     0,   109,
-      61,    65,     0,     0,    62,    66,     0,     0,     0,     0,
-       0,    69,    70,    71,    72,     0,     0,   108,    93,    92,
-      94,    95,   101,   100,   102,   103,     0,     1,     7,     9,
+       2,   163,   164,    21,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,   173,   172,   171,   170,   169,   168,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   174,   175,   176,
+     177,   178,   179,   180,   157,   158,   159,   160,   161,   162,
+     156,     0,     3,     6,    13,    14,    15,     7,     0,    68,
+      58,    65,    59,     0,    62,    63,    64,    61,    60,    66,
+      67,    72,    70,    83,    71,    69,     0,     0,     0,   142,
+     151,     0,    18,    27,     0,     0,    10,     0,     0,     0,
+       0,    19,    20,     0,   156,   104,   108,     0,     0,     0,
+     105,   109,     0,     0,     0,     0,     0,     0,   112,   113,
+     114,   115,     0,     0,   155,     0,   138,   137,   139,   140,
+     147,   146,   148,   149,     0,     1,     4,     5,    16,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    10,     0,     0,     0,
-       0,     0,    63,    64,   118,   119,   120,    30,    32,     0,
-       0,     0,     0,     0,     0,    67,    68,    31,     0,     0,
-     106,    34,     0,     0,   107,     0,    14,     6,    33,     0,
-      96,   104,    36,    37,     0,    73,    74,    75,    76,    77,
-      78,    79,    80,    83,    84,    85,    86,    87,    88,    81,
-      82,    41,    42,    43,    44,    45,     0,     0,     0,     0,
-       0,    39,    46,    47,    48,    49,    50,     0,     0,     0,
-       0,     0,    90,    98,    91,    99,     5,     0,     0,     0,
-       0,    35,     0,    51,    52,    53,    54,    55,    56,    57,
-      58,    59,    60,     4,    15,     0,    38,     0,    89
+       0,     0,     0,     0,     0,    17,     0,     0,     0,     0,
+       0,   106,   107,   165,   166,   167,    73,    75,     0,     0,
+       0,     0,     0,     0,   110,   111,    74,     0,     0,   152,
+      77,     0,     0,   153,     0,     0,   154,    22,     0,    28,
+      29,     9,     0,    12,     0,     0,   152,   153,   154,    25,
+      76,     0,   141,   150,     0,     0,    79,    80,     0,   116,
+     117,   118,   119,   120,   121,   122,   123,   126,   127,   128,
+     129,   130,   131,   124,   125,    84,    85,    86,    87,    88,
+       0,     0,     0,     0,     0,    82,    89,    90,    91,    92,
+      93,     0,     0,     0,     0,     0,   134,   143,     0,   135,
+     144,     0,   136,   145,     0,     0,    30,     8,    11,     0,
+       0,    39,     0,     0,    40,     0,     0,     0,     0,    37,
+      78,     0,    94,    95,    96,    97,    98,    99,   100,   101,
+     102,   103,    34,    35,    36,    23,     0,    31,    26,     0,
+      38,     0,     0,     0,     0,     0,     0,    43,    49,     0,
+      48,    50,    51,    81,    32,     0,    41,     0,     0,    27,
+       0,     0,    46,     0,    42,    47,     0,    33,   132,     0,
+      53,    52,     0,    45,     0,     0,    56,     0,     0,     0,
+      30,    44,     0,    24,   133,    54,     0,    57,    32,     0,
+       0,    55
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-     -61,   -61,   -28,    27,   -36,   -61,   -10,   -61,     2,   -61,
-     -61,   -61,   -61,   -61,   -61,   -61,   -61,   -61,   -61,   124,
-     -61,   -61,   128,   -61,    24,     7,    10
+    -293,  -293,  -293,   -80,  -293,     3,  -252,  -293,  -293,   -32,
+     -55,   -60,   217,  -104,  -293,  -164,  -292,   -30,  -243,  -293,
+    -293,   258,  -293,    22,  -293,  -293,   -38,   -81,  -293,  -293,
+    -293,  -293,  -293,  -293,  -293,    72,  -293,  -190,    79,  -293,
+      29,     0,    21,    47
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-      -1,    41,   146,    42,    43,    44,    45,    46,    47,    48,
-      49,   154,    50,    51,    52,    53,    54,    55,    56,    57,
-      58,    59,    60,    61,   127,    78,    79
+       0,    51,    52,    85,   182,    86,    54,    55,    56,   178,
+     276,   306,    57,   195,   253,   259,   301,   289,   302,   291,
+     292,    58,    59,    60,    61,    62,   198,    63,    64,    65,
+      66,    67,    68,    69,    70,    71,    72,    73,    74,    75,
+     156,   104,   105,   106
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_uint8 yytable[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
-      77,    80,    81,    82,    83,    84,    98,    62,    66,    64,
-      63,   138,   139,   201,    99,    72,    72,    65,    73,    73,
-      85,    86,    10,    10,   142,   143,    88,   138,   139,    89,
-     147,   100,   101,   102,   103,   104,   105,   106,   107,    10,
-     108,   109,   110,   111,   112,   113,   114,   115,    67,    62,
-     202,    90,    63,   100,   101,   102,   103,   104,   105,   106,
-     107,   124,   125,   126,   141,   149,   117,   118,   119,   120,
-     121,   122,   123,    62,   140,    91,    63,   102,   103,   104,
-     141,    92,   128,    87,   137,    93,   153,   144,    85,    86,
-     155,   156,   157,   158,   159,   160,   161,   162,   163,   164,
-     165,   166,   167,   168,   169,   170,    94,   171,   172,   173,
-     174,   175,   142,   143,    95,   124,   125,   126,    96,   181,
-     182,   183,   184,   185,   186,   130,   131,   132,   133,   134,
-     135,   136,    70,    74,   129,   198,    71,    75,    97,   200,
-     176,   177,   178,   179,   180,   187,   188,   189,   190,   191,
-     116,   199,    62,    85,   138,    63,   142,   150,   151,   192,
-     193,    98,   194,   147,   195,   104,   203,   204,   205,   206,
-     207,   214,   197,     0,   124,   125,   126,   208,   209,   210,
-     211,   212,     0,     1,     2,     3,     4,     5,     6,     0,
-       7,     0,   216,     0,     0,     0,     8,     9,    10,     0,
-      11,   196,    12,    13,    62,   217,    62,    63,     0,    63,
-      14,   100,   101,   102,   103,   104,     0,     0,     0,    15,
-      16,    17,    18,    19,    20,    21,    22,     0,    23,    24,
-      25,    26,    27,    28,    29,    30,     0,    31,    32,    33,
-       0,     0,     0,    34,    35,    36,    37,    38,    39,    40,
-       1,     2,     3,     4,     5,     6,     0,     7,     0,     0,
-       0,     0,     0,     8,     9,    10,     0,    11,   213,    12,
-      13,     0,     0,     0,     0,     0,     0,    14,     0,     0,
-       0,     0,     0,     0,     0,     0,    15,    16,    17,    18,
-      19,    20,    21,    22,     0,    23,    24,    25,    26,    27,
-      28,    29,    30,     0,    31,    32,    33,     0,     0,     0,
-      34,    35,    36,    37,    38,    39,    40,     1,     2,     3,
-       4,     5,     6,     0,     7,     0,     0,     0,     0,     0,
-       8,     9,    10,     0,    11,     0,    12,    13,     0,     0,
-       0,     0,     0,     0,    14,     0,     0,     0,     0,     0,
-       0,     0,     0,    15,    16,    17,    18,    19,    20,    21,
-      22,     0,    23,    24,    25,    26,    27,    28,    29,    30,
-       0,    31,    32,    33,     0,     0,     0,    34,    35,    36,
-      37,    38,    39,    40,     1,     2,     3,     4,     5,     6,
-       0,     7,     0,     0,     0,     0,     0,     8,     9,    10,
-       0,   145,     0,    12,    13,     0,     0,     0,     0,     0,
-       0,    14,     0,     0,     0,     0,     0,     0,     0,     0,
-      15,    16,    17,    18,    19,    20,    21,    22,     0,    23,
-      24,    25,    26,    27,    28,    29,    30,     0,    31,    32,
-      33,     0,     0,     0,    34,    35,    36,    37,    38,    39,
-      40,     1,     2,     0,     4,     5,     0,     0,     0,     0,
-       0,     0,     0,     0,     8,     9,    10,   152,    11,     0,
-      12,    13,     0,     0,     0,     0,     0,     0,    14,     0,
-       0,     0,     0,     0,     0,     0,     0,    15,    76,    17,
-      18,    19,    20,    21,    22,     0,    23,    24,    25,    26,
-      27,    28,    29,    30,     0,    31,    32,    33,     0,     0,
-       0,    34,    35,    36,    37,    38,    39,    40,     1,     2,
+      76,   177,   180,    53,   254,   310,   288,   167,   168,    87,
+     189,   316,    79,    97,    97,   290,   112,   113,   324,   167,
+     168,    77,   167,   168,    15,   171,   172,   325,    81,   260,
+      88,   280,    90,   288,    98,    98,    15,   288,   331,    15,
+     174,   175,   171,   172,    80,   288,   305,    78,   288,   174,
+     175,   288,    76,   261,    15,   126,    89,   290,   112,   113,
+      99,    99,   288,   171,   172,   238,   261,   288,   281,   241,
+      82,   305,   244,    77,   272,   174,   175,   273,   288,   169,
+     274,    87,    83,    87,    87,    95,   100,   183,   114,    91,
+      87,   296,    96,   101,   186,    92,   115,   173,   170,    78,
+       4,   157,    88,   166,    88,    88,   153,   154,   155,   170,
+     116,    88,   176,   117,   187,   220,   221,   222,   223,   224,
+     118,   188,   131,   132,   133,   124,   170,   119,    89,   120,
+      89,    89,   231,   232,   233,   234,   235,    89,   121,    93,
+      22,    23,    24,    25,    26,    27,   122,    29,    30,    31,
+      32,   129,   130,   131,   132,   133,    37,    38,    39,    40,
+      41,    42,    43,   123,   128,   275,   125,   145,   158,   185,
+     112,   167,    94,   146,   147,   148,   149,   150,   151,   152,
+     171,   174,    87,   192,   193,   248,   129,   130,   131,   132,
+     133,   134,   135,   136,   255,   137,   138,   139,   140,   141,
+     142,   143,   144,    88,   194,   236,   237,   249,   159,   160,
+     161,   162,   163,   164,   165,   256,   239,   240,   180,   242,
+     191,   243,   245,   246,   258,   133,   153,   154,   155,    89,
+     252,    22,    23,    24,    25,    26,    27,   323,   278,   114,
+     294,   257,   299,   315,   317,    87,   186,    37,    38,    39,
+      40,    41,    42,    43,   187,   188,   319,   320,    87,   327,
+     328,   153,   154,   155,   330,   326,    88,   312,   329,   127,
+     314,   318,     0,   103,   107,   108,   109,   110,   111,    88,
+       0,   255,     0,     0,     0,    87,     0,     0,     0,    87,
+       0,     0,    89,     0,     0,     0,     0,    87,     0,    87,
+      87,     0,   256,    87,   297,    89,    88,     0,   303,     0,
+      88,     0,     0,     0,    87,     0,     0,    87,    88,    87,
+      88,    88,     0,     0,    88,     0,     0,     0,   257,     0,
+      87,   251,    89,     0,     0,    88,    89,   322,    88,     0,
+      88,   179,   184,     0,    89,     0,    89,    89,     0,     0,
+      89,    88,   252,    22,    23,    24,    25,    26,    27,     0,
+       0,    89,     0,     0,    89,     0,    89,     0,     0,    37,
+      38,    39,    40,    41,    42,    43,     0,    89,     0,     0,
+       0,     0,   197,     0,     0,     0,     0,   199,   200,   201,
+     202,   203,   204,   205,   206,   207,   208,   209,   210,   211,
+     212,   213,   214,   128,   215,   216,   217,   218,   219,     0,
+       0,     0,     0,     0,     0,     0,   225,   226,   227,   228,
+     229,   230,     0,     0,     0,   129,   130,   131,   132,   133,
+     134,   135,   136,   311,   137,   138,   139,   140,   141,   142,
+     143,   144,     0,     0,     0,     0,     0,     0,     0,   250,
+       0,     0,     0,     0,     0,   129,   130,   131,   132,   133,
+     134,   135,   136,     0,   137,   138,   139,   140,   141,   142,
+     143,   144,     0,     0,     0,     0,     0,     0,   262,   263,
+     264,   265,   266,     0,     0,     0,     0,     0,     0,   267,
+     268,   269,   270,   271,     0,   308,   129,   130,   131,   132,
+     133,   134,   135,   136,   277,   137,   138,   139,   140,   141,
+     142,   143,   144,     0,     0,     0,     0,     0,     0,   293,
+       0,     0,   129,   130,   131,   132,   133,   134,   135,   136,
+     309,   137,   138,   139,   140,   141,   142,   295,     0,     0,
+       0,   298,   129,   130,   131,   132,   133,   134,   135,   136,
+       0,     0,   307,     0,     0,     0,     0,   179,   184,     0,
+       0,     0,     0,     0,     0,     0,     0,   197,     0,     0,
+       0,     0,     1,     2,     3,     4,     5,     6,   277,     7,
+       8,     9,    10,    11,    12,     0,   307,     0,     0,     0,
+      13,    14,    15,     0,    16,     0,    17,    18,     0,     0,
+       0,     0,     0,     0,    19,     0,     0,     0,     0,     0,
+       0,     0,     0,    20,    21,    22,    23,    24,    25,    26,
+      27,    28,    29,    30,    31,    32,    33,    34,    35,    36,
+       0,    37,    38,    39,    40,    41,    42,    43,     0,     0,
+       0,    44,    45,    46,    47,    48,    49,    50,     1,     2,
+       3,     4,     5,     6,     0,     7,     8,     9,    10,    11,
+      12,     0,     0,     0,     0,     0,    13,    14,    15,     0,
+      16,   181,    17,    18,     0,     0,     0,     0,     0,     0,
+      19,     0,     0,     0,     0,     0,     0,     0,     0,    20,
+      21,    22,    23,    24,    25,    26,    27,     0,    29,    30,
+      31,    32,    33,    34,    35,    36,     0,    37,    38,    39,
+      40,    41,    42,    43,     0,     0,     0,    44,    45,    46,
+      47,    48,    49,    50,     1,     2,     3,     4,     5,     6,
+       0,     7,     8,     9,    10,    11,    12,     0,     0,     0,
+       0,     0,    13,    14,    15,     0,    16,   247,    17,    18,
+       0,     0,     0,     0,     0,     0,    19,     0,     0,     0,
+       0,     0,     0,     0,     0,    20,    21,    22,    23,    24,
+      25,    26,    27,     0,    29,    30,    31,    32,    33,    34,
+      35,    36,     0,    37,    38,    39,    40,    41,    42,    43,
+       0,     0,     0,    44,    45,    46,    47,    48,    49,    50,
+       1,     2,     3,     4,     5,   282,     0,   283,   284,   285,
+     286,    11,    12,     0,     0,     0,     0,     0,    13,    14,
+      15,     0,    16,   287,    17,    18,     0,     0,     0,     0,
+       0,     0,    19,     0,     0,     0,     0,     0,     0,     0,
+       0,    20,    21,    22,    23,    24,    25,    26,    27,     0,
+      29,    30,    31,    32,    33,    34,    35,    36,     0,    37,
+      38,    39,    40,    41,    42,    43,     0,     0,     0,    44,
+      45,    46,    47,    48,    49,    50,     1,     2,     3,     4,
+       5,   282,     0,   283,   284,   285,   286,    11,    12,     0,
+       0,     0,     0,     0,    13,    14,    15,     0,    16,   304,
+      17,    18,     0,     0,     0,     0,     0,     0,    19,     0,
+       0,     0,     0,     0,     0,     0,     0,    20,    21,    22,
+      23,    24,    25,    26,    27,     0,    29,    30,    31,    32,
+      33,    34,    35,    36,     0,    37,    38,    39,    40,    41,
+      42,    43,     0,     0,     0,    44,    45,    46,    47,    48,
+      49,    50,     1,     2,     3,     4,     5,   282,     0,   283,
+     284,   285,   286,    11,    12,     0,     0,     0,     0,     0,
+      13,    14,    15,     0,    16,   313,    17,    18,     0,     0,
+       0,     0,     0,     0,    19,     0,     0,     0,     0,     0,
+       0,     0,     0,    20,    21,    22,    23,    24,    25,    26,
+      27,     0,    29,    30,    31,    32,    33,    34,    35,    36,
+       0,    37,    38,    39,    40,    41,    42,    43,     0,     0,
+       0,    44,    45,    46,    47,    48,    49,    50,     1,     2,
+       3,     4,     5,   282,     0,   283,   284,   285,   286,    11,
+      12,     0,     0,     0,     0,     0,    13,    14,    15,     0,
+      16,   321,    17,    18,     0,     0,     0,     0,     0,     0,
+      19,     0,     0,     0,     0,     0,     0,     0,     0,    20,
+      21,    22,    23,    24,    25,    26,    27,     0,    29,    30,
+      31,    32,    33,    34,    35,    36,     0,    37,    38,    39,
+      40,    41,    42,    43,     0,     0,     0,    44,    45,    46,
+      47,    48,    49,    50,     1,     2,     3,     4,     5,     6,
+       0,     7,     8,     9,    10,    11,    12,     0,     0,     0,
+       0,     0,    13,    14,    15,     0,    84,     0,    17,    18,
+       0,     0,     0,     0,     0,     0,    19,     0,     0,     0,
+       0,     0,     0,     0,     0,    20,    21,    22,    23,    24,
+      25,    26,    27,     0,    29,    30,    31,    32,    33,    34,
+      35,    36,     0,    37,    38,    39,    40,    41,    42,    43,
+       0,     0,     0,    44,    45,    46,    47,    48,    49,    50,
+       1,     2,     3,     4,     5,   282,     0,   283,   284,   285,
+     286,    11,    12,     0,     0,     0,     0,     0,    13,    14,
+      15,     0,   300,     0,    17,    18,     0,     0,     0,     0,
+       0,     0,    19,     0,     0,     0,     0,     0,     0,     0,
+       0,    20,    21,    22,    23,    24,    25,    26,    27,     0,
+      29,    30,    31,    32,    33,    34,    35,    36,     0,    37,
+      38,    39,    40,    41,    42,    43,     0,     0,     0,    44,
+      45,    46,    47,    48,    49,    50,     1,     2,     0,     4,
+       5,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    13,    14,    15,   196,    16,     0,
+      17,    18,     0,     0,     0,     0,     0,     0,    19,     0,
+       0,     0,     0,     0,     0,     0,     0,    20,   102,    22,
+      23,    24,    25,    26,    27,     0,    29,    30,    31,    32,
+      33,    34,    35,    36,     0,    37,    38,    39,    40,    41,
+      42,    43,     0,     0,     0,    44,    45,    46,    47,    48,
+      49,    50,     1,     2,    82,     4,     5,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      13,    14,    15,     0,    16,     0,    17,    18,     0,     0,
+       0,     0,     0,     0,    19,     0,     0,     0,     0,     0,
+       0,     0,     0,    20,   102,    22,    23,    24,    25,    26,
+      27,     0,    29,    30,    31,    32,    33,    34,    35,    36,
+       0,    37,    38,    39,    40,    41,    42,    43,     0,     0,
+       0,    44,    45,    46,    47,    48,    49,    50,     1,     2,
        0,     4,     5,     0,     0,     0,     0,     0,     0,     0,
-       0,     8,     9,    10,     0,    11,     0,    12,    13,     0,
-       0,     0,     0,     0,     0,    14,     0,     0,     0,     0,
-       0,     4,     0,     0,    15,    76,    17,    18,    19,    20,
-      21,    22,     0,    23,    24,    25,    26,    27,    28,    29,
-      30,     0,    31,    32,    33,     0,     0,     0,    34,    35,
-      36,    37,    38,    39,    40,    68,    17,    18,    19,    20,
-      21,    22,     0,    23,    24,    25,    26,     0,     0,     0,
-       0,     0,    31,    32,    33,     0,   100,   101,   102,   103,
-     104,   105,   106,   107,    69,   108,   109,   110,   111,   112,
-     113,   114,   115,   100,   101,   102,   103,   104,   105,   106,
-     107,     0,   108,   109,   110,   111,   112,   113,   114,   115,
-     149,    99,   100,   101,   102,   103,   104,   105,   106,   107,
-       0,   108,   109,   110,   111,   112,   113,   215,   100,   101,
-     102,   103,   104,   105,   106,   107,     0,   108,   109,   110,
-     111,   112,   113,   114,   115,   148,     0,     0,   100,   101,
-     102,   103,   104,   105,   106,   107,     0,   108,   109,   110,
-     111,   112,   113,   114,   115,   218,   100,   101,   102,   103,
-     104,   105,   106,   107,     0,   108,   109,   110,   111,   112,
-     113,   114,   115,   100,   101,   102,   103,   104,   105,   106,
-     107,     0,   108,   109,   110,   111,   112,   113,   114,   115
+       0,     0,     0,     0,     0,     0,    13,    14,    15,     0,
+      16,     0,    17,    18,     0,     0,     0,     0,     0,     0,
+      19,     0,     0,     0,     0,     0,     0,     0,     0,    20,
+     102,    22,    23,    24,    25,    26,    27,     0,    29,    30,
+      31,    32,    33,    34,    35,    36,     0,    37,    38,    39,
+      40,    41,    42,    43,     0,     0,     0,    44,    45,    46,
+      47,    48,    49,    50,     1,     2,     0,     4,     5,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    13,    14,    15,     0,    16,     0,    17,    18,
+       0,     0,     0,     0,     0,     0,    19,     0,     0,     0,
+       0,     0,     0,     0,     0,    20,    21,    22,    23,    24,
+      25,    26,    27,     0,    29,    30,    31,    32,    33,    34,
+      35,    36,     0,    37,    38,    39,    40,    41,    42,    43,
+       0,     0,     0,    44,    45,    46,    47,    48,    49,    50,
+     129,   130,   131,   132,   133,   134,   135,   136,     0,   137,
+     138,   139,   140,   141,   142,   143,   144,   129,   130,   131,
+     132,   133,   134,   135,   136,     0,   137,   138,   139,   140,
+     141,   142,   143,   144,   191,     0,     0,     0,     0,     0,
+     190,     0,     0,   129,   130,   131,   132,   133,   134,   135,
+     136,   279,   137,   138,   139,   140,   141,   142,   143,   144,
+     129,   130,   131,   132,   133,   134,   135,   136,     0,   137,
+     138,   139,   140,   141,   142,   143,   144
 };
 
 static const yytype_int16 yycheck[] =
 {
-      10,    11,    12,    13,    14,    15,    42,     0,     6,    69,
-       0,     6,     7,    19,     5,     8,     9,    69,     8,     9,
-       6,     7,    18,    18,     6,     7,    69,     6,     7,    69,
-      66,    22,    23,    24,    25,    26,    27,    28,    29,    18,
-      31,    32,    33,    34,    35,    36,    37,    38,     5,    42,
-      56,    69,    42,    22,    23,    24,    25,    26,    27,    28,
-      29,    60,    61,    62,    62,    56,    11,    12,    13,    14,
-      15,    16,    17,    66,    69,    69,    66,    24,    25,    26,
-      78,    69,    58,    69,    60,    69,    96,    69,     6,     7,
-     100,   101,   102,   103,   104,   105,   106,   107,   108,   109,
-     110,   111,   112,   113,   114,   115,    69,   117,   118,   119,
-     120,   121,     6,     7,    69,    60,    61,    62,    18,   129,
-     130,   131,   132,   133,   134,    11,    12,    13,    14,    15,
-      16,    17,     8,     9,    11,   145,     8,     9,     0,   149,
-      11,    12,    13,    14,    15,    11,    12,    13,    14,    15,
-       5,     9,   145,     6,     6,   145,     6,    69,    69,    69,
-      69,   197,    69,   199,    69,    26,   176,   177,   178,   179,
-     180,   199,   145,    -1,    60,    61,    62,   187,   188,   189,
-     190,   191,    -1,     3,     4,     5,     6,     7,     8,    -1,
-      10,    -1,   202,    -1,    -1,    -1,    16,    17,    18,    -1,
-      20,    21,    22,    23,   197,   215,   199,   197,    -1,   199,
-      30,    22,    23,    24,    25,    26,    -1,    -1,    -1,    39,
-      40,    41,    42,    43,    44,    45,    46,    -1,    48,    49,
-      50,    51,    52,    53,    54,    55,    -1,    57,    58,    59,
-      -1,    -1,    -1,    63,    64,    65,    66,    67,    68,    69,
-       3,     4,     5,     6,     7,     8,    -1,    10,    -1,    -1,
-      -1,    -1,    -1,    16,    17,    18,    -1,    20,    21,    22,
-      23,    -1,    -1,    -1,    -1,    -1,    -1,    30,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    39,    40,    41,    42,
-      43,    44,    45,    46,    -1,    48,    49,    50,    51,    52,
-      53,    54,    55,    -1,    57,    58,    59,    -1,    -1,    -1,
-      63,    64,    65,    66,    67,    68,    69,     3,     4,     5,
-       6,     7,     8,    -1,    10,    -1,    -1,    -1,    -1,    -1,
-      16,    17,    18,    -1,    20,    -1,    22,    23,    -1,    -1,
-      -1,    -1,    -1,    -1,    30,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    39,    40,    41,    42,    43,    44,    45,
-      46,    -1,    48,    49,    50,    51,    52,    53,    54,    55,
-      -1,    57,    58,    59,    -1,    -1,    -1,    63,    64,    65,
-      66,    67,    68,    69,     3,     4,     5,     6,     7,     8,
-      -1,    10,    -1,    -1,    -1,    -1,    -1,    16,    17,    18,
-      -1,    20,    -1,    22,    23,    -1,    -1,    -1,    -1,    -1,
-      -1,    30,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      39,    40,    41,    42,    43,    44,    45,    46,    -1,    48,
-      49,    50,    51,    52,    53,    54,    55,    -1,    57,    58,
-      59,    -1,    -1,    -1,    63,    64,    65,    66,    67,    68,
-      69,     3,     4,    -1,     6,     7,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    16,    17,    18,    19,    20,    -1,
-      22,    23,    -1,    -1,    -1,    -1,    -1,    -1,    30,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    39,    40,    41,
-      42,    43,    44,    45,    46,    -1,    48,    49,    50,    51,
-      52,    53,    54,    55,    -1,    57,    58,    59,    -1,    -1,
-      -1,    63,    64,    65,    66,    67,    68,    69,     3,     4,
+       0,    81,    83,     0,   194,   297,   258,     6,     7,     9,
+      90,   303,    78,    13,    14,   258,     6,     7,    26,     6,
+       7,     0,     6,     7,    23,     6,     7,   319,     6,    24,
+       9,    24,    10,   285,    13,    14,    23,   289,   330,    23,
+       6,     7,     6,     7,    78,   297,   289,     0,   300,     6,
+       7,   303,    52,    61,    23,    52,     9,   300,     6,     7,
+      13,    14,   314,     6,     7,   169,    61,   319,    61,   173,
+       5,   314,   176,    52,   238,     6,     7,   241,   330,    78,
+     244,    81,    23,    83,    84,    13,    14,    84,    78,     5,
+      90,   281,    13,    14,    78,     5,    78,    78,    76,    52,
+       6,    72,    81,    74,    83,    84,    69,    70,    71,    87,
+      78,    90,    78,    78,    78,    16,    17,    18,    19,    20,
+      78,    78,    29,    30,    31,    23,   104,    78,    81,    78,
+      83,    84,    16,    17,    18,    19,    20,    90,    78,    45,
+      46,    47,    48,    49,    50,    51,    78,    53,    54,    55,
+      56,    27,    28,    29,    30,    31,    62,    63,    64,    65,
+      66,    67,    68,    78,     5,   245,     0,     5,    16,    13,
+       6,     6,    78,    16,    17,    18,    19,    20,    21,    22,
+       6,     6,   182,    78,    78,   182,    27,    28,    29,    30,
+      31,    32,    33,    34,   194,    36,    37,    38,    39,    40,
+      41,    42,    43,   182,    23,    78,    78,   185,    16,    17,
+      18,    19,    20,    21,    22,   194,    78,    78,   299,    78,
+      61,    78,     9,     5,    25,    31,    69,    70,    71,   182,
+      45,    46,    47,    48,    49,    50,    51,   317,     5,    78,
+       5,   194,    23,    13,    24,   245,    78,    62,    63,    64,
+      65,    66,    67,    68,    78,    78,     9,     5,   258,     5,
+       5,    69,    70,    71,    24,   320,   245,   299,   328,    52,
+     300,   309,    -1,    15,    16,    17,    18,    19,    20,   258,
+      -1,   281,    -1,    -1,    -1,   285,    -1,    -1,    -1,   289,
+      -1,    -1,   245,    -1,    -1,    -1,    -1,   297,    -1,   299,
+     300,    -1,   281,   303,   282,   258,   285,    -1,   286,    -1,
+     289,    -1,    -1,    -1,   314,    -1,    -1,   317,   297,   319,
+     299,   300,    -1,    -1,   303,    -1,    -1,    -1,   281,    -1,
+     330,    24,   285,    -1,    -1,   314,   289,   315,   317,    -1,
+     319,    83,    84,    -1,   297,    -1,   299,   300,    -1,    -1,
+     303,   330,    45,    46,    47,    48,    49,    50,    51,    -1,
+      -1,   314,    -1,    -1,   317,    -1,   319,    -1,    -1,    62,
+      63,    64,    65,    66,    67,    68,    -1,   330,    -1,    -1,
+      -1,    -1,   124,    -1,    -1,    -1,    -1,   129,   130,   131,
+     132,   133,   134,   135,   136,   137,   138,   139,   140,   141,
+     142,   143,   144,     5,   146,   147,   148,   149,   150,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,   158,   159,   160,   161,
+     162,   163,    -1,    -1,    -1,    27,    28,    29,    30,    31,
+      32,    33,    34,     5,    36,    37,    38,    39,    40,    41,
+      42,    43,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   191,
+      -1,    -1,    -1,    -1,    -1,    27,    28,    29,    30,    31,
+      32,    33,    34,    -1,    36,    37,    38,    39,    40,    41,
+      42,    43,    -1,    -1,    -1,    -1,    -1,    -1,   220,   221,
+     222,   223,   224,    -1,    -1,    -1,    -1,    -1,    -1,   231,
+     232,   233,   234,   235,    -1,    26,    27,    28,    29,    30,
+      31,    32,    33,    34,   246,    36,    37,    38,    39,    40,
+      41,    42,    43,    -1,    -1,    -1,    -1,    -1,    -1,   261,
+      -1,    -1,    27,    28,    29,    30,    31,    32,    33,    34,
+      61,    36,    37,    38,    39,    40,    41,   279,    -1,    -1,
+      -1,   283,    27,    28,    29,    30,    31,    32,    33,    34,
+      -1,    -1,   294,    -1,    -1,    -1,    -1,   299,   300,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,   309,    -1,    -1,
+      -1,    -1,     3,     4,     5,     6,     7,     8,   320,    10,
+      11,    12,    13,    14,    15,    -1,   328,    -1,    -1,    -1,
+      21,    22,    23,    -1,    25,    -1,    27,    28,    -1,    -1,
+      -1,    -1,    -1,    -1,    35,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    44,    45,    46,    47,    48,    49,    50,
+      51,    52,    53,    54,    55,    56,    57,    58,    59,    60,
+      -1,    62,    63,    64,    65,    66,    67,    68,    -1,    -1,
+      -1,    72,    73,    74,    75,    76,    77,    78,     3,     4,
+       5,     6,     7,     8,    -1,    10,    11,    12,    13,    14,
+      15,    -1,    -1,    -1,    -1,    -1,    21,    22,    23,    -1,
+      25,    26,    27,    28,    -1,    -1,    -1,    -1,    -1,    -1,
+      35,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    44,
+      45,    46,    47,    48,    49,    50,    51,    -1,    53,    54,
+      55,    56,    57,    58,    59,    60,    -1,    62,    63,    64,
+      65,    66,    67,    68,    -1,    -1,    -1,    72,    73,    74,
+      75,    76,    77,    78,     3,     4,     5,     6,     7,     8,
+      -1,    10,    11,    12,    13,    14,    15,    -1,    -1,    -1,
+      -1,    -1,    21,    22,    23,    -1,    25,    26,    27,    28,
+      -1,    -1,    -1,    -1,    -1,    -1,    35,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    44,    45,    46,    47,    48,
+      49,    50,    51,    -1,    53,    54,    55,    56,    57,    58,
+      59,    60,    -1,    62,    63,    64,    65,    66,    67,    68,
+      -1,    -1,    -1,    72,    73,    74,    75,    76,    77,    78,
+       3,     4,     5,     6,     7,     8,    -1,    10,    11,    12,
+      13,    14,    15,    -1,    -1,    -1,    -1,    -1,    21,    22,
+      23,    -1,    25,    26,    27,    28,    -1,    -1,    -1,    -1,
+      -1,    -1,    35,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    44,    45,    46,    47,    48,    49,    50,    51,    -1,
+      53,    54,    55,    56,    57,    58,    59,    60,    -1,    62,
+      63,    64,    65,    66,    67,    68,    -1,    -1,    -1,    72,
+      73,    74,    75,    76,    77,    78,     3,     4,     5,     6,
+       7,     8,    -1,    10,    11,    12,    13,    14,    15,    -1,
+      -1,    -1,    -1,    -1,    21,    22,    23,    -1,    25,    26,
+      27,    28,    -1,    -1,    -1,    -1,    -1,    -1,    35,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    44,    45,    46,
+      47,    48,    49,    50,    51,    -1,    53,    54,    55,    56,
+      57,    58,    59,    60,    -1,    62,    63,    64,    65,    66,
+      67,    68,    -1,    -1,    -1,    72,    73,    74,    75,    76,
+      77,    78,     3,     4,     5,     6,     7,     8,    -1,    10,
+      11,    12,    13,    14,    15,    -1,    -1,    -1,    -1,    -1,
+      21,    22,    23,    -1,    25,    26,    27,    28,    -1,    -1,
+      -1,    -1,    -1,    -1,    35,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    44,    45,    46,    47,    48,    49,    50,
+      51,    -1,    53,    54,    55,    56,    57,    58,    59,    60,
+      -1,    62,    63,    64,    65,    66,    67,    68,    -1,    -1,
+      -1,    72,    73,    74,    75,    76,    77,    78,     3,     4,
+       5,     6,     7,     8,    -1,    10,    11,    12,    13,    14,
+      15,    -1,    -1,    -1,    -1,    -1,    21,    22,    23,    -1,
+      25,    26,    27,    28,    -1,    -1,    -1,    -1,    -1,    -1,
+      35,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    44,
+      45,    46,    47,    48,    49,    50,    51,    -1,    53,    54,
+      55,    56,    57,    58,    59,    60,    -1,    62,    63,    64,
+      65,    66,    67,    68,    -1,    -1,    -1,    72,    73,    74,
+      75,    76,    77,    78,     3,     4,     5,     6,     7,     8,
+      -1,    10,    11,    12,    13,    14,    15,    -1,    -1,    -1,
+      -1,    -1,    21,    22,    23,    -1,    25,    -1,    27,    28,
+      -1,    -1,    -1,    -1,    -1,    -1,    35,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    44,    45,    46,    47,    48,
+      49,    50,    51,    -1,    53,    54,    55,    56,    57,    58,
+      59,    60,    -1,    62,    63,    64,    65,    66,    67,    68,
+      -1,    -1,    -1,    72,    73,    74,    75,    76,    77,    78,
+       3,     4,     5,     6,     7,     8,    -1,    10,    11,    12,
+      13,    14,    15,    -1,    -1,    -1,    -1,    -1,    21,    22,
+      23,    -1,    25,    -1,    27,    28,    -1,    -1,    -1,    -1,
+      -1,    -1,    35,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    44,    45,    46,    47,    48,    49,    50,    51,    -1,
+      53,    54,    55,    56,    57,    58,    59,    60,    -1,    62,
+      63,    64,    65,    66,    67,    68,    -1,    -1,    -1,    72,
+      73,    74,    75,    76,    77,    78,     3,     4,    -1,     6,
+       7,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    21,    22,    23,    24,    25,    -1,
+      27,    28,    -1,    -1,    -1,    -1,    -1,    -1,    35,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    44,    45,    46,
+      47,    48,    49,    50,    51,    -1,    53,    54,    55,    56,
+      57,    58,    59,    60,    -1,    62,    63,    64,    65,    66,
+      67,    68,    -1,    -1,    -1,    72,    73,    74,    75,    76,
+      77,    78,     3,     4,     5,     6,     7,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      21,    22,    23,    -1,    25,    -1,    27,    28,    -1,    -1,
+      -1,    -1,    -1,    -1,    35,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    44,    45,    46,    47,    48,    49,    50,
+      51,    -1,    53,    54,    55,    56,    57,    58,    59,    60,
+      -1,    62,    63,    64,    65,    66,    67,    68,    -1,    -1,
+      -1,    72,    73,    74,    75,    76,    77,    78,     3,     4,
       -1,     6,     7,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    16,    17,    18,    -1,    20,    -1,    22,    23,    -1,
-      -1,    -1,    -1,    -1,    -1,    30,    -1,    -1,    -1,    -1,
-      -1,     6,    -1,    -1,    39,    40,    41,    42,    43,    44,
-      45,    46,    -1,    48,    49,    50,    51,    52,    53,    54,
-      55,    -1,    57,    58,    59,    -1,    -1,    -1,    63,    64,
-      65,    66,    67,    68,    69,    40,    41,    42,    43,    44,
-      45,    46,    -1,    48,    49,    50,    51,    -1,    -1,    -1,
-      -1,    -1,    57,    58,    59,    -1,    22,    23,    24,    25,
-      26,    27,    28,    29,    69,    31,    32,    33,    34,    35,
-      36,    37,    38,    22,    23,    24,    25,    26,    27,    28,
-      29,    -1,    31,    32,    33,    34,    35,    36,    37,    38,
-      56,     5,    22,    23,    24,    25,    26,    27,    28,    29,
-      -1,    31,    32,    33,    34,    35,    36,    56,    22,    23,
-      24,    25,    26,    27,    28,    29,    -1,    31,    32,    33,
-      34,    35,    36,    37,    38,    19,    -1,    -1,    22,    23,
-      24,    25,    26,    27,    28,    29,    -1,    31,    32,    33,
-      34,    35,    36,    37,    38,    21,    22,    23,    24,    25,
-      26,    27,    28,    29,    -1,    31,    32,    33,    34,    35,
-      36,    37,    38,    22,    23,    24,    25,    26,    27,    28,
-      29,    -1,    31,    32,    33,    34,    35,    36,    37,    38
+      -1,    -1,    -1,    -1,    -1,    -1,    21,    22,    23,    -1,
+      25,    -1,    27,    28,    -1,    -1,    -1,    -1,    -1,    -1,
+      35,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    44,
+      45,    46,    47,    48,    49,    50,    51,    -1,    53,    54,
+      55,    56,    57,    58,    59,    60,    -1,    62,    63,    64,
+      65,    66,    67,    68,    -1,    -1,    -1,    72,    73,    74,
+      75,    76,    77,    78,     3,     4,    -1,     6,     7,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    21,    22,    23,    -1,    25,    -1,    27,    28,
+      -1,    -1,    -1,    -1,    -1,    -1,    35,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    44,    45,    46,    47,    48,
+      49,    50,    51,    -1,    53,    54,    55,    56,    57,    58,
+      59,    60,    -1,    62,    63,    64,    65,    66,    67,    68,
+      -1,    -1,    -1,    72,    73,    74,    75,    76,    77,    78,
+      27,    28,    29,    30,    31,    32,    33,    34,    -1,    36,
+      37,    38,    39,    40,    41,    42,    43,    27,    28,    29,
+      30,    31,    32,    33,    34,    -1,    36,    37,    38,    39,
+      40,    41,    42,    43,    61,    -1,    -1,    -1,    -1,    -1,
+      24,    -1,    -1,    27,    28,    29,    30,    31,    32,    33,
+      34,    61,    36,    37,    38,    39,    40,    41,    42,    43,
+      27,    28,    29,    30,    31,    32,    33,    34,    -1,    36,
+      37,    38,    39,    40,    41,    42,    43
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-       0,     3,     4,     5,     6,     7,     8,    10,    16,    17,
-      18,    20,    22,    23,    30,    39,    40,    41,    42,    43,
-      44,    45,    46,    48,    49,    50,    51,    52,    53,    54,
-      55,    57,    58,    59,    63,    64,    65,    66,    67,    68,
-      69,    74,    76,    77,    78,    79,    80,    81,    82,    83,
-      85,    86,    87,    88,    89,    90,    91,    92,    93,    94,
-      95,    96,    98,    99,    69,    69,    81,     5,    40,    69,
-      92,    95,    98,    99,    92,    95,    40,    79,    98,    99,
-      79,    79,    79,    79,    79,     6,     7,    69,    69,    69,
-      69,    69,    69,    69,    69,    69,    18,     0,    77,     5,
-      22,    23,    24,    25,    26,    27,    28,    29,    31,    32,
-      33,    34,    35,    36,    37,    38,     5,    11,    12,    13,
-      14,    15,    16,    17,    60,    61,    62,    97,    97,    11,
-      11,    12,    13,    14,    15,    16,    17,    97,     6,     7,
-      69,    81,     6,     7,    69,    20,    75,    77,    19,    56,
-      69,    69,    19,    79,    84,    79,    79,    79,    79,    79,
-      79,    79,    79,    79,    79,    79,    79,    79,    79,    79,
-      79,    79,    79,    79,    79,    79,    11,    12,    13,    14,
-      15,    79,    79,    79,    79,    79,    79,    11,    12,    13,
-      14,    15,    69,    69,    69,    69,    21,    76,    79,     9,
-      79,    19,    56,    79,    79,    79,    79,    79,    79,    79,
-      79,    79,    79,    21,    75,    56,    79,    79,    21
+       0,     3,     4,     5,     6,     7,     8,    10,    11,    12,
+      13,    14,    15,    21,    22,    23,    25,    27,    28,    35,
+      44,    45,    46,    47,    48,    49,    50,    51,    52,    53,
+      54,    55,    56,    57,    58,    59,    60,    62,    63,    64,
+      65,    66,    67,    68,    72,    73,    74,    75,    76,    77,
+      78,    83,    84,    87,    88,    89,    90,    94,   103,   104,
+     105,   106,   107,   109,   110,   111,   112,   113,   114,   115,
+     116,   117,   118,   119,   120,   121,   123,   124,   125,    78,
+      78,   105,     5,    23,    25,    85,    87,   123,   124,   125,
+     105,     5,     5,    45,    78,   117,   120,   123,   124,   125,
+     117,   120,    45,   103,   123,   124,   125,   103,   103,   103,
+     103,   103,     6,     7,    78,    78,    78,    78,    78,    78,
+      78,    78,    78,    78,    23,     0,    87,    94,     5,    27,
+      28,    29,    30,    31,    32,    33,    34,    36,    37,    38,
+      39,    40,    41,    42,    43,     5,    16,    17,    18,    19,
+      20,    21,    22,    69,    70,    71,   122,   122,    16,    16,
+      17,    18,    19,    20,    21,    22,   122,     6,     7,    78,
+     105,     6,     7,    78,     6,     7,    78,    85,    91,   103,
+     109,    26,    86,    87,   103,    13,    78,    78,    78,    85,
+      24,    61,    78,    78,    23,    95,    24,   103,   108,   103,
+     103,   103,   103,   103,   103,   103,   103,   103,   103,   103,
+     103,   103,   103,   103,   103,   103,   103,   103,   103,   103,
+      16,    17,    18,    19,    20,   103,   103,   103,   103,   103,
+     103,    16,    17,    18,    19,    20,    78,    78,    95,    78,
+      78,    95,    78,    78,    95,     9,     5,    26,    87,   105,
+     103,    24,    45,    96,   119,   123,   124,   125,    25,    97,
+      24,    61,   103,   103,   103,   103,   103,   103,   103,   103,
+     103,   103,    97,    97,    97,    85,    92,   103,     5,    61,
+      24,    61,     8,    10,    11,    12,    13,    26,    88,    99,
+     100,   101,   102,   103,     5,   103,   119,   105,   103,    23,
+      25,    98,   100,   105,    26,   100,    93,   103,    26,    61,
+      98,     5,    91,    26,    99,    13,    98,    24,   108,     9,
+       5,    26,   105,    85,    26,    98,    92,     5,     5,    93,
+      24,    98
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       0,    73,    74,    74,    75,    75,    75,    76,    76,    77,
-      77,    77,    77,    77,    78,    78,    79,    79,    79,    79,
-      79,    79,    79,    79,    79,    79,    79,    79,    79,    79,
-      80,    80,    80,    81,    82,    83,    83,    84,    84,    85,
-      85,    86,    86,    86,    86,    86,    86,    86,    86,    86,
-      86,    87,    87,    87,    87,    87,    87,    87,    87,    87,
-      87,    88,    88,    88,    88,    88,    88,    88,    88,    89,
-      89,    89,    89,    90,    90,    90,    90,    90,    90,    90,
-      90,    90,    90,    90,    90,    90,    90,    90,    90,    91,
-      92,    92,    92,    92,    92,    92,    92,    92,    93,    93,
-      93,    93,    93,    93,    93,    93,    94,    94,    94,    95,
-      96,    96,    96,    96,    96,    96,    96,    96,    97,    97,
-      97,    98,    98,    98,    98,    98,    98,    99,    99,    99
+       0,    82,    83,    83,    84,    84,    84,    84,    85,    85,
+      85,    86,    86,    87,    87,    87,    88,    88,    88,    88,
+      88,    88,    89,    89,    90,    90,    90,    91,    91,    91,
+      92,    92,    93,    93,    94,    94,    94,    94,    95,    95,
+      96,    96,    97,    97,    98,    98,    98,    99,    99,   100,
+     100,   100,   100,   101,   101,   102,   102,   102,   103,   103,
+     103,   103,   103,   103,   103,   103,   103,   103,   103,   103,
+     103,   103,   103,   104,   104,   104,   105,   106,   107,   107,
+     108,   108,   109,   109,   110,   110,   110,   110,   110,   110,
+     110,   110,   110,   110,   111,   111,   111,   111,   111,   111,
+     111,   111,   111,   111,   112,   112,   112,   112,   112,   112,
+     112,   112,   113,   113,   113,   113,   114,   114,   114,   114,
+     114,   114,   114,   114,   114,   114,   114,   114,   114,   114,
+     114,   114,   115,   116,   117,   117,   117,   117,   117,   117,
+     117,   117,   117,   118,   118,   118,   118,   118,   118,   118,
+     118,   118,   119,   119,   119,   119,   120,   121,   121,   121,
+     121,   121,   121,   121,   121,   122,   122,   122,   123,   123,
+     123,   123,   123,   123,   124,   124,   124,   125,   125,   125,
+     125
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,     2,     0,     1,     3,     2,     1,     2,     1,     2,
-       2,     1,     2,     1,     3,     5,     1,     1,     1,     1,
+       0,     2,     0,     1,     2,     2,     1,     1,     3,     2,
+       1,     2,     1,     1,     1,     1,     2,     2,     2,     2,
+       2,     1,     3,     5,     9,     3,     5,     0,     1,     1,
+       0,     1,     0,     1,     4,     4,     4,     4,     3,     2,
+       1,     3,     3,     2,     3,     2,     1,     2,     1,     1,
+       1,     1,     3,     3,     5,     9,     3,     5,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       2,     2,     2,     3,     2,     4,     3,     1,     3,     3,
-       1,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     4,     4,     4,     4,     4,     4,     4,     4,     4,
-       4,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     7,
-       3,     3,     2,     2,     2,     2,     3,     2,     3,     3,
-       2,     2,     2,     2,     3,     2,     2,     2,     2,     1,
+       1,     1,     1,     2,     2,     2,     3,     2,     4,     3,
+       1,     3,     3,     1,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     4,     4,     4,     4,     4,     4,
+       4,     4,     4,     4,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     7,     9,     3,     3,     3,     2,     2,     2,
+       2,     3,     2,     3,     3,     3,     2,     2,     2,     2,
+       3,     2,     2,     2,     2,     2,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (tree, YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (tree, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -1050,20 +1462,27 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
 YY_ATTRIBUTE_UNUSED
-static unsigned
+static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  unsigned res = 0;
+  int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
     {
@@ -1083,64 +1502,72 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location, tree); \
+                  Kind, Value, Location, tree); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, openvdb::ax::ast::Tree** tree)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, openvdb::ax::ast::Tree** tree)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (yylocationp);
-  YYUSE (tree);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (tree);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, openvdb::ax::ast::Tree** tree)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, openvdb::ax::ast::Tree** tree)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp, tree);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, tree);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1149,7 +1576,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYL
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1172,21 +1599,22 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule, openvdb::ax::ast::Tree** tree)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, openvdb::ax::ast::Tree** tree)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       , tree);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), tree);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1201,8 +1629,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1225,28 +1653,77 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1260,10 +1737,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1271,14 +1748,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1289,7 +1765,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -1304,36 +1783,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1357,49 +1820,54 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1407,14 +1875,23 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1423,7 +1900,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1435,42 +1912,41 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, openvdb::ax::ast::Tree** tree)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, openvdb::ax::ast::Tree** tree)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-  YYUSE (tree);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (tree);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 /* The semantic value of the lookahead symbol.  */
@@ -1485,6 +1961,8 @@ YYLTYPE yylloc
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1492,53 +1970,48 @@ int yynerrs;
 int
 yyparse (openvdb::ax::ast::Tree** tree)
 {
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYSIZE_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1546,43 +2019,49 @@ yyparse (openvdb::ax::ast::Tree** tree)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
         YYLTYPE *yyls1 = yyls;
 
         /* Each stack pointer address is followed by the size of the
@@ -1590,32 +2069,29 @@ yyparse (openvdb::ax::ast::Tree** tree)
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
-                    &yyls1, yysize * sizeof (*yylsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
                     &yystacksize);
-
-        yyls = yyls1;
         yyss = yyss1;
         yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
@@ -1624,31 +2100,32 @@ yyparse (openvdb::ax::ast::Tree** tree)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1659,18 +2136,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1698,15 +2187,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1721,7 +2209,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1743,776 +2231,1089 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 206 "grammar/axparser.y" /* yacc.c:1648  */
-    { *tree = new Tree(); (yyval.tree) = *tree; }
-#line 1750 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 2: /* statements: %empty  */
+#line 307 "grammar/axparser.y"
+      { *tree = new Tree(); (yyval.tree) = *tree; }
+#line 2238 "grammar/axparser.cc"
+    break;
+
+  case 3: /* statements: program  */
+#line 308 "grammar/axparser.y"
+              { *tree = new Tree((yyvsp[0].block)); (yyval.tree) = *tree; }
+#line 2244 "grammar/axparser.cc"
+    break;
+
+  case 4: /* program: program statement  */
+#line 314 "grammar/axparser.y"
+                                   { if ((yyvsp[0].statement)) (yyvsp[-1].block)->mList.emplace_back((yyvsp[0].statement)); (yyval.block) = (yyvsp[-1].block); }
+#line 2250 "grammar/axparser.cc"
+    break;
+
+  case 5: /* program: program function_definition  */
+#line 315 "grammar/axparser.y"
+                                   { (yyvsp[-1].block)->mList.emplace_back((yyvsp[0].function_definition)); (yyval.block) = (yyvsp[-1].block); }
+#line 2256 "grammar/axparser.cc"
+    break;
+
+  case 6: /* program: statement  */
+#line 316 "grammar/axparser.y"
+                                   { (yyval.block) = new Block(); if ((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
+#line 2262 "grammar/axparser.cc"
+    break;
+
+  case 7: /* program: function_definition  */
+#line 317 "grammar/axparser.y"
+                                   { (yyval.block) = new Block(); (yyval.block)->mList.emplace_back((yyvsp[0].function_definition)); }
+#line 2268 "grammar/axparser.cc"
     break;
 
-  case 3:
-#line 207 "grammar/axparser.y" /* yacc.c:1648  */
-    { *tree = new Tree((yyvsp[0].block)); (yyval.tree) = *tree; }
-#line 1756 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 8: /* block: LCURLY body RCURLY  */
+#line 321 "grammar/axparser.y"
+                          { (yyval.block) = (yyvsp[-1].block); }
+#line 2274 "grammar/axparser.cc"
     break;
 
-  case 4:
-#line 211 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.block) = (yyvsp[-1].block); }
-#line 1762 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 9: /* block: LCURLY RCURLY  */
+#line 322 "grammar/axparser.y"
+                          { (yyval.block) = new Block(); }
+#line 2280 "grammar/axparser.cc"
     break;
 
-  case 5:
-#line 212 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.block) = new Block(); }
-#line 1768 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 10: /* block: statement  */
+#line 323 "grammar/axparser.y"
+                          { (yyval.block) = new Block(); if((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
+#line 2286 "grammar/axparser.cc"
     break;
 
-  case 6:
-#line 213 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.block) = new Block(); if((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
-#line 1774 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 11: /* body: body statement  */
+#line 327 "grammar/axparser.y"
+                      { if ((yyvsp[0].statement)) (yyvsp[-1].block)->mList.emplace_back((yyvsp[0].statement)); (yyval.block) = (yyvsp[-1].block); }
+#line 2292 "grammar/axparser.cc"
     break;
 
-  case 7:
-#line 217 "grammar/axparser.y" /* yacc.c:1648  */
-    { if ((yyvsp[0].statement)) (yyvsp[-1].block)->mList.emplace_back((yyvsp[0].statement)); (yyval.block) = (yyvsp[-1].block); }
-#line 1780 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 12: /* body: statement  */
+#line 328 "grammar/axparser.y"
+                      { (yyval.block) = new Block(); if ((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
+#line 2298 "grammar/axparser.cc"
     break;
 
-  case 8:
-#line 218 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.block) = new Block(); if ((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
-#line 1786 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 13: /* statement: simple_statement  */
+#line 334 "grammar/axparser.y"
+                             { (yyval.statement) = (yyvsp[0].statement); }
+#line 2304 "grammar/axparser.cc"
     break;
 
-  case 9:
-#line 224 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = (yyvsp[-1].expression); }
-#line 1792 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 14: /* statement: conditional_statement  */
+#line 335 "grammar/axparser.y"
+                             { (yyval.statement) = (yyvsp[0].statement); }
+#line 2310 "grammar/axparser.cc"
     break;
 
-  case 10:
-#line 225 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = (yyvsp[-1].statement); }
-#line 1798 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 15: /* statement: loop_statement  */
+#line 336 "grammar/axparser.y"
+                             { (yyval.statement) = (yyvsp[0].loop); }
+#line 2316 "grammar/axparser.cc"
     break;
 
-  case 11:
-#line 226 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = (yyvsp[0].statement); }
-#line 1804 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 16: /* simple_statement: expression SEMICOLON  */
+#line 341 "grammar/axparser.y"
+                                    { (yyval.statement) = (yyvsp[-1].expression); }
+#line 2322 "grammar/axparser.cc"
     break;
 
-  case 12:
-#line 227 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = new Return; }
-#line 1810 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 17: /* simple_statement: declare_assignment SEMICOLON  */
+#line 342 "grammar/axparser.y"
+                                    { (yyval.statement) = (yyvsp[-1].statement); }
+#line 2328 "grammar/axparser.cc"
     break;
 
-  case 13:
-#line 228 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = nullptr; }
-#line 1816 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 18: /* simple_statement: RETURN SEMICOLON  */
+#line 343 "grammar/axparser.y"
+                                    { (yyval.statement) = new Return; }
+#line 2334 "grammar/axparser.cc"
     break;
 
-  case 14:
-#line 236 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = new ConditionalStatement((yyvsp[-1].expression), (yyvsp[0].block), new Block()); }
-#line 1822 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 19: /* simple_statement: BREAK SEMICOLON  */
+#line 344 "grammar/axparser.y"
+                                    { (yyval.statement) = new Break; }
+#line 2340 "grammar/axparser.cc"
     break;
 
-  case 15:
-#line 237 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = new ConditionalStatement((yyvsp[-3].expression), (yyvsp[-2].block), (yyvsp[0].block)); }
-#line 1828 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 20: /* simple_statement: CONTINUE SEMICOLON  */
+#line 345 "grammar/axparser.y"
+                                    { (yyval.statement) = new Continue; }
+#line 2346 "grammar/axparser.cc"
     break;
 
-  case 16:
-#line 243 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1834 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 21: /* simple_statement: SEMICOLON  */
+#line 346 "grammar/axparser.y"
+                                    { (yyval.statement) = nullptr; }
+#line 2352 "grammar/axparser.cc"
     break;
 
-  case 17:
-#line 244 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1840 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 22: /* conditional_statement: IF expression_expand block  */
+#line 353 "grammar/axparser.y"
+                                                        { (yyval.statement) = new ConditionalStatement((yyvsp[-1].expression), (yyvsp[0].block), new Block()); }
+#line 2358 "grammar/axparser.cc"
     break;
 
-  case 18:
-#line 245 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1846 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 23: /* conditional_statement: IF expression_expand block ELSE block  */
+#line 354 "grammar/axparser.y"
+                                                        { (yyval.statement) = new ConditionalStatement((yyvsp[-3].expression), (yyvsp[-2].block), (yyvsp[0].block)); }
+#line 2364 "grammar/axparser.cc"
     break;
 
-  case 19:
-#line 246 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1852 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 24: /* loop_statement: FOR LPARENS loop_initial SEMICOLON loop_condition SEMICOLON loop_iteration RPARENS block  */
+#line 360 "grammar/axparser.y"
+                                                                                                { (yyval.loop) = new Loop(Loop::For, (yyvsp[-6].statement), (yyvsp[-4].expression), (yyvsp[-2].expression), (yyvsp[0].block)); }
+#line 2370 "grammar/axparser.cc"
     break;
 
-  case 20:
-#line 247 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1858 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 25: /* loop_statement: WHILE expression_expand block  */
+#line 361 "grammar/axparser.y"
+                                                       { (yyval.loop) = new Loop(Loop::While, nullptr, (yyvsp[-1].expression), nullptr, (yyvsp[0].block)); }
+#line 2376 "grammar/axparser.cc"
     break;
 
-  case 21:
-#line 248 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1864 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 26: /* loop_statement: DO block WHILE expression_expand SEMICOLON  */
+#line 362 "grammar/axparser.y"
+                                                       { (yyval.loop) = new Loop(Loop::DoWhile, nullptr, (yyvsp[-1].expression), nullptr, (yyvsp[-3].block)); }
+#line 2382 "grammar/axparser.cc"
     break;
 
-  case 22:
-#line 249 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1870 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 27: /* loop_initial: %empty  */
+#line 368 "grammar/axparser.y"
+                          { (yyval.statement) = nullptr; }
+#line 2388 "grammar/axparser.cc"
     break;
 
-  case 23:
-#line 250 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1876 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 28: /* loop_initial: expression  */
+#line 369 "grammar/axparser.y"
+                          { (yyval.statement) = (yyvsp[0].expression); }
+#line 2394 "grammar/axparser.cc"
     break;
 
-  case 24:
-#line 251 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].value); }
-#line 1882 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 29: /* loop_initial: declare_assignment  */
+#line 370 "grammar/axparser.y"
+                          { (yyval.statement) = (yyvsp[0].statement); }
+#line 2400 "grammar/axparser.cc"
     break;
 
-  case 25:
-#line 252 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].vector_unpack); }
-#line 1888 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 30: /* loop_condition: %empty  */
+#line 374 "grammar/axparser.y"
+                     { (yyval.expression) = nullptr; }
+#line 2406 "grammar/axparser.cc"
     break;
 
-  case 26:
-#line 253 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].value); }
-#line 1894 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 31: /* loop_condition: expression  */
+#line 375 "grammar/axparser.y"
+                     { (yyval.expression) = (yyvsp[0].expression); }
+#line 2412 "grammar/axparser.cc"
     break;
 
-  case 27:
-#line 254 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].external); }
-#line 1900 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 32: /* loop_iteration: %empty  */
+#line 379 "grammar/axparser.y"
+                     { (yyval.expression) = nullptr; }
+#line 2418 "grammar/axparser.cc"
     break;
 
-  case 28:
-#line 255 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new LocalValue((yyvsp[0].local)); }
-#line 1906 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 33: /* loop_iteration: expression  */
+#line 380 "grammar/axparser.y"
+                     { (yyval.expression) = (yyvsp[0].expression); }
+#line 2424 "grammar/axparser.cc"
     break;
 
-  case 29:
-#line 256 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AttributeValue((yyvsp[0].attribute)); }
-#line 1912 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 34: /* function_definition: scalar_type IDENTIFIER function_parameters function_scope  */
+#line 387 "grammar/axparser.y"
+                                                                 { (yyval.function_definition) = buildFunctionDefinition((yyvsp[-3].value_string), (yyvsp[-2].value_string), (yyvsp[-1].expressionlist), (yyvsp[0].block)); free((char*)(yyvsp[-2].value_string)); }
+#line 2430 "grammar/axparser.cc"
     break;
 
-  case 30:
-#line 263 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.vector_unpack) = new VectorUnpack(new AttributeValue((yyvsp[-1].attribute)), (yyvsp[0].index)); }
-#line 1918 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 35: /* function_definition: vector_type IDENTIFIER function_parameters function_scope  */
+#line 388 "grammar/axparser.y"
+                                                                 { (yyval.function_definition) = buildFunctionDefinition((yyvsp[-3].value_string), (yyvsp[-2].value_string), (yyvsp[-1].expressionlist), (yyvsp[0].block)); free((char*)(yyvsp[-2].value_string)); }
+#line 2436 "grammar/axparser.cc"
     break;
 
-  case 31:
-#line 264 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.vector_unpack) = new VectorUnpack(new LocalValue((yyvsp[-1].local)), (yyvsp[0].index)); }
-#line 1924 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 36: /* function_definition: matrix_type IDENTIFIER function_parameters function_scope  */
+#line 389 "grammar/axparser.y"
+                                                                 { (yyval.function_definition) = buildFunctionDefinition((yyvsp[-3].value_string), (yyvsp[-2].value_string), (yyvsp[-1].expressionlist), (yyvsp[0].block)); free((char*)(yyvsp[-2].value_string)); }
+#line 2442 "grammar/axparser.cc"
     break;
 
-  case 32:
-#line 265 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.vector_unpack) = new VectorUnpack((yyvsp[-1].external), (yyvsp[0].index)); }
-#line 1930 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 37: /* function_definition: VOID IDENTIFIER function_parameters function_scope  */
+#line 390 "grammar/axparser.y"
+                                                                 { (yyval.function_definition) = buildFunctionDefinition("void", (yyvsp[-2].value_string), (yyvsp[-1].expressionlist), (yyvsp[0].block)); free((char*)(yyvsp[-2].value_string)); }
+#line 2448 "grammar/axparser.cc"
     break;
 
-  case 33:
-#line 270 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[-1].expression); }
-#line 1936 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 38: /* function_parameters: LPARENS parameters RPARENS  */
+#line 395 "grammar/axparser.y"
+                                  { (yyval.expressionlist) = (yyvsp[-1].expressionlist); }
+#line 2454 "grammar/axparser.cc"
     break;
 
-  case 34:
-#line 277 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Cast((yyvsp[0].expression), (yyvsp[-1].value_string)); }
-#line 1942 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 39: /* function_parameters: LPARENS RPARENS  */
+#line 396 "grammar/axparser.y"
+                                  { (yyval.expressionlist) = new ExpressionList(); }
+#line 2460 "grammar/axparser.cc"
     break;
 
-  case 35:
-#line 282 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new FunctionCall((yyvsp[-3].value_string), (yyvsp[-1].expressionlist)); free((char*)(yyvsp[-3].value_string)); }
-#line 1948 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 40: /* parameters: declare_local  */
+#line 401 "grammar/axparser.y"
+                                      { (yyval.expressionlist) = new ExpressionList(); (yyval.expressionlist)->mList.emplace_back((yyvsp[0].declare_local)); }
+#line 2466 "grammar/axparser.cc"
     break;
 
-  case 36:
-#line 283 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new FunctionCall((yyvsp[-2].value_string)); free((char*)(yyvsp[-2].value_string)); }
-#line 1954 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 41: /* parameters: parameters COMMA declare_local  */
+#line 402 "grammar/axparser.y"
+                                      { (yyvsp[-2].expressionlist)->mList.emplace_back((yyvsp[0].declare_local)); (yyval.expressionlist) = (yyvsp[-2].expressionlist); }
+#line 2472 "grammar/axparser.cc"
     break;
 
-  case 37:
-#line 288 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expressionlist) = new ExpressionList(); (yyval.expressionlist)->mList.emplace_back((yyvsp[0].expression)); }
-#line 1960 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 42: /* function_scope: LCURLY function_body RCURLY  */
+#line 407 "grammar/axparser.y"
+                                   { (yyval.block) = (yyvsp[-1].block); }
+#line 2478 "grammar/axparser.cc"
     break;
 
-  case 38:
-#line 289 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyvsp[-2].expressionlist)->mList.emplace_back((yyvsp[0].expression)); (yyval.expressionlist) = (yyvsp[-2].expressionlist); }
-#line 1966 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 43: /* function_scope: LCURLY RCURLY  */
+#line 408 "grammar/axparser.y"
+                                   { (yyval.block) = new Block(); }
+#line 2484 "grammar/axparser.cc"
     break;
 
-  case 39:
-#line 296 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = new AssignExpression((yyvsp[-2].declare_local), (yyvsp[0].expression)); }
-#line 1972 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 44: /* function_block: LCURLY function_body RCURLY  */
+#line 412 "grammar/axparser.y"
+                                   { (yyval.block) = (yyvsp[-1].block); }
+#line 2490 "grammar/axparser.cc"
     break;
 
-  case 40:
-#line 297 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = (yyvsp[0].declare_local); }
-#line 1978 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 45: /* function_block: LCURLY RCURLY  */
+#line 413 "grammar/axparser.y"
+                                   { (yyval.block) = new Block(); }
+#line 2496 "grammar/axparser.cc"
     break;
 
-  case 41:
-#line 306 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), (yyvsp[0].expression)); }
-#line 1984 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 46: /* function_block: function_statement  */
+#line 414 "grammar/axparser.y"
+                                   { (yyval.block) = new Block(); if((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
+#line 2502 "grammar/axparser.cc"
     break;
 
-  case 42:
-#line 307 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::PLUS, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
-#line 1990 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 47: /* function_body: function_body function_statement  */
+#line 418 "grammar/axparser.y"
+                                        { if ((yyvsp[0].statement)) (yyvsp[-1].block)->mList.emplace_back((yyvsp[0].statement)); (yyval.block) = (yyvsp[-1].block); }
+#line 2508 "grammar/axparser.cc"
     break;
 
-  case 43:
-#line 308 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::MINUS, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
-#line 1996 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 48: /* function_body: function_statement  */
+#line 419 "grammar/axparser.y"
+                                        { (yyval.block) = new Block(); if ((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
+#line 2514 "grammar/axparser.cc"
     break;
 
-  case 44:
-#line 309 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::MULTIPLY, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
-#line 2002 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 49: /* function_statement: simple_statement  */
+#line 425 "grammar/axparser.y"
+                                      { (yyval.statement) = (yyvsp[0].statement); }
+#line 2520 "grammar/axparser.cc"
     break;
 
-  case 45:
-#line 310 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::DIVIDE, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
-#line 2008 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 50: /* function_statement: function_conditional_statement  */
+#line 426 "grammar/axparser.y"
+                                      { (yyval.statement) = (yyvsp[0].statement); }
+#line 2526 "grammar/axparser.cc"
     break;
 
-  case 46:
-#line 311 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), (yyvsp[0].expression)); }
-#line 2014 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 51: /* function_statement: function_loop_statement  */
+#line 427 "grammar/axparser.y"
+                                      { (yyval.statement) = (yyvsp[0].loop); }
+#line 2532 "grammar/axparser.cc"
     break;
 
-  case 47:
-#line 312 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::PLUS, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
-#line 2020 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 52: /* function_statement: RETURN expression SEMICOLON  */
+#line 428 "grammar/axparser.y"
+                                      { (yyval.statement) = new Return((yyvsp[-1].expression)); }
+#line 2538 "grammar/axparser.cc"
     break;
 
-  case 48:
-#line 313 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::MINUS, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
-#line 2026 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 53: /* function_conditional_statement: IF expression_expand function_block  */
+#line 433 "grammar/axparser.y"
+                                                                 { (yyval.statement) = new ConditionalStatement((yyvsp[-1].expression), (yyvsp[0].block), new Block()); }
+#line 2544 "grammar/axparser.cc"
     break;
 
-  case 49:
-#line 314 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::MULTIPLY, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
-#line 2032 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 54: /* function_conditional_statement: IF expression_expand function_block ELSE function_block  */
+#line 434 "grammar/axparser.y"
+                                                                 { (yyval.statement) = new ConditionalStatement((yyvsp[-3].expression), (yyvsp[-2].block), (yyvsp[0].block)); }
+#line 2550 "grammar/axparser.cc"
     break;
 
-  case 50:
-#line 315 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::DIVIDE, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
-#line 2038 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 55: /* function_loop_statement: FOR LPARENS loop_initial SEMICOLON loop_condition SEMICOLON loop_iteration RPARENS function_block  */
+#line 439 "grammar/axparser.y"
+                                                                                                         { (yyval.loop) = new Loop(Loop::For, (yyvsp[-6].statement), (yyvsp[-4].expression), (yyvsp[-2].expression), (yyvsp[0].block)); }
+#line 2556 "grammar/axparser.cc"
     break;
 
-  case 51:
-#line 326 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(nullptr, (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2044 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 56: /* function_loop_statement: WHILE expression_expand function_block  */
+#line 440 "grammar/axparser.y"
+                                                           { (yyval.loop) = new Loop(Loop::While, nullptr, (yyvsp[-1].expression), nullptr, (yyvsp[0].block)); }
+#line 2562 "grammar/axparser.cc"
     break;
 
-  case 52:
-#line 327 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::PLUS), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2050 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 57: /* function_loop_statement: DO function_block WHILE expression_expand SEMICOLON  */
+#line 441 "grammar/axparser.y"
+                                                           { (yyval.loop) = new Loop(Loop::DoWhile, nullptr, (yyvsp[-1].expression), nullptr, (yyvsp[-3].block)); }
+#line 2568 "grammar/axparser.cc"
     break;
 
-  case 53:
-#line 328 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::MINUS), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2056 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 58: /* expression: expression_expand  */
+#line 447 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2574 "grammar/axparser.cc"
     break;
 
-  case 54:
-#line 329 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::MULTIPLY), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2062 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 59: /* expression: function_call_expression  */
+#line 448 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2580 "grammar/axparser.cc"
     break;
 
-  case 55:
-#line 330 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::DIVIDE), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2068 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 60: /* expression: binary_expression  */
+#line 449 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2586 "grammar/axparser.cc"
     break;
 
-  case 56:
-#line 331 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(nullptr, (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2074 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 61: /* expression: unary_expression  */
+#line 450 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2592 "grammar/axparser.cc"
     break;
 
-  case 57:
-#line 332 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::PLUS), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2080 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 62: /* expression: assign_expression  */
+#line 451 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2598 "grammar/axparser.cc"
     break;
 
-  case 58:
-#line 333 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::MINUS), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2086 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 63: /* expression: assign_component_expression  */
+#line 452 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2604 "grammar/axparser.cc"
     break;
 
-  case 59:
-#line 334 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::MULTIPLY), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2092 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 64: /* expression: crement  */
+#line 453 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2610 "grammar/axparser.cc"
     break;
 
-  case 60:
-#line 335 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::DIVIDE), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2098 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 65: /* expression: cast_expression  */
+#line 454 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2616 "grammar/axparser.cc"
     break;
 
-  case 61:
-#line 344 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[0].attribute), new AttributeValue((yyvsp[0].attribute)->copy()), Crement::Increment, /*post*/false); }
-#line 2104 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 66: /* expression: vector_literal  */
+#line 455 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].value); }
+#line 2622 "grammar/axparser.cc"
     break;
 
-  case 62:
-#line 345 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[0].attribute), new AttributeValue((yyvsp[0].attribute)->copy()), Crement::Decrement, /*post*/false); }
-#line 2110 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 67: /* expression: matrix_literal  */
+#line 456 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].value); }
+#line 2628 "grammar/axparser.cc"
     break;
 
-  case 63:
-#line 346 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[-1].attribute), new AttributeValue((yyvsp[-1].attribute)->copy()), Crement::Increment, /*post*/true); }
-#line 2116 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 68: /* expression: vector_element  */
+#line 457 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].vector_unpack); }
+#line 2634 "grammar/axparser.cc"
     break;
 
-  case 64:
-#line 347 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[-1].attribute), new AttributeValue((yyvsp[-1].attribute)->copy()), Crement::Decrement, /*post*/true); }
-#line 2122 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 69: /* expression: literal  */
+#line 458 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].value); }
+#line 2640 "grammar/axparser.cc"
     break;
 
-  case 65:
-#line 348 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[0].local), new LocalValue((yyvsp[0].local)->copy()), Crement::Increment, /*post*/false); }
-#line 2128 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 70: /* expression: external  */
+#line 459 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].external); }
+#line 2646 "grammar/axparser.cc"
     break;
 
-  case 66:
-#line 349 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[0].local), new LocalValue((yyvsp[0].local)->copy()), Crement::Decrement, /*post*/false); }
-#line 2134 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 71: /* expression: local  */
+#line 460 "grammar/axparser.y"
+                                   { (yyval.expression) = new LocalValue((yyvsp[0].local)); }
+#line 2652 "grammar/axparser.cc"
     break;
 
-  case 67:
-#line 350 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[-1].local), new LocalValue((yyvsp[-1].local)->copy()), Crement::Increment, /*post*/true); }
-#line 2140 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 72: /* expression: attribute  */
+#line 461 "grammar/axparser.y"
+                                   { (yyval.expression) = new AttributeValue((yyvsp[0].attribute)); }
+#line 2658 "grammar/axparser.cc"
     break;
 
-  case 68:
-#line 351 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[-1].local), new LocalValue((yyvsp[-1].local)->copy()), Crement::Decrement, /*post*/true); }
-#line 2146 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 73: /* vector_element: attribute component  */
+#line 468 "grammar/axparser.y"
+                         { (yyval.vector_unpack) = new VectorUnpack(new AttributeValue((yyvsp[-1].attribute)), (yyvsp[0].index)); }
+#line 2664 "grammar/axparser.cc"
     break;
 
-  case 69:
-#line 356 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new UnaryOperator(tokens::PLUS, (yyvsp[0].expression)); }
-#line 2152 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 74: /* vector_element: local component  */
+#line 469 "grammar/axparser.y"
+                         { (yyval.vector_unpack) = new VectorUnpack(new LocalValue((yyvsp[-1].local)), (yyvsp[0].index)); }
+#line 2670 "grammar/axparser.cc"
     break;
 
-  case 70:
-#line 357 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new UnaryOperator(tokens::MINUS, (yyvsp[0].expression)); }
-#line 2158 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 75: /* vector_element: external component  */
+#line 470 "grammar/axparser.y"
+                         { (yyval.vector_unpack) = new VectorUnpack((yyvsp[-1].external), (yyvsp[0].index)); }
+#line 2676 "grammar/axparser.cc"
     break;
 
-  case 71:
-#line 358 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new UnaryOperator(tokens::BITNOT, (yyvsp[0].expression)); }
-#line 2164 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 76: /* expression_expand: LPARENS expression RPARENS  */
+#line 475 "grammar/axparser.y"
+                                { (yyval.expression) = (yyvsp[-1].expression); }
+#line 2682 "grammar/axparser.cc"
     break;
 
-  case 72:
-#line 359 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new UnaryOperator(tokens::NOT, (yyvsp[0].expression)); }
-#line 2170 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 77: /* cast_expression: scalar_type expression_expand  */
+#line 482 "grammar/axparser.y"
+                                   { (yyval.expression) = new Cast((yyvsp[0].expression), (yyvsp[-1].value_string)); }
+#line 2688 "grammar/axparser.cc"
     break;
 
-  case 73:
-#line 365 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::PLUS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2176 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 78: /* function_call_expression: IDENTIFIER LPARENS arguments RPARENS  */
+#line 487 "grammar/axparser.y"
+                                            { (yyval.expression) = new FunctionCall((yyvsp[-3].value_string), (yyvsp[-1].expressionlist)); free((char*)(yyvsp[-3].value_string)); }
+#line 2694 "grammar/axparser.cc"
     break;
 
-  case 74:
-#line 366 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MINUS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2182 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 79: /* function_call_expression: IDENTIFIER LPARENS RPARENS  */
+#line 488 "grammar/axparser.y"
+                                            { (yyval.expression) = new FunctionCall((yyvsp[-2].value_string)); free((char*)(yyvsp[-2].value_string)); }
+#line 2700 "grammar/axparser.cc"
     break;
 
-  case 75:
-#line 367 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MULTIPLY, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2188 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 80: /* arguments: expression  */
+#line 493 "grammar/axparser.y"
+                                  { (yyval.expressionlist) = new ExpressionList(); (yyval.expressionlist)->mList.emplace_back((yyvsp[0].expression)); }
+#line 2706 "grammar/axparser.cc"
     break;
 
-  case 76:
-#line 368 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::DIVIDE, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2194 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 81: /* arguments: arguments COMMA expression  */
+#line 494 "grammar/axparser.y"
+                                  { (yyvsp[-2].expressionlist)->mList.emplace_back((yyvsp[0].expression)); (yyval.expressionlist) = (yyvsp[-2].expressionlist); }
+#line 2712 "grammar/axparser.cc"
     break;
 
-  case 77:
-#line 369 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MODULO, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2200 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 82: /* declare_assignment: declare_local EQUALS expression  */
+#line 501 "grammar/axparser.y"
+                                       { (yyval.statement) = new AssignExpression((yyvsp[-2].declare_local), (yyvsp[0].expression)); }
+#line 2718 "grammar/axparser.cc"
     break;
 
-  case 78:
-#line 370 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::BITAND, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2206 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 83: /* declare_assignment: declare_local  */
+#line 502 "grammar/axparser.y"
+                                       { (yyval.statement) = (yyvsp[0].declare_local); }
+#line 2724 "grammar/axparser.cc"
     break;
 
-  case 79:
-#line 371 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::BITOR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2212 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 84: /* assign_expression: attribute EQUALS expression  */
+#line 511 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), (yyvsp[0].expression)); }
+#line 2730 "grammar/axparser.cc"
     break;
 
-  case 80:
-#line 372 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::BITXOR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2218 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 85: /* assign_expression: attribute PLUSEQUALS expression  */
+#line 512 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::PLUS, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
+#line 2736 "grammar/axparser.cc"
     break;
 
-  case 81:
-#line 373 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::AND, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2224 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 86: /* assign_expression: attribute MINUSEQUALS expression  */
+#line 513 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::MINUS, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
+#line 2742 "grammar/axparser.cc"
     break;
 
-  case 82:
-#line 374 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::OR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2230 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 87: /* assign_expression: attribute MULTIPLYEQUALS expression  */
+#line 514 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::MULTIPLY, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
+#line 2748 "grammar/axparser.cc"
     break;
 
-  case 83:
-#line 375 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::EQUALSEQUALS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2236 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 88: /* assign_expression: attribute DIVIDEEQUALS expression  */
+#line 515 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::DIVIDE, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
+#line 2754 "grammar/axparser.cc"
     break;
 
-  case 84:
-#line 376 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::NOTEQUALS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2242 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 89: /* assign_expression: local EQUALS expression  */
+#line 516 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), (yyvsp[0].expression)); }
+#line 2760 "grammar/axparser.cc"
     break;
 
-  case 85:
-#line 377 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MORETHAN, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2248 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 90: /* assign_expression: local PLUSEQUALS expression  */
+#line 517 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::PLUS, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
+#line 2766 "grammar/axparser.cc"
     break;
 
-  case 86:
-#line 378 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::LESSTHAN, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2254 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 91: /* assign_expression: local MINUSEQUALS expression  */
+#line 518 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::MINUS, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
+#line 2772 "grammar/axparser.cc"
     break;
 
-  case 87:
-#line 379 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MORETHANOREQUAL, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2260 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 92: /* assign_expression: local MULTIPLYEQUALS expression  */
+#line 519 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::MULTIPLY, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
+#line 2778 "grammar/axparser.cc"
     break;
 
-  case 88:
-#line 380 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::LESSTHANOREQUAL, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2266 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 93: /* assign_expression: local DIVIDEEQUALS expression  */
+#line 520 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::DIVIDE, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
+#line 2784 "grammar/axparser.cc"
     break;
 
-  case 89:
-#line 385 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new VectorPack((yyvsp[-5].expression), (yyvsp[-3].expression), (yyvsp[-1].expression)); }
-#line 2272 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 94: /* assign_component_expression: attribute component EQUALS expression  */
+#line 531 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(nullptr, (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2790 "grammar/axparser.cc"
     break;
 
-  case 90:
-#line 390 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2278 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 95: /* assign_component_expression: attribute component PLUSEQUALS expression  */
+#line 532 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::PLUS), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2796 "grammar/axparser.cc"
     break;
 
-  case 91:
-#line 391 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2284 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 96: /* assign_component_expression: attribute component MINUSEQUALS expression  */
+#line 533 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::MINUS), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2802 "grammar/axparser.cc"
     break;
 
-  case 92:
-#line 392 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<int32_t>()); free((char*)(yyvsp[0].value_string)); }
-#line 2290 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 97: /* assign_component_expression: attribute component MULTIPLYEQUALS expression  */
+#line 534 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::MULTIPLY), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2808 "grammar/axparser.cc"
     break;
 
-  case 93:
-#line 393 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<float>()); free((char*)(yyvsp[0].value_string)); }
-#line 2296 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 98: /* assign_component_expression: attribute component DIVIDEEQUALS expression  */
+#line 535 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::DIVIDE), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2814 "grammar/axparser.cc"
     break;
 
-  case 94:
-#line 394 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<openvdb::Vec3s>()); free((char*)(yyvsp[0].value_string)); }
-#line 2302 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 99: /* assign_component_expression: local component EQUALS expression  */
+#line 536 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(nullptr, (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2820 "grammar/axparser.cc"
     break;
 
-  case 95:
-#line 395 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
-#line 2308 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 100: /* assign_component_expression: local component PLUSEQUALS expression  */
+#line 537 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::PLUS), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2826 "grammar/axparser.cc"
     break;
 
-  case 96:
-#line 396 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
-#line 2314 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 101: /* assign_component_expression: local component MINUSEQUALS expression  */
+#line 538 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::MINUS), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2832 "grammar/axparser.cc"
     break;
 
-  case 97:
-#line 397 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<float>(), true); free((char*)(yyvsp[0].value_string)); }
-#line 2320 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 102: /* assign_component_expression: local component MULTIPLYEQUALS expression  */
+#line 539 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::MULTIPLY), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2838 "grammar/axparser.cc"
     break;
 
-  case 98:
-#line 402 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2326 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 103: /* assign_component_expression: local component DIVIDEEQUALS expression  */
+#line 540 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::DIVIDE), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2844 "grammar/axparser.cc"
     break;
 
-  case 99:
-#line 403 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2332 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 104: /* crement: PLUSPLUS attribute  */
+#line 549 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[0].attribute), new AttributeValue((yyvsp[0].attribute)->copy()), Crement::Increment, /*post*/false); }
+#line 2850 "grammar/axparser.cc"
     break;
 
-  case 100:
-#line 404 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<int32_t>()); free((char*)(yyvsp[0].value_string)); }
-#line 2338 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 105: /* crement: MINUSMINUS attribute  */
+#line 550 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[0].attribute), new AttributeValue((yyvsp[0].attribute)->copy()), Crement::Decrement, /*post*/false); }
+#line 2856 "grammar/axparser.cc"
     break;
 
-  case 101:
-#line 405 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<float>()); free((char*)(yyvsp[0].value_string)); }
-#line 2344 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 106: /* crement: attribute PLUSPLUS  */
+#line 551 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[-1].attribute), new AttributeValue((yyvsp[-1].attribute)->copy()), Crement::Increment, /*post*/true); }
+#line 2862 "grammar/axparser.cc"
     break;
 
-  case 102:
-#line 406 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<openvdb::Vec3s>()); free((char*)(yyvsp[0].value_string)); }
-#line 2350 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 107: /* crement: attribute MINUSMINUS  */
+#line 552 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[-1].attribute), new AttributeValue((yyvsp[-1].attribute)->copy()), Crement::Decrement, /*post*/true); }
+#line 2868 "grammar/axparser.cc"
     break;
 
-  case 103:
-#line 407 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
-#line 2356 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 108: /* crement: PLUSPLUS local  */
+#line 553 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[0].local), new LocalValue((yyvsp[0].local)->copy()), Crement::Increment, /*post*/false); }
+#line 2874 "grammar/axparser.cc"
     break;
 
-  case 104:
-#line 408 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
-#line 2362 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 109: /* crement: MINUSMINUS local  */
+#line 554 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[0].local), new LocalValue((yyvsp[0].local)->copy()), Crement::Decrement, /*post*/false); }
+#line 2880 "grammar/axparser.cc"
     break;
 
-  case 105:
-#line 409 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<float>()); free((char*)(yyvsp[0].value_string)); }
-#line 2368 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 110: /* crement: local PLUSPLUS  */
+#line 555 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[-1].local), new LocalValue((yyvsp[-1].local)->copy()), Crement::Increment, /*post*/true); }
+#line 2886 "grammar/axparser.cc"
     break;
 
-  case 106:
-#line 414 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), (yyvsp[-1].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2374 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 111: /* crement: local MINUSMINUS  */
+#line 556 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[-1].local), new LocalValue((yyvsp[-1].local)->copy()), Crement::Decrement, /*post*/true); }
+#line 2892 "grammar/axparser.cc"
     break;
 
-  case 107:
-#line 415 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), (yyvsp[-1].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2380 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 112: /* unary_expression: PLUS expression  */
+#line 561 "grammar/axparser.y"
+                         { (yyval.expression) = new UnaryOperator(tokens::PLUS, (yyvsp[0].expression)); }
+#line 2898 "grammar/axparser.cc"
     break;
 
-  case 108:
-#line 416 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
-#line 2386 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 113: /* unary_expression: MINUS expression  */
+#line 562 "grammar/axparser.y"
+                         { (yyval.expression) = new UnaryOperator(tokens::MINUS, (yyvsp[0].expression)); }
+#line 2904 "grammar/axparser.cc"
     break;
 
-  case 109:
-#line 423 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.local) = new Local((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2392 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 114: /* unary_expression: BITNOT expression  */
+#line 563 "grammar/axparser.y"
+                         { (yyval.expression) = new UnaryOperator(tokens::BITNOT, (yyvsp[0].expression)); }
+#line 2910 "grammar/axparser.cc"
     break;
 
-  case 110:
-#line 430 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<int16_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2398 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 115: /* unary_expression: NOT expression  */
+#line 564 "grammar/axparser.y"
+                         { (yyval.expression) = new UnaryOperator(tokens::NOT, (yyvsp[0].expression)); }
+#line 2916 "grammar/axparser.cc"
     break;
 
-  case 111:
-#line 431 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<int32_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2404 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 116: /* binary_expression: expression PLUS expression  */
+#line 570 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::PLUS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2922 "grammar/axparser.cc"
     break;
 
-  case 112:
-#line 432 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<int64_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2410 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 117: /* binary_expression: expression MINUS expression  */
+#line 571 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MINUS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2928 "grammar/axparser.cc"
     break;
 
-  case 113:
-#line 433 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<float>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2416 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 118: /* binary_expression: expression MULTIPLY expression  */
+#line 572 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MULTIPLY, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2934 "grammar/axparser.cc"
     break;
 
-  case 114:
-#line 434 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<double>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2422 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 119: /* binary_expression: expression DIVIDE expression  */
+#line 573 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::DIVIDE, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2940 "grammar/axparser.cc"
     break;
 
-  case 115:
-#line 435 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<std::string>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2428 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 120: /* binary_expression: expression MODULO expression  */
+#line 574 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MODULO, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2946 "grammar/axparser.cc"
     break;
 
-  case 116:
-#line 436 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<bool>(true); }
-#line 2434 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 121: /* binary_expression: expression BITAND expression  */
+#line 575 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::BITAND, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2952 "grammar/axparser.cc"
     break;
 
-  case 117:
-#line 437 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<bool>(false); }
-#line 2440 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 122: /* binary_expression: expression BITOR expression  */
+#line 576 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::BITOR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2958 "grammar/axparser.cc"
     break;
 
-  case 118:
-#line 442 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.index) = 0; }
-#line 2446 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 123: /* binary_expression: expression BITXOR expression  */
+#line 577 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::BITXOR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2964 "grammar/axparser.cc"
     break;
 
-  case 119:
-#line 443 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.index) = 1; }
-#line 2452 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 124: /* binary_expression: expression AND expression  */
+#line 578 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::AND, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2970 "grammar/axparser.cc"
     break;
 
-  case 120:
-#line 444 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.index) = 2; }
-#line 2458 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 125: /* binary_expression: expression OR expression  */
+#line 579 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::OR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2976 "grammar/axparser.cc"
     break;
 
-  case 121:
-#line 450 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<bool>(); }
-#line 2464 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 126: /* binary_expression: expression EQUALSEQUALS expression  */
+#line 580 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::EQUALSEQUALS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2982 "grammar/axparser.cc"
     break;
 
-  case 122:
-#line 451 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<int16_t>(); }
-#line 2470 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 127: /* binary_expression: expression NOTEQUALS expression  */
+#line 581 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::NOTEQUALS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2988 "grammar/axparser.cc"
     break;
 
-  case 123:
-#line 452 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<int32_t>(); }
-#line 2476 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 128: /* binary_expression: expression MORETHAN expression  */
+#line 582 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MORETHAN, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2994 "grammar/axparser.cc"
     break;
 
-  case 124:
-#line 453 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<int64_t>(); }
-#line 2482 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 129: /* binary_expression: expression LESSTHAN expression  */
+#line 583 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::LESSTHAN, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 3000 "grammar/axparser.cc"
     break;
 
-  case 125:
-#line 454 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<float>(); }
-#line 2488 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 130: /* binary_expression: expression MORETHANOREQUAL expression  */
+#line 584 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MORETHANOREQUAL, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 3006 "grammar/axparser.cc"
     break;
 
-  case 126:
-#line 455 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<double>(); }
-#line 2494 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 131: /* binary_expression: expression LESSTHANOREQUAL expression  */
+#line 585 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::LESSTHANOREQUAL, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 3012 "grammar/axparser.cc"
     break;
 
-  case 127:
-#line 461 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3i>(); }
-#line 2500 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 132: /* vector_literal: LCURLY expression COMMA expression COMMA expression RCURLY  */
+#line 590 "grammar/axparser.y"
+                                                               { (yyval.value) = new VectorPack((yyvsp[-5].expression), (yyvsp[-3].expression), (yyvsp[-1].expression)); }
+#line 3018 "grammar/axparser.cc"
     break;
 
-  case 128:
-#line 462 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3s>(); }
-#line 2506 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 133: /* matrix_literal: LCURLY expression COMMA expression COMMA expression COMMA arguments RCURLY  */
+#line 596 "grammar/axparser.y"
+        {
+            (yyval.value) = buildMatrixLiteral((yyvsp[-7].expression), (yyvsp[-5].expression), (yyvsp[-3].expression), (yyvsp[-1].expressionlist));
+            if (!(yyval.value)) {
+                yyerror(tree, "syntax error, matrix literals must have 9 or 16 elements");
+                YYERROR;
+            }
+        }
+#line 3030 "grammar/axparser.cc"
     break;
 
-  case 129:
-#line 463 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3d>(); }
-#line 2512 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 134: /* attribute: scalar_type AT IDENTIFIER  */
+#line 607 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3036 "grammar/axparser.cc"
     break;
 
+  case 135: /* attribute: vector_type AT IDENTIFIER  */
+#line 608 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3042 "grammar/axparser.cc"
+    break;
+
+  case 136: /* attribute: matrix_type AT IDENTIFIER  */
+#line 609 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3048 "grammar/axparser.cc"
+    break;
+
+  case 137: /* attribute: I_AT IDENTIFIER  */
+#line 610 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<int32_t>()); free((char*)(yyvsp[0].value_string)); }
+#line 3054 "grammar/axparser.cc"
+    break;
+
+  case 138: /* attribute: F_AT IDENTIFIER  */
+#line 611 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<float>()); free((char*)(yyvsp[0].value_string)); }
+#line 3060 "grammar/axparser.cc"
+    break;
+
+  case 139: /* attribute: V_AT IDENTIFIER  */
+#line 612 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<openvdb::Vec3s>()); free((char*)(yyvsp[0].value_string)); }
+#line 3066 "grammar/axparser.cc"
+    break;
+
+  case 140: /* attribute: S_AT IDENTIFIER  */
+#line 613 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
+#line 3072 "grammar/axparser.cc"
+    break;
+
+  case 141: /* attribute: STRING AT IDENTIFIER  */
+#line 614 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
+#line 3078 "grammar/axparser.cc"
+    break;
+
+  case 142: /* attribute: AT IDENTIFIER  */
+#line 615 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<float>(), true); free((char*)(yyvsp[0].value_string)); }
+#line 3084 "grammar/axparser.cc"
+    break;
+
+  case 143: /* external: scalar_type DOLLAR IDENTIFIER  */
+#line 620 "grammar/axparser.y"
+                                     { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3090 "grammar/axparser.cc"
+    break;
+
+  case 144: /* external: vector_type DOLLAR IDENTIFIER  */
+#line 621 "grammar/axparser.y"
+                                     { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3096 "grammar/axparser.cc"
+    break;
+
+  case 145: /* external: matrix_type DOLLAR IDENTIFIER  */
+#line 622 "grammar/axparser.y"
+                                     { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3102 "grammar/axparser.cc"
+    break;
+
+  case 146: /* external: I_DOLLAR IDENTIFIER  */
+#line 623 "grammar/axparser.y"
+                                     { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<int32_t>()); free((char*)(yyvsp[0].value_string)); }
+#line 3108 "grammar/axparser.cc"
+    break;
+
+  case 147: /* external: F_DOLLAR IDENTIFIER  */
+#line 624 "grammar/axparser.y"
+                                     { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<float>()); free((char*)(yyvsp[0].value_string)); }
+#line 3114 "grammar/axparser.cc"
+    break;
+
+  case 148: /* external: V_DOLLAR IDENTIFIER  */
+#line 625 "grammar/axparser.y"
+                                     { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<openvdb::Vec3s>()); free((char*)(yyvsp[0].value_string)); }
+#line 3120 "grammar/axparser.cc"
+    break;
+
+  case 149: /* external: S_DOLLAR IDENTIFIER  */
+#line 626 "grammar/axparser.y"
+                                     { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
+#line 3126 "grammar/axparser.cc"
+    break;
+
+  case 150: /* external: STRING DOLLAR IDENTIFIER  */
+#line 627 "grammar/axparser.y"
+                                     { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
+#line 3132 "grammar/axparser.cc"
+    break;
+
+  case 151: /* external: DOLLAR IDENTIFIER  */
+#line 628 "grammar/axparser.y"
+                                     { (yyval.external) = new ExternalVariable((yyvsp[0].value_string), openvdb::typeNameAsString<float>()); free((char*)(yyvsp[0].value_string)); }
+#line 3138 "grammar/axparser.cc"
+    break;
+
+  case 152: /* declare_local: scalar_type IDENTIFIER  */
+#line 633 "grammar/axparser.y"
+                              { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), (yyvsp[-1].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3144 "grammar/axparser.cc"
+    break;
+
+  case 153: /* declare_local: vector_type IDENTIFIER  */
+#line 634 "grammar/axparser.y"
+                              { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), (yyvsp[-1].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3150 "grammar/axparser.cc"
+    break;
+
+  case 154: /* declare_local: matrix_type IDENTIFIER  */
+#line 635 "grammar/axparser.y"
+                              { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), (yyvsp[-1].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3156 "grammar/axparser.cc"
+    break;
+
+  case 155: /* declare_local: STRING IDENTIFIER  */
+#line 636 "grammar/axparser.y"
+                              { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
+#line 3162 "grammar/axparser.cc"
+    break;
+
+  case 156: /* local: IDENTIFIER  */
+#line 643 "grammar/axparser.y"
+                { (yyval.local) = new Local((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3168 "grammar/axparser.cc"
+    break;
+
+  case 157: /* literal: L_SHORT  */
+#line 650 "grammar/axparser.y"
+                { (yyval.value) = new Value<int16_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3174 "grammar/axparser.cc"
+    break;
+
+  case 158: /* literal: L_INT  */
+#line 651 "grammar/axparser.y"
+                { (yyval.value) = new Value<int32_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3180 "grammar/axparser.cc"
+    break;
+
+  case 159: /* literal: L_LONG  */
+#line 652 "grammar/axparser.y"
+                { (yyval.value) = new Value<int64_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3186 "grammar/axparser.cc"
+    break;
+
+  case 160: /* literal: L_FLOAT  */
+#line 653 "grammar/axparser.y"
+                { (yyval.value) = new Value<float>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3192 "grammar/axparser.cc"
+    break;
+
+  case 161: /* literal: L_DOUBLE  */
+#line 654 "grammar/axparser.y"
+                { (yyval.value) = new Value<double>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3198 "grammar/axparser.cc"
+    break;
+
+  case 162: /* literal: L_STRING  */
+#line 655 "grammar/axparser.y"
+                { (yyval.value) = new Value<std::string>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 3204 "grammar/axparser.cc"
+    break;
+
+  case 163: /* literal: TRUE  */
+#line 656 "grammar/axparser.y"
+                { (yyval.value) = new Value<bool>(true); }
+#line 3210 "grammar/axparser.cc"
+    break;
+
+  case 164: /* literal: FALSE  */
+#line 657 "grammar/axparser.y"
+                { (yyval.value) = new Value<bool>(false); }
+#line 3216 "grammar/axparser.cc"
+    break;
+
+  case 165: /* component: DOT_X  */
+#line 662 "grammar/axparser.y"
+             { (yyval.index) = 0; }
+#line 3222 "grammar/axparser.cc"
+    break;
+
+  case 166: /* component: DOT_Y  */
+#line 663 "grammar/axparser.y"
+             { (yyval.index) = 1; }
+#line 3228 "grammar/axparser.cc"
+    break;
+
+  case 167: /* component: DOT_Z  */
+#line 664 "grammar/axparser.y"
+             { (yyval.index) = 2; }
+#line 3234 "grammar/axparser.cc"
+    break;
+
+  case 168: /* scalar_type: BOOL  */
+#line 670 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<bool>(); }
+#line 3240 "grammar/axparser.cc"
+    break;
+
+  case 169: /* scalar_type: SHORT  */
+#line 671 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<int16_t>(); }
+#line 3246 "grammar/axparser.cc"
+    break;
+
+  case 170: /* scalar_type: INT  */
+#line 672 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<int32_t>(); }
+#line 3252 "grammar/axparser.cc"
+    break;
+
+  case 171: /* scalar_type: LONG  */
+#line 673 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<int64_t>(); }
+#line 3258 "grammar/axparser.cc"
+    break;
+
+  case 172: /* scalar_type: FLOAT  */
+#line 674 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<float>(); }
+#line 3264 "grammar/axparser.cc"
+    break;
+
+  case 173: /* scalar_type: DOUBLE  */
+#line 675 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<double>(); }
+#line 3270 "grammar/axparser.cc"
+    break;
+
+  case 174: /* vector_type: VEC3I  */
+#line 681 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3i>(); }
+#line 3276 "grammar/axparser.cc"
+    break;
+
+  case 175: /* vector_type: VEC3F  */
+#line 682 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3s>(); }
+#line 3282 "grammar/axparser.cc"
+    break;
+
+  case 176: /* vector_type: VEC3D  */
+#line 683 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3d>(); }
+#line 3288 "grammar/axparser.cc"
+    break;
+
+  case 177: /* matrix_type: MAT3F  */
+#line 689 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Mat3s>(); }
+#line 3294 "grammar/axparser.cc"
+    break;
+
+  case 178: /* matrix_type: MAT3D  */
+#line 690 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Mat3d>(); }
+#line 3300 "grammar/axparser.cc"
+    break;
+
+  case 179: /* matrix_type: MAT4F  */
+#line 691 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Mat4s>(); }
+#line 3306 "grammar/axparser.cc"
+    break;
+
+  case 180: /* matrix_type: MAT4D  */
+#line 692 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Mat4d>(); }
+#line 3312 "grammar/axparser.cc"
+    break;
+
+
+#line 3316 "grammar/axparser.cc"
 
-#line 2516 "grammar/axparser.cc" /* yacc.c:1648  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2526,11 +3327,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2538,14 +3338,13 @@ yyreduce:
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -2556,50 +3355,45 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (tree, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (tree, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2628,12 +3422,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2650,13 +3443,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2670,7 +3464,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp, tree);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, tree);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2681,13 +3475,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2698,26 +3490,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (tree, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2733,22 +3529,21 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, yylsp, tree);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, tree);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 465 "grammar/axparser.y" /* yacc.c:1907  */
+
+#line 694 "grammar/axparser.y"
 
 
-// Copyright (c) 2015-2018 DNEG Visual Effects
+// Copyright (c) 2015-2019 DNEG
 // All rights reserved. This software is distributed under the
 // Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
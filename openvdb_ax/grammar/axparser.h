@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.5.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_GRAMMAR_AXPARSER_H_INCLUDED
 # define YY_YY_GRAMMAR_AXPARSER_H_INCLUDED
 /* Debug traces.  */
@@ -40,90 +45,103 @@
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    TRUE = 258,
-    FALSE = 259,
-    SEMICOLON = 260,
-    AT = 261,
-    DOLLAR = 262,
-    IF = 263,
-    ELSE = 264,
-    RETURN = 265,
-    EQUALS = 266,
-    PLUSEQUALS = 267,
-    MINUSEQUALS = 268,
-    MULTIPLYEQUALS = 269,
-    DIVIDEEQUALS = 270,
-    PLUSPLUS = 271,
-    MINUSMINUS = 272,
-    LPARENS = 273,
-    RPARENS = 274,
-    LCURLY = 275,
-    RCURLY = 276,
-    PLUS = 277,
-    MINUS = 278,
-    MULTIPLY = 279,
-    DIVIDE = 280,
-    MODULO = 281,
-    BITAND = 282,
-    BITOR = 283,
-    BITXOR = 284,
-    BITNOT = 285,
-    EQUALSEQUALS = 286,
-    NOTEQUALS = 287,
-    MORETHAN = 288,
-    LESSTHAN = 289,
-    MORETHANOREQUAL = 290,
-    LESSTHANOREQUAL = 291,
-    AND = 292,
-    OR = 293,
-    NOT = 294,
-    STRING = 295,
-    DOUBLE = 296,
-    FLOAT = 297,
-    LONG = 298,
-    INT = 299,
-    SHORT = 300,
-    BOOL = 301,
-    VOID = 302,
-    F_AT = 303,
-    I_AT = 304,
-    V_AT = 305,
-    S_AT = 306,
-    F_DOLLAR = 307,
-    I_DOLLAR = 308,
-    V_DOLLAR = 309,
-    S_DOLLAR = 310,
-    COMMA = 311,
-    VEC3I = 312,
-    VEC3F = 313,
-    VEC3D = 314,
-    DOT_X = 315,
-    DOT_Y = 316,
-    DOT_Z = 317,
-    L_SHORT = 318,
-    L_INT = 319,
-    L_LONG = 320,
-    L_FLOAT = 321,
-    L_DOUBLE = 322,
-    L_STRING = 323,
-    IDENTIFIER = 324,
-    LPAREN = 325,
-    RPAREN = 326,
-    LOWER_THAN_ELSE = 327
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    TRUE = 258,                    /* TRUE  */
+    FALSE = 259,                   /* FALSE  */
+    SEMICOLON = 260,               /* SEMICOLON  */
+    AT = 261,                      /* AT  */
+    DOLLAR = 262,                  /* DOLLAR  */
+    IF = 263,                      /* IF  */
+    ELSE = 264,                    /* ELSE  */
+    RETURN = 265,                  /* RETURN  */
+    FOR = 266,                     /* FOR  */
+    DO = 267,                      /* DO  */
+    WHILE = 268,                   /* WHILE  */
+    BREAK = 269,                   /* BREAK  */
+    CONTINUE = 270,                /* CONTINUE  */
+    EQUALS = 271,                  /* EQUALS  */
+    PLUSEQUALS = 272,              /* PLUSEQUALS  */
+    MINUSEQUALS = 273,             /* MINUSEQUALS  */
+    MULTIPLYEQUALS = 274,          /* MULTIPLYEQUALS  */
+    DIVIDEEQUALS = 275,            /* DIVIDEEQUALS  */
+    PLUSPLUS = 276,                /* PLUSPLUS  */
+    MINUSMINUS = 277,              /* MINUSMINUS  */
+    LPARENS = 278,                 /* LPARENS  */
+    RPARENS = 279,                 /* RPARENS  */
+    LCURLY = 280,                  /* LCURLY  */
+    RCURLY = 281,                  /* RCURLY  */
+    PLUS = 282,                    /* PLUS  */
+    MINUS = 283,                   /* MINUS  */
+    MULTIPLY = 284,                /* MULTIPLY  */
+    DIVIDE = 285,                  /* DIVIDE  */
+    MODULO = 286,                  /* MODULO  */
+    BITAND = 287,                  /* BITAND  */
+    BITOR = 288,                   /* BITOR  */
+    BITXOR = 289,                  /* BITXOR  */
+    BITNOT = 290,                  /* BITNOT  */
+    EQUALSEQUALS = 291,            /* EQUALSEQUALS  */
+    NOTEQUALS = 292,               /* NOTEQUALS  */
+    MORETHAN = 293,                /* MORETHAN  */
+    LESSTHAN = 294,                /* LESSTHAN  */
+    MORETHANOREQUAL = 295,         /* MORETHANOREQUAL  */
+    LESSTHANOREQUAL = 296,         /* LESSTHANOREQUAL  */
+    AND = 297,                     /* AND  */
+    OR = 298,                      /* OR  */
+    NOT = 299,                     /* NOT  */
+    STRING = 300,                  /* STRING  */
+    DOUBLE = 301,                  /* DOUBLE  */
+    FLOAT = 302,                   /* FLOAT  */
+    LONG = 303,                    /* LONG  */
+    INT = 304,                     /* INT  */
+    SHORT = 305,                   /* SHORT  */
+    BOOL = 306,                    /* BOOL  */
+    VOID = 307,                    /* VOID  */
+    F_AT = 308,                    /* F_AT  */
+    I_AT = 309,                    /* I_AT  */
+    V_AT = 310,                    /* V_AT  */
+    S_AT = 311,                    /* S_AT  */
+    F_DOLLAR = 312,                /* F_DOLLAR  */
+    I_DOLLAR = 313,                /* I_DOLLAR  */
+    V_DOLLAR = 314,                /* V_DOLLAR  */
+    S_DOLLAR = 315,                /* S_DOLLAR  */
+    COMMA = 316,                   /* COMMA  */
+    VEC3I = 317,                   /* VEC3I  */
+    VEC3F = 318,                   /* VEC3F  */
+    VEC3D = 319,                   /* VEC3D  */
+    MAT3F = 320,                   /* MAT3F  */
+    MAT3D = 321,                   /* MAT3D  */
+    MAT4F = 322,                   /* MAT4F  */
+    MAT4D = 323,                   /* MAT4D  */
+    DOT_X = 324,                   /* DOT_X  */
+    DOT_Y = 325,                   /* DOT_Y  */
+    DOT_Z = 326,                   /* DOT_Z  */
+    L_SHORT = 327,                 /* L_SHORT  */
+    L_INT = 328,                   /* L_INT  */
+    L_LONG = 329,                  /* L_LONG  */
+    L_FLOAT = 330,                 /* L_FLOAT  */
+    L_DOUBLE = 331,                /* L_DOUBLE  */
+    L_STRING = 332,                /* L_STRING  */
+    IDENTIFIER = 333,              /* IDENTIFIER  */
+    LPAREN = 334,                  /* LPAREN  */
+    RPAREN = 335,                  /* RPAREN  */
+    LOWER_THAN_ELSE = 336          /* LOWER_THAN_ELSE  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
 union YYSTYPE
 {
-#line 114 "grammar/axparser.y" /* yacc.c:1910  */
+#line 147 "grammar/axparser.y"
 
     const char* value_string;
     uint64_t index;
@@ -141,10 +159,12 @@ union YYSTYPE
     openvdb::ax::ast::AttributeValue* attributevalue;
     openvdb::ax::ast::DeclareLocal* declare_local;
     openvdb::ax::ast::Local* local;
+    openvdb::ax::ast::FunctionDefinition* function_definition;
+    openvdb::ax::ast::Loop* loop;
 
-#line 146 "grammar/axparser.h" /* yacc.c:1910  */
-};
+#line 166 "grammar/axparser.h"
 
+};
 typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
@@ -167,6 +187,8 @@ struct YYLTYPE
 
 extern YYSTYPE yylval;
 extern YYLTYPE yylloc;
+
 int yyparse (openvdb::ax::ast::Tree** tree);
 
+
 #endif /* !YY_YY_GRAMMAR_AXPARSER_H_INCLUDED  */
@@ -105,6 +105,39 @@
             return new Attribute(name, openvdb::typeNameAsString<float>());
         }
     }
+
+    FunctionDefinition* buildFunctionDefinition(const std::string& type,
+                                                const std::string& name,
+                                                ExpressionList* parameters,
+                                                Block* body)
+    {
+        // parameters are parsed as a list of local declarations
+        const ExpressionList::UniquePtr list(parameters);
+        std::vector<DeclareLocal::Ptr> declarations;
+        declarations.reserve(list->mList.size());
+        for (const Expression::Ptr& parameter : list->mList) {
+            declarations.emplace_back(std::static_pointer_cast<DeclareLocal>(parameter));
+        }
+        return new FunctionDefinition(name, type, declarations, body);
+    }
+
+    /// @brief  Build a matrix literal from its first three elements and the list of
+    ///         remaining elements. Returns a nullptr if the total number of elements
+    ///         does not represent a 3x3 or 4x4 matrix.
+    ArrayPack* buildMatrixLiteral(Expression* first,
+                                  Expression* second,
+                                  Expression* third,
+                                  ExpressionList* remaining)
+    {
+        ExpressionList::UniquePtr elements(remaining);
+        elements->mList.emplace(elements->mList.begin(), third);
+        elements->mList.emplace(elements->mList.begin(), second);
+        elements->mList.emplace(elements->mList.begin(), first);
+
+        const size_t size = elements->mList.size();
+        if (size != 9 && size != 16) return nullptr;
+        return new ArrayPack(elements.release());
+    }
 %}
 
 %error-verbose
@@ -128,6 +161,8 @@
     openvdb::ax::ast::AttributeValue* attributevalue;
     openvdb::ax::ast::DeclareLocal* declare_local;
     openvdb::ax::ast::Local* local;
+    openvdb::ax::ast::FunctionDefinition* function_definition;
+    openvdb::ax::ast::Loop* loop;
 }
 
 %start statements
@@ -136,6 +171,7 @@
 %token SEMICOLON AT DOLLAR
 %token IF ELSE
 %token RETURN
+%token FOR DO WHILE BREAK CONTINUE
 %token EQUALS PLUSEQUALS MINUSEQUALS MULTIPLYEQUALS DIVIDEEQUALS PLUSPLUS MINUSMINUS
 %token LPARENS RPARENS LCURLY RCURLY
 %token PLUS MINUS MULTIPLY DIVIDE MODULO
@@ -145,6 +181,7 @@
 %token STRING DOUBLE FLOAT LONG INT SHORT BOOL VOID F_AT I_AT V_AT S_AT F_DOLLAR I_DOLLAR V_DOLLAR S_DOLLAR
 %token COMMA
 %token VEC3I VEC3F VEC3D
+%token MAT3F MAT3D MAT4F MAT4D
 %token DOT_X DOT_Y DOT_Z
 
 %token <value_string> L_SHORT
@@ -158,8 +195,23 @@
 %type <tree> statements
 %type <block> block
 %type <block> body
+%type <block> program
+%type <block> function_scope
+%type <block> function_block
+%type <block> function_body
 %type <statement> statement
+%type <statement> simple_statement
+%type <statement> function_statement
+%type <statement> function_conditional_statement
+%type <function_definition> function_definition
+%type <expressionlist> function_parameters
+%type <expressionlist> parameters
 %type <statement> conditional_statement
+%type <loop> loop_statement
+%type <loop> function_loop_statement
+%type <statement> loop_initial
+%type <expression> loop_condition
+%type <expression> loop_iteration
 %type <statement> declare_assignment
 %type <expression> assign_expression
 %type <expression> assign_component_expression
@@ -179,9 +231,11 @@
 %type <index> component
 
 %type <value> vector_literal
+%type <value> matrix_literal
 %type <value> literal
 %type <value_string> scalar_type
 %type <value_string> vector_type
+%type <value_string> matrix_type
 
 %right EQUALS PLUSEQUALS MINUSEQUALS MULTIPLYEQUALS DIVIDEEQUALS PLUSPLUS MINUSMINUS
 %left AND OR
@@ -200,11 +254,67 @@
 
 %parse-param {openvdb::ax::ast::Tree** tree}
 
+%{
+    #include <cstring>
+    #include <utility>
+
+    /// @brief  Returns the token of a keyword which is not a rule of the lexer, or
+    ///         IDENTIFIER if the text is not one of these keywords
+    int keywordToken(const char* text)
+    {
+        static const std::pair<const char*, int> keywords[] = {
+            { "void", VOID },
+            { "for", FOR },
+            { "do", DO },
+            { "while", WHILE },
+            { "break", BREAK },
+            { "continue", CONTINUE },
+            { "mat3f", MAT3F },
+            { "mat3d", MAT3D },
+            { "mat4f", MAT4F },
+            { "mat4d", MAT4D },
+            { "matrix3", MAT3F }, // VEX support tokens
+            { "matrix", MAT4F }
+        };
+
+        for (const auto& keyword : keywords) {
+            if (std::strcmp(text, keyword.first) == 0) return keyword.second;
+        }
+        return IDENTIFIER;
+    }
+
+    /// @brief  Returns the next token of the lexer. Keywords without lexer rules are
+    ///         scanned as identifiers and are replaced with their tokens here
+    int yylexKeyword(void)
+    {
+        const int token = yylex();
+        if (token != IDENTIFIER) return token;
+
+        const int keyword = keywordToken(yylval.value_string);
+        if (keyword != IDENTIFIER) {
+            free((char*)yylval.value_string);
+            yylval.value_string = nullptr;
+        }
+        return keyword;
+    }
+
+    #define yylex yylexKeyword
+%}
+
 %%
 
 statements:
       { *tree = new Tree(); $$ = *tree; } /* nothing */
-    | body { *tree = new Tree($1); $$ = *tree; }
+    | program { *tree = new Tree($1); $$ = *tree; }
+;
+
+/// @brief  The top level of a program; a list of statements and function
+///         definitions. Functions can only be defined at this level
+program:
+      program statement            { if ($2) $1->mList.emplace_back($2); $$ = $1; }
+    | program function_definition  { $1->mList.emplace_back($2); $$ = $1; }
+    | statement                    { $$ = new Block(); if ($1) $$->mList.emplace_back($1); }
+    | function_definition          { $$ = new Block(); $$->mList.emplace_back($1); }
 ;
 
 block:
@@ -221,22 +331,116 @@ body:
 /// @brief  Syntax for a statement; a line followed by a semicolon or a
 ///         conditional statement
 statement:
+      simple_statement       { $$ = $1; }
+    | conditional_statement  { $$ = $1; }
+    | loop_statement         { $$ = $1; }
+;
+
+/// @brief  Syntax for a single line statement followed by a semicolon
+simple_statement:
       expression SEMICOLON          { $$ = $1; }
     | declare_assignment SEMICOLON  { $$ = $1; }
-    | conditional_statement         { $$ = $1; }
     | RETURN SEMICOLON              { $$ = new Return; }
+    | BREAK SEMICOLON               { $$ = new Break; }
+    | CONTINUE SEMICOLON            { $$ = new Continue; }
     | SEMICOLON                     { $$ = nullptr; } // The only possible nullptr rule
 ;
 
 /// @brief  Syntax for a conditional statement, capable of supporting a single if
 ///         and an optional single else clause
 /// @todo   Support multiple else if statements
-/// @todo   Support break keyword
 conditional_statement:
       IF expression_expand block %prec LOWER_THAN_ELSE  { $$ = new ConditionalStatement($2, $3, new Block()); }
     | IF expression_expand block ELSE block             { $$ = new ConditionalStatement($2, $3, $5); }
 ;
 
+/// @brief  Syntax for for, while and do while loops. Any part of a for loop header
+///         may be omitted, in which case a missing condition is always true.
+loop_statement:
+      FOR LPARENS loop_initial SEMICOLON loop_condition SEMICOLON loop_iteration RPARENS block  { $$ = new Loop(Loop::For, $3, $5, $7, $9); }
+    | WHILE expression_expand block                    { $$ = new Loop(Loop::While, nullptr, $2, nullptr, $3); }
+    | DO block WHILE expression_expand SEMICOLON       { $$ = new Loop(Loop::DoWhile, nullptr, $4, nullptr, $2); }
+;
+
+/// @brief  The optional initial statement of a for loop, which may declare locals
+///         scoped to the loop
+loop_initial:
+      /* nothing */       { $$ = nullptr; }
+    | expression          { $$ = $1; }
+    | declare_assignment  { $$ = $1; }
+;
+
+loop_condition:
+      /* nothing */  { $$ = nullptr; }
+    | expression     { $$ = $1; }
+;
+
+loop_iteration:
+      /* nothing */  { $$ = nullptr; }
+    | expression     { $$ = $1; }
+;
+
+/// @brief  Syntax for a user defined function. The return type may be any
+///         scalar, vector or matrix type or void. Definitions are only valid at the top
+///         level of a program and may not be nested.
+function_definition:
+      scalar_type IDENTIFIER function_parameters function_scope  { $$ = buildFunctionDefinition($1, $2, $3, $4); free((char*)$2); }
+    | vector_type IDENTIFIER function_parameters function_scope  { $$ = buildFunctionDefinition($1, $2, $3, $4); free((char*)$2); }
+    | matrix_type IDENTIFIER function_parameters function_scope  { $$ = buildFunctionDefinition($1, $2, $3, $4); free((char*)$2); }
+    | VOID IDENTIFIER function_parameters function_scope         { $$ = buildFunctionDefinition("void", $2, $3, $4); free((char*)$2); }
+;
+
+/// @brief  The parameter list of a function definition
+function_parameters:
+      LPARENS parameters RPARENS  { $$ = $2; }
+    | LPARENS RPARENS             { $$ = new ExpressionList(); }
+;
+
+/// @brief  A parameter list of at least size 1
+parameters:
+      declare_local                   { $$ = new ExpressionList(); $$->mList.emplace_back($1); }
+    | parameters COMMA declare_local  { $1->mList.emplace_back($3); $$ = $1; }
+;
+
+/// @brief  The scoped body of a function definition
+function_scope:
+      LCURLY function_body RCURLY  { $$ = $2; }
+    | LCURLY RCURLY                { $$ = new Block(); }
+;
+
+function_block:
+      LCURLY function_body RCURLY  { $$ = $2; }
+    | LCURLY RCURLY                { $$ = new Block(); }
+    | function_statement           { $$ = new Block(); if($1) $$->mList.emplace_back($1); }
+;
+
+function_body:
+      function_body function_statement  { if ($2) $1->mList.emplace_back($2); $$ = $1; }
+    | function_statement                { $$ = new Block(); if ($1) $$->mList.emplace_back($1); }
+;
+
+/// @brief  Syntax for a statement within a function body. Unlike top level
+///         statements, these may return a value.
+function_statement:
+      simple_statement                { $$ = $1; }
+    | function_conditional_statement  { $$ = $1; }
+    | function_loop_statement         { $$ = $1; }
+    | RETURN expression SEMICOLON     { $$ = new Return($2); }
+;
+
+/// @brief  Syntax for a conditional statement within a function body
+function_conditional_statement:
+      IF expression_expand function_block %prec LOWER_THAN_ELSE  { $$ = new ConditionalStatement($2, $3, new Block()); }
+    | IF expression_expand function_block ELSE function_block    { $$ = new ConditionalStatement($2, $3, $5); }
+;
+
+/// @brief  Syntax for loops within a function body
+function_loop_statement:
+      FOR LPARENS loop_initial SEMICOLON loop_condition SEMICOLON loop_iteration RPARENS function_block  { $$ = new Loop(Loop::For, $3, $5, $7, $9); }
+    | WHILE expression_expand function_block               { $$ = new Loop(Loop::While, nullptr, $2, nullptr, $3); }
+    | DO function_block WHILE expression_expand SEMICOLON  { $$ = new Loop(Loop::DoWhile, nullptr, $4, nullptr, $2); }
+;
+
 /// @brief  Syntax for a combination of all numerical expressions which can return
 ///         an rvalue.
 expression:
@@ -249,6 +453,7 @@ expression:
     | crement                      { $$ = $1; }
     | cast_expression              { $$ = $1; }
     | vector_literal               { $$ = $1; }
+    | matrix_literal               { $$ = $1; }
     | vector_element               { $$ = $1; }
     | literal                      { $$ = $1; }
     | external                     { $$ = $1; }
@@ -385,10 +590,23 @@ vector_literal:
     LCURLY expression COMMA expression COMMA expression RCURLY { $$ = new VectorPack($2, $4, $6); }
 ;
 
+/// @brief  Syntax for matrix literals, which must have 9 or 16 elements
+matrix_literal:
+    LCURLY expression COMMA expression COMMA expression COMMA arguments RCURLY
+        {
+            $$ = buildMatrixLiteral($2, $4, $6, $8);
+            if (!$$) {
+                yyerror(tree, "syntax error, matrix literals must have 9 or 16 elements");
+                YYERROR;
+            }
+        }
+;
+
 /// @brief  Syntax for supported attribute access
 attribute:
       scalar_type AT IDENTIFIER  { $$ = new Attribute($3, $1); free((char*)$3); }
     | vector_type AT IDENTIFIER  { $$ = new Attribute($3, $1); free((char*)$3); }
+    | matrix_type AT IDENTIFIER  { $$ = new Attribute($3, $1); free((char*)$3); }
     | I_AT  IDENTIFIER           { $$ = new Attribute($2, openvdb::typeNameAsString<int32_t>()); free((char*)$2); }
     | F_AT  IDENTIFIER           { $$ = new Attribute($2, openvdb::typeNameAsString<float>()); free((char*)$2); }
     | V_AT IDENTIFIER            { $$ = new Attribute($2, openvdb::typeNameAsString<openvdb::Vec3s>()); free((char*)$2); }
@@ -401,6 +619,7 @@ attribute:
 external:
       scalar_type DOLLAR IDENTIFIER  { $$ = new ExternalVariable($3, $1); free((char*)$3); }
     | vector_type DOLLAR IDENTIFIER  { $$ = new ExternalVariable($3, $1); free((char*)$3); }
+    | matrix_type DOLLAR IDENTIFIER  { $$ = new ExternalVariable($3, $1); free((char*)$3); }
     | I_DOLLAR  IDENTIFIER           { $$ = new ExternalVariable($2, openvdb::typeNameAsString<int32_t>()); free((char*)$2); }
     | F_DOLLAR  IDENTIFIER           { $$ = new ExternalVariable($2, openvdb::typeNameAsString<float>()); free((char*)$2); }
     | V_DOLLAR IDENTIFIER            { $$ = new ExternalVariable($2, openvdb::typeNameAsString<openvdb::Vec3s>()); free((char*)$2); }
@@ -413,6 +632,7 @@ external:
 declare_local:
       scalar_type IDENTIFIER  { $$ = new DeclareLocal($2, $1); free((char*)$2); }
     | vector_type IDENTIFIER  { $$ = new DeclareLocal($2, $1); free((char*)$2); }
+    | matrix_type IDENTIFIER  { $$ = new DeclareLocal($2, $1); free((char*)$2); }
     | STRING IDENTIFIER       { $$ = new DeclareLocal($2, openvdb::typeNameAsString<std::string>()); free((char*)$2); }
 ;
 
@@ -461,6 +681,15 @@ vector_type:
       VEC3I   { $$ = openvdb::typeNameAsString<openvdb::Vec3i>(); }
     | VEC3F   { $$ = openvdb::typeNameAsString<openvdb::Vec3s>(); }
     | VEC3D   { $$ = openvdb::typeNameAsString<openvdb::Vec3d>(); }
+;
+
+/// @brief  Matrix types consolidated as strings. These should be used to ensure
+///         type matching.
+matrix_type:
+      MAT3F   { $$ = openvdb::typeNameAsString<openvdb::Mat3s>(); }
+    | MAT3D   { $$ = openvdb::typeNameAsString<openvdb::Mat3d>(); }
+    | MAT4F   { $$ = openvdb::typeNameAsString<openvdb::Mat4s>(); }
+    | MAT4D   { $$ = openvdb::typeNameAsString<openvdb::Mat4d>(); }
 
 %%
 
@@ -0,0 +1,780 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "util.h"
+
+#include <openvdb_ax/ast/AST.h>
+#include <openvdb_ax/ast/ConstantFolding.h>
+#include <openvdb_ax/codegen/FunctionBitcode.h>
+#include <openvdb_ax/codegen/FunctionRegistry.h>
+#include <openvdb_ax/codegen/PointComputeGenerator.h>
+#include <openvdb_ax/codegen/VolumeComputeGenerator.h>
+#include <openvdb_ax/compiler/CompilerOptions.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Transforms/InstCombine/InstCombine.h>
+#include <llvm/Transforms/IPO.h>
+#include <llvm/Transforms/Scalar.h>
+
+#include <functional>
+#include <set>
+#include <type_traits>
+
+class TestComputeGenerator : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestComputeGenerator);
+    CPPUNIT_TEST(testEntryBlockAllocas);
+    CPPUNIT_TEST(testNativeVectors);
+    CPPUNIT_TEST(testMathFunctions);
+    CPPUNIT_TEST(testAttributePromotion);
+    CPPUNIT_TEST(testKernelAttributes);
+    CPPUNIT_TEST(testPrecisionPolicy);
+    CPPUNIT_TEST(testFastMathFlags);
+    CPPUNIT_TEST(testFunctionBitcode);
+    CPPUNIT_TEST(testScratchSites);
+    CPPUNIT_TEST(testConstantFolding);
+    CPPUNIT_TEST(testLookupGlobals);
+    CPPUNIT_TEST(testUnreachableBlocks);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testEntryBlockAllocas();
+    void testNativeVectors();
+    void testMathFunctions();
+    void testAttributePromotion();
+    void testKernelAttributes();
+    void testPrecisionPolicy();
+    void testFastMathFlags();
+    void testFunctionBitcode();
+    void testScratchSites();
+    void testConstantFolding();
+    void testLookupGlobals();
+    void testUnreachableBlocks();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestComputeGenerator);
+
+namespace {
+
+inline size_t
+countAllocas(const llvm::Function& function, const bool excludeEntry)
+{
+    size_t count = 0;
+    for (const llvm::BasicBlock& block : function) {
+        if (excludeEntry && &block == &function.getEntryBlock()) continue;
+        for (const llvm::Instruction& inst : block) {
+            if (llvm::isa<llvm::AllocaInst>(inst)) ++count;
+        }
+    }
+    return count;
+}
+
+inline size_t
+countVectorInstructions(const llvm::Function& function)
+{
+    size_t count = 0;
+    for (const llvm::BasicBlock& block : function) {
+        for (const llvm::Instruction& inst : block) {
+            if (inst.getType()->isVectorTy()) ++count;
+        }
+    }
+    return count;
+}
+
+inline size_t
+countCalls(const llvm::Function& function, const std::string& name)
+{
+    size_t count = 0;
+    for (const llvm::BasicBlock& block : function) {
+        for (const llvm::Instruction& inst : block) {
+            const llvm::CallInst* call = llvm::dyn_cast<llvm::CallInst>(&inst);
+            if (!call || !call->getCalledFunction()) continue;
+            if (call->getCalledFunction()->getName().str().find(name) != std::string::npos) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+inline bool
+callsFunction(const llvm::Function& function, const std::string& name)
+{
+    for (const llvm::BasicBlock& block : function) {
+        for (const llvm::Instruction& inst : block) {
+            const llvm::CallInst* call = llvm::dyn_cast<llvm::CallInst>(&inst);
+            if (!call || !call->getCalledFunction()) continue;
+            if (call->getCalledFunction()->getName().str().find(name) != std::string::npos) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+using PointGenerator = openvdb::ax::codegen::PointComputeGenerator;
+using VolumeGenerator = openvdb::ax::codegen::VolumeComputeGenerator;
+
+template <typename GeneratorT>
+using GeneratedCallback =
+    std::function<void(GeneratorT&, openvdb::ax::codegen::FunctionRegistry&)>;
+
+/// Generates the kernel for the tree with the given options and returns it. The optional
+/// prepare callback is applied to the tree before code generation, and the optional
+/// generated callback is given the generator and registry once the kernel exists
+template <typename GeneratorT>
+inline llvm::Function*
+generateKernel(openvdb::ax::ast::Tree& tree,
+               const openvdb::ax::FunctionOptions& options,
+               unittest_util::LLVMState& state,
+               std::vector<std::string>* warnings = nullptr,
+               const std::function<void(openvdb::ax::ast::Tree&)>& prepare = nullptr,
+               const GeneratedCallback<GeneratorT>& generated = nullptr)
+{
+    if (prepare) prepare(tree);
+
+    openvdb::ax::codegen::FunctionRegistry::UniquePtr registry =
+        openvdb::ax::codegen::createStandardRegistry(options);
+    GeneratorT generator(state.module(), options, *registry, warnings);
+    tree.accept(generator);
+    if (generated) generated(generator, *registry);
+
+    const std::string name =
+        std::is_same<GeneratorT, PointGenerator>::value ?
+            openvdb::ax::codegen::PointKernel::getDefaultName() :
+            openvdb::ax::codegen::VolumeKernel::getDefaultName();
+    return state.module().getFunction(name);
+}
+
+}
+
+void
+TestComputeGenerator::testEntryBlockAllocas()
+{
+    // locals, temporaries and crements inside of branches should all be allocated in the
+    // entry block, so that they are promoted to registers
+
+    const std::string code =
+        "float a = 1.0f;"
+        "float c = 0.0f;"
+        "if (a > 0.5f) { float b = a * 2.0f; c = b; }"
+        "else { vec3f v = {a, 2.0f, 3.0f}; c = v.y + 1.0f; }"
+        "if (c > 1.0f && a < 2.0f) { c += 1.0f; ++a; }";
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+    CPPUNIT_ASSERT(tree);
+
+    unittest_util::LLVMState state;
+    openvdb::ax::FunctionOptions options;
+    llvm::Function* function = generateKernel<VolumeGenerator>(*tree, options, state);
+    CPPUNIT_ASSERT(function);
+
+    // no allocas outside of the entry block
+
+    CPPUNIT_ASSERT_EQUAL(size_t(0), countAllocas(*function, /*exclude entry*/true));
+    CPPUNIT_ASSERT(countAllocas(*function, false) > 0);
+
+    // all allocas are promoted
+
+    llvm::legacy::FunctionPassManager passes(&state.module());
+    passes.add(llvm::createSROAPass());
+    passes.add(llvm::createPromoteMemoryToRegisterPass());
+    passes.doInitialization();
+    passes.run(*function);
+    passes.doFinalization();
+
+    CPPUNIT_ASSERT_EQUAL(size_t(0), countAllocas(*function, false));
+}
+
+void
+TestComputeGenerator::testNativeVectors()
+{
+    const std::string code =
+        "vec3f a = {1.0f, 2.0f, 3.0f};"
+        "vec3i b = {4, 5, 6};"
+        "vec3f c = a * b + 2.0f;"
+        "c = cross(a, c);"
+        "float d = dot(a, c) + length(c) + lengthsq(b);"
+        "c = normalize(c) / d;";
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+    CPPUNIT_ASSERT(tree);
+
+    // by default, vectors are operated on per element
+
+    {
+        unittest_util::LLVMState state;
+        openvdb::ax::FunctionOptions options;
+        options.mNativeVectors = false;
+        llvm::Function* function = generateKernel<VolumeGenerator>(*tree, options, state);
+        CPPUNIT_ASSERT(function);
+        CPPUNIT_ASSERT_EQUAL(size_t(0), countVectorInstructions(*function));
+        CPPUNIT_ASSERT(callsFunction(*function, "cross<"));
+    }
+
+    // native vectors generate llvm vector instructions and no longer call out to the
+    // cross product implementation
+
+    {
+        unittest_util::LLVMState state;
+        openvdb::ax::FunctionOptions options;
+        options.mNativeVectors = true;
+        llvm::Function* function = generateKernel<VolumeGenerator>(*tree, options, state);
+        CPPUNIT_ASSERT(function);
+        CPPUNIT_ASSERT(countVectorInstructions(*function) > 0);
+        CPPUNIT_ASSERT(!callsFunction(*function, "cross<"));
+    }
+}
+
+void
+TestComputeGenerator::testMathFunctions()
+{
+    // math functions with an llvm intrinsic are always generated as intrinsics, external
+    // math functions use the standard library symbols and don't access memory
+
+    const std::string code =
+        "float a = sin(1.0f);"
+        "double b = exp(2.0);"
+        "float c = tanh(a);"
+        "double d = atan2(b, 1.0);";
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+    CPPUNIT_ASSERT(tree);
+
+    unittest_util::LLVMState state;
+    openvdb::ax::FunctionOptions options;
+    llvm::Function* function = generateKernel<VolumeGenerator>(*tree, options, state);
+    CPPUNIT_ASSERT(function);
+
+    CPPUNIT_ASSERT(callsFunction(*function, "llvm.sin.f32"));
+    CPPUNIT_ASSERT(callsFunction(*function, "llvm.exp.f64"));
+
+    const llvm::Function* tanh = state.module().getFunction("tanhf");
+    CPPUNIT_ASSERT(tanh);
+    CPPUNIT_ASSERT(tanh->doesNotAccessMemory());
+    CPPUNIT_ASSERT(tanh->doesNotThrow());
+
+    const llvm::Function* atan2 = state.module().getFunction("atan2");
+    CPPUNIT_ASSERT(atan2);
+    CPPUNIT_ASSERT(atan2->doesNotAccessMemory());
+}
+
+void
+TestComputeGenerator::testAttributePromotion()
+{
+    const std::string code =
+        "@a += 1.0f;"
+        "@a *= @b;"
+        "@a = clamp(@a, 0.0f, 1.0f);";
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+    CPPUNIT_ASSERT(tree);
+
+    // by default, every access calls into the attribute handle
+
+    {
+        unittest_util::LLVMState state;
+        openvdb::ax::FunctionOptions options;
+        options.mPromoteAttributes = false;
+        llvm::Function* function = generateKernel<PointGenerator>(*tree, options, state);
+        CPPUNIT_ASSERT(function);
+        CPPUNIT_ASSERT_EQUAL(size_t(4), countCalls(*function, "get_attribute<"));
+        CPPUNIT_ASSERT_EQUAL(size_t(3), countCalls(*function, "set_attribute<"));
+    }
+
+    // promoted attributes are read once and written once
+
+    {
+        unittest_util::LLVMState state;
+        openvdb::ax::FunctionOptions options;
+        options.mPromoteAttributes = true;
+        llvm::Function* function = generateKernel<PointGenerator>(*tree, options, state);
+        CPPUNIT_ASSERT(function);
+        CPPUNIT_ASSERT_EQUAL(size_t(2), countCalls(*function, "get_attribute<"));
+        CPPUNIT_ASSERT_EQUAL(size_t(1), countCalls(*function, "set_attribute<"));
+    }
+}
+
+void
+TestComputeGenerator::testKernelAttributes()
+{
+    // the handle tables are marked as not aliasing and only read, and loads from them
+    // are invariant so that they may be hoisted out of the point range loop
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse("@a = @b + 1.0f;");
+    CPPUNIT_ASSERT(tree);
+
+    unittest_util::LLVMState state;
+    openvdb::ax::FunctionOptions options;
+    const llvm::Function* function = generateKernel<PointGenerator>(*tree, options, state);
+    CPPUNIT_ASSERT(function);
+
+    for (const std::string& name : {
+            openvdb::ax::codegen::PointKernel::getDefaultName(),
+            openvdb::ax::codegen::PointRangeKernel::getDefaultName() }) {
+        const llvm::Function* kernel = state.module().getFunction(name);
+        CPPUNIT_ASSERT(kernel);
+        CPPUNIT_ASSERT(kernel->hasParamAttribute(3, llvm::Attribute::NoAlias));
+        CPPUNIT_ASSERT(kernel->hasParamAttribute(3, llvm::Attribute::ReadOnly));
+        CPPUNIT_ASSERT(kernel->hasParamAttribute(4, llvm::Attribute::NoAlias));
+        CPPUNIT_ASSERT(!kernel->hasParamAttribute(3, llvm::Attribute::NonNull));
+        CPPUNIT_ASSERT(kernel->hasParamAttribute(5, llvm::Attribute::NonNull));
+    }
+
+    size_t invariant = 0;
+    for (const llvm::BasicBlock& block : *function) {
+        for (const llvm::Instruction& inst : block) {
+            if (!llvm::isa<llvm::LoadInst>(inst)) continue;
+            if (!inst.getMetadata(llvm::LLVMContext::MD_invariant_load)) continue;
+            ++invariant;
+        }
+    }
+
+    // one handle load for each access
+
+    CPPUNIT_ASSERT_EQUAL(size_t(2), invariant);
+}
+
+void
+TestComputeGenerator::testPrecisionPolicy()
+{
+    // untyped literals are only demoted when no other operand is explicitly double
+
+    const std::string code =
+        "float a = 1.0f;"
+        "float b = a * 0.5 + sin(0.25) * 0.1;"
+        "double c = 1.0;"
+        "double d = c * 0.1;";
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+    CPPUNIT_ASSERT(tree);
+
+    using PrecisionPolicy = openvdb::ax::FunctionOptions::PrecisionPolicy;
+
+    auto countDoubleArithmetic = [](const llvm::Function& function) -> size_t {
+        size_t count = 0;
+        for (const llvm::BasicBlock& block : function) {
+            for (const llvm::Instruction& inst : block) {
+                if (llvm::isa<llvm::BinaryOperator>(inst) && inst.getType()->isDoubleTy()) ++count;
+            }
+        }
+        return count;
+    };
+
+    {
+        unittest_util::LLVMState state;
+        std::vector<std::string> warnings;
+        openvdb::ax::FunctionOptions options;
+        options.mPrecisionPolicy = PrecisionPolicy::DEFAULT;
+        llvm::Function* function =
+            generateKernel<VolumeGenerator>(*tree, options, state, &warnings);
+        CPPUNIT_ASSERT(function);
+        CPPUNIT_ASSERT_EQUAL(size_t(4), countDoubleArithmetic(*function));
+        CPPUNIT_ASSERT(warnings.empty());
+    }
+
+    // only the arithmetic with the double local remains in double precision. 0.1 can not
+    // be represented exactly as a float, so its demotion is reported
+
+    {
+        unittest_util::LLVMState state;
+        std::vector<std::string> warnings;
+        openvdb::ax::FunctionOptions options;
+        options.mPrecisionPolicy = PrecisionPolicy::DEMOTE_LITERALS;
+        llvm::Function* function =
+            generateKernel<VolumeGenerator>(*tree, options, state, &warnings);
+        CPPUNIT_ASSERT(function);
+        CPPUNIT_ASSERT_EQUAL(size_t(1), countDoubleArithmetic(*function));
+        CPPUNIT_ASSERT(callsFunction(*function, "llvm.sin.f32"));
+        CPPUNIT_ASSERT_EQUAL(size_t(1), warnings.size());
+        CPPUNIT_ASSERT(warnings.front().find("0.1") != std::string::npos);
+    }
+
+    // literals which would overflow to infinity or flush to zero as a float are not
+    // demoted, and keep the arithmetic in double precision
+
+    tree = openvdb::ax::ast::parse(
+        "float a = 1.0f;"
+        "float b = a * 1e300;"
+        "float c = a * 1e-300;");
+    CPPUNIT_ASSERT(tree);
+
+    {
+        unittest_util::LLVMState state;
+        std::vector<std::string> warnings;
+        openvdb::ax::FunctionOptions options;
+        options.mPrecisionPolicy = PrecisionPolicy::DEMOTE_LITERALS;
+        llvm::Function* function =
+            generateKernel<VolumeGenerator>(*tree, options, state, &warnings);
+        CPPUNIT_ASSERT(function);
+        CPPUNIT_ASSERT_EQUAL(size_t(2), countDoubleArithmetic(*function));
+        CPPUNIT_ASSERT(warnings.empty());
+    }
+}
+
+void
+TestComputeGenerator::testFastMathFlags()
+{
+    // pragmas are removed from the code prior to parsing and stored on the tree
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(
+        "#pragma fastmath nnan, contract\n"
+        "float a = 1.0f;\n"
+        "float b = a * 2.0f + a / 3.0f;\n");
+    CPPUNIT_ASSERT(tree);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), tree->mPragmas.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("fastmath nnan, contract"), tree->mPragmas.front());
+
+    auto floatingOperations = [](const llvm::Function& function)
+            -> std::vector<const llvm::Instruction*> {
+        std::vector<const llvm::Instruction*> operations;
+        for (const llvm::BasicBlock& block : function) {
+            for (const llvm::Instruction& inst : block) {
+                if (llvm::isa<llvm::BinaryOperator>(inst) &&
+                    inst.getType()->isFloatingPointTy()) {
+                    operations.emplace_back(&inst);
+                }
+            }
+        }
+        return operations;
+    };
+
+    // strict floating point semantics by default
+
+    {
+        unittest_util::LLVMState state;
+        openvdb::ax::FunctionOptions options;
+        llvm::Function* function = generateKernel<VolumeGenerator>(*tree, options, state);
+        CPPUNIT_ASSERT(function);
+
+        const std::vector<const llvm::Instruction*> operations = floatingOperations(*function);
+        CPPUNIT_ASSERT_EQUAL(size_t(3), operations.size());
+        for (const llvm::Instruction* inst : operations) {
+            CPPUNIT_ASSERT(!inst->hasNoNaNs());
+            CPPUNIT_ASSERT(!inst->hasAllowContract());
+            CPPUNIT_ASSERT(!inst->hasAllowReciprocal());
+        }
+    }
+
+    {
+        unittest_util::LLVMState state;
+        openvdb::ax::FunctionOptions options;
+        options.mFastMathFlags.mNoNaNs = true;
+        options.mFastMathFlags.mAllowContract = true;
+        llvm::Function* function = generateKernel<VolumeGenerator>(*tree, options, state);
+        CPPUNIT_ASSERT(function);
+
+        const std::vector<const llvm::Instruction*> operations = floatingOperations(*function);
+        CPPUNIT_ASSERT_EQUAL(size_t(3), operations.size());
+        for (const llvm::Instruction* inst : operations) {
+            CPPUNIT_ASSERT(inst->hasNoNaNs());
+            CPPUNIT_ASSERT(inst->hasAllowContract());
+            CPPUNIT_ASSERT(!inst->hasAllowReciprocal());
+        }
+    }
+}
+
+void
+TestComputeGenerator::testFunctionBitcode()
+{
+    // dot and cross are external C++ functions unless IR is prioritised
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(
+        "vec3f a = {1.0f, 2.0f, 3.0f};"
+        "vec3f b = cross(a, a);"
+        "float c = dot(a, b);");
+    CPPUNIT_ASSERT(tree);
+
+    unittest_util::LLVMState state;
+    openvdb::ax::FunctionOptions options;
+
+    size_t linked = 0;
+    llvm::Function* kernel = generateKernel<VolumeGenerator>(*tree, options, state,
+        /*warnings*/nullptr, /*prepare*/nullptr,
+        [&](VolumeGenerator&, openvdb::ax::codegen::FunctionRegistry& registry) {
+            linked = openvdb::ax::codegen::linkFunctionBitcode(registry, state.module());
+        });
+    CPPUNIT_ASSERT(kernel);
+
+    const llvm::Function* dot = state.module().getFunction("dot<float>");
+    const llvm::Function* cross = state.module().getFunction("cross<float>");
+    CPPUNIT_ASSERT(dot);
+    CPPUNIT_ASSERT(cross);
+
+    if (!openvdb::ax::codegen::hasFunctionBitcode()) {
+        CPPUNIT_ASSERT_EQUAL(size_t(0), linked);
+        CPPUNIT_ASSERT(dot->isDeclaration());
+        CPPUNIT_ASSERT(cross->isDeclaration());
+        return;
+    }
+
+    // functions are only linked if their host symbols are exported by the process, which
+    // they are from the shared library. Any linked definitions are internal so that they
+    // can be removed once inlined
+
+    CPPUNIT_ASSERT(linked > 0);
+
+    std::vector<std::string> defined;
+    for (const llvm::Function* function : { dot, cross }) {
+        if (function->isDeclaration()) continue;
+        CPPUNIT_ASSERT(function->hasInternalLinkage());
+        defined.emplace_back(function->getName().str());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(defined.size(), linked);
+
+    for (const std::string& name : defined) {
+        CPPUNIT_ASSERT(callsFunction(*kernel, name));
+    }
+
+    llvm::legacy::PassManager passes;
+    passes.add(llvm::createFunctionInliningPass());
+    passes.run(state.module());
+
+    for (const std::string& name : defined) {
+        CPPUNIT_ASSERT(!callsFunction(*kernel, name));
+    }
+}
+
+void
+TestComputeGenerator::testScratchSites()
+{
+    // strings too large for the stack are allocated from the scratch arena. Every call
+    // to allocate is given its own constant site, so that a call inside of a loop reuses
+    // the same memory on every iteration
+
+    const std::string code =
+        "string big = \"0000000000000000\";"
+        "big = big + big; big = big + big; big = big + big; big = big + big;"
+        "big = big + big; big = big + big; big = big + big;"
+        "for (int i = 0; i < 100; ++i) { string t = big + \"x\"; }";
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+    CPPUNIT_ASSERT(tree);
+
+    unittest_util::LLVMState state;
+    openvdb::ax::FunctionOptions options;
+    const llvm::Function* function = generateKernel<PointGenerator>(*tree, options, state);
+    CPPUNIT_ASSERT(function);
+
+    std::set<int64_t> sites;
+    size_t calls = 0;
+    for (const llvm::BasicBlock& block : *function) {
+        for (const llvm::Instruction& inst : block) {
+            const llvm::CallInst* call = llvm::dyn_cast<llvm::CallInst>(&inst);
+            if (!call || !call->getCalledFunction()) continue;
+            if (call->getCalledFunction()->getName().str().find("allocate_scratch") ==
+                std::string::npos) continue;
+
+            const llvm::ConstantInt* site =
+                llvm::dyn_cast<llvm::ConstantInt>(call->getArgOperand(1));
+            CPPUNIT_ASSERT(site);
+            sites.insert(site->getSExtValue());
+            ++calls;
+        }
+    }
+
+    CPPUNIT_ASSERT(calls > 0);
+    CPPUNIT_ASSERT_EQUAL(calls, sites.size());
+    CPPUNIT_ASSERT_EQUAL(int64_t(0), *sites.begin());
+    CPPUNIT_ASSERT_EQUAL(int64_t(calls - 1), *sites.rbegin());
+}
+
+void
+TestComputeGenerator::testConstantFolding()
+{
+    // operations on literals are folded and dead branches removed before code generation,
+    // so that neither the arithmetic and branches nor the accesses in dead code are
+    // generated
+
+    const std::string code =
+        "float a = 1.0f + 2.0f * 3.0f;"
+        "if (false) { @dead = a; }"
+        "if (2 > 1) { @alive = a; } else { @dead = 0.0f; }";
+
+    auto countFloatArithmeticAndBranches = [](const llvm::Function& function) -> size_t {
+        size_t count = 0;
+        for (const llvm::BasicBlock& block : function) {
+            for (const llvm::Instruction& inst : block) {
+                if (llvm::isa<llvm::BinaryOperator>(inst) &&
+                    inst.getType()->isFloatingPointTy()) ++count;
+                if (const llvm::BranchInst* branch = llvm::dyn_cast<llvm::BranchInst>(&inst)) {
+                    if (branch->isConditional()) ++count;
+                }
+            }
+        }
+        return count;
+    };
+
+    auto accessesAttribute = [](const openvdb::ax::codegen::SymbolTable& globals,
+            const std::string& attribute) -> bool {
+        std::string name, type;
+        for (const auto& global : globals.map()) {
+            if (!openvdb::ax::codegen::isGlobalAttributeAccess(global.first, name, type)) continue;
+            if (name == attribute) return true;
+        }
+        return false;
+    };
+
+    for (const bool fold : { false, true }) {
+        openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+        CPPUNIT_ASSERT(tree);
+
+        unittest_util::LLVMState state;
+        openvdb::ax::FunctionOptions options;
+
+        bool alive = false, dead = false;
+        const llvm::Function* function = generateKernel<PointGenerator>(*tree, options, state,
+            /*warnings*/nullptr,
+            [&](openvdb::ax::ast::Tree& parsed) {
+                if (fold) openvdb::ax::ast::foldConstants(parsed);
+            },
+            [&](PointGenerator& generator, openvdb::ax::codegen::FunctionRegistry&) {
+                alive = accessesAttribute(generator.globals(), "alive");
+                dead = accessesAttribute(generator.globals(), "dead");
+            });
+        CPPUNIT_ASSERT(function);
+
+        CPPUNIT_ASSERT(alive);
+
+        if (fold) {
+            CPPUNIT_ASSERT_EQUAL(size_t(0), countFloatArithmeticAndBranches(*function));
+            CPPUNIT_ASSERT(!dead);
+        }
+        else {
+            CPPUNIT_ASSERT(countFloatArithmeticAndBranches(*function) > 0);
+            CPPUNIT_ASSERT(dead);
+        }
+    }
+}
+
+void
+TestComputeGenerator::testLookupGlobals()
+{
+    // lookups of literal names load the address of the custom data from a global, which
+    // the compiler initializes if the data exists at compile time. The runtime lookup is
+    // only called if the global is not bound
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse("@a = lookupf(\"value\");");
+    CPPUNIT_ASSERT(tree);
+
+    const float value = 2.0f;
+
+    for (const bool bind : { false, true }) {
+        unittest_util::LLVMState state;
+        openvdb::ax::FunctionOptions options;
+
+        std::vector<std::pair<std::string, llvm::GlobalVariable*>> lookups;
+        llvm::Function* function = generateKernel<VolumeGenerator>(*tree, options, state,
+            /*warnings*/nullptr, /*prepare*/nullptr,
+            [&](VolumeGenerator& generator, openvdb::ax::codegen::FunctionRegistry&) {
+                std::string name, type;
+                for (const auto& iter : generator.globals().map()) {
+                    if (!openvdb::ax::codegen::isGlobalLookupAccess(iter.first, name, type)) {
+                        continue;
+                    }
+                    lookups.emplace_back(name, llvm::dyn_cast<llvm::GlobalVariable>(iter.second));
+                }
+            });
+        CPPUNIT_ASSERT(function);
+
+        CPPUNIT_ASSERT_EQUAL(size_t(1), lookups.size());
+        CPPUNIT_ASSERT_EQUAL(std::string("value"), lookups.front().first);
+        llvm::GlobalVariable* global = lookups.front().second;
+        CPPUNIT_ASSERT(global);
+
+        bool loadsGlobal = false;
+        for (const llvm::BasicBlock& block : *function) {
+            for (const llvm::Instruction& inst : block) {
+                const llvm::LoadInst* load = llvm::dyn_cast<llvm::LoadInst>(&inst);
+                if (load && load->getPointerOperand() == global) loadsGlobal = true;
+            }
+        }
+        CPPUNIT_ASSERT(loadsGlobal);
+        CPPUNIT_ASSERT(callsFunction(*function, "lookup<"));
+
+        // bind the global as the compiler does and fold the branch on its value
+
+        const uintptr_t address = bind ? reinterpret_cast<uintptr_t>(&value) : 0;
+        global->setInitializer(llvm::ConstantInt::get(global->getValueType(), address));
+        global->setConstant(true);
+
+        llvm::legacy::FunctionPassManager passes(&state.module());
+        passes.add(llvm::createInstructionCombiningPass());
+        passes.add(llvm::createCFGSimplificationPass());
+        passes.doInitialization();
+        passes.run(*function);
+        passes.doFinalization();
+
+        CPPUNIT_ASSERT_EQUAL(!bind, callsFunction(*function, "lookup<"));
+    }
+}
+
+void
+TestComputeGenerator::testUnreachableBlocks()
+{
+    // code following return, break and continue statements is generated into blocks
+    // which are removed, including those used by the phi nodes of logical operators
+    // and of the fbm loop
+
+    const std::vector<std::string> codes = {
+        "return; bool b = @a > 0 && @b > 0;",
+        "for (int i = 0; i < 2; ++i) { continue; bool b = @a > 0 || @b > 0; }",
+        "while (true) { break; @a = fbm(v@P, 4); }",
+        "float foo(float a) { return a; bool b = a > 0 && a < 1; } @a = foo(@a);"
+    };
+
+    for (const std::string& code : codes) {
+        unittest_util::LLVMState state;
+        openvdb::ax::FunctionOptions options;
+
+        openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+        llvm::Function* function = generateKernel<PointGenerator>(*tree, options, state);
+        CPPUNIT_ASSERT_MESSAGE(code, function);
+        CPPUNIT_ASSERT_MESSAGE(code, !llvm::verifyModule(state.module()));
+
+        for (const llvm::Function& F : state.module()) {
+            for (const llvm::BasicBlock& block : F) {
+                CPPUNIT_ASSERT_MESSAGE(code, block.getName() != "return");
+                CPPUNIT_ASSERT_MESSAGE(code, block.getName() != "break");
+                CPPUNIT_ASSERT_MESSAGE(code, block.getName() != "continue");
+            }
+        }
+    }
+}
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -150,12 +150,14 @@ public:
     CPPUNIT_TEST_SUITE(TestFunctionBase);
     CPPUNIT_TEST(testCreate);
     CPPUNIT_TEST(testMatching);
+    CPPUNIT_TEST(testMatchCache);
     CPPUNIT_TEST(testExecuteCall);
     CPPUNIT_TEST(testGenerate);
     CPPUNIT_TEST_SUITE_END();
 
     void testCreate();
     void testMatching();
+    void testMatchCache();
     void testExecuteCall();
     void testGenerate();
 };
@@ -635,6 +637,67 @@ TestFunctionBase::testMatching()
     CPPUNIT_ASSERT_EQUAL((*list)[7], match.first);
 }
 
+void
+TestFunctionBase::testMatchCache()
+{
+    unittest_util::LLVMState state;
+
+    FunctionBase::Ptr function;
+    function.reset(new TestMultiFunction());
+
+    const std::vector<FunctionSignatureBase::Ptr>* list = &function->list();
+
+    std::vector<llvm::Type*> types;
+    FunctionBase::FunctionMatch match;
+
+    // cached explicit and implicit matches should be identical to the first match
+
+    types = { LLVMType<int32_t>::get(state.context()) };
+    for (size_t i = 0; i < 2; ++i) {
+        match = function->match(types, state.context(), /*add output arguments*/false);
+        CPPUNIT_ASSERT(FunctionSignatureBase::SignatureMatch::Explicit == match.second);
+        CPPUNIT_ASSERT_EQUAL((*list)[1], match.first);
+    }
+
+    types = { LLVMType<float>::get(state.context()) };
+    for (size_t i = 0; i < 2; ++i) {
+        match = function->match(types, state.context(), /*add output arguments*/false);
+        CPPUNIT_ASSERT(FunctionSignatureBase::SignatureMatch::Implicit == match.second);
+        CPPUNIT_ASSERT_EQUAL((*list)[1], match.first);
+    }
+
+    // matches with and without output arguments are cached separately
+
+    types = { LLVMType<int32_t>::get(state.context()), LLVMType<double>::get(state.context()) };
+    for (size_t i = 0; i < 2; ++i) {
+        match = function->match(types, state.context(), /*add output arguments*/true);
+        CPPUNIT_ASSERT(FunctionSignatureBase::SignatureMatch::Explicit == match.second);
+        CPPUNIT_ASSERT_EQUAL((*list)[4], match.first);
+
+        match = function->match(types, state.context(), /*add output arguments*/false);
+        CPPUNIT_ASSERT(FunctionSignatureBase::SignatureMatch::Explicit == match.second);
+        CPPUNIT_ASSERT_EQUAL((*list)[3], match.first);
+    }
+
+    // failed matches are also cached
+
+    types.resize(4, LLVMType<double>::get(state.context()));
+    for (size_t i = 0; i < 2; ++i) {
+        match = function->match(types, state.context(), /*add output arguments*/false);
+        CPPUNIT_ASSERT(FunctionSignatureBase::SignatureMatch::None == match.second);
+        CPPUNIT_ASSERT(!match.first);
+    }
+
+    // matches are recomputed for a new context
+
+    unittest_util::LLVMState other;
+
+    types = { LLVMType<int32_t>::get(other.context()) };
+    match = function->match(types, other.context(), /*add output arguments*/false);
+    CPPUNIT_ASSERT(FunctionSignatureBase::SignatureMatch::Explicit == match.second);
+    CPPUNIT_ASSERT_EQUAL((*list)[1], match.first);
+}
+
 void
 TestFunctionBase::testExecuteCall()
 {
@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/codegen/FunctionRegistry.h>
+#include <openvdb_ax/codegen/Functions.h>
+#include <openvdb_ax/compiler/CompilerOptions.h>
+#include <openvdb_ax/Exceptions.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class TestFunctionRegistry : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestFunctionRegistry);
+    CPPUNIT_TEST(testSharedDefinitions);
+    CPPUNIT_TEST(testCreateAll);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testSharedDefinitions();
+    void testCreateAll();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFunctionRegistry);
+
+void
+TestFunctionRegistry::testSharedDefinitions()
+{
+    using openvdb::ax::codegen::FunctionRegistry;
+
+    const FunctionRegistry::ConstPtr definitions = openvdb::ax::codegen::standardDefinitions();
+    CPPUNIT_ASSERT(definitions);
+    CPPUNIT_ASSERT_EQUAL(definitions.get(), openvdb::ax::codegen::standardDefinitions().get());
+    CPPUNIT_ASSERT(definitions->definition("sin"));
+    CPPUNIT_ASSERT(!definitions->definition("unknown"));
+
+    openvdb::ax::FunctionOptions options;
+    FunctionRegistry::UniquePtr registry = openvdb::ax::codegen::createStandardRegistry(options);
+    CPPUNIT_ASSERT_EQUAL(definitions.get(), registry->definitions().get());
+    CPPUNIT_ASSERT(registry->map().empty());
+    CPPUNIT_ASSERT(!registry->empty());
+
+    // functions are only instantiated in the derived registry
+
+    CPPUNIT_ASSERT(registry->getOrInsert("sin", options, false));
+    CPPUNIT_ASSERT(registry->get("sin", false));
+    CPPUNIT_ASSERT(!definitions->get("sin", false));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), registry->map().size());
+
+    // internal functions are only available with internal access
+
+    CPPUNIT_ASSERT(!registry->getOrInsert("getattribute", options, false));
+    CPPUNIT_ASSERT(registry->getOrInsert("getattribute", options, true));
+
+    // dependencies are also instantiated in the derived registry
+
+    CPPUNIT_ASSERT(registry->getOrInsert("cross", options, false));
+    CPPUNIT_ASSERT(registry->get("internal_cross", true));
+    CPPUNIT_ASSERT(!definitions->get("internal_cross", true));
+
+    // shared definitions can not be redefined, and new definitions are not shared
+
+    CPPUNIT_ASSERT_THROW(registry->insert("sin", openvdb::ax::codegen::Sin::create),
+        openvdb::LLVMFunctionError);
+    registry->insert("sine", openvdb::ax::codegen::Sin::create);
+    CPPUNIT_ASSERT(registry->definition("sine"));
+    CPPUNIT_ASSERT(!definitions->definition("sine"));
+
+    // registries can be derived from any other registry
+
+    FunctionRegistry::ConstPtr base(std::move(registry));
+    FunctionRegistry derived(base);
+    CPPUNIT_ASSERT(derived.map().empty());
+    CPPUNIT_ASSERT(derived.getOrInsert("sine", options, false));
+    CPPUNIT_ASSERT(derived.getOrInsert("cos", options, false));
+}
+
+void
+TestFunctionRegistry::testCreateAll()
+{
+    openvdb::ax::FunctionOptions options;
+    options.mLazyFunctions = false;
+
+    const openvdb::ax::codegen::FunctionRegistry::UniquePtr registry =
+        openvdb::ax::codegen::createStandardRegistry(options);
+
+    const openvdb::ax::codegen::FunctionRegistry::ConstPtr definitions =
+        openvdb::ax::codegen::standardDefinitions();
+
+    CPPUNIT_ASSERT_EQUAL(definitions->map().size(), registry->map().size());
+    for (const auto& iter : registry->map()) {
+        CPPUNIT_ASSERT(iter.second.function());
+        CPPUNIT_ASSERT(!definitions->map().at(iter.first).function());
+    }
+}
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
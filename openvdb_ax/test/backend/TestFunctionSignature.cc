@@ -51,6 +51,7 @@ public:
     CPPUNIT_TEST(testCreate);
     CPPUNIT_TEST(testPrint);
     CPPUNIT_TEST(testTypeCreation);
+    CPPUNIT_TEST(testCachedTypes);
     CPPUNIT_TEST(testReturnOutputs);
     CPPUNIT_TEST(testMatching);
     CPPUNIT_TEST(testLLVMFunction);
@@ -59,6 +60,7 @@ public:
     void testCreate();
     void testPrint();
     void testTypeCreation();
+    void testCachedTypes();
     void testReturnOutputs();
     void testMatching();
     void testLLVMFunction();
@@ -408,6 +410,44 @@ TestFunctionSignature::testTypeCreation()
     CPPUNIT_ASSERT_EQUAL(types[5], llvm::cast<llvm::Type>(LLVMType<double(*)[2]>::get(state.context())));
 }
 
+void
+TestFunctionSignature::testCachedTypes()
+{
+    unittest_util::LLVMState state;
+
+    FunctionSignatureBase::Ptr functionPtr =
+        FunctionSignature<float(bool,int16_t*,int32_t(*)[1],int64_t,float*,double(*)[2])>
+            ::create(&TestFunctions::FFunctionMix, "FFunctionMix");
+
+    std::vector<llvm::Type*> types;
+    llvm::Type* returnType = functionPtr->toLLVMTypes(state.context(), &types);
+
+    llvm::Type* cachedReturnType = nullptr;
+    const std::vector<llvm::Type*>* cached =
+        &functionPtr->llvmTypes(state.context(), &cachedReturnType);
+    CPPUNIT_ASSERT_EQUAL(returnType, cachedReturnType);
+    CPPUNIT_ASSERT(types == *cached);
+
+    // check the same types are returned without being rebuilt
+
+    cachedReturnType = nullptr;
+    CPPUNIT_ASSERT_EQUAL(cached, &functionPtr->llvmTypes(state.context(), &cachedReturnType));
+    CPPUNIT_ASSERT_EQUAL(returnType, cachedReturnType);
+    CPPUNIT_ASSERT(types == *cached);
+
+    // check the types are rebuilt for a new context
+
+    unittest_util::LLVMState other;
+
+    types.clear();
+    returnType = functionPtr->toLLVMTypes(other.context(), &types);
+    cached = &functionPtr->llvmTypes(other.context(), &cachedReturnType);
+    CPPUNIT_ASSERT_EQUAL(returnType, cachedReturnType);
+    CPPUNIT_ASSERT(types == *cached);
+    CPPUNIT_ASSERT(cachedReturnType == llvm::cast<llvm::Type>(LLVMType<float>::get(other.context())));
+    CPPUNIT_ASSERT(cachedReturnType != llvm::cast<llvm::Type>(LLVMType<float>::get(state.context())));
+}
+
 void
 TestFunctionSignature::testReturnOutputs()
 {
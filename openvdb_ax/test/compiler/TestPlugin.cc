@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/ast/AST.h>
+#include <openvdb_ax/codegen/FunctionBitcode.h>
+#include <openvdb_ax/codegen/VolumeComputeGenerator.h>
+#include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/Plugin.h>
+#include <openvdb_ax/compiler/VolumeExecutable.h>
+#include <openvdb_ax/Exceptions.h>
+
+#include <openvdb/openvdb.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+class TestPlugin : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestPlugin);
+    CPPUNIT_TEST(testLoadErrors);
+#ifdef OPENVDB_AX_TEST_PLUGIN
+    CPPUNIT_TEST(testLoadPlugin);
+#endif
+    CPPUNIT_TEST_SUITE_END();
+
+    void testLoadErrors();
+#ifdef OPENVDB_AX_TEST_PLUGIN
+    void testLoadPlugin();
+#endif
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPlugin);
+
+void
+TestPlugin::testLoadErrors()
+{
+    CPPUNIT_ASSERT_THROW(openvdb::ax::Plugin::load("libdoesnotexist.so"),
+        openvdb::AXCompilerError);
+
+    openvdb::ax::Compiler compiler;
+    CPPUNIT_ASSERT_THROW(compiler.loadPlugin("libdoesnotexist.so"), openvdb::AXCompilerError);
+}
+
+#ifdef OPENVDB_AX_TEST_PLUGIN
+void
+TestPlugin::testLoadPlugin()
+{
+    using namespace openvdb::ax;
+
+    const Plugin::Ptr plugin = Plugin::load(OPENVDB_AX_TEST_PLUGIN);
+    CPPUNIT_ASSERT(plugin);
+    CPPUNIT_ASSERT_EQUAL(std::string(OPENVDB_AX_TEST_PLUGIN), plugin->path());
+
+    // plugin functions are only available to compilers which have loaded the plugin
+
+    Compiler compiler;
+    CPPUNIT_ASSERT_THROW(compiler.compile<VolumeExecutable>("@a = twice(2.0f);"),
+        openvdb::Exception);
+
+    compiler.loadPlugin(OPENVDB_AX_TEST_PLUGIN);
+    const VolumeExecutable::Ptr executable =
+        compiler.compile<VolumeExecutable>("@a = twice(2.0f);");
+    CPPUNIT_ASSERT(executable);
+
+    openvdb::FloatGrid::Ptr grid = openvdb::FloatGrid::create();
+    grid->setName("a");
+    grid->tree().setValueOn(openvdb::Coord(0), 1.0f);
+
+    executable->execute(openvdb::GridPtrVec{grid});
+    CPPUNIT_ASSERT_EQUAL(4.0f, grid->tree().getValue(openvdb::Coord(0)));
+
+    // functions may not be redefined
+
+    CPPUNIT_ASSERT_THROW(compiler.loadPlugin(OPENVDB_AX_TEST_PLUGIN),
+        openvdb::LLVMFunctionError);
+
+    // the definition of twice is linked from the plugin bitcode in place of the call
+    // to the plugin
+
+#ifdef OPENVDB_AX_TEST_PLUGIN_BITCODE
+    CPPUNIT_ASSERT(plugin->bitcode());
+    CPPUNIT_ASSERT(plugin->bitcodeSize() > 0);
+#endif
+
+    if (!plugin->bitcode()) return;
+
+    const ast::Tree::Ptr tree = ast::parse("@a = twice(2.0f);");
+    CPPUNIT_ASSERT(tree);
+
+    llvm::LLVMContext context;
+    llvm::Module module("test_module", context);
+
+    FunctionOptions options;
+    codegen::FunctionRegistry::UniquePtr registry = codegen::createStandardRegistry(options);
+    plugin->registerFunctions(*registry, options);
+
+    codegen::VolumeComputeGenerator generator(module, options, *registry);
+    tree->accept(generator);
+
+    const llvm::Function* twice = module.getFunction("openvdb_ax_test_plugin_twice");
+    CPPUNIT_ASSERT(twice);
+    CPPUNIT_ASSERT(twice->isDeclaration());
+
+    CPPUNIT_ASSERT_EQUAL(size_t(1), codegen::linkFunctionBitcode(*registry, module,
+        plugin->bitcode(), plugin->bitcodeSize(), plugin->path()));
+
+    twice = module.getFunction("openvdb_ax_test_plugin_twice");
+    CPPUNIT_ASSERT(twice);
+    CPPUNIT_ASSERT(!twice->isDeclaration());
+    CPPUNIT_ASSERT(twice->hasInternalLinkage());
+}
+#endif
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -29,8 +29,11 @@
 ///////////////////////////////////////////////////////////////////////////
 
 #include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/LeafLocalData.h>
 #include <openvdb_ax/compiler/PointExecutable.h>
 
+#include <openvdb/points/PointConversion.h>
+
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
@@ -41,9 +44,13 @@ public:
 
     CPPUNIT_TEST_SUITE(TestPointExecutable);
     CPPUNIT_TEST(testConstructionDestruction);
+    CPPUNIT_TEST(testScratchArena);
+    CPPUNIT_TEST(testDeadCodeAttributes);
     CPPUNIT_TEST_SUITE_END();
 
     void testConstructionDestruction();
+    void testScratchArena();
+    void testDeadCodeAttributes();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestPointExecutable);
@@ -95,6 +102,80 @@ TestPointExecutable::testConstructionDestruction()
     CPPUNIT_ASSERT_EQUAL(0, int(wC.use_count()));
 }
 
+void
+TestPointExecutable::testScratchArena()
+{
+    // A string concatenation inside of a loop allocates from the same site on every
+    // iteration. The arena should only grow to the peak size of each site, no matter how
+    // many iterations, points or leaf nodes use it
+
+    openvdb::ax::compiler::ScratchArena arena;
+    CPPUNIT_ASSERT_EQUAL(size_t(0), arena.capacity());
+
+    const size_t bigString = 2049;
+
+    for (size_t leaf = 0; leaf < 4; ++leaf) {
+        openvdb::ax::compiler::LeafLocalData data(/*count*/100, &arena);
+        for (size_t point = 0; point < 100; ++point) {
+            // string big = ...; for (...) { string t = big + "x"; }
+            char* big = data.allocateScratch(0, bigString);
+            CPPUNIT_ASSERT(big);
+            for (size_t i = 0; i < 1000; ++i) {
+                char* concat = data.allocateScratch(1, bigString + 1);
+                CPPUNIT_ASSERT(concat);
+                CPPUNIT_ASSERT(concat != big);
+            }
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(bigString + bigString + 1, arena.capacity());
+
+    // a site which grows reallocates geometrically, so its capacity is bounded by twice
+    // its largest request
+
+    for (size_t i = 1; i <= 100000; ++i) {
+        CPPUNIT_ASSERT(arena.allocate(2, i));
+    }
+
+    CPPUNIT_ASSERT(arena.capacity() <= bigString + bigString + 1 + 2 * 100000);
+
+    // data which does not share an arena owns its own
+
+    openvdb::ax::compiler::LeafLocalData owned(/*count*/1);
+    CPPUNIT_ASSERT(owned.allocateScratch(0, bigString));
+}
+
+void
+TestPointExecutable::testDeadCodeAttributes()
+{
+    // attributes which are only accessed in branches which are never executed are not
+    // created on the points
+
+    openvdb::ax::Compiler compiler;
+    openvdb::ax::PointExecutable::Ptr executable =
+        compiler.compile<openvdb::ax::PointExecutable>(
+            "if (false) { @dead = 1.0f; }"
+            "if (1 < 2) { @alive = 2.0f; } else { @dead = 0.0f; }");
+    CPPUNIT_ASSERT(executable);
+
+    openvdb::math::Transform::Ptr transform =
+        openvdb::math::Transform::createLinearTransform(1.0);
+    openvdb::points::PointDataGrid::Ptr grid =
+        openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+            openvdb::points::PointDataGrid>(std::vector<openvdb::Vec3d>{openvdb::Vec3d(0.0)},
+                *transform);
+
+    executable->execute(*grid);
+
+    const auto leaf = grid->tree().cbeginLeaf();
+    CPPUNIT_ASSERT(leaf);
+
+    const openvdb::points::AttributeSet::Descriptor& descriptor =
+        leaf->attributeSet().descriptor();
+    CPPUNIT_ASSERT(descriptor.find("alive") != openvdb::points::AttributeSet::INVALID_POS);
+    CPPUNIT_ASSERT(descriptor.find("dead") == openvdb::points::AttributeSet::INVALID_POS);
+}
+
 // Copyright (c) 2015-2019 DNEG
 // All rights reserved. This software is distributed under the
 // Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -31,6 +31,8 @@
 #include <openvdb_ax/compiler/Compiler.h>
 #include <openvdb_ax/compiler/VolumeExecutable.h>
 
+#include <openvdb/openvdb.h>
+
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
@@ -41,9 +43,17 @@ public:
 
     CPPUNIT_TEST_SUITE(TestVolumeExecutable);
     CPPUNIT_TEST(testConstructionDestruction);
+    CPPUNIT_TEST(testExecuteRegion);
+    CPPUNIT_TEST(testExecutionTopology);
+    CPPUNIT_TEST(testBlockScheduling);
+    CPPUNIT_TEST(testBufferedMaskGrid);
     CPPUNIT_TEST_SUITE_END();
 
     void testConstructionDestruction();
+    void testExecuteRegion();
+    void testExecutionTopology();
+    void testBlockScheduling();
+    void testBufferedMaskGrid();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestVolumeExecutable);
@@ -95,6 +105,260 @@ TestVolumeExecutable::testConstructionDestruction()
     CPPUNIT_ASSERT_EQUAL(0, int(wC.use_count()));
 }
 
+void
+TestVolumeExecutable::testExecuteRegion()
+{
+    openvdb::ax::Compiler compiler;
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler.compile<openvdb::ax::VolumeExecutable>("@f += 1.0f;");
+    CPPUNIT_ASSERT(executable);
+
+    // two active voxels in different leaf nodes and an active tile, which is not
+    // executed over
+
+    auto createGrid = []() -> openvdb::FloatGrid::Ptr {
+        openvdb::FloatGrid::Ptr grid = openvdb::FloatGrid::create();
+        grid->setName("f");
+        grid->tree().setValueOn(openvdb::Coord(0), 0.0f);
+        grid->tree().setValueOn(openvdb::Coord(20), 0.0f);
+        grid->tree().addTile(1, openvdb::Coord(-128), 0.0f, true);
+        return grid;
+    };
+
+    // bounding box
+
+    openvdb::FloatGrid::Ptr grid = createGrid();
+    openvdb::GridPtrVec grids { grid };
+
+    executable->execute(grids, openvdb::CoordBBox(openvdb::Coord(-1), openvdb::Coord(1)));
+
+    CPPUNIT_ASSERT_EQUAL(1.0f, grid->tree().getValue(openvdb::Coord(0)));
+    CPPUNIT_ASSERT_EQUAL(0.0f, grid->tree().getValue(openvdb::Coord(20)));
+    CPPUNIT_ASSERT_EQUAL(0.0f, grid->tree().getValue(openvdb::Coord(-128)));
+
+    // empty bounding box
+
+    executable->execute(grids, openvdb::CoordBBox());
+
+    CPPUNIT_ASSERT_EQUAL(1.0f, grid->tree().getValue(openvdb::Coord(0)));
+    CPPUNIT_ASSERT_EQUAL(0.0f, grid->tree().getValue(openvdb::Coord(20)));
+
+    // mask, containing a voxel in the same leaf node as an active voxel and a tile
+    // covering the other
+
+    grid = createGrid();
+    grids = { grid };
+
+    openvdb::MaskGrid mask;
+    mask.tree().setValueOn(openvdb::Coord(1));
+    mask.tree().fill(openvdb::CoordBBox(openvdb::Coord(16), openvdb::Coord(23)), true);
+
+    executable->execute(grids, mask);
+
+    CPPUNIT_ASSERT_EQUAL(0.0f, grid->tree().getValue(openvdb::Coord(0)));
+    CPPUNIT_ASSERT_EQUAL(1.0f, grid->tree().getValue(openvdb::Coord(20)));
+    CPPUNIT_ASSERT_EQUAL(0.0f, grid->tree().getValue(openvdb::Coord(-128)));
+
+    // full execution is unaffected
+
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(1.0f, grid->tree().getValue(openvdb::Coord(0)));
+    CPPUNIT_ASSERT_EQUAL(2.0f, grid->tree().getValue(openvdb::Coord(20)));
+}
+
+void
+TestVolumeExecutable::testExecutionTopology()
+{
+    using ExecutionTopology = openvdb::ax::VolumeExecutable::ExecutionTopology;
+
+    openvdb::ax::Compiler compiler;
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler.compile<openvdb::ax::VolumeExecutable>("@out = @a + @b;");
+    CPPUNIT_ASSERT(executable);
+    CPPUNIT_ASSERT(executable->getExecutionTopology() == ExecutionTopology::ASSIGNED);
+
+    const openvdb::Coord ca(0), cb(20), cab(40), cn(60);
+
+    auto createGrid = [](const std::string& name) -> openvdb::FloatGrid::Ptr {
+        openvdb::FloatGrid::Ptr grid = openvdb::FloatGrid::create();
+        grid->setName(name);
+        return grid;
+    };
+
+    openvdb::FloatGrid::Ptr a = createGrid("a"), b = createGrid("b");
+    a->tree().setValueOn(ca, 1.0f);
+    a->tree().setValueOn(cab, 1.0f);
+    b->tree().setValueOn(cb, 2.0f);
+    b->tree().setValueOn(cab, 2.0f);
+
+    openvdb::FloatGrid::Ptr named = createGrid("n");
+    named->tree().setValueOn(cn);
+
+    // assigned topology
+
+    openvdb::FloatGrid::Ptr out = createGrid("out");
+    openvdb::GridPtrVec grids { a, b, out, named };
+
+    executable->execute(grids);
+    CPPUNIT_ASSERT(out->tree().empty());
+
+    // union
+
+    executable->setExecutionTopology(ExecutionTopology::UNION);
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(3), out->tree().activeVoxelCount());
+    CPPUNIT_ASSERT_EQUAL(1.0f, out->tree().getValue(ca));
+    CPPUNIT_ASSERT_EQUAL(2.0f, out->tree().getValue(cb));
+    CPPUNIT_ASSERT_EQUAL(3.0f, out->tree().getValue(cab));
+
+    // intersection
+
+    out = createGrid("out");
+    grids = { a, b, out, named };
+
+    executable->setExecutionTopology(ExecutionTopology::INTERSECTION);
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(1), out->tree().activeVoxelCount());
+    CPPUNIT_ASSERT_EQUAL(3.0f, out->tree().getValue(cab));
+
+    // named
+
+    out = createGrid("out");
+    grids = { a, b, out, named };
+
+    executable->setExecutionTopology(ExecutionTopology::NAMED, "n");
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(1), out->tree().activeVoxelCount());
+    CPPUNIT_ASSERT(out->tree().isValueOn(cn));
+    CPPUNIT_ASSERT_EQUAL(0.0f, out->tree().getValue(cn));
+
+    executable->setExecutionTopology(ExecutionTopology::NAMED, "missing");
+    CPPUNIT_ASSERT_THROW(executable->execute(grids), openvdb::LookupError);
+
+    // named, with an active tile which is voxelized in the volume written to
+
+    const openvdb::Coord ct(200);
+    named->tree().addTile(/*level*/1, ct, 0.0f, /*active*/true);
+
+    out = createGrid("out");
+    grids = { a, b, out, named };
+
+    executable->setExecutionTopology(ExecutionTopology::NAMED, "n");
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(513), out->tree().activeVoxelCount());
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(0), out->tree().activeTileCount());
+    CPPUNIT_ASSERT(out->tree().probeConstLeaf(ct));
+    CPPUNIT_ASSERT(out->tree().isValueOn(ct.offsetBy(7)));
+    CPPUNIT_ASSERT(named->tree().hasActiveTiles());
+
+    // named, where the named volume is written to by an earlier block
+
+    openvdb::ax::VolumeExecutable::Ptr written =
+        compiler.compile<openvdb::ax::VolumeExecutable>("@n = @a + 1.0f; @out = @n;");
+    CPPUNIT_ASSERT(written);
+
+    out = createGrid("out");
+    grids = { a, out, named };
+
+    written->setExecutionTopology(ExecutionTopology::NAMED, "n");
+    written->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(513), out->tree().activeVoxelCount());
+    CPPUNIT_ASSERT_EQUAL(1.0f, out->tree().getValue(cn));
+    CPPUNIT_ASSERT_EQUAL(1.0f, out->tree().getValue(ct));
+}
+
+void
+TestVolumeExecutable::testBlockScheduling()
+{
+    // the first two blocks are independent, the third must wait for both to read @a
+    // before writing to it and the last must wait for the first two to write to @b and @c
+
+    const std::string code = "@b = @a + 1.0f; @c = @a * 2.0f; @a = 5.0f; @d = @b + @c;";
+
+    openvdb::ax::Compiler compiler;
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler.compile<openvdb::ax::VolumeExecutable>(code);
+    CPPUNIT_ASSERT(executable);
+
+    const std::vector<std::vector<size_t>> expected = { {}, {}, { 0, 1 }, { 0, 1 } };
+    CPPUNIT_ASSERT(expected == executable->getBlockDependencies());
+
+    for (int iteration = 0; iteration < 10; ++iteration) {
+
+        openvdb::GridPtrVec grids;
+        for (const std::string name : { "a", "b", "c", "d" }) {
+            openvdb::FloatGrid::Ptr grid = openvdb::FloatGrid::create();
+            grid->setName(name);
+            for (int i = 0; i < 64; ++i) {
+                grid->tree().setValueOn(openvdb::Coord(i * 8, 0, 0), 1.0f);
+            }
+            grids.emplace_back(grid);
+        }
+
+        executable->execute(grids);
+
+        for (int i = 0; i < 64; ++i) {
+            const openvdb::Coord ijk(i * 8, 0, 0);
+            CPPUNIT_ASSERT_EQUAL(5.0f,
+                openvdb::StaticPtrCast<openvdb::FloatGrid>(grids[0])->tree().getValue(ijk));
+            CPPUNIT_ASSERT_EQUAL(2.0f,
+                openvdb::StaticPtrCast<openvdb::FloatGrid>(grids[1])->tree().getValue(ijk));
+            CPPUNIT_ASSERT_EQUAL(2.0f,
+                openvdb::StaticPtrCast<openvdb::FloatGrid>(grids[2])->tree().getValue(ijk));
+            CPPUNIT_ASSERT_EQUAL(4.0f,
+                openvdb::StaticPtrCast<openvdb::FloatGrid>(grids[3])->tree().getValue(ijk));
+        }
+    }
+
+    // blocks which touch unrelated volumes are independent
+
+    executable = compiler.compile<openvdb::ax::VolumeExecutable>("@b = @a; @d = @c;");
+    CPPUNIT_ASSERT(executable);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), executable->getBlockDependencies().size());
+    CPPUNIT_ASSERT(executable->getBlockDependencies()[0].empty());
+    CPPUNIT_ASSERT(executable->getBlockDependencies()[1].empty());
+}
+
+void
+TestVolumeExecutable::testBufferedMaskGrid()
+{
+    // writes to a volume which is also sampled by a stencil function are buffered,
+    // which is not supported for mask grids
+
+    const std::string code = "bool@m = sample_offset(bool@m, 1, 0, 0);";
+
+    openvdb::ax::Compiler compiler;
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler.compile<openvdb::ax::VolumeExecutable>(code);
+    CPPUNIT_ASSERT(executable);
+
+    openvdb::MaskGrid::Ptr mask = openvdb::MaskGrid::create();
+    mask->setName("m");
+    mask->tree().setValueOn(openvdb::Coord(0));
+    openvdb::GridPtrVec grids { mask };
+
+    CPPUNIT_ASSERT_THROW(executable->execute(grids), openvdb::TypeError);
+
+    // bool grids may be written to and sampled
+
+    openvdb::BoolGrid::Ptr grid = openvdb::BoolGrid::create();
+    grid->setName("m");
+    grid->tree().setValueOn(openvdb::Coord(0), false);
+    grid->tree().setValueOn(openvdb::Coord(1), true);
+    grids = { grid };
+
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(true, grid->tree().getValue(openvdb::Coord(0)));
+    CPPUNIT_ASSERT_EQUAL(false, grid->tree().getValue(openvdb::Coord(1)));
+}
+
 // Copyright (c) 2015-2019 DNEG
 // All rights reserved. This software is distributed under the
 // Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
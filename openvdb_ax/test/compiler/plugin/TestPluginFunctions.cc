@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file test/compiler/plugin/TestPluginFunctions.cc
+///
+/// @brief  A function plugin which is loaded by TestPlugin
+///
+
+#include <openvdb_ax/codegen/Functions.h>
+#include <openvdb_ax/compiler/Plugin.h>
+
+#ifdef OPENVDB_AX_TEST_PLUGIN_BITCODE
+// Generated at build time from the bitcode of this file
+extern "C" const unsigned char openvdb_ax_test_plugin_bitcode[];
+extern "C" const size_t openvdb_ax_test_plugin_bitcode_size;
+#endif
+
+/// @brief  Functions are exported so that their definitions in the plugin bitcode can be
+///         matched to the host functions
+extern "C" OPENVDB_EXPORT float openvdb_ax_test_plugin_twice(const float value)
+{
+    return value * 2.0f;
+}
+
+namespace {
+
+using namespace openvdb::ax::codegen;
+
+struct Twice : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("twice", FunctionBase::All,
+        "Returns the input multiplied by two.")
+
+    inline static Ptr create(const openvdb::ax::FunctionOptions&) { return Ptr(new Twice()); }
+    inline bool readNone() const override { return true; }
+
+    Twice() : FunctionBase({
+        DECLARE_FUNCTION_SIGNATURE(openvdb_ax_test_plugin_twice)
+    }) {}
+};
+
+void registerFunctions(FunctionRegistry& registry, const openvdb::ax::FunctionOptions&)
+{
+    registry.insert("twice", Twice::create);
+}
+
+}
+
+OPENVDB_AX_PLUGIN(registerFunctions)
+
+#ifdef OPENVDB_AX_TEST_PLUGIN_BITCODE
+OPENVDB_AX_PLUGIN_BITCODE(openvdb_ax_test_plugin_bitcode, openvdb_ax_test_plugin_bitcode_size)
+#endif
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
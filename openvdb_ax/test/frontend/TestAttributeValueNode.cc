@@ -64,6 +64,10 @@ static const unittest_util::CodeTests tests =
     { "s@a;",      EXPECTED_PASS(std::string, BehaviourFlags::Specified, 2)},
     { "vec3f@a;",  EXPECTED_PASS(openvdb::Vec3f, BehaviourFlags::Specified, 2)},
     { "vec3d@a;",  EXPECTED_PASS(openvdb::Vec3d, BehaviourFlags::Specified, 2)},
+    { "mat3f@a;",  EXPECTED_PASS(openvdb::Mat3s, BehaviourFlags::Specified, 2)},
+    { "mat3d@a;",  EXPECTED_PASS(openvdb::Mat3d, BehaviourFlags::Specified, 2)},
+    { "mat4f@a;",  EXPECTED_PASS(openvdb::Mat4s, BehaviourFlags::Specified, 2)},
+    { "mat4d@a;",  EXPECTED_PASS(openvdb::Mat4d, BehaviourFlags::Specified, 2)},
     { "string@a;", EXPECTED_PASS(std::string, BehaviourFlags::Specified, 2)},
 };
 
@@ -57,6 +57,12 @@ static const unittest_util::CodeTests tests =
     { "vec3i a;",   EXPECTED_PASS(openvdb::Vec3i, 1) },
     { "vec3f a;",   EXPECTED_PASS(openvdb::Vec3f, 1) },
     { "vec3d a;",   EXPECTED_PASS(openvdb::Vec3d, 1) },
+    { "mat3f a;",   EXPECTED_PASS(openvdb::Mat3s, 1) },
+    { "mat3d a;",   EXPECTED_PASS(openvdb::Mat3d, 1) },
+    { "mat4f a;",   EXPECTED_PASS(openvdb::Mat4s, 1) },
+    { "mat4d a;",   EXPECTED_PASS(openvdb::Mat4d, 1) },
+    { "matrix3 a;", EXPECTED_PASS(openvdb::Mat3s, 1) },
+    { "matrix a;",  EXPECTED_PASS(openvdb::Mat4s, 1) },
     { "string a;",  EXPECTED_PASS(std::string, 1) },
 };
 
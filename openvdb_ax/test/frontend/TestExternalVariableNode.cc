@@ -57,6 +57,10 @@ static const unittest_util::CodeTests tests =
     { "s$a;",      EXPECTED_PASS(std::string) },
     { "vec3f$a;",  EXPECTED_PASS(openvdb::Vec3f) },
     { "vec3d$a;",  EXPECTED_PASS(openvdb::Vec3d) },
+    { "mat3f$a;",  EXPECTED_PASS(openvdb::Mat3s) },
+    { "mat3d$a;",  EXPECTED_PASS(openvdb::Mat3d) },
+    { "mat4f$a;",  EXPECTED_PASS(openvdb::Mat4s) },
+    { "mat4d$a;",  EXPECTED_PASS(openvdb::Mat4d) },
     { "string$a;", EXPECTED_PASS(std::string) },
 };
 
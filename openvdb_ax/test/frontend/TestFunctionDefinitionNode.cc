@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/ast/AST.h>
+#include <openvdb_ax/Exceptions.h>
+#include <openvdb_ax/test/util.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace {
+
+enum BehaviourFlags
+{
+    Pass = unittest_util::ExpectedBase::Pass,    // else Fails
+};
+
+// The count is the number of function parameters. void is used for void functions
+
+#define EXPECTED_PASS(Type, Count) \
+    unittest_util::ExpectedBase::Ptr(new unittest_util::ExpectedType<Type>(BehaviourFlags::Pass, Count))
+
+static const unittest_util::CodeTests tests =
+{
+    { "void foo() {}",                                           EXPECTED_PASS(void, 0) },
+    { "void foo() { return; }",                                  EXPECTED_PASS(void, 0) },
+    { "void foo(int a) { a = 1; }",                              EXPECTED_PASS(void, 1) },
+    { "bool foo() { return true; }",                             EXPECTED_PASS(bool, 0) },
+    { "int foo(int a) { return a; }",                            EXPECTED_PASS(int, 1) },
+    { "long foo(long a, long b) { return a * b; }",              EXPECTED_PASS(long, 2) },
+    { "float foo(float a, float b, float t) { return a + (b - a) * t; }", EXPECTED_PASS(float, 3) },
+    { "double foo(double a) { if (a > 0) return a; else return -a; }", EXPECTED_PASS(double, 1) },
+    { "vec3i foo(vec3i a) { return a; }",                        EXPECTED_PASS(openvdb::Vec3i, 1) },
+    { "vec3f foo(vec3f a, float b) { return a * b; }",           EXPECTED_PASS(openvdb::Vec3f, 2) },
+    { "vec3d foo() { return {1.0, 2.0, 3.0}; }",                 EXPECTED_PASS(openvdb::Vec3d, 0) },
+    { "int foo(int a) { if (a > 0) { return foo(a - 1); } return 0; }", EXPECTED_PASS(int, 1) },
+    { "int a = 1; int foo() { return 1; } a = foo();",           EXPECTED_PASS(int, 0) },
+};
+
+struct FunctionDefinitionVisitor : public openvdb::ax::ast::Visitor
+{
+    ~FunctionDefinitionVisitor() override = default;
+    inline virtual void
+    visit(const openvdb::ax::ast::FunctionDefinition& node) override final {
+        ++mCount;
+        mNode = &node;
+    }
+    size_t mCount = 0;
+    const openvdb::ax::ast::FunctionDefinition* mNode = nullptr;
+};
+
+}
+
+class TestFunctionDefinitionNode : public CppUnit::TestCase
+{
+ 	public:
+
+ 	CPPUNIT_TEST_SUITE(TestFunctionDefinitionNode);
+ 	CPPUNIT_TEST(testSyntax);
+ 	CPPUNIT_TEST(testASTNode);
+ 	CPPUNIT_TEST_SUITE_END();
+
+ 	void testSyntax() { TEST_SYNTAX(tests); }
+ 	void testASTNode();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFunctionDefinitionNode);
+
+void TestFunctionDefinitionNode::testASTNode()
+{
+	using namespace openvdb::ax::ast;
+
+    for (const auto& test : tests) {
+        const unittest_util::ExpectedBase::Ptr behaviour = test.second;
+        if (behaviour->fails()) continue;
+
+        const std::string& code = test.first;
+        const openvdb::ax::ast::Tree::Ptr tree = parse(code.c_str());
+        CPPUNIT_ASSERT_MESSAGE(ERROR_MSG("No AST returned", code), static_cast<bool>(tree));
+
+        FunctionDefinitionVisitor visitor;
+        tree->accept(visitor);
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MSG("Unexpected AST node count", code),
+            size_t(1), visitor.mCount);
+        CPPUNIT_ASSERT_MESSAGE(ERROR_MSG("Invalid AST node", code),
+            static_cast<bool>(visitor.mNode));
+
+        std::string type = behaviour->type();
+        if (type == openvdb::typeNameAsString<void>()) type = "void";
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MSG("Unexpected FunctionDefinition type", code),
+            type, visitor.mNode->mType);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MSG("Unexpected FunctionDefinition name", code),
+            std::string("foo"), visitor.mNode->mName);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MSG("Unexpected parameter count", code),
+            behaviour->count(), visitor.mNode->mParameters.size());
+        CPPUNIT_ASSERT_MESSAGE(ERROR_MSG("Invalid function body", code),
+            static_cast<bool>(visitor.mNode->mBody));
+    }
+}
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
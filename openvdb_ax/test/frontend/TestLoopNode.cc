@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2019 DNEG
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/ast/AST.h>
+#include <openvdb_ax/Exceptions.h>
+#include <openvdb_ax/test/util.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace {
+
+enum BehaviourFlags
+{
+    Pass = unittest_util::ExpectedBase::Pass,    // else Fails
+};
+
+#define EXPECTED_PASS(Count) \
+    unittest_util::ExpectedBase::Ptr(new unittest_util::ExpectedType<>(BehaviourFlags::Pass, Count))
+
+static const unittest_util::CodeTests tests =
+{
+    { "for (int i = 0; i < 10; ++i) {}",                  EXPECTED_PASS(1) },
+    { "for (int i = 0; i < 10; ++i) a += i;",             EXPECTED_PASS(1) },
+    { "for (i = 0; i < 10; i++) { a += i; }",             EXPECTED_PASS(1) },
+    { "for (;;) { break; }",                              EXPECTED_PASS(1) },
+    { "for (int i; ; ) { continue; }",                    EXPECTED_PASS(1) },
+    { "for (; a < 10;) { a++; }",                         EXPECTED_PASS(1) },
+    { "while (a) {}",                                     EXPECTED_PASS(1) },
+    { "while (a < 10) a++;",                              EXPECTED_PASS(1) },
+    { "while (true) { if (a) break; else continue; }",    EXPECTED_PASS(1) },
+    { "do {} while (a);",                                 EXPECTED_PASS(1) },
+    { "do a++; while (a < 10);",                          EXPECTED_PASS(1) },
+    { "do { if (a) { continue; } } while (false);",       EXPECTED_PASS(1) },
+    { "for (int i = 0; i < 3; ++i) { while (a) { a--; } }", EXPECTED_PASS(2) },
+    { "if (a) for (;;) { return; }",                      EXPECTED_PASS(1) },
+    { "int foo(int a) { while (true) { return a; } }",    EXPECTED_PASS(1) },
+    { "break; continue;",                                 EXPECTED_PASS(0) },
+};
+
+struct LoopVisitor : public openvdb::ax::ast::Visitor
+{
+    ~LoopVisitor() override = default;
+    inline virtual void
+    visit(const openvdb::ax::ast::Loop& node) override final {
+        ++mCount;
+        mNode = &node;
+    }
+    size_t mCount = 0;
+    const openvdb::ax::ast::Loop* mNode = nullptr;
+};
+
+}
+
+class TestLoopNode : public CppUnit::TestCase
+{
+ 	public:
+
+ 	CPPUNIT_TEST_SUITE(TestLoopNode);
+ 	CPPUNIT_TEST(testSyntax);
+ 	CPPUNIT_TEST(testASTNode);
+ 	CPPUNIT_TEST(testLoopTypes);
+ 	CPPUNIT_TEST_SUITE_END();
+
+ 	void testSyntax() { TEST_SYNTAX(tests); }
+ 	void testASTNode();
+ 	void testLoopTypes();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestLoopNode);
+
+void TestLoopNode::testASTNode()
+{
+	using namespace openvdb::ax::ast;
+
+    for (const auto& test : tests) {
+        const unittest_util::ExpectedBase::Ptr behaviour = test.second;
+        if (behaviour->fails()) continue;
+
+        const std::string& code = test.first;
+        const openvdb::ax::ast::Tree::Ptr tree = parse(code.c_str());
+        CPPUNIT_ASSERT_MESSAGE(ERROR_MSG("No AST returned", code), static_cast<bool>(tree));
+
+        LoopVisitor visitor;
+        tree->accept(visitor);
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MSG("Unexpected AST node count", code),
+            behaviour->count(), visitor.mCount);
+        if (behaviour->count() == 0) continue;
+        CPPUNIT_ASSERT_MESSAGE(ERROR_MSG("Invalid AST node", code),
+            static_cast<bool>(visitor.mNode));
+        CPPUNIT_ASSERT_MESSAGE(ERROR_MSG("Invalid loop body", code),
+            static_cast<bool>(visitor.mNode->mBody));
+    }
+}
+
+void TestLoopNode::testLoopTypes()
+{
+	using namespace openvdb::ax::ast;
+
+    LoopVisitor visitor;
+
+    Tree::Ptr tree = parse("for (int i = 0; i < 10; ++i) {}");
+    tree->accept(visitor);
+    CPPUNIT_ASSERT(visitor.mNode);
+    CPPUNIT_ASSERT_EQUAL(Loop::For, visitor.mNode->mLoopType);
+    CPPUNIT_ASSERT(visitor.mNode->mInitial);
+    CPPUNIT_ASSERT(visitor.mNode->mCondition);
+    CPPUNIT_ASSERT(visitor.mNode->mIteration);
+
+    visitor.mNode = nullptr;
+    tree = parse("for (;;) {}");
+    tree->accept(visitor);
+    CPPUNIT_ASSERT(visitor.mNode);
+    CPPUNIT_ASSERT_EQUAL(Loop::For, visitor.mNode->mLoopType);
+    CPPUNIT_ASSERT(!visitor.mNode->mInitial);
+    CPPUNIT_ASSERT(!visitor.mNode->mCondition);
+    CPPUNIT_ASSERT(!visitor.mNode->mIteration);
+
+    visitor.mNode = nullptr;
+    tree = parse("while (a) {}");
+    tree->accept(visitor);
+    CPPUNIT_ASSERT(visitor.mNode);
+    CPPUNIT_ASSERT_EQUAL(Loop::While, visitor.mNode->mLoopType);
+    CPPUNIT_ASSERT(!visitor.mNode->mInitial);
+    CPPUNIT_ASSERT(visitor.mNode->mCondition);
+    CPPUNIT_ASSERT(!visitor.mNode->mIteration);
+
+    visitor.mNode = nullptr;
+    tree = parse("do {} while (a);");
+    tree->accept(visitor);
+    CPPUNIT_ASSERT(visitor.mNode);
+    CPPUNIT_ASSERT_EQUAL(Loop::DoWhile, visitor.mNode->mLoopType);
+    CPPUNIT_ASSERT(visitor.mNode->mCondition);
+
+    // copies are deep
+
+    const Tree::Ptr copy(tree->copy());
+    visitor.mNode = nullptr;
+    copy->accept(visitor);
+    CPPUNIT_ASSERT(visitor.mNode);
+    CPPUNIT_ASSERT_EQUAL(Loop::DoWhile, visitor.mNode->mLoopType);
+    CPPUNIT_ASSERT(visitor.mNode->mCondition);
+}
+
+// Copyright (c) 2015-2019 DNEG
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
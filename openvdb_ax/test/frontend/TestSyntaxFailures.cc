@@ -379,8 +379,8 @@ static const unittest_util::CodeTests tests =
     { "--float;",                      EXPECTED_FAILURE() },
     { "++double;",                     EXPECTED_FAILURE() },
     { "--vector;",                     EXPECTED_FAILURE() },
-    // @todo - disabled as 'matrix' by itself is not yet a keyword
-    // { "matrix--;",                 EXPECTED_FAILURE() },
+    { "matrix--;",                     EXPECTED_FAILURE() },
+    { "++mat4f;",                      EXPECTED_FAILURE() },
     { "--();",                         EXPECTED_FAILURE() },
     { "()++;",                         EXPECTED_FAILURE() },
     { "{}++;",                         EXPECTED_FAILURE() },
@@ -396,6 +396,10 @@ static const unittest_util::CodeTests tests =
     { "int a",                         EXPECTED_FAILURE() },
     { "vector a",                      EXPECTED_FAILURE() },
     { "vector float a",                EXPECTED_FAILURE() },
+    { "mat3f;",                        EXPECTED_FAILURE() },
+    { "mat4d mat3d a;",                EXPECTED_FAILURE() },
+    { "int mat4f = 1;",                EXPECTED_FAILURE() },
+    { "mat4f a = {1,2,3,4};",          EXPECTED_FAILURE() },
 
     // invalid function
     { "function(;",                    EXPECTED_FAILURE() },
@@ -442,6 +446,49 @@ static const unittest_util::CodeTests tests =
     { "return a;",                     EXPECTED_FAILURE() },
     { "return @a;",                    EXPECTED_FAILURE() },
 
+    // invalid function definitions
+    { "foo bar() {}",                  EXPECTED_FAILURE() },
+    { "void foo();",                   EXPECTED_FAILURE() },
+    { "void foo() return;",            EXPECTED_FAILURE() },
+    { "void foo {}",                   EXPECTED_FAILURE() },
+    { "void () {}",                    EXPECTED_FAILURE() },
+    { "void foo(int) {}",              EXPECTED_FAILURE() },
+    { "void foo(a) {}",                EXPECTED_FAILURE() },
+    { "void foo(int a,) {}",           EXPECTED_FAILURE() },
+    { "void foo(int a = 1) {}",        EXPECTED_FAILURE() },
+    { "string foo() {}",               EXPECTED_FAILURE() },
+    { "int 1foo() {}",                 EXPECTED_FAILURE() },
+    { "void foo() { void bar() {} }",  EXPECTED_FAILURE() },
+    { "if (a) { void foo() {} }",      EXPECTED_FAILURE() },
+    { "if (a) void foo() {}",          EXPECTED_FAILURE() },
+    { "{ void foo() {} }",             EXPECTED_FAILURE() },
+    { "void foo() {} return 1;",       EXPECTED_FAILURE() },
+    { "void void() {}",                EXPECTED_FAILURE() },
+    { "int void = 1;",                 EXPECTED_FAILURE() },
+
+    // invalid loops
+    { "for {}",                        EXPECTED_FAILURE() },
+    { "for () {}",                     EXPECTED_FAILURE() },
+    { "for (;) {}",                    EXPECTED_FAILURE() },
+    { "for (;;;) {}",                  EXPECTED_FAILURE() },
+    { "for (int i = 0; i < 1; ++i)",   EXPECTED_FAILURE() },
+    { "for (int i = 0, j = 0;;) {}",   EXPECTED_FAILURE() },
+    { "while {}",                      EXPECTED_FAILURE() },
+    { "while () {}",                   EXPECTED_FAILURE() },
+    { "while (a)",                     EXPECTED_FAILURE() },
+    { "while a {}",                    EXPECTED_FAILURE() },
+    { "do {} while (a)",               EXPECTED_FAILURE() },
+    { "do {} while a;",                EXPECTED_FAILURE() },
+    { "do {};",                        EXPECTED_FAILURE() },
+    { "do while (a);",                 EXPECTED_FAILURE() },
+    { "while (true) { return 1; }",    EXPECTED_FAILURE() },
+    { "break",                         EXPECTED_FAILURE() },
+    { "continue",                      EXPECTED_FAILURE() },
+    { "break 1;",                      EXPECTED_FAILURE() },
+    { "int for = 1;",                  EXPECTED_FAILURE() },
+    { "int while;",                    EXPECTED_FAILURE() },
+    { "break = 1;",                    EXPECTED_FAILURE() },
+
     // invalid unary
     { "+bool;" ,                       EXPECTED_FAILURE() },
     { "+bool a;" ,                     EXPECTED_FAILURE() },
@@ -312,7 +312,10 @@ compareAttributes<openvdb::points::PointDataTree::LeafNodeType>
             else if (type == openvdb::typeNameAsString<openvdb::Vec3d>()) compareArrays<openvdb::Vec3d>(array1, array2, firstLeaf, name, data);
             else if (type == openvdb::typeNameAsString<openvdb::Vec3f>()) compareArrays<openvdb::Vec3f>(array1, array2, firstLeaf, name, data);
             else if (type == openvdb::typeNameAsString<openvdb::Vec3i>()) compareArrays<openvdb::Vec3i>(array1, array2, firstLeaf, name, data);
+            else if (type == openvdb::typeNameAsString<openvdb::Mat3s>()) compareArrays<openvdb::Mat3s>(array1, array2, firstLeaf, name, data);
+            else if (type == openvdb::typeNameAsString<openvdb::Mat3d>()) compareArrays<openvdb::Mat3d>(array1, array2, firstLeaf, name, data);
             else if (type == openvdb::typeNameAsString<openvdb::Mat4s>()) compareArrays<openvdb::Mat4s>(array1, array2, firstLeaf, name, data);
+            else if (type == openvdb::typeNameAsString<openvdb::Mat4d>()) compareArrays<openvdb::Mat4d>(array1, array2, firstLeaf, name, data);
             else {
                 throw std::runtime_error("Unsupported array type for comparison: " + type);
             }
@@ -64,6 +64,7 @@ public:
     CPPUNIT_TEST(testAssignDuplicateLocalVariables);
     CPPUNIT_TEST(testAssignDuplicateScopedLocalVariables);
     CPPUNIT_TEST(testAssignFromExternals);
+    CPPUNIT_TEST(testAssignPromotedAttributes);
     CPPUNIT_TEST_SUITE_END();
 
     void testAssignArithmeticPoints();
@@ -85,6 +86,7 @@ public:
     void testAssignDuplicateLocalVariables();
     void testAssignDuplicateScopedLocalVariables();
     void testAssignFromExternals();
+    void testAssignPromotedAttributes();
 
 };
 
@@ -344,6 +346,23 @@ TestAssign::testAssignFromExternals()
     AXTESTS_STANDARD_ASSERT();
 }
 
+void
+TestAssign::testAssignPromotedAttributes()
+{
+    // attributes promoted to locals must be stored at every exit of the point kernel
+
+    mHarness.testVolumes(false);
+    mHarness.mOptions.mFunctionOptions.mPromoteAttributes = true;
+
+    mHarness.addAttributes<float>({"float_test", "float_test2"}, {3.0f, 2.0f});
+    mHarness.addAttribute<int>("int_test", 1);
+    mHarness.addAttribute<openvdb::Vec3f>("vec_float_test", openvdb::Vec3f(0.0f, 3.0f, 0.0f));
+
+    mHarness.executeCode("test/snippets/assign/assignPromotedAttributes");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
 // Copyright (c) 2015-2019 DNEG
 // All rights reserved. This software is distributed under the
 // Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -42,18 +42,22 @@ public:
 
     CPPUNIT_TEST_SUITE(TestBinary);
     CPPUNIT_TEST(testBitwise);
+    CPPUNIT_TEST(testFastMath);
     CPPUNIT_TEST(testFloatingArithmetic);
     CPPUNIT_TEST(testIntegerArithmetic);
     CPPUNIT_TEST(testLogical);
+    CPPUNIT_TEST(testLogicalShortCircuit);
     CPPUNIT_TEST(testRelational);
     CPPUNIT_TEST(testVectorArithmetic);
     CPPUNIT_TEST(testVectorRelational);
     CPPUNIT_TEST_SUITE_END();
 
     void testBitwise();
+    void testFastMath();
     void testFloatingArithmetic();
     void testIntegerArithmetic();
     void testLogical();
+    void testLogicalShortCircuit();
     void testRelational();
     void testVectorArithmetic();
     void testVectorRelational();
@@ -70,6 +74,21 @@ TestBinary::testBitwise()
     AXTESTS_STANDARD_ASSERT()
 }
 
+void
+TestBinary::testFastMath()
+{
+    // the operands are attributes, so that the arithmetic is not folded at compile time.
+    // All values are exactly representable so fast-math flags do not change the results
+
+    mHarness.addAttributes<float>({"float_a", "float_b", "float_c"},
+        {2.0f, 2.5f, 0.5f}, {2.0f, 2.5f, 0.5f});
+    mHarness.addAttributes<float>(unittest_util::nameSequence("float_test", 4),
+        {4.5f, 5.0f, -0.5f, 4.0f});
+    mHarness.executeCode("test/snippets/binary/binaryFastMath");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
 void
 TestBinary::testFloatingArithmetic()
 {
@@ -101,6 +120,19 @@ TestBinary::testLogical()
     AXTESTS_STANDARD_ASSERT();
 }
 
+void
+TestBinary::testLogicalShortCircuit()
+{
+    // the right hand side of && and || is only evaluated if it can change the result
+
+    mHarness.addAttributes<bool>(unittest_util::nameSequence("bool_test", 5),
+        {false, true, true, true, true});
+    mHarness.addAttribute<int>("int_test1", 3);
+    mHarness.executeCode("test/snippets/binary/binaryLogicalShortCircuit");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
 void
 TestBinary::testRelational()
 {
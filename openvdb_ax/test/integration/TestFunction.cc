@@ -39,6 +39,9 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_01.hpp>
 
+#include <cmath>
+#include <cstring>
+
 using namespace openvdb::points;
 using namespace openvdb::ax;
 
@@ -54,17 +57,25 @@ public:
     CPPUNIT_TEST(testFunctionIntrinsic);
     CPPUNIT_TEST(testFunctionLength);
     CPPUNIT_TEST(testFunctionLengthSq);
+    CPPUNIT_TEST(testFunctionLongString);
+    CPPUNIT_TEST(testFunctionLongStringLoop);
+    CPPUNIT_TEST(testFunctionMatrix);
+    CPPUNIT_TEST(testFunctionNoise);
     CPPUNIT_TEST(testFunctionCeil);
     CPPUNIT_TEST(testFunctionRound);
     CPPUNIT_TEST(testFunctionMax);
     CPPUNIT_TEST(testFunctionMin);
     CPPUNIT_TEST(testFunctionNormalize);
     CPPUNIT_TEST(testFunctionRand);
+    CPPUNIT_TEST(testFunctionRandHash);
     CPPUNIT_TEST(testFunctionPow);
     CPPUNIT_TEST(testFunctionVolumeIndexCoords);
     CPPUNIT_TEST(testFunctionVolumePWS);
+    CPPUNIT_TEST(testFunctionVolumeStencils);
+    CPPUNIT_TEST(testFunctionVolumeStencilSelfRead);
     CPPUNIT_TEST(testFunctionDeletePoint);
     CPPUNIT_TEST(testFunctionLookup);
+    CPPUNIT_TEST(testFunctionUserDefined);
     CPPUNIT_TEST_SUITE_END();
 
     void testFunctionAbs();
@@ -75,17 +86,25 @@ public:
     void testFunctionIntrinsic();
     void testFunctionLength();
     void testFunctionLengthSq();
+    void testFunctionLongString();
+    void testFunctionLongStringLoop();
+    void testFunctionMatrix();
+    void testFunctionNoise();
     void testFunctionCeil();
     void testFunctionRound();
     void testFunctionMax();
     void testFunctionMin();
     void testFunctionNormalize();
     void testFunctionRand();
+    void testFunctionRandHash();
     void testFunctionPow();
     void testFunctionVolumeIndexCoords();
     void testFunctionVolumePWS();
+    void testFunctionVolumeStencils();
+    void testFunctionVolumeStencilSelfRead();
     void testFunctionDeletePoint();
     void testFunctionLookup();
+    void testFunctionUserDefined();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestFunction);
@@ -169,6 +188,29 @@ TestFunction::testFunctionLengthSq()
     AXTESTS_STANDARD_ASSERT();
 }
 
+void
+TestFunction::testFunctionLongString()
+{
+    // concatenates temporaries larger than the maximum stack string size
+
+    mHarness.addAttribute<int>("long_string", 42);
+    mHarness.executeCode("test/snippets/function/functionLongString");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
+void
+TestFunction::testFunctionLongStringLoop()
+{
+    // concatenates temporaries larger than the maximum stack string size on every
+    // iteration of a loop, which reuse the same scratch memory
+
+    mHarness.addAttribute<int>("long_string_loop", 100000);
+    mHarness.executeCode("test/snippets/function/functionLongStringLoop");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
 void
 TestFunction::testFunctionCeil()
 {
@@ -207,6 +249,110 @@ TestFunction::testFunctionMin()
     AXTESTS_STANDARD_ASSERT();
 }
 
+void
+TestFunction::testFunctionMatrix()
+{
+    const openvdb::Mat4s matrix(2.0f, 0.0f, 0.0f, 0.0f,
+                                0.0f, 4.0f, 0.0f, 0.0f,
+                                0.0f, 0.0f, 8.0f, 0.0f,
+                                1.0f, 2.0f, 3.0f, 1.0f);
+
+    const openvdb::Mat4s inverse(0.5f,  0.0f,   0.0f,   0.0f,
+                                 0.0f,  0.25f,  0.0f,   0.0f,
+                                 0.0f,  0.0f,   0.125f, 0.0f,
+                                -0.5f, -0.5f,  -0.375f, 1.0f);
+
+    mHarness.addAttribute<openvdb::Mat4s>("mat4_in", matrix, matrix);
+    mHarness.addAttribute<openvdb::Mat4s>("mat4_inverse", inverse);
+    mHarness.addAttribute<openvdb::Mat4s>("mat4_transpose", matrix.transpose());
+    mHarness.addAttribute<float>("mat4_determinant", 64.0f);
+    mHarness.addAttribute<openvdb::Vec3f>("mat4_transform", openvdb::Vec3f(3.0f, 6.0f, 11.0f));
+
+    mHarness.addAttribute<openvdb::Mat3s>("mat3_inverse",
+        openvdb::Mat3s(1.0f, -2.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.5f));
+    mHarness.addAttribute<openvdb::Mat3s>("mat3_transpose",
+        openvdb::Mat3s(1.0f, 0.0f, 0.0f, 2.0f, 1.0f, 0.0f, 0.0f, 0.0f, 2.0f));
+    mHarness.addAttribute<openvdb::Mat3s>("mat3_singular", openvdb::Mat3s::zero());
+    mHarness.addAttribute<float>("mat3_determinant", 2.0f);
+    mHarness.addAttribute<openvdb::Vec3f>("mat3_transform", openvdb::Vec3f(1.0f, 3.0f, 2.0f));
+
+    mHarness.testVolumes(false);
+    mHarness.executeCode("test/snippets/function/functionMatrix");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
+void
+TestFunction::testFunctionNoise()
+{
+    // reference implementation of the improved Perlin noise generated by noise()
+
+    auto hash = [](const int32_t x, const int32_t y, const int32_t z) -> uint32_t {
+        uint32_t h = static_cast<uint32_t>(x) * 0x8da6b343u;
+        h += static_cast<uint32_t>(y) * 0xd8163841u;
+        h += static_cast<uint32_t>(z) * 0xcb1ab31fu;
+        h ^= h >> 16;
+        h *= 0x7feb352du;
+        h ^= h >> 15;
+        h *= 0x846ca68bu;
+        return h ^ (h >> 16);
+    };
+
+    auto gradient = [](uint32_t h, const double x, const double y, const double z) -> double {
+        h &= 15;
+        const double u = h < 8 ? x : y;
+        const double v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+        return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+    };
+
+    auto perlin = [&](const openvdb::Vec3d& p) -> double {
+        const openvdb::Vec3d lattice(std::floor(p[0]), std::floor(p[1]), std::floor(p[2]));
+        const openvdb::Vec3d offset = p - lattice;
+        const openvdb::Vec3i coord(lattice);
+
+        double values[8];
+        for (int corner = 0; corner < 8; ++corner) {
+            const openvdb::Vec3i c(corner & 1, (corner >> 1) & 1, (corner >> 2) & 1);
+            const openvdb::Vec3i ci = coord + c;
+            values[corner] = gradient(hash(ci[0], ci[1], ci[2]),
+                offset[0] - c[0], offset[1] - c[1], offset[2] - c[2]);
+        }
+
+        double fade[3];
+        for (int i = 0; i < 3; ++i) {
+            const double t = offset[i];
+            fade[i] = t * t * t * ((t * 6.0 - 15.0) * t + 10.0);
+        }
+
+        for (int i = 0, size = 4; i < 3; ++i, size /= 2) {
+            for (int j = 0; j < size; ++j) {
+                const double a = values[j * 2], b = values[j * 2 + 1];
+                values[j] = a + fade[i] * (b - a);
+            }
+        }
+
+        return values[0] * 0.5 + 0.5;
+    };
+
+    const double expected = perlin(openvdb::Vec3d(0.3, 1.7, -2.4));
+    CPPUNIT_ASSERT(expected > 0.0 && expected < 1.0);
+    CPPUNIT_ASSERT(expected != 0.5);
+
+    mHarness.addAttribute<double>("noise_value", expected);
+    mHarness.addAttribute<double>("noise_lattice", 0.5);
+    mHarness.addAttribute<bool>("noise_range", true);
+    mHarness.addAttribute<bool>("snoise_range", true);
+    mHarness.addAttribute<bool>("fbm_octave", true);
+    mHarness.addAttribute<double>("fbm_empty", 0.0);
+    mHarness.addAttribute<bool>("fbm_range", true);
+    mHarness.addAttribute<bool>("curlnoise_divergence", true);
+    mHarness.addAttribute<bool>("curlnoise_nonzero", true);
+
+    mHarness.executeCode("test/snippets/function/functionNoise");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
 void
 TestFunction::testFunctionNormalize()
 {
@@ -235,6 +381,8 @@ unsigned int hashToSeed(size_t hash) {
 void
 TestFunction::testFunctionRand()
 {
+    mHarness.mOptions.mFunctionOptions.mLegacyRand = true;
+
     boost::uniform_01<double> uniform_01;
     size_t hash = boost::hash<double>()(2.0);
     boost::mt19937 engine(static_cast<boost::mt19937::result_type>(hashToSeed(hash)));
@@ -253,6 +401,34 @@ TestFunction::testFunctionRand()
     AXTESTS_STANDARD_ASSERT();
 }
 
+void
+TestFunction::testFunctionRandHash()
+{
+    auto splitmix = [](double seed) -> double {
+        seed += 0.0;
+        uint64_t z;
+        std::memcpy(&z, &seed, sizeof(double));
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+        return static_cast<double>(z >> 11) * (1.0 / 9007199254740992.0);
+    };
+
+    const double expected1 = splitmix(2.0);
+    const double expected2 = splitmix(3.0);
+    CPPUNIT_ASSERT(expected1 >= 0.0 && expected1 < 1.0);
+    CPPUNIT_ASSERT(expected2 >= 0.0 && expected2 < 1.0);
+    CPPUNIT_ASSERT(expected1 != expected2);
+
+    mHarness.addAttributes<double>({"rand_test_0", "rand_test_1", "rand_test_2"},
+        {expected1, expected1, expected2});
+
+    mHarness.executeCode("test/snippets/function/functionRand");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
 void
 TestFunction::testFunctionPow()
 {
@@ -341,6 +517,86 @@ TestFunction::testFunctionVolumePWS()
     AXTESTS_STANDARD_ASSERT();
 }
 
+void
+TestFunction::testFunctionVolumeStencils()
+{
+    // f(x,y,z) = 2x + 3y + z^2 and g(x,y,z) = x - y, densely populated around the leaf
+    // at the origin. g has the same type as f so that both are sampled through caches
+    // of the same tree type
+
+    openvdb::FloatGrid::Ptr f = openvdb::FloatGrid::create();
+    openvdb::FloatGrid::Ptr g = openvdb::FloatGrid::create();
+    f->setName("f");
+    g->setName("g");
+    openvdb::FloatGrid::Accessor fAccessor = f->getAccessor();
+    openvdb::FloatGrid::Accessor gAccessor = g->getAccessor();
+    for (int x = -4; x < 12; ++x) {
+        for (int y = -4; y < 12; ++y) {
+            for (int z = -4; z < 12; ++z) {
+                fAccessor.setValueOn(openvdb::Coord(x, y, z), float(2*x + 3*y + z*z));
+                gAccessor.setValueOn(openvdb::Coord(x, y, z), float(x - y));
+            }
+        }
+    }
+
+    // an interior voxel and a voxel on the border of a leaf node
+
+    const std::vector<openvdb::Coord> coords {
+        openvdb::Coord(1, 2, 3), openvdb::Coord(7, 8, -1)
+    };
+
+    openvdb::Vec3fGrid::Ptr grad = openvdb::Vec3fGrid::create();
+    openvdb::FloatGrid::Ptr lap = openvdb::FloatGrid::create();
+    openvdb::FloatGrid::Ptr offset = openvdb::FloatGrid::create();
+    openvdb::Vec3fGrid::Ptr gradsum = openvdb::Vec3fGrid::create();
+    grad->setName("grad");
+    lap->setName("lap");
+    offset->setName("offset");
+    gradsum->setName("gradsum");
+
+    for (const openvdb::Coord& ijk : coords) {
+        grad->tree().setValueOn(ijk, openvdb::Vec3f(0.0f));
+        lap->tree().setValueOn(ijk, 0.0f);
+        offset->tree().setValueOn(ijk, 0.0f);
+        gradsum->tree().setValueOn(ijk, openvdb::Vec3f(0.0f));
+    }
+
+    openvdb::GridPtrVec grids { f, g, grad, lap, offset, gradsum };
+    unittest_util::wrapExecution(grids, "test/snippets/function/functionVolumeStencils");
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Vec3f(2.0f, 3.0f, 6.0f), grad->tree().getValue(coords[0]));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Vec3f(2.0f, 3.0f, -2.0f), grad->tree().getValue(coords[1]));
+    CPPUNIT_ASSERT_EQUAL(2.0f, lap->tree().getValue(coords[0]));
+    CPPUNIT_ASSERT_EQUAL(2.0f, lap->tree().getValue(coords[1]));
+    CPPUNIT_ASSERT_EQUAL(14.0f, offset->tree().getValue(coords[0]));
+    CPPUNIT_ASSERT_EQUAL(44.0f, offset->tree().getValue(coords[1]));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Vec3f(3.0f, 2.0f, 6.0f), gradsum->tree().getValue(coords[0]));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Vec3f(3.0f, 2.0f, -2.0f), gradsum->tree().getValue(coords[1]));
+}
+
+void
+TestFunction::testFunctionVolumeStencilSelfRead()
+{
+    // d(x) = x^2 along a line crossing several leaf nodes. Every voxel must be
+    // computed from the values before execution, regardless of the order in
+    // which leaf nodes are processed
+
+    openvdb::FloatGrid::Ptr d = openvdb::FloatGrid::create();
+    d->setName("d");
+    for (int x = 0; x < 64; ++x) {
+        d->tree().setValueOn(openvdb::Coord(x, 0, 0), float(x*x));
+    }
+
+    openvdb::GridPtrVec grids { d };
+    unittest_util::wrapExecution(grids, "test/snippets/function/functionVolumeStencilSelfRead");
+
+    CPPUNIT_ASSERT_EQUAL(0.5f, d->tree().getValue(openvdb::Coord(0, 0, 0)));
+    for (int x = 1; x < 63; ++x) {
+        CPPUNIT_ASSERT_EQUAL(float(x*x + 1), d->tree().getValue(openvdb::Coord(x, 0, 0)));
+    }
+    CPPUNIT_ASSERT_EQUAL(float(62*62) * 0.5f, d->tree().getValue(openvdb::Coord(63, 0, 0)));
+}
+
 void
 TestFunction::testFunctionDeletePoint()
 {
@@ -415,6 +671,46 @@ TestFunction::testFunctionLookup()
     }
 
     AXTESTS_STANDARD_ASSERT_HARNESS(mHarness)
+
+    mHarness.reset();
+
+    mHarness.addAttribute<float>("foo", 4.0f);
+    mHarness.addAttribute<openvdb::Vec3f>("v", openvdb::Vec3f(4.0f, 5.0f, 6.0f));
+
+    // test modifying the data post compilation. literal names are bound to the data
+    // which exists at compile time
+
+    data->reset();
+    data->insertData("float1", customFloatData.copy());
+    data->insertData("vector1", customVecData.copy());
+
+    pointExecutable = compiler.compile<PointExecutable>(code, data);
+    volumeExecutable = compiler.compile<VolumeExecutable>(code, data);
+
+    data->insertData("float1", FloatMeta(4.0f).copy());
+    data->insertData("vector1", VectorFloatMeta(openvdb::math::Vec3<float>(4.0f, 5.0f, 6.0f)).copy());
+
+    for (auto& grid : mHarness.mInputPointGrids) {
+        pointExecutable->execute(*grid.second);
+    }
+
+    for (auto& grid : mHarness.mInputVolumeGrids) {
+        volumeExecutable->execute(grid.second);
+    }
+
+    AXTESTS_STANDARD_ASSERT_HARNESS(mHarness)
+}
+
+void
+TestFunction::testFunctionUserDefined()
+{
+    mHarness.addAttribute<float>("float_test", 1.5f);
+    mHarness.addAttributes<int>({"int_test1", "int_test2"}, {120, 1});
+    mHarness.addAttribute<openvdb::Vec3f>("vec_float_test", openvdb::Vec3f(2.0f, 4.0f, 6.0f));
+
+    mHarness.executeCode("test/snippets/function/functionUserDefined");
+
+    AXTESTS_STANDARD_ASSERT();
 }
 
 // Copyright (c) 2015-2019 DNEG
@@ -52,11 +52,12 @@ void wrapExecution(openvdb::points::PointDataGrid& grid,
                    const std::string& codeFileName,
                    const std::string * const group,
                    std::vector<std::string>* warnings,
-                   const openvdb::ax::CustomData::Ptr& data)
+                   const openvdb::ax::CustomData::Ptr& data,
+                   const openvdb::ax::CompilerOptions& options)
 {
     using namespace openvdb::ax;
 
-    Compiler compiler;
+    Compiler compiler(options);
     const std::string code = loadText(codeFileName);
     ast::Tree::Ptr syntaxTree = ast::parse(code.c_str());
     PointExecutable::Ptr executable = compiler.compile<PointExecutable>(*syntaxTree, data, warnings);
@@ -66,11 +67,12 @@ void wrapExecution(openvdb::points::PointDataGrid& grid,
 void wrapExecution(openvdb::GridPtrVec& grids,
                    const std::string& codeFileName,
                    std::vector<std::string>* warnings,
-                   const openvdb::ax::CustomData::Ptr& data)
+                   const openvdb::ax::CustomData::Ptr& data,
+                   const openvdb::ax::CompilerOptions& options)
 {
     using namespace openvdb::ax;
 
-    Compiler compiler;
+    Compiler compiler(options);
     const std::string code = loadText(codeFileName);
     ast::Tree::Ptr syntaxTree = ast::parse(code.c_str());
     VolumeExecutable::Ptr executable = compiler.compile<VolumeExecutable>(*syntaxTree, data, warnings);
@@ -106,14 +108,14 @@ void AXTestHarness::executeCode(const std::string& codeFile,
 {
     if (mUsePoints) {
         for (auto& grid : mInputPointGrids) {
-            wrapExecution(*(grid.second), codeFile, group, warnings, data);
+            wrapExecution(*(grid.second), codeFile, group, warnings, data, mOptions);
         }
     }
 
     if (mUseVolumes)
     {
         for (auto& grids : mInputVolumeGrids) {
-            wrapExecution(grids.second, codeFile, warnings, data);
+            wrapExecution(grids.second, codeFile, warnings, data, mOptions);
         }
     }
 }
@@ -193,6 +195,8 @@ void AXTestHarness::reset()
 
     mInputVolumeGrids["one_voxel"].clear();
     mOutputVolumeGrids["one_voxel"].clear();
+
+    mOptions = openvdb::ax::CompilerOptions();
 }
 
 void AXTestCase::setUp()
@@ -60,13 +60,17 @@ void wrapExecution(openvdb::points::PointDataGrid& grid,
                    const std::string * const group = nullptr,
                    std::vector<std::string>* warnings = nullptr,
                    const openvdb::ax::CustomData::Ptr& data =
-                      openvdb::ax::CustomData::create());
+                      openvdb::ax::CustomData::create(),
+                   const openvdb::ax::CompilerOptions& options =
+                      openvdb::ax::CompilerOptions());
 
 void wrapExecution(openvdb::GridPtrVec& grids,
                    const std::string& codeFileName,
                    std::vector<std::string>* warnings = nullptr,
                    const openvdb::ax::CustomData::Ptr& data =
-                        openvdb::ax::CustomData::create());
+                        openvdb::ax::CustomData::create(),
+                   const openvdb::ax::CompilerOptions& options =
+                        openvdb::ax::CompilerOptions());
 
 struct AXTestHarness
 {
@@ -77,6 +81,7 @@ struct AXTestHarness
       , mOutputVolumeGrids()
       , mUseVolumes(true)
       , mUsePoints(true)
+      , mOptions()
     {
         reset();
     }
@@ -216,6 +221,9 @@ struct AXTestHarness
     bool mUseVolumes;
     bool mUsePoints;
 
+    /// @brief the compiler options used by executeCode, reset to their defaults by reset()
+    openvdb::ax::CompilerOptions mOptions;
+
 private:
     template <typename T>
     void addInputPtAttributes(const std::vector<std::string>& names,
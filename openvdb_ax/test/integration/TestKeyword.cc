@@ -44,6 +44,8 @@ public:
     CPPUNIT_TEST(testKeywordSimpleElseIf);
     CPPUNIT_TEST(testKeywordSimpleReturn);
     CPPUNIT_TEST(testKeywordConditionalReturn);
+    CPPUNIT_TEST(testKeywordConstantFolding);
+    CPPUNIT_TEST(testKeywordLoops);
     CPPUNIT_TEST_SUITE_END();
 
     void testKeywordIfWithinElse();
@@ -52,6 +54,8 @@ public:
     void testKeywordSimpleElseIf();
     void testKeywordSimpleReturn();
     void testKeywordConditionalReturn();
+    void testKeywordConstantFolding();
+    void testKeywordLoops();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestKeyword);
@@ -114,6 +118,29 @@ TestKeyword::testKeywordConditionalReturn()
     AXTESTS_STANDARD_ASSERT();
 }
 
+void
+TestKeyword::testKeywordConstantFolding()
+{
+    mHarness.addAttribute<int>("int_test", 5);
+    mHarness.addAttribute<float>("float_test", 0.25f);
+    mHarness.addAttribute<bool>("bool_test", true);
+    mHarness.executeCode("test/snippets/keyword/conditionalConstantFolding");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
+void
+TestKeyword::testKeywordLoops()
+{
+    mHarness.addAttribute<int>("loop_for", 45);
+    mHarness.addAttribute<int>("loop_while", 7);
+    mHarness.addAttribute<int>("loop_do", 25);
+    mHarness.addAttribute<int>("loop_function", 25);
+    mHarness.executeCode("test/snippets/keyword/loops");
+
+    AXTESTS_STANDARD_ASSERT();
+}
+
 // Copyright (c) 2015-2019 DNEG
 // All rights reserved. This software is distributed under the
 // Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -178,13 +178,21 @@ struct ParameterCache
 /// @param  allowVex  Whether to include support for available houdini functions
 void initializeFunctionRegistry(ax::Compiler& compiler, const bool allowVex)
 {
-    ax::FunctionOptions functionOptions;
-    ax::codegen::FunctionRegistry::UniquePtr functionRegistry =
-        ax::codegen::createStandardRegistry(functionOptions);
-
-    if (allowVex) {
-        hax::registerCustomHoudiniFunctions(*functionRegistry, functionOptions);
-    }
+    // the VEX definitions are built once and shared by all compilers. Each compiler
+    // instantiates the functions it uses in its own registry
+
+    static const ax::codegen::FunctionRegistry::ConstPtr vexDefinitions =
+        []() -> ax::codegen::FunctionRegistry::ConstPtr {
+            ax::FunctionOptions functionOptions;
+            ax::codegen::FunctionRegistry::Ptr registry(
+                new ax::codegen::FunctionRegistry(ax::codegen::standardDefinitions()));
+            hax::registerCustomHoudiniFunctions(*registry, functionOptions);
+            return registry;
+        }();
+
+    ax::codegen::FunctionRegistry::UniquePtr functionRegistry(
+        new ax::codegen::FunctionRegistry(allowVex ?
+            vexDefinitions : ax::codegen::standardDefinitions()));
 
     compiler.setFunctionRegistry(std::move(functionRegistry));
 }